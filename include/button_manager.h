@@ -8,11 +8,6 @@
 #define BUTTON_MANAGER_H
 
 #include <lvgl.h>
-#include <vector>
-#include <functional>
-#include <string>
-#include "freertos/FreeRTOS.h"
-#include "freertos/semphr.h"
 
 // Incluir configuracao centralizada (se disponivel)
 #if __has_include("config/app_config.h")
@@ -43,6 +38,10 @@
     #define GRID_AREA_HEIGHT (SCREEN_HEIGHT - STATUS_BAR_HEIGHT)
 #endif
 
+#ifndef BUTTON_MANAGER_POOL_SIZE
+    #define BUTTON_MANAGER_POOL_SIZE 2
+#endif
+
 // ============================================================================
 // CONFIGURAÇÕES DA GRADE (compatibilidade com codigo legado)
 // ============================================================================
@@ -55,10 +54,40 @@
     #define GRID_ROWS 3
 #endif
 
-#define BUTTON_WIDTH 110
-#define BUTTON_HEIGHT 85
-#define BUTTON_MARGIN 5
-#define GRID_PADDING 10
+#ifndef GRID_TOTAL_BUTTONS
+    #define GRID_TOTAL_BUTTONS (GRID_COLS * GRID_ROWS)
+#endif
+
+#ifndef GRID_BUTTON_WIDTH
+    #define GRID_BUTTON_WIDTH 110
+#endif
+
+#ifndef GRID_BUTTON_HEIGHT
+    #define GRID_BUTTON_HEIGHT 85
+#endif
+
+#ifndef GRID_BUTTON_MARGIN
+    #define GRID_BUTTON_MARGIN 5
+#endif
+
+#ifndef GRID_PADDING
+    #define GRID_PADDING 10
+#endif
+
+#define BUTTON_WIDTH GRID_BUTTON_WIDTH
+#define BUTTON_HEIGHT GRID_BUTTON_HEIGHT
+#define BUTTON_MARGIN GRID_BUTTON_MARGIN
+
+#include "ui/common/button_face.h"
+#include "ui/common/grid_layout.h"
+#include "ui/widgets/popup.h"
+#include "utils/fixed_string.h"
+#include "utils/inline_function.h"
+#include "utils/static_vector.h"
+
+#ifndef BUTTON_LABEL_MAX
+    #define BUTTON_LABEL_MAX 24
+#endif
 
 // ============================================================================
 // ENUMS
@@ -88,33 +117,26 @@ enum ButtonIcon {
     ICON_CHART
 };
 
-enum PopupType {
-    POPUP_INFO,
-    POPUP_WARNING,
-    POPUP_ERROR,
-    POPUP_QUESTION,
-    POPUP_SUCCESS
-};
-
-enum PopupResult {
-    POPUP_RESULT_NONE,
-    POPUP_RESULT_OK,
-    POPUP_RESULT_CANCEL
-};
-
 // ============================================================================
 // ESTRUTURAS
 // ============================================================================
 
+// Callbacks de UI sem alocacao (ponteiro de funcao ou lambda pequeno)
+typedef InlineFunction<void(int)> ButtonCallback;
+typedef InlineFunction<void(PopupResult)> PopupResultCallback;
+
 struct GridButton {
     int id;
     int gridX, gridY;
     int width, height;
-    std::string label;
+    FixedString<BUTTON_LABEL_MAX> label;
     ButtonIcon icon;
     lv_color_t color;
+    const char* imageSrc;           // Guardados para refazer a face (modo de faces)
+    lv_color_t textColor;
+    const lv_font_t* textFont;
     lv_obj_t* obj;
-    std::function<void(int)> callback;
+    ButtonCallback callback;
     bool enabled;
 };
 
@@ -154,62 +176,34 @@ private:
     
     unsigned long messageExpireTime;
     
-    // Sistema de popup
-    lv_obj_t* activePopup;
-    std::function<void(PopupResult)> popupCallback;
+    // Sistema de popup (objetos no PopupService, compartilhados)
+    PopupResultCallback popupCallback;
     PopupResult lastPopupResult;
     
     // Sistema de botões
-    std::vector<GridButton> buttons;
-    bool gridOccupancy[GRID_COLS][GRID_ROWS];
+    StaticVector<GridButton, GRID_TOTAL_BUTTONS> buttons;    // Cada botao ocupa ao menos uma celula
+    int16_t gridOwner[GRID_COLS][GRID_ROWS];    // ID do botao em cada celula (-1 = livre)
     int nextButtonId;
+    bool bakedFaces_;               // Botoes novos com face pre-renderizada
 
     // Debounce por instancia (isolamento entre telas)
     unsigned long lastButtonClickTime_;
     int lastButtonClickedId_;
     
-    // ==========================================
-    // NOVO: Sistema de criação robusta
-    // ==========================================
-    struct PendingButton {
-        int gridX, gridY;
-        const char* label;
-        ButtonIcon icon;
-        const char* image_src;
-        lv_color_t color;
-        std::function<void(int)> callback;
-        int width, height;
-        lv_color_t textColor;
-        const lv_font_t* textFont;
-        int assignedId;
-        int retryCount;
-    };
-    
-    std::vector<PendingButton> pendingButtons;
-    SemaphoreHandle_t creationMutex;
-    lv_timer_t* retryTimer;
-    static const int MAX_RETRY_ATTEMPTS = 3;
-    static const int RETRY_DELAY_MS = 100;
-    
-    // Métodos privados para criação robusta
-    int addButtonInternal(const PendingButton& btn);
-    void processPendingButtons();
-    static void retryTimerCallback(lv_timer_t* timer);
-    bool verifyButtonCreation(int buttonId);
-    
     // Métodos privados existentes
     void createScreen();
     bool isGridPositionFree(int x, int y, int width, int height);
-    void markGridPosition(int x, int y, int width, int height, bool occupied);
+    void markGridPosition(int x, int y, int width, int height, int ownerId);
     bool findFreePosition(int width, int height, int* outX, int* outY);
     bool isPositionValid(int x, int y);
+    void clearGrid();
     
     lv_obj_t* createIconForButton(ButtonIcon icon, lv_obj_t* parent,
                                   lv_color_t textColor, const lv_font_t* iconFont);
     const char* getIconText(ButtonIcon icon);
     
     static void buttonEventHandler(lv_event_t* e);
-    static void popupButtonHandler(lv_event_t* e);
+    static void popupResultHandler(PopupResult result, void* ctx);
     static void statusUpdateCallback(lv_timer_t* timer);
     static void statusTimerHandler(lv_timer_t* timer);
     
@@ -217,55 +211,105 @@ public:
     ButtonManager();
     ~ButtonManager();
 
-    // Non-copyable (possui objetos LVGL, mutex, timers)
+    // Non-copyable (possui objetos LVGL e timers)
     ButtonManager(const ButtonManager&) = delete;
     ButtonManager& operator=(const ButtonManager&) = delete;
 
     // Singleton (para compatibilidade com codigo legado)
     static ButtonManager* getInstance();
     static void destroyInstance();
+
+    /**
+     * Obtem uma instancia do pool (BUTTON_MANAGER_POOL_SIZE por tela).
+     * As instancias sao alocadas uma unica vez e nunca deletadas: release()
+     * apaga a arvore LVGL; a lista de botoes e inline (sem heap).
+     * @return Instancia livre ou nullptr se o pool estiver esgotado
+     */
+    static ButtonManager* acquire();
+
+    /**
+     * Devolve uma instancia ao pool (apaga a tela LVGL e os timers)
+     * @param screenDeleted true se o LVGL ja deletou a tela (invalidate)
+     */
+    static void release(ButtonManager* mgr, bool screenDeleted = false);
     
     // Inicialização
     void init();
 
+    /**
+     * Pausa/retoma os timers LVGL da tela (tela fora de foco, mas viva)
+     */
+    void suspend();
+    void resume();
+
     // Acesso ao screen LVGL interno
     lv_obj_t* getScreen() const { return screen; }
+
+    /**
+     * Modo de faces pre-renderizadas (padrao BUTTON_FACE_BAKE, desligado;
+     * cada tela liga depois do init()) para os botoes criados depois: cada estado vira uma imagem na PSRAM e o
+     * redesenho e uma copia. Texto, icone, cor e habilitado refazem a face;
+     * filhos adicionados depois em GridButton::obj sao desenhados ao vivo.
+     */
+    void setBakedFaces(bool enable) { bakedFaces_ = enable; }
+    bool hasBakedFaces() const { return bakedFaces_; }
     
     // ==========================================
-    // Sistema de botões com criação robusta
+    // Sistema de botões
     // ==========================================
-    int addButton(int gridX, int gridY, const char* label, ButtonIcon icon,
-                 const char* image_src,
-                 lv_color_t color, std::function<void(int)> callback,
-                 int width = 1, int height = 1,
-                 lv_color_t textColor = lv_color_hex(0xFFFFFF),
-                 const lv_font_t* textFont = &lv_font_montserrat_16);
-    
-    // NOVO: Criação em lote
     struct ButtonBatchDef {
         int gridX, gridY;
         const char* label;
         ButtonIcon icon;
         const char* image_src;
         lv_color_t color;
-        std::function<void(int)> callback;
+        ButtonCallback callback;
         int width, height;
         lv_color_t textColor;
         const lv_font_t* textFont;
     };
     
-    std::vector<int> addButtonBatch(const std::vector<ButtonBatchDef>& buttonDefs);
-    bool waitForAllButtons(const std::vector<int>& buttonIds, int timeoutMs = 1000);
+    /**
+     * Constroi uma grade declarativa de botoes em uma unica passada.
+     * Valida o layout inteiro (limites e sobreposicao com gridOwner)
+     * antes de criar qualquer objeto; cria tudo com um unico lock do display.
+     * Retorna de forma sincrona: nao ha fila de retry nem espera.
+     * @param defs Definicoes dos botoes
+     * @param count Numero de definicoes
+     * @param outIds Saida opcional: IDs na ordem das definicoes (-1 se falhou)
+     * @return Numero de botoes criados (0 se o layout for invalido)
+     */
+    int buildGrid(const ButtonBatchDef* defs, size_t count, int* outIds = nullptr);
+
+    /**
+     * Constroi a grade a partir de um layout validado em tempo de compilacao.
+     * As posicoes de defs sao preenchidas pelo layout (mesma ordem).
+     */
+    template <size_t N>
+    int buildGrid(const GridLayout<AppGridGeometry, N>& layout, ButtonBatchDef (&defs)[N],
+                  int* outIds = nullptr) {
+        for (size_t i = 0; i < N; i++) {
+            defs[i].gridX = layout.cell(i).x;
+            defs[i].gridY = layout.cell(i).y;
+            defs[i].width = layout.cell(i).w;
+            defs[i].height = layout.cell(i).h;
+        }
+        return buildGrid(defs, N, outIds);
+    }
+    
+    int addButton(int gridX, int gridY, const char* label, ButtonIcon icon,
+                 const char* image_src,
+                 lv_color_t color, ButtonCallback callback,
+                 int width = 1, int height = 1,
+                 lv_color_t textColor = lv_color_hex(0xFFFFFF),
+                 const lv_font_t* textFont = &lv_font_montserrat_16);
     
-    // NOVO: Status de criação
     enum CreationStatus {
         CREATION_SUCCESS,
-        CREATION_PENDING,
         CREATION_FAILED
     };
     
     CreationStatus getButtonCreationStatus(int buttonId);
-    int getPendingButtonCount() const { return pendingButtons.size(); }
     
     // Gerenciamento de botões existente
     bool removeButton(int buttonId);
@@ -277,6 +321,13 @@ public:
     bool setButtonColor(int buttonId, lv_color_t color);
     
     GridButton* getButton(int buttonId);
+
+    /**
+     * Hit-test O(1) na grade
+     * @param x, y Coordenadas relativas a area de conteudo da grade
+     * @return ID do botao sob o ponto ou -1
+     */
+    int getButtonAt(lv_coord_t x, lv_coord_t y) const;
     
     // Barra de status
     void updateStatusBar(const BtnStatusBarData& data);
@@ -299,15 +350,32 @@ public:
      */
     lv_obj_t* createPopupOverlay();
 
+    /**
+     * Exibe popup padrao pelo PopupService (objetos pre-alocados, sem
+     * criacao por chamada). Com outro popup visivel, entra na fila.
+     */
     void showPopup(const char* title, const char* message,
                   PopupType type = POPUP_INFO, bool showCancel = false,
-                  std::function<void(PopupResult)> callback = nullptr);
+                  PopupResultCallback callback = nullptr);
     void closePopup();
     PopupResult getLastPopupResult() const { return lastPopupResult; }
     
     // Utilitários
     void setScreenBackground(lv_color_t color);
     void printGridOccupancy();
+
+private:
+    // Construcao da grade (uma passada, sem espera)
+    lv_obj_t* createButtonObject(const ButtonBatchDef& def, int buttonId);
+    lv_obj_t* createButtonTree(const ButtonBatchDef& def);
+    bool rebakeFace(GridButton& btn, bool withDisabled);
+
+    // Libera timers e a tela LVGL, voltando ao estado pos-construtor
+    void reset(bool deleteScreen = true);
+
+    // Pool de instancias
+    static ButtonManager* pool[BUTTON_MANAGER_POOL_SIZE];
+    static bool poolInUse[BUTTON_MANAGER_POOL_SIZE];
 };
 
 // ============================================================================
@@ -55,18 +55,64 @@ extern "C" {
 #define GRID_BUTTON_MARGIN      5
 #define GRID_PADDING            10
 #define GRID_TOTAL_BUTTONS      (GRID_COLS * GRID_ROWS)
+#define BUTTON_LABEL_MAX        24      // Bytes do texto do botao (com terminador)
+#define BUTTON_FACE_BAKE        0       // Faces pre-renderizadas por padrao; as telas ligam com setBakedFaces(true)
+#define BUTTON_FACE_POOL        (GRID_TOTAL_BUTTONS * BUTTON_MANAGER_POOL_SIZE) // Botoes com face ao mesmo tempo
 
 // ============================================================================
 // CONFIGURACOES DA BARRA DE STATUS
 // ============================================================================
 
 #define STATUS_BAR_HEIGHT       40
-#define STATUS_BAR_UPDATE_MS    250     // Intervalo de atualizacao
 #define STATUS_MESSAGE_TIMEOUT  3000    // Timeout padrao de mensagens
 
 // Area util da grade (sem barra de status)
 #define GRID_AREA_HEIGHT        (DISPLAY_HEIGHT - STATUS_BAR_HEIGHT)
 
+// ============================================================================
+// CONFIGURACOES DE POPUP
+// ============================================================================
+
+#define POPUP_QUEUE_SIZE        4       // Popups pendentes (inclui o visivel)
+#define POPUP_TITLE_MAX         32      // Bytes do titulo (com terminador)
+#define POPUP_MESSAGE_MAX       128     // Bytes da mensagem (com terminador)
+
+// ============================================================================
+// CONFIGURACOES DE ASSETS DE IMAGEM
+// ============================================================================
+
+#define ASSET_PARTITION_LABEL   "assets"    // Particao gerada por tools/assets/img_compile.py
+#define ASSET_MAX_ENTRIES       16      // Imagens no indice
+#define ASSET_NAME_MAX          32      // Bytes do nome (com terminador), igual ao compilador
+#define PNG_STREAM_INPUT_SIZE   1024    // Bytes de IDAT lidos por vez pelo decoder PNG em streaming
+#define PNG_STREAM_FULL_DECODE_MAX (96 * 1024) // Ate aqui o PNG e decodificado inteiro no open (PSRAM)
+#define IMG_CACHE_REPORT_PERIOD_MS 60000   // Relatorio do cache de imagens da LVGL
+
+// ============================================================================
+// CONFIGURACOES DO HEAP DA LVGL
+// ============================================================================
+
+// Tamanho do pool na RAM interna: LV_MEM_TLSF_POOL_SIZE em lv_conf.h
+#define LVGL_MEM_SMALL_MAX      2048    // Maior pedido atendido pelo pool (maiores vao para a PSRAM)
+#define LVGL_MEM_REPORT_PERIOD_MS 60000 // Relatorio de uso/fragmentacao do pool no log
+#ifndef LVGL_MEM_TRACE
+#define LVGL_MEM_TRACE          0       // 1 = captura alocacoes para replay no host (lvgl_mem_trace_dump)
+#endif
+#ifndef LVGL_MEM_TRACE_EVENTS
+#define LVGL_MEM_TRACE_EVENTS   8192    // Operacoes guardadas no trace (PSRAM, 16 B cada)
+#endif
+
+// ============================================================================
+// CONFIGURACOES DE CACHE DE GLIFOS
+// ============================================================================
+
+#define GLYPH_CACHE_ENABLE      1       // 0 = so mede o tempo de desenho (comparacao)
+#define GLYPH_CACHE_ENTRIES     192     // Glifos (fonte + codepoint) no LRU
+#define GLYPH_CACHE_BUDGET      (48 * 1024) // Bytes de bitmaps A8 na PSRAM
+#define GLYPH_CACHE_MAX_FONTS   12      // Fontes com tabela ASCII direta
+#define GLYPH_CACHE_RAMP        1       // Letras opacas sobre fundo liso direto no buffer
+#define GLYPH_CACHE_REPORT_PERIOD_MS 60000 // Relatorio de acertos/tempo no log
+
 // ============================================================================
 // CONFIGURACOES DE JORNADA
 // ============================================================================
@@ -84,6 +130,10 @@ extern "C" {
 // 5 = DESCARGA
 // 6 = ABASTECIMENTO
 
+// Persistencia dos totais (espelho em RTC + flush agregado na NVS)
+#define JORNADA_FLUSH_INTERVAL_MS   (10 * 60 * 1000)    // Idade maxima de dados sujos
+#define JORNADA_FLUSH_THRESHOLD     16      // Mudancas agregadas que forcam flush
+
 // ============================================================================
 // CONFIGURACOES DE IGNICAO
 // ============================================================================
@@ -91,7 +141,8 @@ extern "C" {
 #define IGNICAO_PIN             18
 #define IGNICAO_DEBOUNCE_ON_S   1.0f    // Segundos para confirmar ON
 #define IGNICAO_DEBOUNCE_OFF_S  2.0f    // Segundos para confirmar OFF
-#define IGNICAO_CHECK_INTERVAL  100     // Intervalo de verificacao (ms)
+#define IGNICAO_CHECK_INTERVAL  100     // Intervalo de verificacao durante o debounce (ms)
+#define IGNICAO_IDLE_CHECK_MS   5000    // Verificacao de seguranca sem borda (ms)
 #define IGNICAO_MIN_DEBOUNCE    0.0f    // Debounce minimo
 #define IGNICAO_MAX_DEBOUNCE    10.0f   // Debounce maximo
 
@@ -157,11 +208,41 @@ extern "C" {
 
 #define BAT_ADC_PIN             5
 
+// ============================================================================
+// CONFIGURACOES DE BATERIA
+// ============================================================================
+
+#define BATTERY_SAMPLE_FREQ_HZ      20000   // Frequencia do ADC continuo durante a rajada
+#define BATTERY_FRAME_SAMPLES       64      // Amostras por quadro DMA (mediana)
+#define BATTERY_SAMPLE_PERIOD_MS    1000    // Intervalo entre rajadas (duty cycle baixo)
+#define BATTERY_IIR_SHIFT           3       // Filtro IIR: alpha = 1/2^shift
+#define BATTERY_DIVIDER_NUM         2       // Divisor resistivo: Vbat = Vadc * NUM / DEN
+#define BATTERY_DIVIDER_DEN         1
+#define BATTERY_LOW_MV              3400    // Limiar de bateria fraca (mV)
+#define BATTERY_LOW_HYST_MV         100     // Histerese para sair de bateria fraca (mV)
+#define BATTERY_REPORT_FRAMES       60      // Quadros entre relatorios de custo de CPU
+
+// ============================================================================
+// CONFIGURACOES DO BARRAMENTO DE EVENTOS
+// ============================================================================
+
+#define EVENT_BUS_RING_SIZE         16      // Eventos por anel (nucleo x destino), potencia de 2
+#define EVENT_BUS_MAX_SUBSCRIBERS   8       // Handlers por destino
+
+// ============================================================================
+// CONFIGURACOES DE ENERGIA
+// ============================================================================
+
+#define POWER_LIGHT_SLEEP_ENABLE    1       // Light sleep automatico (exige tickless idle)
+#define POWER_CPU_MIN_FREQ_MHZ      80      // Frequencia com CPU ociosa sem dormir
+#define POWER_REPORT_PERIOD_MS      60000   // Relatorio de residencia/wakeups
+
 // ============================================================================
 // CONFIGURACOES DE TIMEOUT
 // ============================================================================
 
 #define NUMPAD_TIMEOUT_MS       10000   // Timeout do teclado numerico
+#define NUMPAD_MAX_DIGITS       16      // Capacidade do codigo digitado
 #define POPUP_DEFAULT_TIMEOUT   3000    // Timeout padrao de popups
 #define BUTTON_DEBOUNCE_MS      300     // Debounce de botoes UI
 #define DISPLAY_LOCK_TIMEOUT    100     // Timeout para lock do display
@@ -178,10 +259,15 @@ extern "C" {
 // CONFIGURACOES DE FILESYSTEM
 // ============================================================================
 
-#define FS_BASE_PATH            "/littlefs"
+#ifndef FS_BASE_PATH
+#define FS_BASE_PATH            "/littlefs"   // Sobrescrito pelo teste de host (diretorio do build)
+#endif
 #define FS_PARTITION_LABEL      "spiffs"
 #define FS_MAX_FILES            5
 #define FS_FORMAT_IF_FAILED     false
+#define FS_DRV_HANDLE_CACHE     3       // Handles de leitura mantidos abertos pelo driver LVGL (< FS_MAX_FILES)
+#define FS_DRV_READAHEAD        4096    // Bloco de read-ahead por handle (bloco do LittleFS)
+#define FS_DRV_PATH_MAX         64      // Caminho maximo dos arquivos em cache
 
 // ============================================================================
 // CONFIGURACOES DE DEBUG
@@ -199,10 +285,26 @@ extern "C" {
 #define SYSTEM_TASK_PRIORITY    5       // Prioridade da task principal
 #define SYSTEM_TASK_STACK_SIZE  8192    // Stack da task principal
 
+#define LVGL_TASK_CORE          0       // Task LVGL: unica que toca no LVGL
+#define LVGL_TASK_PRIORITY      4
+#define LVGL_TASK_STACK_SIZE    6144
+
 #define IGNICAO_TASK_CORE       0
 #define IGNICAO_TASK_PRIORITY   2
 #define IGNICAO_TASK_STACK_SIZE 4096
 
+#define BATTERY_TASK_CORE       0
+#define BATTERY_TASK_PRIORITY   1
+#define BATTERY_TASK_STACK_SIZE 3072
+
+// ============================================================================
+// CONFIGURACOES DO BOOT
+// ============================================================================
+
+#define BOOT_WORKER_STACK_SIZE  8192    // Task auxiliar do boot (outro core)
+#define BOOT_MAX_STAGES         16      // Etapas do escalonador (max 24)
+#define BOOT_TRACE_MAX_SPANS    32      // Intervalos medidos no boot
+
 // ============================================================================
 // CORES DO TEMA (formato 0xRRGGBB)
 // ============================================================================
@@ -235,6 +337,10 @@ extern "C" {
 #define THEME_BTN_EMERGENCIA    0xFF0000    // Vermelho
 #define THEME_BTN_NUMPAD        0x4444FF    // Azul claro
 
+// Folha de estilos compartilhados (capacidade fixa, alocada no primeiro uso)
+#define THEME_MAX_BG_STYLES     16      // Estilos de cor de fundo distintos
+#define THEME_MAX_TEXT_STYLES   16      // Combinacoes cor de texto + fonte
+
 // ============================================================================
 // ARQUIVOS DE AUDIO
 // ============================================================================
@@ -279,6 +385,7 @@ extern "C" {
 #define NVS_NS_JORNADA          "jornada"
 #define NVS_KEY_VOLUME          "volume"
 #define NVS_KEY_BRIGHTNESS      "brightness"
+#define NVS_KEY_JORNADA_TOTAIS  "totais"
 #define NVS_JORNADA_VERSION     1
 
 // ============================================================================
@@ -303,9 +410,10 @@ extern "C" {
 // CONFIGURACOES DE NAVEGACAO DE TELAS
 // ============================================================================
 
-#define SCREEN_TRANSITION_TIME_MS   250
+#define SCREEN_TRANSITION_TIME_MS   250     // Slide por snapshot (0 = troca instantanea)
 #define SCREEN_TRANSITION_DELAY_MS  0
 #define SCREEN_NAV_STACK_MAX        8
+#define BUTTON_MANAGER_POOL_SIZE    2       // Um ButtonManager por tela com grade
 
 #ifdef __cplusplus
 }
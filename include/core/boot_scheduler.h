@@ -0,0 +1,112 @@
+/**
+ * ============================================================================
+ * ESCALONADOR DO BOOT - HEADER
+ * ============================================================================
+ *
+ * Roda as etapas de inicializacao respeitando dependencias, nos dois
+ * cores: a task que chama run() trabalha no seu core e uma task auxiliar
+ * no outro. Cada worker pega a primeira etapa pronta (dependencias
+ * concluidas e core compativel) na ordem em que foram adicionadas, entao
+ * as etapas do caminho critico devem vir primeiro.
+ *
+ * Exemplo:
+ *   BootScheduler boot;
+ *   int fs   = boot.add("fs", stageFs);
+ *   int disp = boot.add("display", stageDisplay, 0, 0);
+ *   boot.add("splash", stageSplash, BOOT_DEP(fs) | BOOT_DEP(disp));
+ *   boot.run();
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef BOOT_SCHEDULER_H
+#define BOOT_SCHEDULER_H
+
+#include <stdint.h>
+#include "config/app_config.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+
+#ifndef BOOT_MAX_STAGES
+#define BOOT_MAX_STAGES         16
+#endif
+
+#ifndef BOOT_WORKER_STACK_SIZE
+#define BOOT_WORKER_STACK_SIZE  8192
+#endif
+
+// Um bit do event group por etapa
+static_assert(BOOT_MAX_STAGES <= 24, "BOOT_MAX_STAGES limitado aos 24 bits do event group");
+
+#define BOOT_DEP(stage)         (1u << (stage))
+#define BOOT_ANY_CORE           (-1)
+
+/**
+ * Etapa de boot
+ * @return false em falha: etapas que dependem dela sao puladas
+ */
+typedef bool (*BootStageFn)(void* arg);
+
+class BootScheduler {
+public:
+    BootScheduler();
+
+    /**
+     * Adiciona uma etapa
+     * @param deps BOOT_DEP() de etapas ja adicionadas
+     * @param core Core obrigatorio (BOOT_ANY_CORE: qualquer um). Etapas que
+     *             instalam interrupcoes devem fixar o core: o ISR fica no
+     *             core de quem o registra.
+     * @return indice para BOOT_DEP() (-1 se a tabela estiver cheia ou as
+     *         dependencias forem invalidas; run() entao falha)
+     */
+    int add(const char* name, BootStageFn fn, uint32_t deps = 0,
+            int core = BOOT_ANY_CORE, void* arg = nullptr);
+
+    /**
+     * Executa todas as etapas e retorna quando terminarem. Chamar de uma
+     * task fixa em um core. Imprime o caminho critico no fim.
+     * @return true se nenhuma etapa falhou
+     */
+    bool run();
+
+private:
+    struct Stage {
+        const char* name;
+        BootStageFn fn;
+        void* arg;
+        uint32_t deps;
+        int8_t core;
+        int8_t after;           // Dependencia que terminou por ultimo (-1: nenhuma)
+        int64_t readyUs;        // Dependencias concluidas
+        int64_t startUs;
+        int64_t endUs;
+    };
+
+    static void helperTask(void* arg);
+    void work(int core);
+    int pick(int core);
+    void finish(int idx, bool ok);
+    void printCriticalPath() const;
+
+    Stage stages_[BOOT_MAX_STAGES];
+    uint8_t count_;
+    bool invalid_;
+    bool pinning_;              // Sem task auxiliar o core vira so preferencia
+
+    uint32_t started_;          // Bits protegidos por mutex_
+    uint32_t done_;
+    uint32_t failed_;
+    int64_t runStartUs_;
+
+    SemaphoreHandle_t mutex_;
+    EventGroupHandle_t doneBits_;   // Acorda workers sem etapa pronta
+    SemaphoreHandle_t helperExit_;
+};
+
+#endif // BOOT_SCHEDULER_H
@@ -0,0 +1,78 @@
+/**
+ * ============================================================================
+ * TRACE DO BOOT - HEADER
+ * ============================================================================
+ *
+ * Intervalos com inicio, duracao e core de cada etapa da inicializacao,
+ * mais dois marcos: primeiro quadro (splash desenhado) e sistema
+ * interativo (UI pronta e task LVGL recebendo eventos). Pode ser chamado
+ * de qualquer task; o relatorio sai uma vez, no fim do boot.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef BOOT_TRACE_H
+#define BOOT_TRACE_H
+
+#include "config/app_config.h"
+
+#ifndef BOOT_TRACE_MAX_SPANS
+#define BOOT_TRACE_MAX_SPANS    32
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    BOOT_MARK_FIRST_FRAME = 0,  // Primeiro quadro desenhado
+    BOOT_MARK_INTERACTIVE,      // UI pronta para toque
+    BOOT_MARK_COUNT
+} boot_mark_t;
+
+/**
+ * Abre um intervalo na task atual
+ * @param name Nome da etapa (literal, nao e copiado)
+ * @return id para boot_trace_end (-1 se a tabela estiver cheia)
+ */
+int boot_trace_begin(const char* name);
+
+/**
+ * Fecha o intervalo aberto por boot_trace_begin (ignora id -1)
+ */
+void boot_trace_end(int id);
+
+/**
+ * Registra um marco; so a primeira chamada de cada marco vale
+ */
+void boot_trace_mark(boot_mark_t mark);
+
+/**
+ * Imprime os intervalos, o tempo ate o primeiro quadro e ate o sistema
+ * interativo, e quanto das etapas rodou em paralelo
+ */
+void boot_trace_report(void);
+
+#ifdef __cplusplus
+}
+
+/**
+ * Intervalo com escopo: fecha no fim do bloco
+ */
+class BootSpan {
+public:
+    explicit BootSpan(const char* name) : id_(boot_trace_begin(name)) {}
+    ~BootSpan() { boot_trace_end(id_); }
+
+    BootSpan(const BootSpan&) = delete;
+    BootSpan& operator=(const BootSpan&) = delete;
+
+private:
+    int id_;
+};
+#endif
+
+#endif // BOOT_TRACE_H
@@ -0,0 +1,250 @@
+/**
+ * ============================================================================
+ * BARRAMENTO DE EVENTOS - HEADER
+ * ============================================================================
+ *
+ * Pub/sub tipado entre servicos e consumidores (UI, audio) sem alocacao.
+ *
+ * Cada destino tem um anel SPSC de capacidade fixa por nucleo. publish()
+ * escreve so nos aneis do nucleo em que roda, com as interrupcoes do
+ * proprio nucleo mascaradas (nenhuma outra task desse nucleo entra no
+ * meio); nao ha trava entre nucleos. O seq vem de um contador atomico
+ * global. A task do destino e a unica que le, sem lock, e consome os
+ * eventos no seu proprio contexto (UI no loop LVGL, audio na task do
+ * Core 1), intercalando os aneis dos nucleos por seq. Para nao entregar
+ * um seq maior antes de um menor que o outro nucleo ainda esta gravando,
+ * cada nucleo anuncia o menor seq que pode receber enquanto publica
+ * (inflightSeq_), e dispatch() para abaixo dele.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include "config/app_config.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+
+#include <atomic>
+
+// ============================================================================
+// TIPOS
+// ============================================================================
+
+/**
+ * Tipos de evento
+ */
+enum class EventType : uint8_t {
+    IGNICAO_CHANGED = 0,    // payload: ignicao
+    JORNADA_CHANGED,        // payload: jornada
+    MAX_TYPES
+};
+
+/**
+ * Origens (identificam o produtor nos logs; o anel e escolhido pelo nucleo)
+ */
+enum class EventSource : uint8_t {
+    IGNICAO = 0,            // Task IgnicaoMonitor
+    JORNADA,                // Chamadores do JornadaService (UI, servicos)
+    MAX_SOURCES
+};
+
+/**
+ * Destinos (uma task consumidora por destino)
+ */
+enum class EventSink : uint8_t {
+    UI = 0,                 // Task LVGL (drenado pelo pump do lv_port)
+    AUDIO,                  // Task de audio (Core 1)
+    MAX_SINKS
+};
+
+/**
+ * Evento (copiado por valor nos aneis)
+ */
+struct AppEvent {
+    EventType type;
+    uint32_t seq;           // Ordem global de publicacao (preenchido pelo bus)
+    uint32_t timestamp;     // time_millis() na publicacao
+    union {
+        struct {
+            bool on;
+        } ignicao;
+        struct {
+            int16_t motoristaId;
+            uint8_t estado;     // static_cast de EstadoJornada
+        } jornada;
+    };
+};
+
+/**
+ * Handler de evento (executado no contexto do destino)
+ */
+typedef void (*EventHandler)(const AppEvent& event, void* ctx);
+
+// ============================================================================
+// ANEL SPSC
+// ============================================================================
+
+/**
+ * Fila circular de produtor unico / consumidor unico
+ * N deve ser potencia de 2. Politica de overflow: o evento novo e
+ * descartado e contado (o produtor nunca toca no indice do consumidor).
+ * O EventBus tem um anel por nucleo: as tasks de um nucleo se revezam
+ * com as interrupcoes do nucleo mascaradas, entao ha um escritor por vez.
+ */
+template <typename T, uint32_t N>
+class SpscRing {
+    static_assert((N & (N - 1)) == 0, "Capacidade do anel deve ser potencia de 2");
+
+public:
+    SpscRing() : head_(0), tail_(0), dropped_(0) {}
+
+    bool push(const T& item) {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        uint32_t tail = tail_.load(std::memory_order_acquire);
+        if (head - tail >= N) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        items_[head & (N - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    const T* peek() const {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items_[tail & (N - 1)];
+    }
+
+    void pop() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_relaxed) == head_.load(std::memory_order_acquire);
+    }
+
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    T items_[N];
+    std::atomic<uint32_t> head_;    // Escrito apenas pelo produtor
+    std::atomic<uint32_t> tail_;    // Escrito apenas pelo consumidor
+    std::atomic<uint32_t> dropped_;
+};
+
+// ============================================================================
+// BARRAMENTO
+// ============================================================================
+
+/**
+ * Estatisticas do barramento
+ */
+struct EventBusStats {
+    uint32_t published;     // Eventos aceitos em pelo menos um destino
+    uint32_t delivered;     // Handlers executados
+    uint32_t dropped;       // Eventos descartados por anel cheio
+};
+
+class EventBus {
+public:
+    // Singleton
+    static EventBus* getInstance();
+
+    /**
+     * Registra um handler em um destino
+     * Deve ser chamado na inicializacao, antes dos produtores publicarem.
+     * @return false se a tabela de inscricoes estiver cheia
+     */
+    bool subscribe(EventSink sink, EventType type, EventHandler handler, void* ctx = nullptr);
+
+    /**
+     * Define a task consumidora de um destino (acordada via notificacao
+     * quando um evento chega). UI: task LVGL (lvgl_port_get_task()).
+     */
+    void setSinkTask(EventSink sink, TaskHandle_t task);
+
+    /**
+     * Publica um evento (nao bloqueia, nao aloca, sem trava entre nucleos)
+     * Pode ser chamado de qualquer task; nao chamar de ISR.
+     * @return false se algum destino inscrito descartou o evento
+     */
+    bool publish(EventSource source, AppEvent event);
+
+    /**
+     * Entrega os eventos pendentes de um destino aos seus handlers
+     * Deve ser chamado apenas pela task consumidora do destino.
+     * @return Numero de eventos entregues
+     */
+    uint32_t dispatch(EventSink sink);
+
+    /**
+     * Verifica se ha eventos pendentes para um destino
+     */
+    bool hasPending(EventSink sink) const;
+
+    /**
+     * Obtem estatisticas
+     */
+    EventBusStats getStats() const;
+
+private:
+    EventBus();
+
+    // Nao permitir copia
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    typedef SpscRing<AppEvent, EVENT_BUS_RING_SIZE> Ring;
+
+    struct Subscriber {
+        EventType type;
+        EventHandler handler;
+        void* ctx;
+    };
+
+    static constexpr int NUM_SOURCES = static_cast<int>(EventSource::MAX_SOURCES);
+    static constexpr int NUM_SINKS = static_cast<int>(EventSink::MAX_SINKS);
+    static constexpr int NUM_CORES = portNUM_PROCESSORS;
+
+    // Singleton
+    static EventBus* instance;
+
+    // Aneis [destino][nucleo produtor]
+    Ring rings_[NUM_SINKS][NUM_CORES];
+
+    // Inscricoes por destino
+    Subscriber subscribers_[NUM_SINKS][EVENT_BUS_MAX_SUBSCRIBERS];
+    uint8_t subscriberCount_[NUM_SINKS];
+    uint32_t typeMask_[NUM_SINKS];
+
+    // Tasks consumidoras (opcional)
+    TaskHandle_t sinkTasks_[NUM_SINKS];
+
+    // Numeracao global (fetch_add, sem trava)
+    std::atomic<uint32_t> seq_;     // Proximo seq
+
+    // Publicacao em andamento por nucleo: busy_ e o limite inferior do seq
+    // que ela vai receber (gravado antes de busy_)
+    std::atomic<bool> busy_[NUM_CORES];
+    std::atomic<uint32_t> inflightSeq_[NUM_CORES];
+
+    // Estatisticas
+    std::atomic<uint32_t> published_;
+    std::atomic<uint32_t> delivered_;
+};
+
+#endif // __cplusplus
+
+#endif // EVENT_BUS_H
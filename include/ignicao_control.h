@@ -1,16 +1,13 @@
 /**
  * ============================================================================
- * CONTROLE DE IGNIÇÃO - ESP32-S3
+ * CONTROLE DE IGNIÇÃO - ESP32-S3 (API LEGADA)
  * ============================================================================
  * 
- * Módulo responsável por monitorar o sinal de ignição na IO18 com debounce
- * configurável para evitar leituras falsas devido a ruídos elétricos.
+ * Shim de compatibilidade sobre o IgnicaoService. Nao possui task, mutex
+ * ou estado proprios: todas as chamadas sao delegadas ao singleton do
+ * servico, de modo que existe uma unica task "IgnicaoMonitor" no sistema.
  * 
- * Características:
- * - Monitoramento contínuo da IO18
- * - Debounce independente para ON e OFF
- * - Suporte a leitura instantânea (debounce = 0)
- * - Thread-safe com mutex para acesso multi-core
+ * Codigo novo deve usar IgnicaoService (services/ignicao/ignicao_service.h).
  * 
  * ============================================================================
  */
@@ -20,11 +17,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "freertos/semphr.h"
-#include "driver/gpio.h"
-#include "esp_timer.h"
+#include "config/app_config.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,37 +27,12 @@ extern "C" {
 // DEFINIÇÕES E CONSTANTES
 // ============================================================================
 
-// Pino de monitoramento da ignição
-#define IGNICAO_PIN 18
-
 // Estados da ignição
 #define IGNICAO_OFF false
 #define IGNICAO_ON  true
 
-// Intervalo de verificação em ms (100ms = 10 verificações por segundo)
-#define IGNICAO_CHECK_INTERVAL_MS 100
-
-// ============================================================================
-// VARIÁVEIS EXTERNAS
-// ============================================================================
-
-// Status atual da ignição (protegido por mutex)
-extern volatile bool ignicaoStatus;
-
-// Tempos de debounce em segundos (podem ser alterados em runtime)
-extern float debounceIgnicaoOn;   // Tempo para confirmar ignição ligada
-extern float debounceIgnicaoOff;  // Tempo para confirmar ignição desligada
-
-// Mutex para acesso thread-safe
-extern SemaphoreHandle_t ignicaoMutex;
-
-// Handle da task de monitoramento
-extern TaskHandle_t ignicaoTaskHandle;
-
-// Estatísticas de monitoramento (opcional)
-extern unsigned long totalIgnicaoOnTime;
-extern unsigned long totalIgnicaoOffTime;
-extern unsigned long lastIgnicaoChangeTime;
+// Intervalo de verificação em ms (mantido por compatibilidade)
+#define IGNICAO_CHECK_INTERVAL_MS IGNICAO_CHECK_INTERVAL
 
 // ============================================================================
 // FUNÇÕES PÚBLICAS
@@ -72,6 +40,8 @@ extern unsigned long lastIgnicaoChangeTime;
 
 /**
  * Inicializa o sistema de controle de ignição.
+ * Inicializa o IgnicaoService (se necessario) e registra
+ * onIgnicaoStatusChange() como callback do servico.
  * 
  * @param debounceOn  Tempo em segundos para confirmar ignição ON (default: 2.0)
  * @param debounceOff Tempo em segundos para confirmar ignição OFF (default: 3.0)
@@ -105,15 +75,7 @@ void setDebounceTime(float debounceOn, float debounceOff);
 void getDebounceTime(float* debounceOn, float* debounceOff);
 
 /**
- * Task de monitoramento da ignição (executada em loop).
- * Não deve ser chamada diretamente - use initIgnicaoControl().
- * 
- * @param parameter Parâmetro da task (não utilizado)
- */
-void ignicaoMonitorTask(void* parameter);
-
-/**
- * Para a task de monitoramento da ignição.
+ * Para a task de monitoramento da ignição (IgnicaoService::stop).
  */
 void stopIgnicaoMonitor();
 
@@ -0,0 +1,115 @@
+/**
+ * ============================================================================
+ * INTERFACE DE BATERIA
+ * ============================================================================
+ *
+ * Abstrai a leitura da tensao da bateria (ADC em BAT_ADC_PIN).
+ *
+ * ============================================================================
+ */
+
+#ifndef I_BATTERY_H
+#define I_BATTERY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+/**
+ * Callback para mudanca do estado de bateria fraca
+ */
+typedef void (*BatteryCallback)(bool low, uint16_t voltageMv);
+
+/**
+ * Leitura publicada (copia consistente, sem lock)
+ */
+struct BatteryReading {
+    uint16_t voltageMv;     // Tensao filtrada da bateria (mV)
+    bool low;               // Bateria abaixo do limiar (com histerese)
+    bool valid;             // Ja existe ao menos uma leitura
+};
+
+/**
+ * Estatisticas do servico de bateria
+ */
+struct BatteryStats {
+    uint32_t frames;        // Quadros DMA processados
+    uint32_t samples;       // Amostras validas processadas
+    uint32_t errors;        // Falhas de leitura/timeout
+    uint32_t filterAvgUs;   // Custo medio de CPU por quadro (us)
+    uint32_t filterMaxUs;   // Custo maximo de CPU por quadro (us)
+    uint16_t lastRawMv;     // Ultima tensao no pino, antes do IIR (mV)
+};
+
+/**
+ * Interface abstrata para monitoramento de bateria
+ */
+class IBatteryService {
+public:
+    virtual ~IBatteryService() = default;
+
+    /**
+     * Inicializa o ADC continuo e a calibracao
+     * @return true se inicializado com sucesso
+     */
+    virtual bool init() = 0;
+
+    /**
+     * Obtem a ultima leitura publicada (lock-free, seguro em qualquer contexto)
+     */
+    virtual BatteryReading getReading() const = 0;
+
+    /**
+     * Obtem a tensao filtrada da bateria
+     * @return Tensao em mV (0 se ainda nao houver leitura)
+     */
+    virtual uint16_t getVoltageMv() const = 0;
+
+    /**
+     * Verifica se a bateria esta fraca
+     */
+    virtual bool isLow() const = 0;
+
+    /**
+     * Registra callback para mudanca de bateria fraca
+     * Chamado a partir da task de amostragem.
+     */
+    virtual void setCallback(BatteryCallback callback) = 0;
+
+    /**
+     * Obtem estatisticas de amostragem e custo de CPU
+     */
+    virtual BatteryStats getStats() const = 0;
+
+    /**
+     * Inicia a amostragem
+     */
+    virtual void start() = 0;
+
+    /**
+     * Para a amostragem
+     */
+    virtual void stop() = 0;
+
+    /**
+     * Verifica se esta amostrando
+     */
+    virtual bool isRunning() const = 0;
+};
+
+extern "C" {
+#endif
+
+// Interface C para compatibilidade
+bool battery_init(void);
+uint16_t battery_get_voltage_mv(void);
+bool battery_is_low(void);
+void battery_start(void);
+void battery_stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // I_BATTERY_H
@@ -30,6 +30,15 @@ enum class ScreenType : uint8_t {
     MAX_SCREENS
 };
 
+/**
+ * Politica de retencao ao sair da tela
+ */
+enum class ScreenRetention : uint8_t {
+    KEEP_ALIVE = 0,     // Permanece criada e com timers ativos
+    SUSPEND,            // Permanece criada, timers pausados (suspend/resume)
+    DESTROY             // Destruida ao sair; recriada na proxima visita
+};
+
 /**
  * Interface abstrata para uma tela
  */
@@ -86,6 +95,22 @@ public:
      * (ex: lv_scr_load_anim com auto_del=true).
      */
     virtual void invalidate() = 0;
+
+    /**
+     * Politica aplicada pelo gerenciador quando a tela perde o foco
+     * @return Politica de retencao (padrao: DESTROY)
+     */
+    virtual ScreenRetention getRetention() const { return ScreenRetention::DESTROY; }
+
+    /**
+     * Pausa timers da tela (politica SUSPEND, chamado apos onExit)
+     */
+    virtual void suspend() {}
+
+    /**
+     * Retoma timers da tela (politica SUSPEND, chamado antes de onEnter)
+     */
+    virtual void resume() {}
 };
 
 /**
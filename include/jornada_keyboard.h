@@ -58,8 +58,14 @@ private:
     // Botões da jornada - cada um com seus próprios motoristas
     std::array<BotaoJornada, ACAO_MAX> botoes;
     
-    // Popup de seleção de motorista
+    // Popup de seleção de motorista (criado uma vez, depois so escondido)
     lv_obj_t* popupMotorista;
+    lv_obj_t* popupTitulo;
+    lv_obj_t* popupBotoes[3];
+    lv_obj_t* popupLabels[3];
+    bool popupLogado[3];                // Estado refletido na cor de cada botao
+    char popupTituloTexto[50];
+    char popupLabelTexto[3][32];
     TipoAcao acaoPendente;
     
     // Singleton
@@ -72,6 +78,7 @@ private:
     
     // Métodos internos
     void showMotoristaSelection(TipoAcao acao);
+    bool criarPopupMotorista();
     void processarAcao(int motorista, TipoAcao acao);
     void atualizarIndicadores(TipoAcao acao);
     void atualizarTodosIndicadores();
@@ -112,70 +119,29 @@ public:
     EstadoMotorista getEstadoMotorista(TipoAcao acao, int motorista);
 };
 
-// ============================================================================
-// CLASSE SCREEN MANAGER - GERENCIADOR DE TELAS
-// ============================================================================
-
-class ScreenManager {
-private:
-    enum TelaAtiva {
-        TELA_NUMPAD = 0,
-        TELA_JORNADA = 1
-    };
-    
-    TelaAtiva telaAtual;
-    lv_obj_t* container;
-    
-    // Instâncias das telas
-    void* numpadInstance;  // NumpadExample*
-    JornadaKeyboard* jornadaInstance;
-    
-    // Botão de troca de tela
-    lv_obj_t* btnScreenSwitch;
-    
-    // Singleton
-    static ScreenManager* instance;
-    
-    // Callbacks
-    static void onScreenSwitchClick(lv_event_t* e);
-    
-    // Criar botão de troca de tela
-    void createScreenSwitchButton();
-    
-public:
-    ScreenManager();
-    ~ScreenManager();
-    
-    static ScreenManager* getInstance();
-    
-    void init();
-    void showNumpadScreen();
-    void showJornadaScreen();
-    void toggleScreen();
-    
-    TelaAtiva getTelaAtual() const { return telaAtual; }
-};
-
 // ============================================================================
 // FUNÇÕES HELPER (extern C para acesso de main.cpp)
 // ============================================================================
+// Shims legados sobre o ScreenManagerImpl (ui/screen_manager.h).
+// O antigo ScreenManager deste arquivo foi removido: ha um unico
+// gerenciador de telas no sistema.
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * Inicializa o gerenciador de telas
+ * Inicializa o gerenciador de telas (ScreenManagerImpl::init)
  */
 void initScreenManager();
 
 /**
- * Mostra tela do teclado numérico
+ * Mostra tela do teclado numérico (cycleTo NUMPAD)
  */
 void showNumpadKeyboard();
 
 /**
- * Mostra tela do teclado de jornada
+ * Mostra tela do teclado de jornada (cycleTo JORNADA)
  */
 void showJornadaKeyboard();
 
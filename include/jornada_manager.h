@@ -1,12 +1,16 @@
 /**
  * ============================================================================
- * GERENCIADOR DE JORNADA - HEADER
+ * GERENCIADOR DE JORNADA - HEADER (API LEGADA)
  * ============================================================================
  * 
  * Sistema de controle de jornada para até 3 motoristas simultâneos.
  * Gerencia estados de: jornada (direção), manobra, refeição, espera, 
  * descarga e abastecimento.
  * 
+ * Shim de compatibilidade sobre o JornadaService: os dados e o mutex
+ * vivem apenas no servico. Codigo novo deve usar JornadaService
+ * (services/jornada/jornada_service.h).
+ * 
  * ============================================================================
  */
 
@@ -16,38 +20,24 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
+#include "config/app_config.h"
+#include "interfaces/i_jornada.h"
 
 // ============================================================================
 // DEFINIÇÕES
 // ============================================================================
 
-#define MAX_MOTORISTAS 3
-
-// Estados possíveis de cada motorista
-enum EstadoJornada {
-    ESTADO_INATIVO = 0,
-    ESTADO_JORNADA,      // Direção
-    ESTADO_MANOBRA,
-    ESTADO_REFEICAO,
-    ESTADO_ESPERA,
-    ESTADO_DESCARGA,
-    ESTADO_ABASTECIMENTO
-};
-
-// Estrutura de dados de um motorista
-struct Motorista {
-    int id;                           // ID do motorista (1, 2 ou 3)
-    char nome[32];                    // Nome do motorista
-    EstadoJornada estadoAtual;        // Estado atual
-    unsigned long tempoInicio;        // Timestamp do início do estado atual
-    unsigned long tempoTotalJornada;  // Tempo total em jornada (direção)
-    unsigned long tempoTotalManobra;  // Tempo total em manobra
-    unsigned long tempoTotalRefeicao; // Tempo total em refeição
-    unsigned long tempoTotalEspera;   // Tempo total em espera
-    unsigned long tempoTotalDescarga; // Tempo total em descarga
-    unsigned long tempoTotalAbastecimento; // Tempo total em abastecimento
-    bool ativo;                       // Se o motorista está ativo no sistema
-};
+// Nomes legados dos estados, mapeados no enum do servico
+constexpr EstadoJornada ESTADO_INATIVO       = EstadoJornada::INATIVO;
+constexpr EstadoJornada ESTADO_JORNADA       = EstadoJornada::JORNADA;     // Direção
+constexpr EstadoJornada ESTADO_MANOBRA       = EstadoJornada::MANOBRA;
+constexpr EstadoJornada ESTADO_REFEICAO      = EstadoJornada::REFEICAO;
+constexpr EstadoJornada ESTADO_ESPERA        = EstadoJornada::ESPERA;
+constexpr EstadoJornada ESTADO_DESCARGA      = EstadoJornada::DESCARGA;
+constexpr EstadoJornada ESTADO_ABASTECIMENTO = EstadoJornada::ABASTECIMENTO;
+
+// Estrutura de dados de um motorista (mesmo layout do servico)
+typedef DadosMotorista Motorista;
 
 // ============================================================================
 // FUNÇÕES PÚBLICAS
@@ -74,6 +64,8 @@ void removeMotorista(int id);
 
 /**
  * Obtém ponteiro para os dados de um motorista
+ * O ponteiro aponta para uma copia tirada sob o mutex do servico;
+ * nao reflete alteracoes posteriores ate a proxima chamada.
  * @param id ID do motorista
  * @return Ponteiro para struct Motorista ou NULL se não encontrado
  */
@@ -60,10 +60,15 @@
     #endif
 
 #else       /*LV_MEM_CUSTOM*/
-    #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
-    #define LV_MEM_CUSTOM_ALLOC   malloc
-    #define LV_MEM_CUSTOM_FREE    free
-    #define LV_MEM_CUSTOM_REALLOC realloc
+    /*LVGL heap of the application (src/lvgl_mem.c): small blocks come from a TLSF pool in
+     *internal RAM, large ones (and the pool's overflow) from PSRAM*/
+    #define LV_MEM_CUSTOM_INCLUDE "lvgl_mem.h"   /*Header for the dynamic memory function*/
+    #define LV_MEM_CUSTOM_ALLOC   lvgl_mem_alloc
+    #define LV_MEM_CUSTOM_FREE    lvgl_mem_free
+    #define LV_MEM_CUSTOM_REALLOC lvgl_mem_realloc
+
+    /*Size of that pool; also builds lv_tlsf for it*/
+    #define LV_MEM_TLSF_POOL_SIZE (48U * 1024U)          /*[bytes]*/
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
@@ -85,7 +90,7 @@
 
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
-#define LV_TICK_CUSTOM 0
+#define LV_TICK_CUSTOM 1
 #if LV_TICK_CUSTOM
     //#define LV_TICK_CUSTOM_INCLUDE "Arduino.h"         /*Header for the system time function*/
     //#define LV_TICK_CUSTOM_SYS_TIME_EXPR (millis())    /*Expression evaluating to current system time in ms*/
@@ -144,7 +149,16 @@
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
  *However the opened images might consume additional RAM.
  *0: to disable caching*/
-#define LV_IMG_CACHE_DEF_SIZE 16
+#define LV_IMG_CACHE_DEF_SIZE 20
+
+/*Maximum bytes held by the images open in the cache (decoded frames and decoder working memory).
+ *The least used images are closed until the total fits. 0: limit only by LV_IMG_CACHE_DEF_SIZE*/
+#define LV_IMG_CACHE_BUDGET (1024 * 1024)
+
+/*Allocator for decoded frames kept open by the cache (lv_img_cache_data_alloc): external RAM*/
+#define LV_IMG_CACHE_DATA_INCLUDE "esp_heap_caps.h"
+#define LV_IMG_CACHE_DATA_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define LV_IMG_CACHE_DATA_FREE(p)     heap_caps_free(p)
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -351,6 +365,18 @@
 /*Place performance critical functions into a faster memory (e.g RAM)*/
 #define LV_ATTRIBUTE_FAST_MEM
 
+/*Only the RGB565 blend kernels (fill_normal, map_normal, rgb565_mix_pair in lv_draw_sw_blend.c)
+ *run from IRAM on the ESP32-S3, so the per-pixel loops don't compete with flash reads through
+ *the shared cache while the panel is being refreshed. LV_ATTRIBUTE_FAST_MEM stays empty: it
+ *marks ~120 LVGL functions and would cost tens of kB of IRAM*/
+#define LV_ATTRIBUTE_BLEND_IRAM_USE 1
+#if LV_ATTRIBUTE_BLEND_IRAM_USE && defined(ESP_PLATFORM)
+#include "esp_attr.h"
+#define LV_ATTRIBUTE_BLEND_IRAM IRAM_ATTR
+#else
+#define LV_ATTRIBUTE_BLEND_IRAM
+#endif
+
 /*Prefix variables that are used in GPU accelerated operations, often these need to be placed in RAM sections that are DMA accessible*/
 #define LV_ATTRIBUTE_DMA
 
@@ -365,26 +391,32 @@
  *   FONT USAGE
  *===================*/
 
+/*Replace the built-in Montserrat fonts with a pack generated at build time by
+ *tools/fonts/font_subset.py: only the sizes referenced by the UI sources, printable
+ *ASCII plus the LV_SYMBOL_* glyphs actually used, same `lv_font_montserrat_N` names.
+ *The sizes below stay as the list of allowed sizes (used when the pack is off).*/
+#define LV_FONT_PACK 1
+
 /*Montserrat fonts with ASCII range and some symbols using bpp = 4
  *https://fonts.google.com/specimen/Montserrat*/
 #define LV_FONT_MONTSERRAT_8  0
-#define LV_FONT_MONTSERRAT_10 1
-#define LV_FONT_MONTSERRAT_12 1
-#define LV_FONT_MONTSERRAT_14 1
-#define LV_FONT_MONTSERRAT_16 1
-#define LV_FONT_MONTSERRAT_18 1
-#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_10 (!LV_FONT_PACK)
+#define LV_FONT_MONTSERRAT_12 (!LV_FONT_PACK)
+#define LV_FONT_MONTSERRAT_14 (!LV_FONT_PACK)
+#define LV_FONT_MONTSERRAT_16 (!LV_FONT_PACK)
+#define LV_FONT_MONTSERRAT_18 (!LV_FONT_PACK)
+#define LV_FONT_MONTSERRAT_20 (!LV_FONT_PACK)
 #define LV_FONT_MONTSERRAT_22 0
-#define LV_FONT_MONTSERRAT_24 1
+#define LV_FONT_MONTSERRAT_24 (!LV_FONT_PACK)
 #define LV_FONT_MONTSERRAT_26 0
-#define LV_FONT_MONTSERRAT_28 1
+#define LV_FONT_MONTSERRAT_28 (!LV_FONT_PACK)
 #define LV_FONT_MONTSERRAT_30 0
 #define LV_FONT_MONTSERRAT_32 0
 #define LV_FONT_MONTSERRAT_34 0
 #define LV_FONT_MONTSERRAT_36 0
-#define LV_FONT_MONTSERRAT_38 1
+#define LV_FONT_MONTSERRAT_38 (!LV_FONT_PACK)
 #define LV_FONT_MONTSERRAT_40 0
-#define LV_FONT_MONTSERRAT_42 1
+#define LV_FONT_MONTSERRAT_42 (!LV_FONT_PACK)
 #define LV_FONT_MONTSERRAT_44 0
 #define LV_FONT_MONTSERRAT_46 0
 #define LV_FONT_MONTSERRAT_48 0
@@ -402,7 +434,21 @@
 /*Optionally declare custom fonts here.
  *You can use these fonts as default font too and they will be available globally.
  *E.g. #define LV_FONT_CUSTOM_DECLARE   LV_FONT_DECLARE(my_font_1) LV_FONT_DECLARE(my_font_2)*/
+#if LV_FONT_PACK
+#define LV_FONT_CUSTOM_DECLARE  LV_FONT_DECLARE(lv_font_montserrat_8)  LV_FONT_DECLARE(lv_font_montserrat_10) \
+                                LV_FONT_DECLARE(lv_font_montserrat_12) LV_FONT_DECLARE(lv_font_montserrat_14) \
+                                LV_FONT_DECLARE(lv_font_montserrat_16) LV_FONT_DECLARE(lv_font_montserrat_18) \
+                                LV_FONT_DECLARE(lv_font_montserrat_20) LV_FONT_DECLARE(lv_font_montserrat_22) \
+                                LV_FONT_DECLARE(lv_font_montserrat_24) LV_FONT_DECLARE(lv_font_montserrat_26) \
+                                LV_FONT_DECLARE(lv_font_montserrat_28) LV_FONT_DECLARE(lv_font_montserrat_30) \
+                                LV_FONT_DECLARE(lv_font_montserrat_32) LV_FONT_DECLARE(lv_font_montserrat_34) \
+                                LV_FONT_DECLARE(lv_font_montserrat_36) LV_FONT_DECLARE(lv_font_montserrat_38) \
+                                LV_FONT_DECLARE(lv_font_montserrat_40) LV_FONT_DECLARE(lv_font_montserrat_42) \
+                                LV_FONT_DECLARE(lv_font_montserrat_44) LV_FONT_DECLARE(lv_font_montserrat_46) \
+                                LV_FONT_DECLARE(lv_font_montserrat_48)
+#else
 #define LV_FONT_CUSTOM_DECLARE
+#endif
 
 /*Always set a default font*/
 #define LV_FONT_DEFAULT &lv_font_montserrat_14
@@ -700,7 +746,7 @@
  *----------*/
 
 /*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
@@ -11,6 +11,8 @@
 #include "driver/gpio.h"
 #include "esp_err.h"
 #include "esp_lcd_types.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "lvgl.h"
 
 #if __has_include ("esp_lcd_touch.h")
@@ -22,8 +24,29 @@
 extern "C" {
 #endif
 
+#ifndef LVGL_PORT_CMD_QUEUE_LEN
+#define LVGL_PORT_CMD_QUEUE_LEN     16      /*!< Commands waiting for the LVGL task */
+#endif
+
+#ifndef LVGL_PORT_STATS_PERIOD_MS
+#define LVGL_PORT_STATS_PERIOD_MS   10000   /*!< LVGL task load report period */
+#endif
+
+#ifndef LVGL_PORT_TOUCH_IDLE_MS
+#define LVGL_PORT_TOUCH_IDLE_MS     3000    /*!< Inactivity before touch polling slows down */
+#endif
+
+#ifndef LVGL_PORT_TOUCH_IDLE_READ_MS
+#define LVGL_PORT_TOUCH_IDLE_READ_MS 100    /*!< Touch read period while idle (lets the chip sleep) */
+#endif
+
 typedef bool (*lvgl_port_wait_cb)(void *handle);
 
+/**
+ * @brief Command executed by the LVGL task (with the LVGL mutex taken)
+ */
+typedef void (*lvgl_port_cmd_cb)(void *arg);
+
 /**
  * @brief Init configuration structure
  */
@@ -63,6 +86,43 @@ typedef struct {
 } lvgl_port_touch_cfg_t;
 #endif
 
+/**
+ * @brief Render time statistics (filled by the display monitor callback)
+ */
+typedef struct {
+    uint32_t frames;        /*!< Frames rendered since boot */
+    uint32_t last_ms;       /*!< Render + flush time of the last frame */
+    uint32_t last_px;       /*!< Pixels refreshed in the last frame */
+    uint32_t avg_ms_x8;     /*!< Moving average render time, in 1/8 ms */
+    uint32_t max_ms;        /*!< Worst render time seen */
+    uint32_t total_ms;      /*!< Accumulated render time (wraps), for load over an interval */
+} lvgl_port_render_stats_t;
+
+/**
+ * @brief LVGL task load statistics (updated every LVGL_PORT_STATS_PERIOD_MS)
+ */
+typedef struct {
+    uint32_t wakeups_per_s;     /*!< Task wakeups per second in the last period */
+    uint32_t cpu_pct_x10;       /*!< Time running LVGL in the last period, in 0.1 % */
+    uint32_t cmds;              /*!< Commands executed since boot */
+    uint32_t cmds_dropped;      /*!< Commands rejected because the queue was full */
+} lvgl_port_task_stats_t;
+
+/**
+ * @brief Touch latency statistics (start of a press -> first flush of its redraw)
+ *
+ * The start is the touch IRQ when the controller's INT line is wired. Without
+ * it (the controller is polled) the start is the indev read that saw the
+ * press, so the time spent waiting for that read is not included.
+ */
+typedef struct {
+    uint32_t presses;       /*!< Presses measured since boot */
+    uint32_t last_read_us;  /*!< Start -> end of the indev read of the last press */
+    uint32_t last_us;       /*!< Start -> first flushed pixel of the last press */
+    uint32_t avg_us;        /*!< Moving average start -> first flush (1/8 weight) */
+    uint32_t max_us;        /*!< Worst start -> first flush seen */
+} lvgl_port_input_stats_t;
+
 /**
  * @brief LVGL port configuration structure
  *
@@ -140,8 +200,73 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg);
  *      - ESP_OK                    on success
  */
 esp_err_t lvgl_port_remove_touch(lv_indev_t *touch);
+
+/**
+ * @brief Wake the LVGL task from the touch interrupt
+ *
+ * @note Call from the touch ISR. The LVGL task reads the input device and
+ * refreshes the display right away, instead of waiting for the indev read
+ * timer and the display refresh period. The IRQ time is kept for the
+ * latency probe (see lvgl_port_get_input_stats()). Only used when the touch
+ * INT line is wired; polled controllers get the prompt refresh from the
+ * press edge in the indev read.
+ *
+ * @return true if a higher priority task was woken (caller should yield)
+ */
+bool lvgl_port_touch_wake_from_isr(void);
+
+/**
+ * @brief Get touch-to-display latency statistics
+ *
+ * @param[out] stats Copy of the current statistics
+ */
+void lvgl_port_get_input_stats(lvgl_port_input_stats_t *stats);
 #endif
 
+/**
+ * @brief Get render time statistics of the display
+ *
+ * @param[out] stats Copy of the current statistics
+ */
+void lvgl_port_get_render_stats(lvgl_port_render_stats_t *stats);
+
+/**
+ * @brief Get LVGL task load statistics
+ *
+ * @param[out] stats Copy of the last completed period
+ */
+void lvgl_port_get_task_stats(lvgl_port_task_stats_t *stats);
+
+/**
+ * @brief Run a function on the LVGL task
+ *
+ * @note Preferred way for other tasks to change the UI: no LVGL mutex is
+ * taken by the caller and nothing is allocated (the command is copied into
+ * a fixed queue of LVGL_PORT_CMD_QUEUE_LEN entries). Commands run in
+ * posting order, before the LVGL timers, with the LVGL mutex taken.
+ *
+ * @param cb  Function to run
+ * @param arg Argument passed to cb (must stay valid until it runs)
+ *
+ * @return
+ *      - true:  Command queued
+ *      - false: Queue full (command dropped)
+ */
+bool lvgl_port_post(lvgl_port_cmd_cb cb, void *arg);
+
+/**
+ * @brief Set a function called by the LVGL task on every wakeup
+ *
+ * @note Runs with the LVGL mutex taken, before the LVGL timers. Used to
+ * drain event queues whose producers wake the task (lvgl_port_get_task()).
+ */
+void lvgl_port_set_pump_cb(lvgl_port_cmd_cb cb, void *arg);
+
+/**
+ * @brief Get the LVGL task handle (for task notifications)
+ */
+TaskHandle_t lvgl_port_get_task(void);
+
 /**
  * @brief Take LVGL mutex
  *
@@ -2,6 +2,40 @@
 #define LVGL_FS_DRIVER_H
 
 #include <lvgl.h>
+#include <stdint.h>
+#include "config/app_config.h"
+
+#ifndef FS_BASE_PATH
+#define FS_BASE_PATH            "/littlefs"
+#endif
+
+#ifndef FS_DRV_HANDLE_CACHE
+#define FS_DRV_HANDLE_CACHE     3
+#endif
+
+#ifndef FS_DRV_READAHEAD
+#define FS_DRV_READAHEAD        4096
+#endif
+
+#ifndef FS_DRV_PATH_MAX
+#define FS_DRV_PATH_MAX         64
+#endif
+
+/**
+ * @brief Contadores do driver (acumulados desde lvgl_fs_init()).
+ *
+ * "Syscalls" são as chamadas que descem para VFS/LittleFS.
+ */
+typedef struct {
+    uint32_t opens;             // open() no VFS
+    uint32_t closes;            // close() no VFS
+    uint32_t reads;             // read() no VFS
+    uint32_t writes;            // write() no VFS
+    uint32_t seeks;             // lseek() no VFS
+    uint32_t stats;             // fstat() no VFS
+    uint32_t handleHits;        // Aberturas atendidas por handle em cache
+    uint32_t bufferHits;        // Leituras atendidas pelo bloco de read-ahead
+} lvgl_fs_stats_t;
 
 /**
  * @brief Inicializa e registra o driver do LittleFS para a LVGL.
@@ -11,4 +45,17 @@
  */
 void lvgl_fs_init(char drive_letter);
 
-#endif // LVGL_FS_DRIVER_H
\ No newline at end of file
+/**
+ * @brief Fecha os handles ociosos do cache.
+ *
+ * Chamar (na task da LVGL) antes de alterar arquivos por fora da LVGL
+ * ou desmontar o LittleFS.
+ */
+void lvgl_fs_flush_cache(void);
+
+/**
+ * @brief Copia os contadores do driver.
+ */
+void lvgl_fs_get_stats(lvgl_fs_stats_t *stats);
+
+#endif // LVGL_FS_DRIVER_H
@@ -0,0 +1,86 @@
+/**
+ * ============================================================================
+ * HEAP DA LVGL - HEADER
+ * ============================================================================
+ *
+ * Alocador usado pela LVGL (LV_MEM_CUSTOM_ALLOC/FREE/REALLOC em lv_conf.h).
+ * Blocos pequenos (objetos, estilos, textos, buffers de mascara) vem de um
+ * pool TLSF proprio na RAM interna, separado do heap do sistema onde ficam
+ * audio e servicos; blocos grandes (camadas, imagens decodificadas) e o
+ * que nao couber no pool vao para a PSRAM.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef LVGL_MEM_H
+#define LVGL_MEM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config/app_config.h"
+
+#ifndef LVGL_MEM_SMALL_MAX
+#define LVGL_MEM_SMALL_MAX      2048
+#endif
+
+#ifndef LVGL_MEM_REPORT_PERIOD_MS
+#define LVGL_MEM_REPORT_PERIOD_MS 60000
+#endif
+
+#ifndef LVGL_MEM_TRACE
+#define LVGL_MEM_TRACE          0
+#endif
+
+#ifndef LVGL_MEM_TRACE_EVENTS
+#define LVGL_MEM_TRACE_EVENTS   8192
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Contadores do heap (bytes em tamanho de bloco, com o overhead).
+ */
+typedef struct {
+    uint32_t poolSize;          // Bytes do pool na RAM interna (0: sem pool)
+    uint32_t poolUsed;          // Em uso no pool agora
+    uint32_t poolPeak;          // Maior poolUsed desde o boot
+    uint32_t poolFreeBiggest;   // Maior bloco livre do pool
+    uint8_t poolFragPct;        // 100 - maior livre / total livre
+    uint32_t poolBlocks;        // Blocos em uso no pool
+    uint32_t psramUsed;         // Blocos da LVGL fora do pool agora
+    uint32_t psramPeak;         // Maior psramUsed desde o boot
+    uint32_t poolAllocs;        // Alocacoes atendidas pelo pool
+    uint32_t largeAllocs;       // Maiores que LVGL_MEM_SMALL_MAX (direto na PSRAM)
+    uint32_t overflowAllocs;    // Pequenas que nao couberam no pool
+    uint32_t failedAllocs;      // Sem memoria em nenhum dos dois
+} lvgl_mem_stats_t;
+
+void *lvgl_mem_alloc(size_t size);
+void lvgl_mem_free(void *ptr);
+void *lvgl_mem_realloc(void *ptr, size_t size);
+
+/**
+ * @brief Copia os contadores, percorrendo o pool para maior bloco livre e
+ * fragmentacao. Chamar na task da LVGL.
+ */
+void lvgl_mem_get_stats(lvgl_mem_stats_t *stats);
+
+/**
+ * @brief Imprime o trace de alocacoes capturado (LVGL_MEM_TRACE 1) e
+ * recomeca a captura. Chamar na task da LVGL.
+ *
+ * Uma linha por operacao (enderecos em hex, pedidos em bytes):
+ * "LVMEM a <ptr> <bytes>", "LVMEM f <ptr>", "LVMEM r <ptr> <novo ptr> <bytes>".
+ */
+void lvgl_mem_trace_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LVGL_MEM_H
@@ -13,7 +13,11 @@
 #define NUMPAD_EXAMPLE_H
 
 #include "button_manager.h"
-#include <string>
+#include "utils/fixed_string.h"
+
+#ifndef NUMPAD_MAX_DIGITS
+    #define NUMPAD_MAX_DIGITS 16
+#endif
 
 // Forward declaration
 class StatusBar;
@@ -26,7 +30,7 @@ class NumpadExample {
 private:
     ButtonManager* btnManager;
     StatusBar* statusBar_;
-    std::string currentNumber;
+    FixedString<NUMPAD_MAX_DIGITS + 1> currentNumber;
     int maxDigits;
     
     // IDs dos botões
@@ -79,13 +83,15 @@ public:
     void addDigit(int digit);
     void removeLastDigit();
     void clearNumber();
-    std::string getNumber() const { return currentNumber; }
+    const char* getNumber() const { return currentNumber.c_str(); }
 
     // Atualização do display
     void updateDisplay();
 
     // Configurações
-    void setMaxDigits(int max) { maxDigits = max; }
+    void setMaxDigits(int max) {
+        maxDigits = (max > NUMPAD_MAX_DIGITS) ? NUMPAD_MAX_DIGITS : max;
+    }
 
     void resetToInitialMessage();
 };
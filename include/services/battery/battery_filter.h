@@ -0,0 +1,81 @@
+/**
+ * ============================================================================
+ * FILTRO DE BATERIA - HEADER
+ * ============================================================================
+ *
+ * Filtro em ponto fixo para as amostras do ADC da bateria:
+ * mediana por quadro DMA (rejeita picos) seguida de IIR de primeira ordem.
+ *
+ * Nao depende do ESP-IDF: pode ser compilado no host para validar o
+ * filtro com formas de onda gravadas.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef BATTERY_FILTER_H
+#define BATTERY_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BATTERY_FILTER_FRAC_BITS    4   // Bits fracionarios do estado do IIR
+
+/**
+ * Estado do filtro IIR (y += (x - y) / 2^shift)
+ */
+typedef struct {
+    int32_t state;      // Estado em Q(BATTERY_FILTER_FRAC_BITS)
+    uint8_t shift;      // alpha = 1/2^shift
+    bool primed;        // Primeira amostra ja carregada
+} battery_filter_t;
+
+/**
+ * Inicializa o filtro
+ * @param f Estado do filtro
+ * @param shift alpha = 1/2^shift (0 = sem filtragem)
+ */
+void battery_filter_init(battery_filter_t* f, uint8_t shift);
+
+/**
+ * Calcula a mediana de um quadro de amostras (ordena o buffer in-place)
+ * @param samples Amostras brutas
+ * @param count Numero de amostras
+ * @return Mediana (0 se count == 0)
+ */
+uint16_t battery_filter_median(uint16_t* samples, size_t count);
+
+/**
+ * Aplica o IIR a uma nova amostra
+ * @param f Estado do filtro
+ * @param value Nova amostra (mV)
+ * @return Valor filtrado (mV, arredondado)
+ */
+uint16_t battery_filter_update(battery_filter_t* f, uint16_t value);
+
+/**
+ * Obtem o valor filtrado atual sem atualizar
+ */
+uint16_t battery_filter_value(const battery_filter_t* f);
+
+/**
+ * Estado de bateria fraca com histerese: entra abaixo de lowMv e so sai
+ * acima de lowMv + hystMv
+ * @param low Estado atual
+ * @param mv Tensao filtrada (mV)
+ * @return Novo estado
+ */
+bool battery_filter_low(bool low, uint16_t mv, uint16_t lowMv, uint16_t hystMv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BATTERY_FILTER_H
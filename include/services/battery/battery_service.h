@@ -0,0 +1,98 @@
+/**
+ * ============================================================================
+ * SERVICO DE BATERIA - HEADER
+ * ============================================================================
+ *
+ * Amostragem da tensao da bateria via ADC continuo (DMA) em rajadas curtas,
+ * com filtro mediana + IIR e publicacao lock-free da leitura.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef BATTERY_SERVICE_H
+#define BATTERY_SERVICE_H
+
+#include "interfaces/i_battery.h"
+#include "services/battery/battery_filter.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali.h"
+
+#ifdef __cplusplus
+
+#include <atomic>
+
+/**
+ * Implementacao do servico de bateria
+ */
+class BatteryService : public IBatteryService {
+public:
+    // Singleton
+    static BatteryService* getInstance();
+    static void destroyInstance();
+
+    // IBatteryService interface
+    bool init() override;
+    BatteryReading getReading() const override;
+    uint16_t getVoltageMv() const override;
+    bool isLow() const override;
+    void setCallback(BatteryCallback callback) override;
+    BatteryStats getStats() const override;
+    void start() override;
+    void stop() override;
+    bool isRunning() const override;
+
+private:
+    BatteryService();
+    ~BatteryService();
+
+    // Nao permitir copia
+    BatteryService(const BatteryService&) = delete;
+    BatteryService& operator=(const BatteryService&) = delete;
+
+    // Task de amostragem
+    static void samplingTask(void* arg);
+    static bool onConvDone(adc_continuous_handle_t handle,
+                           const adc_continuous_evt_data_t* edata,
+                           void* userData);
+    void sampleBurst();
+    void processFrame(const uint8_t* data, uint32_t length);
+    uint16_t rawToMv(uint16_t raw) const;
+    void publish(uint16_t voltageMv, bool low);
+
+    // Singleton
+    static BatteryService* instance;
+
+    // Driver ADC
+    adc_continuous_handle_t adcHandle;
+    adc_cali_handle_t caliHandle;
+    adc_unit_t adcUnit;
+    adc_channel_t adcChannel;
+
+    // Leitura publicada: bits 0-15 = mV, bit 16 = low, bit 17 = valid
+    std::atomic<uint32_t> published;
+
+    // Estado do filtro (acessado apenas pela task)
+    battery_filter_t filter;
+    bool lowState;
+
+    // Task
+    SemaphoreHandle_t exitSem;      // Task avisa que saiu do loop (stop apaga)
+    TaskHandle_t taskHandle;
+    BatteryCallback callback;
+    bool initialized;
+    std::atomic<bool> running;
+
+    // Estatisticas (escritas pela task, lidas sem lock)
+    BatteryStats stats;
+    uint64_t filterTotalUs;
+};
+
+#endif // __cplusplus
+
+#endif // BATTERY_SERVICE_H
@@ -15,6 +15,7 @@
 #define IGNICAO_SERVICE_H
 
 #include "interfaces/i_ignicao.h"
+#include "services/power/power_service.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
@@ -53,6 +54,8 @@ private:
 
     // Task de monitoramento
     static void monitorTask(void* arg);
+    static void pinIsr(void* arg);
+    void armPinWakeup();
     void processDebounce();
 
     // Singleton
@@ -65,6 +68,7 @@ private:
 
     // Sincronizacao
     SemaphoreHandle_t mutex;
+    SemaphoreHandle_t exitSem;      // Task avisa que saiu do loop (stop apaga)
     TaskHandle_t taskHandle;
 
     // Callback
@@ -80,6 +84,9 @@ private:
     bool targetState;
     uint32_t debounceStartTime;
 
+    // Sem light sleep enquanto o debounce amostra o pino
+    PowerLock debounceLock;
+
     // Estatisticas
     IgnicaoStats stats;
 };
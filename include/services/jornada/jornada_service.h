@@ -16,6 +16,7 @@
 
 #include "config/app_config.h"
 #include "interfaces/i_jornada.h"
+#include "services/jornada/jornada_store.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 
@@ -44,6 +45,20 @@ public:
     uint32_t getTempoEstadoAtual(int id) const override;
     void setCallback(JornadaCallback callback) override;
 
+    // Persistencia dos totais
+    /**
+     * Grava os totais na NVS se o flush venceu (tempo ou numero de mudancas)
+     * Chamar periodicamente (loop principal).
+     */
+    bool flushIfDue();
+
+    /**
+     * Grava os totais na NVS imediatamente (ex.: ignicao desligada)
+     */
+    bool flush();
+
+    JornadaPersistStats getPersistStats() const;
+
 private:
     JornadaService();
     ~JornadaService();
@@ -55,6 +70,9 @@ private:
     // Metodos privados
     int findMotoristaIndex(int id) const;
     void atualizarTempoAcumulado(int idx);
+    void publishChange(int id, EstadoJornada estado);
+    void restoreFromStore();
+    bool flushLocked(bool force);
 
     // Singleton
     static JornadaService* instance;
@@ -62,6 +80,9 @@ private:
     // Dados
     DadosMotorista motoristas[MAX_MOTORISTAS];
 
+    // Espelho RTC + NVS dos totais
+    JornadaStore store;
+
     // Sincronizacao
     mutable SemaphoreHandle_t mutex;
 
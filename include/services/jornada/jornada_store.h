@@ -0,0 +1,132 @@
+/**
+ * ============================================================================
+ * PERSISTENCIA DE JORNADA - HEADER
+ * ============================================================================
+ *
+ * Totais por motorista com espelho em memoria RTC (sobrevive a reset a
+ * quente) e gravacao agregada na particao nvs_data. Cada mudanca atualiza
+ * apenas o espelho; a NVS so e escrita quando o flush vence por tempo ou
+ * por numero de mudancas, ou quando forcado (ignicao desligada).
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef JORNADA_STORE_H
+#define JORNADA_STORE_H
+
+#include "config/app_config.h"
+#include "interfaces/i_jornada.h"
+#include "nvs.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+// Estados com total acumulado (JORNADA..ABASTECIMENTO)
+#define JORNADA_NUM_TOTAIS  (NUM_ESTADOS_JORNADA - 1)
+
+/**
+ * Registro persistido de um motorista
+ */
+struct JornadaPersistSlot {
+    int16_t id;
+    uint8_t ativo;
+    uint8_t reservado;
+    char nome[MAX_NOME_MOTORISTA];
+    uint32_t totais[JORNADA_NUM_TOTAIS];    // ms, indice = estado - 1
+};
+
+/**
+ * Imagem completa (mesmo layout no RTC e no blob da NVS)
+ */
+struct JornadaPersistImage {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t generation;                    // Incrementado a cada flush
+    JornadaPersistSlot slots[MAX_MOTORISTAS];
+    uint32_t crc;                           // CRC32 dos campos anteriores
+};
+
+/**
+ * Origem dos dados restaurados no boot
+ */
+enum class JornadaRestoreSource : uint8_t {
+    NONE = 0,
+    RTC,        // Reset a quente: espelho RTC valido
+    NVS         // Boot a frio: ultimo flush
+};
+
+/**
+ * Estatisticas de persistencia
+ */
+struct JornadaPersistStats {
+    uint32_t changes;       // Mudancas aplicadas ao espelho
+    uint32_t flushes;       // Escritas na NVS
+    uint32_t errors;        // Falhas de escrita
+    uint32_t lastFlushMs;   // time_millis() do ultimo flush
+    JornadaRestoreSource restoredFrom;
+};
+
+/**
+ * Espelho RTC + NVS dos totais de jornada
+ * Nao e thread-safe: o JornadaService chama tudo com o seu mutex tomado.
+ */
+class JornadaStore {
+public:
+    JornadaStore();
+
+    /**
+     * Abre a NVS e restaura a imagem (RTC, senao NVS)
+     * @return true se havia dados validos
+     */
+    bool begin();
+
+    /**
+     * Imagem atual (para restaurar os motoristas)
+     */
+    const JornadaPersistImage& image() const { return *mirror; }
+
+    /**
+     * Copia os totais efetivos de um motorista para o espelho
+     * O tempo do estado em curso e somado ao total correspondente.
+     * @param countChange true se for uma mudanca de estado (conta no limiar)
+     */
+    void update(int idx, const DadosMotorista& m, uint32_t now, bool countChange);
+
+    /**
+     * Verifica se o flush venceu
+     * @param running Algum estado em curso (o total efetivo segue crescendo)
+     */
+    bool flushDue(uint32_t now, bool running) const;
+
+    /**
+     * Grava o espelho na NVS (se houver algo novo)
+     * @return true se gravou ou se nao havia nada a gravar
+     */
+    bool flush(uint32_t now);
+
+    bool isDirty() const { return dirty; }
+    JornadaPersistStats getStats() const { return stats; }
+
+private:
+    static bool isValid(const JornadaPersistImage& img);
+    static uint32_t computeCrc(const JornadaPersistImage& img);
+    static void format(JornadaPersistImage& img);
+
+    JornadaPersistImage* mirror;    // Aponta para o espelho em RTC
+    nvs_handle_t nvs;
+    bool nvsOpen;
+
+    bool dirty;
+    uint32_t dirtySince;
+    uint32_t pendingChanges;
+
+    JornadaPersistStats stats;
+};
+
+#endif // __cplusplus
+
+#endif // JORNADA_STORE_H
@@ -0,0 +1,127 @@
+/**
+ * ============================================================================
+ * SERVICO DE ENERGIA - HEADER
+ * ============================================================================
+ *
+ * Gerenciamento de energia com tickless idle + light sleep automatico do
+ * ESP-IDF. O chip dorme sempre que nenhuma trava esta ativa; cada modulo
+ * segura a sua (PowerLock) apenas enquanto renderiza, toca audio ou faz
+ * debounce. Wakeups vem dos timers do FreeRTOS e dos GPIOs armados
+ * (ignicao); um relatorio periodico mostra residencia e causas.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef POWER_SERVICE_H
+#define POWER_SERVICE_H
+
+#include "sdkconfig.h"
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef CONFIG_PM_ENABLE
+#include "esp_pm.h"
+#endif
+
+#ifdef __cplusplus
+
+// ============================================================================
+// TRAVA DE ENERGIA
+// ============================================================================
+
+/**
+ * Trava esp_pm nomeada, criada no primeiro acquire()
+ * acquire()/release() sao idempotentes: o estado e de quem segura a
+ * trava, nao um contador. Sem CONFIG_PM_ENABLE vira no-op.
+ */
+class PowerLock {
+public:
+    /**
+     * @param name Nome exibido em esp_pm_dump_locks (literal)
+     * @param cpuMax true = CPU na frequencia maxima (render/audio);
+     *               false = apenas impede light sleep (debounce)
+     */
+    explicit PowerLock(const char* name, bool cpuMax = false);
+
+    void acquire();
+    void release();
+    bool isHeld() const { return held_; }
+
+private:
+    PowerLock(const PowerLock&) = delete;
+    PowerLock& operator=(const PowerLock&) = delete;
+
+    const char* name_;
+    bool cpuMax_;
+    bool held_;
+#ifdef CONFIG_PM_ENABLE
+    esp_pm_lock_handle_t handle_;
+#endif
+};
+
+// ============================================================================
+// SERVICO
+// ============================================================================
+
+/**
+ * Contadores de sono (acumulados desde init())
+ */
+struct PowerStats {
+    uint32_t sleeps;            // Entradas em light sleep
+    uint32_t wakeTimer;         // Acordou por timer (deadline de task/timer)
+    uint32_t wakeGpio;          // Acordou por GPIO (ignicao)
+    uint32_t wakeOther;         // Outras causas
+    uint64_t sleepUs;           // Tempo total em light sleep
+    uint32_t residencyPctX10;   // Residencia em sono no ultimo periodo (0.1%)
+};
+
+class PowerService {
+public:
+    // Singleton
+    static PowerService* getInstance();
+
+    /**
+     * Configura DFS + light sleep automatico e os wakeups por GPIO
+     * Chamado depois do boot (a inicializacao roda sem dormir).
+     */
+    bool init();
+
+    /**
+     * Relatorio de residencia/wakeups a cada POWER_REPORT_PERIOD_MS
+     * Chamado pela system_task (1 Hz).
+     */
+    void reportIfDue(uint32_t nowMs);
+
+    PowerStats getStats() const { return stats_; }
+    bool isLightSleepEnabled() const { return lightSleep_; }
+
+private:
+    PowerService();
+
+    // Nao permitir copia
+    PowerService(const PowerService&) = delete;
+    PowerService& operator=(const PowerService&) = delete;
+
+    static esp_err_t onSleepExit(int64_t sleepTimeUs, void* arg);
+
+    // Singleton
+    static PowerService* instance;
+
+    bool initialized_;
+    bool lightSleep_;
+
+    // Atualizado no callback de saida do sono (task idle)
+    PowerStats stats_;
+
+    // Periodo do relatorio
+    uint32_t lastReportMs_;
+    uint64_t lastSleepUs_;
+    uint32_t lastSleeps_;
+};
+
+#endif // __cplusplus
+
+#endif // POWER_SERVICE_H
@@ -0,0 +1,79 @@
+/**
+ * ============================================================================
+ * ASSETS DE IMAGEM PRE-COMPILADOS - HEADER
+ * ============================================================================
+ *
+ * Imagens convertidas em tempo de build (tools/assets/img_compile.py) para
+ * o formato nativo do display (RGB565 / RGB565A8, bytes ja trocados) e
+ * gravadas na particao "assets". A particao e mapeada em memoria no init():
+ * o lv_img_dsc_t aponta direto para a flash, sem decodificar PNG nem
+ * alocar o quadro. Entradas com RLE sao expandidas uma vez na PSRAM.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef UI_ASSET_STORE_H
+#define UI_ASSET_STORE_H
+
+#include "config/app_config.h"
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+class AssetStore {
+public:
+    // Singleton
+    static AssetStore* getInstance();
+
+    /**
+     * Mapeia a particao ASSET_PARTITION_LABEL e valida o indice
+     * @return false se a particao nao existir ou for invalida
+     */
+    bool init();
+
+    /**
+     * Descritor da imagem pronto para lv_img_set_src()
+     * @param name Nome do PNG de origem sem extensao (ex.: "logo_splash")
+     * @return nullptr se nao existir (usar o PNG do LittleFS como fallback)
+     */
+    const lv_img_dsc_t* get(const char* name);
+
+    bool isReady() const { return count_ > 0; }
+    uint16_t getCount() const { return count_; }
+
+private:
+    AssetStore();
+
+    // Nao permitir copia
+    AssetStore(const AssetStore&) = delete;
+    AssetStore& operator=(const AssetStore&) = delete;
+
+    struct Entry {
+        char name[ASSET_NAME_MAX];
+        uint8_t compression;
+        const uint8_t* payload;     // Na flash mapeada
+        uint32_t payloadSize;
+        lv_img_dsc_t dsc;           // data_size/data validos apos expandir
+        bool ready;
+    };
+
+    bool expand(Entry& e);
+
+    // Singleton
+    static AssetStore* instance;
+
+    // Particao mapeada (mantida por toda a execucao)
+    const uint8_t* base_;
+    uint32_t size_;
+
+    Entry entries_[ASSET_MAX_ENTRIES];
+    uint16_t count_;
+};
+
+#endif // __cplusplus
+
+#endif // UI_ASSET_STORE_H
@@ -0,0 +1,143 @@
+/**
+ * ============================================================================
+ * FACES PRE-RENDERIZADAS DE BOTOES - HEADER
+ * ============================================================================
+ *
+ * Um botao de grade e uma arvore (fundo com raio, imagem/icone, label)
+ * que a LVGL refaz a partir das primitivas sempre que qualquer parte dele
+ * e invalidada. No modo de faces, a arvore e renderizada uma vez por
+ * estado (normal, pressionado, desabilitado) em imagens na PSRAM
+ * (lv_snapshot), sombra incluida, e o botao passa a desenhar so a imagem
+ * do estado atual. Filhos adicionados depois (overlays) continuam sendo
+ * desenhados ao vivo por cima.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef UI_BUTTON_FACE_H
+#define UI_BUTTON_FACE_H
+
+#include "config/app_config.h"
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifndef BUTTON_FACE_BAKE
+#define BUTTON_FACE_BAKE        0
+#endif
+
+#ifndef BUTTON_FACE_POOL
+#define BUTTON_FACE_POOL        24
+#endif
+
+#ifdef __cplusplus
+
+/**
+ * Estados com imagem propria
+ */
+enum ButtonFaceState : uint8_t {
+    BUTTON_FACE_NORMAL = 0,
+    BUTTON_FACE_PRESSED,
+    BUTTON_FACE_DISABLED,
+    BUTTON_FACE_STATES
+};
+
+#define BUTTON_FACE_MASK(state)     (1u << (state))
+
+/**
+ * Imagem de um estado. A face completa (com a sombra) fica em RGB565A8;
+ * o maior retangulo sem transparencia tambem fica copiado em TRUE_COLOR,
+ * desenhado sem mistura por pixel.
+ */
+struct ButtonFaceImage {
+    lv_img_dsc_t img;           // Face completa (data == nullptr: estado nao renderizado)
+    lv_img_dsc_t body;          // Miolo opaco (data == nullptr: nao ha)
+    lv_area_t bodyArea;         // Posicao do miolo dentro de img
+    lv_coord_t ext;             // Margem da imagem alem das coords (sombra, crescimento)
+};
+
+/**
+ * Imagens de um botao (slot do pool, endereco fixo)
+ */
+struct ButtonFace {
+    ButtonFaceImage state[BUTTON_FACE_STATES];
+    bool inUse;
+
+    bool has(ButtonFaceState s) const { return state[s].img.data != nullptr; }
+};
+
+/**
+ * Contadores (acumulados desde o boot)
+ */
+struct ButtonFaceStats {
+    uint32_t faces;             // Botoes com face agora
+    uint32_t images;            // Imagens renderizadas agora
+    uint32_t bytes;             // PSRAM das imagens agora
+    uint32_t bakes;             // Imagens renderizadas desde o boot
+    uint64_t bakeUs;            // Tempo somado das renderizacoes
+    uint32_t blits;             // Faces desenhadas
+};
+
+class ButtonFaceCache {
+public:
+    // Singleton
+    static ButtonFaceCache* getInstance();
+
+    /**
+     * Reserva um slot do pool (BUTTON_FACE_POOL)
+     * @return nullptr se o pool estiver esgotado (botao fica como arvore)
+     */
+    ButtonFace* acquire();
+
+    /**
+     * Libera as imagens e devolve o slot (feito no LV_EVENT_DELETE do botao)
+     */
+    void release(ButtonFace* face);
+
+    /**
+     * Renderiza a arvore de `stamp` (estilos e filhos) nos estados da
+     * mascara. Reaproveita o buffer se o tamanho nao mudou.
+     * Chamar com o lock do display; `stamp` volta ao estado padrao.
+     */
+    bool bake(ButtonFace* face, lv_obj_t* stamp, uint8_t stateMask);
+
+    /**
+     * Converte `btn` em botao de face: remove filhos e estilos (mantem
+     * posicao e tamanho) e passa a desenhar a face do estado.
+     * A face e liberada junto com o botao.
+     */
+    void attach(lv_obj_t* btn, ButtonFace* face);
+
+    /**
+     * Face de um botao convertido por attach() (nullptr se for arvore)
+     */
+    static ButtonFace* faceOf(lv_obj_t* btn);
+
+    ButtonFaceStats getStats() const { return stats_; }
+
+private:
+    ButtonFaceCache();
+
+    // Nao permitir copia
+    ButtonFaceCache(const ButtonFaceCache&) = delete;
+    ButtonFaceCache& operator=(const ButtonFaceCache&) = delete;
+
+    bool render(ButtonFace* face, lv_obj_t* stamp, ButtonFaceState state);
+    void freeImage(ButtonFace* face, ButtonFaceState state);
+
+    static void eventCallback(lv_event_t* e);
+
+    // Singleton
+    static ButtonFaceCache* instance;
+
+    ButtonFace pool_[BUTTON_FACE_POOL];
+    ButtonFaceStats stats_;
+    uint8_t* scratch_;          // Snapshot intercalado antes da conversao (PSRAM)
+    uint32_t scratchSize_;
+};
+
+#endif // __cplusplus
+
+#endif // UI_BUTTON_FACE_H
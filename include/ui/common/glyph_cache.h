@@ -0,0 +1,166 @@
+/**
+ * ============================================================================
+ * CACHE DE GLIFOS - HEADER
+ * ============================================================================
+ *
+ * Cache LRU de glifos chaveado por fonte + codepoint, instalado no
+ * draw_letter do draw_ctx da LVGL. Cada entrada guarda o descritor do
+ * glifo (ja resolvido, inclusive fallback) e o bitmap expandido para A8
+ * na PSRAM, entao um acerto nao passa pela busca no cmap nem desempacota
+ * os pixels A4 a cada redesenho (digitos do numpad, relogio da barra de
+ * status). Caracteres ASCII tem tabela de indice direto por fonte; o
+ * restante (LV_SYMBOL_*, acentos) usa hash.
+ *
+ * Letras opacas sem mascara sao misturadas direto no buffer de desenho,
+ * com uma rampa de 16 cores (texto -> fundo) no lugar do lv_color_mix.
+ *
+ * O desenho produz exatamente os mesmos pixels do lv_draw_sw_letter.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef UI_GLYPH_CACHE_H
+#define UI_GLYPH_CACHE_H
+
+#include "config/app_config.h"
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifndef GLYPH_CACHE_ENABLE
+#define GLYPH_CACHE_ENABLE      1
+#endif
+
+#ifndef GLYPH_CACHE_ENTRIES
+#define GLYPH_CACHE_ENTRIES     192
+#endif
+
+#ifndef GLYPH_CACHE_BUDGET
+#define GLYPH_CACHE_BUDGET      (48 * 1024)
+#endif
+
+#ifndef GLYPH_CACHE_MAX_FONTS
+#define GLYPH_CACHE_MAX_FONTS   12
+#endif
+
+#ifndef GLYPH_CACHE_RAMP
+#define GLYPH_CACHE_RAMP        1
+#endif
+
+#ifndef GLYPH_CACHE_REPORT_PERIOD_MS
+#define GLYPH_CACHE_REPORT_PERIOD_MS 60000
+#endif
+
+#ifdef __cplusplus
+
+/**
+ * Contadores (acumulados desde init())
+ */
+struct GlyphCacheStats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t entries;           // Glifos no cache agora
+    uint32_t bytes;             // Bitmaps A8 alocados agora
+    uint32_t letters;           // Letras desenhadas (com ou sem cache)
+    uint32_t rampLetters;       // Letras misturadas direto no buffer (rampa)
+    uint64_t drawCycles;        // Ciclos de CPU gastos desenhando letras
+};
+
+class GlyphCache {
+public:
+    // Singleton
+    static GlyphCache* getInstance();
+
+    /**
+     * Aloca o cache e instala o draw_letter no display padrao
+     * Chamar depois de bsp_display_start(), antes da primeira tela.
+     */
+    bool init();
+
+    /**
+     * Relatorio de acertos e tempo de desenho a cada GLYPH_CACHE_REPORT_PERIOD_MS
+     * Chamado pela system_task (1 Hz).
+     */
+    void reportIfDue(uint32_t nowMs);
+
+    GlyphCacheStats getStats() const { return stats_; }
+
+private:
+    GlyphCache();
+
+    // Nao permitir copia
+    GlyphCache(const GlyphCache&) = delete;
+    GlyphCache& operator=(const GlyphCache&) = delete;
+
+    struct Entry {
+        const lv_font_t* font;
+        uint32_t letter;
+        lv_font_glyph_dsc_t dsc;    // bpp ja convertido para 8
+        uint8_t* bitmap;            // A8 box_w * box_h (nullptr se vazio)
+        int16_t prev;               // LRU (mais recente na cabeca)
+        int16_t next;
+        int16_t hashNext;
+        uint8_t fontSlot;
+        bool levels16;              // Fonte com bpp <= 4: alfa sempre multiplo de 17
+    };
+
+    static constexpr int bucketCount = 64;     // Hash dos codepoints fora do ASCII
+    static constexpr int asciiCount = 0x7F - 0x20;
+
+    typedef void (*DrawLetterFn)(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                                 const lv_point_t* pos, uint32_t letter);
+
+    static void drawLetter(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                           const lv_point_t* pos, uint32_t letter);
+
+    bool drawCached(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                    const lv_point_t* pos, uint32_t letter);
+    static void drawA8(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                       const lv_point_t* gpos, const Entry& e);
+    bool drawRamp(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                  const lv_point_t* gpos, const Entry& e);
+    void buildRamp(lv_color_t fg, lv_color_t bg);
+
+    int fontSlot(const lv_font_t* font);
+    int16_t* indexSlot(int slot, uint32_t letter);
+    int16_t find(int slot, uint32_t letter);
+    int16_t insert(int slot, const lv_font_t* font, uint32_t letter);
+    void evict(int16_t idx);
+    void touch(int16_t idx);
+    void unlink(int16_t idx);
+
+    // Singleton
+    static GlyphCache* instance;
+
+    DrawLetterFn baseDrawLetter_;           // lv_draw_sw_letter
+
+    // Entradas na PSRAM; indices em RAM interna
+    Entry* entries_;
+    int16_t head_;
+    int16_t tail_;
+    int16_t freeList_;
+
+    const lv_font_t* fonts_[GLYPH_CACHE_MAX_FONTS];
+    uint8_t fontCount_;
+    int16_t ascii_[GLYPH_CACHE_MAX_FONTS][asciiCount];
+    int16_t buckets_[bucketCount];
+
+    // Rampa fg -> bg do ultimo par usado (indice = alfa >> 4)
+    lv_color_t ramp_[16];
+    lv_color_t rampFg_;
+    lv_color_t rampBg_;
+    bool rampValid_;
+
+    GlyphCacheStats stats_;
+
+    // Periodo do relatorio
+    uint32_t lastReportMs_;
+    GlyphCacheStats lastStats_;
+};
+
+#endif // __cplusplus
+
+#endif // UI_GLYPH_CACHE_H
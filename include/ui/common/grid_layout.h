@@ -0,0 +1,192 @@
+/**
+ * ============================================================================
+ * LAYOUT DE GRADE EM TEMPO DE COMPILACAO
+ * ============================================================================
+ *
+ * Geometria da grade de botoes calculada pelo compilador. Um layout de
+ * tela (lista de celulas) vira uma tabela constexpr com o retangulo de
+ * cada botao em pixels e o dono de cada celula; sobreposicao ou botao
+ * fora da grade e erro de compilacao. O hit-test e O(1): divisao pelo
+ * passo da grade e uma leitura da tabela. Testes (3x4, 4x3, 5x4) em
+ * test/test_grid_layout.cpp.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef UI_COMMON_GRID_LAYOUT_H
+#define UI_COMMON_GRID_LAYOUT_H
+
+#include "config/app_config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+// ============================================================================
+// TIPOS
+// ============================================================================
+
+/**
+ * Botao na grade (em celulas)
+ */
+struct GridCell {
+    int8_t x, y;
+    int8_t w, h;
+};
+
+/**
+ * Botao na tela (em pixels, relativo a area de conteudo da grade)
+ */
+struct GridRect {
+    int16_t x, y;
+    int16_t w, h;
+};
+
+// ============================================================================
+// GEOMETRIA
+// ============================================================================
+
+/**
+ * Geometria de uma grade Cols x Rows com celulas de CellW x CellH pixels
+ */
+template <int Cols, int Rows, int CellW, int CellH, int Margin = GRID_BUTTON_MARGIN>
+struct GridGeometry {
+    static_assert(Cols > 0 && Rows > 0, "Grade vazia");
+    static_assert(CellW > 0 && CellH > 0, "Celula sem area");
+
+    static constexpr int cols = Cols;
+    static constexpr int rows = Rows;
+    static constexpr int cellCount = Cols * Rows;
+    static constexpr int pitchX = CellW + Margin;
+    static constexpr int pitchY = CellH + Margin;
+    static constexpr int width = Cols * CellW + (Cols - 1) * Margin;
+    static constexpr int height = Rows * CellH + (Rows - 1) * Margin;
+
+    static constexpr bool contains(const GridCell& c) {
+        return c.w >= 1 && c.h >= 1 && c.x >= 0 && c.y >= 0 &&
+               c.x + c.w <= Cols && c.y + c.h <= Rows;
+    }
+
+    static constexpr GridRect rect(const GridCell& c) {
+        return GridRect{
+            static_cast<int16_t>(c.x * pitchX),
+            static_cast<int16_t>(c.y * pitchY),
+            static_cast<int16_t>(c.w * CellW + (c.w - 1) * Margin),
+            static_cast<int16_t>(c.h * CellH + (c.h - 1) * Margin)
+        };
+    }
+
+    /**
+     * Celula sob um ponto (row * Cols + col), -1 fora da grade.
+     * Um ponto na margem pertence a celula anterior: a margem entre
+     * as celulas de um botao multi-celula tambem e dele.
+     */
+    static constexpr int cellAt(int px, int py) {
+        return (px < 0 || py < 0 || px >= width || py >= height)
+            ? -1 : (py / pitchY) * Cols + (px / pitchX);
+    }
+};
+
+/**
+ * Geometria com celulas dimensionadas para preencher a area util
+ */
+template <int Cols, int Rows, int Margin = GRID_BUTTON_MARGIN>
+using GridFitGeometry = GridGeometry<Cols, Rows,
+    (DISPLAY_WIDTH - 2 * GRID_PADDING - (Cols - 1) * Margin) / Cols,
+    (GRID_AREA_HEIGHT - 2 * GRID_PADDING - (Rows - 1) * Margin) / Rows,
+    Margin>;
+
+/**
+ * Geometria da grade padrao do aplicativo (GRID_COLS x GRID_ROWS)
+ */
+using AppGridGeometry = GridGeometry<GRID_COLS, GRID_ROWS,
+                                     GRID_BUTTON_WIDTH, GRID_BUTTON_HEIGHT>;
+
+// ============================================================================
+// LAYOUT
+// ============================================================================
+
+namespace grid_detail {
+// Nao e constexpr: chamada apenas para layout invalido, o que torna a
+// construcao de um GridLayout constexpr um erro de compilacao.
+inline void layoutInvalido() {}
+}
+
+/**
+ * Tabela de um layout de tela: retangulos e dono de cada celula
+ * Declare como constexpr para que o layout seja validado pelo compilador.
+ */
+template <typename Geometry, size_t N>
+class GridLayout {
+public:
+    constexpr explicit GridLayout(const GridCell (&cells)[N])
+        : cells_{}, rects_{}, owner_{}, valid_(true)
+    {
+        for (int i = 0; i < Geometry::cellCount; i++) {
+            owner_[i] = -1;
+        }
+
+        for (size_t i = 0; i < N; i++) {
+            const GridCell& c = cells[i];
+            cells_[i] = c;
+            rects_[i] = Geometry::rect(c);
+
+            if (!Geometry::contains(c)) {
+                grid_detail::layoutInvalido();     // Fora da grade
+                valid_ = false;
+                continue;
+            }
+
+            for (int y = c.y; y < c.y + c.h; y++) {
+                for (int x = c.x; x < c.x + c.w; x++) {
+                    int idx = y * Geometry::cols + x;
+                    if (owner_[idx] >= 0) {
+                        grid_detail::layoutInvalido();     // Sobreposicao
+                        valid_ = false;
+                        continue;
+                    }
+                    owner_[idx] = static_cast<int8_t>(i);
+                }
+            }
+        }
+    }
+
+    static constexpr size_t size() { return N; }
+
+    /**
+     * Falso se algum botao sai da grade ou sobrepoe outro (so acontece
+     * com um layout montado em tempo de execucao; o constexpr nao compila)
+     */
+    constexpr bool valid() const { return valid_; }
+    constexpr const GridCell& cell(size_t i) const { return cells_[i]; }
+    constexpr const GridRect& rect(size_t i) const { return rects_[i]; }
+
+    /**
+     * Indice do botao que ocupa a celula (col, row), -1 se livre
+     */
+    constexpr int ownerAt(int col, int row) const {
+        return (col < 0 || row < 0 || col >= Geometry::cols || row >= Geometry::rows)
+            ? -1 : owner_[row * Geometry::cols + col];
+    }
+
+    /**
+     * Indice do botao sob um ponto em pixels (O(1)), -1 se nenhum
+     */
+    constexpr int hitTest(int px, int py) const {
+        int c = Geometry::cellAt(px, py);
+        return c < 0 ? -1 : owner_[c];
+    }
+
+private:
+    GridCell cells_[N];
+    GridRect rects_[N];
+    int8_t owner_[Geometry::cellCount];
+    bool valid_;
+};
+
+#endif // __cplusplus
+
+#endif // UI_COMMON_GRID_LAYOUT_H
@@ -0,0 +1,48 @@
+/**
+ * ============================================================================
+ * DECODER PNG EM STREAMING - HEADER
+ * ============================================================================
+ *
+ * Decoder de imagem LVGL para PNGs em arquivo que entrega as linhas sob
+ * demanda (read_line), sem o buffer do quadro inteiro do lv_png/lodepng.
+ * O IDAT e lido em blocos e descomprimido com o inflate da ROM (miniz):
+ * a memoria de trabalho e a janela de 32 KB + o estado do inflate + duas
+ * linhas, independente da altura da imagem. Cada linha e convertida direto
+ * para RGB565 (RGB565 + A8 se houver transparencia).
+ *
+ * Imagens de ate PNG_STREAM_FULL_DECODE_MAX bytes (no formato da LVGL)
+ * sao decodificadas inteiras no open, pelo mesmo caminho linha a linha,
+ * e ficam no cache de imagens: com full_refresh cada quadro redesenha a
+ * tela toda, e uma imagem em streaming passa pelo inflate de novo a cada
+ * quadro. O streaming fica para imagens grandes desenhadas poucas vezes.
+ *
+ * PNG entrelacado (Adam7) ou em memoria (LV_IMG_SRC_VARIABLE) continua com
+ * o lv_png, que deve ser registrado antes como fallback.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef UI_PNG_STREAM_H
+#define UI_PNG_STREAM_H
+
+#include "config/app_config.h"
+#include "lvgl.h"
+
+#ifndef PNG_STREAM_INPUT_SIZE
+#define PNG_STREAM_INPUT_SIZE   1024
+#endif
+
+#ifndef PNG_STREAM_FULL_DECODE_MAX
+#define PNG_STREAM_FULL_DECODE_MAX  (96 * 1024)
+#endif
+
+/**
+ * Registra o decoder na LVGL. Chamar depois de lv_png_init(): o ultimo
+ * decoder registrado e consultado primeiro.
+ */
+void png_stream_init(void);
+
+#endif // UI_PNG_STREAM_H
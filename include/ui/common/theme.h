@@ -14,6 +14,7 @@
 #ifndef UI_THEME_H
 #define UI_THEME_H
 
+#include "config/app_config.h"
 #include "lvgl.h"
 
 #ifdef __cplusplus
@@ -45,15 +46,44 @@ public:
     lv_color_t getColorForJornadaState(int state);
     lv_color_t getColorForAction(int action);
 
-    // Aplicar estilos
+    // Aplicar estilos (estilos compartilhados via lv_obj_add_style;
+    // chamar com o lock do display)
     void applyButtonStyle(lv_obj_t* btn, lv_color_t bgColor);
     void applyLabelStyle(lv_obj_t* label, lv_color_t textColor, const lv_font_t* font = nullptr);
     void applyContainerStyle(lv_obj_t* container, lv_color_t bgColor);
     void applyPopupStyle(lv_obj_t* popup);
 
+    // Botoes de grade (ButtonManager)
+    void applyGridButtonStyle(lv_obj_t* btn, lv_color_t bgColor);
+    void applyImageStyle(lv_obj_t* img);
+
+    /**
+     * Troca a cor de fundo de um objeto estilizado pelo tema
+     * Remove o estilo da cor anterior e adiciona o da nova.
+     */
+    void setBgColor(lv_obj_t* obj, lv_color_t oldColor, lv_color_t newColor);
+
+    // Folha de estilos
+    lv_style_t* getBgStyle(lv_color_t color);
+    lv_style_t* getTextStyle(lv_color_t color, const lv_font_t* font);
+
 private:
     Theme();
     void initColors();
+    void initStyles();
+    lv_style_t* findBgStyle(lv_color_t color);
+    void addBgStyle(lv_obj_t* obj, lv_color_t color);
+
+    struct BgStyleSlot {
+        lv_color_t color;
+        lv_style_t style;
+    };
+
+    struct TextStyleSlot {
+        lv_color_t color;
+        const lv_font_t* font;
+        lv_style_t style;
+    };
 
     static Theme* instance;
 
@@ -72,6 +102,21 @@ private:
     lv_color_t textPrimary;
     lv_color_t textSecondary;
     lv_color_t textMuted;
+
+    // Estilos por papel
+    bool stylesReady;
+    lv_style_t styleButton;         // Botao generico (applyButtonStyle)
+    lv_style_t styleGridButton;     // Botao de grade: forma + layout flex
+    lv_style_t styleDisabled;       // Seletor LV_STATE_DISABLED
+    lv_style_t styleImage;          // Imagem sem fundo/borda
+    lv_style_t styleContainer;
+    lv_style_t stylePopup;
+
+    // Estilos por cor (capacidade fixa)
+    BgStyleSlot bgStyles[THEME_MAX_BG_STYLES];
+    int bgStyleCount;
+    TextStyleSlot textStyles[THEME_MAX_TEXT_STYLES];
+    int textStyleCount;
 };
 
 extern "C" {
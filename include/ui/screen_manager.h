@@ -4,7 +4,7 @@
  * ============================================================================
  *
  * Implementacao do IScreenManager com navegacao baseada em pilha
- * e troca instantanea (sem animacao). Cada tela eh 100% isolada.
+ * e transicao slide a partir de snapshots. Cada tela eh 100% isolada.
  *
  * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
  * Desenvolvido por Mario Stanski Jr
@@ -16,6 +16,7 @@
 #define UI_SCREEN_MANAGER_H
 
 #include "interfaces/i_screen.h"
+#include "ui/screen_transition.h"
 #include "config/app_config.h"
 #include "lvgl.h"
 
@@ -24,10 +25,25 @@
 // Forward declaration
 class StatusBar;
 
+/**
+ * Estatisticas de navegacao (heap medido a cada troca de tela)
+ */
+struct ScreenNavStats {
+    uint32_t transitions;       // Trocas de tela
+    uint32_t creates;           // create() executados
+    uint32_t resumes;           // Telas retidas retomadas (sem alocacao)
+    uint32_t destroys;          // destroy() executados pela politica
+    int32_t lastHeapDelta;      // Bytes consumidos pela ultima troca
+    uint32_t heapFree;          // Heap livre apos a ultima troca
+    uint32_t heapMinFree;       // Menor heap livre desde o boot
+    uint32_t largestFreeBlock;  // Maior bloco livre
+    uint8_t fragmentationPct;   // 100 - maior bloco / livre
+};
+
 /**
  * Implementacao concreta do IScreenManager
  *
- * Gerencia uma pilha de navegacao de telas com troca instantanea.
+ * Gerencia uma pilha de navegacao de telas com transicao animada.
  * Cada tela possui seu proprio ButtonManager para isolamento total.
  */
 class ScreenManagerImpl : public IScreenManager {
@@ -54,8 +70,8 @@ public:
 
     /**
      * Volta para a tela anterior (pop da pilha)
-     * A tela atual eh destruida e a tela do topo da pilha
-     * eh carregada com animacao slide-right.
+     * A tela atual segue sua politica de retencao e a tela do topo
+     * da pilha eh carregada.
      * @return true se conseguiu voltar, false se pilha vazia
      */
     bool goBack() override;
@@ -104,6 +120,11 @@ public:
      */
     int getStackDepth() const { return stackTop_ + 1; }
 
+    /**
+     * Obtem estatisticas de navegacao e heap
+     */
+    ScreenNavStats getNavStats() const { return navStats_; }
+
 private:
     ScreenManagerImpl();
     ~ScreenManagerImpl() = default;
@@ -123,6 +144,20 @@ private:
 
     // Referencia para StatusBar persistente
     StatusBar* statusBar_;
+
+    // Telas retidas com timers pausados (politica SUSPEND)
+    bool suspended_[static_cast<int>(ScreenType::MAX_SCREENS)];
+
+    ScreenNavStats navStats_;
+
+    // Transicao animada (snapshots na PSRAM)
+    ScreenTransition transition_;
+
+    // Troca comum a navigateTo/goBack/cycleTo
+    void switchScreen(IScreen* leaving, IScreen* target, TransitionDir dir);
+    void activateScreen(IScreen* screen);
+    void retireScreen(IScreen* screen);
+    void recordHeap(size_t heapBefore);
 };
 
 #endif // __cplusplus
@@ -0,0 +1,97 @@
+/**
+ * ============================================================================
+ * TRANSICAO DE TELAS - HEADER
+ * ============================================================================
+ *
+ * Transicao slide a partir de snapshots. As telas de saida e de entrada
+ * sao renderizadas uma unica vez em buffers na PSRAM (lv_snapshot) e a
+ * animacao move apenas duas imagens em uma tela auxiliar: cada frame e
+ * uma copia de pixels, sem redesenhar a arvore de widgets.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef UI_SCREEN_TRANSITION_H
+#define UI_SCREEN_TRANSITION_H
+
+#include "config/app_config.h"
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+
+/**
+ * Direcao da transicao
+ */
+enum class TransitionDir : uint8_t {
+    NONE = 0,       // Troca instantanea
+    LEFT,           // Nova tela entra pela direita (avancar)
+    RIGHT           // Nova tela entra pela esquerda (voltar)
+};
+
+/**
+ * Medicao da ultima transicao (frames e carga de render)
+ */
+struct TransitionStats {
+    uint32_t count;         // Transicoes animadas executadas
+    uint32_t fallbacks;     // Trocas instantaneas por falta de buffer/snapshot
+    uint32_t frames;        // Frames renderizados na ultima transicao
+    uint32_t durationMs;    // Duracao real da ultima transicao
+    uint32_t renderMs;      // Tempo de render somado na ultima transicao
+    uint32_t snapshotUs;    // Tempo dos dois snapshots
+};
+
+class ScreenTransition {
+public:
+    ScreenTransition();
+
+    /**
+     * Carrega a tela destino com animacao (ou instantaneamente se
+     * dir == NONE, SCREEN_TRANSITION_TIME_MS == 0 ou sem memoria)
+     * Deve ser chamado com o display lock tomado.
+     * @param from Tela atual (fonte do snapshot de saida)
+     * @param to Tela destino
+     */
+    void run(lv_obj_t* from, lv_obj_t* to, TransitionDir dir);
+
+    /**
+     * Conclui uma transicao em andamento (carrega a tela destino)
+     */
+    void finish();
+
+    bool isRunning() const { return running_; }
+    TransitionStats getStats() const { return stats_; }
+
+private:
+    bool ensureBuffers(lv_obj_t* from, lv_obj_t* to);
+    void ensureScreen();
+
+    static void animExecCallback(void* var, int32_t v);
+    static void animReadyCallback(lv_anim_t* a);
+
+    // Buffers de snapshot na PSRAM (alocados uma vez)
+    uint8_t* buf_[2];
+    uint32_t bufSize_;
+    lv_img_dsc_t dsc_[2];
+
+    // Tela auxiliar com as duas imagens (criada uma vez)
+    lv_obj_t* screen_;
+    lv_obj_t* img_[2];
+
+    // Transicao em andamento
+    lv_obj_t* target_;
+    TransitionDir dir_;
+    bool running_;
+    int64_t startUs_;
+    uint32_t startFrames_;
+    uint32_t startRenderMs_;
+
+    TransitionStats stats_;
+};
+
+#endif // __cplusplus
+
+#endif // UI_SCREEN_TRANSITION_H
@@ -48,6 +48,9 @@ public:
     void onExit() override;
     lv_obj_t* getLvScreen() const override;
     void invalidate() override;
+    ScreenRetention getRetention() const override;
+    void suspend() override;
+    void resume() override;
 
 private:
     // Tela LVGL
@@ -0,0 +1,141 @@
+/**
+ * ============================================================================
+ * WIDGET POPUP - HEADER
+ * ============================================================================
+ *
+ * Popup modal unico por display, criado uma vez em lv_layer_top().
+ * Mostrar um popup apenas reatribui textos, icone, cores e callback aos
+ * objetos ja existentes; fechar apenas esconde. Pedidos feitos com um
+ * popup visivel entram em uma fila fixa e sao exibidos em sequencia.
+ * Nenhum objeto LVGL ou texto e alocado por popup.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#ifndef UI_WIDGETS_POPUP_H
+#define UI_WIDGETS_POPUP_H
+
+#include "config/app_config.h"
+#include "lvgl.h"
+#include <stdint.h>
+
+// ============================================================================
+// TIPOS
+// ============================================================================
+
+enum PopupType {
+    POPUP_INFO,
+    POPUP_WARNING,
+    POPUP_ERROR,
+    POPUP_QUESTION,
+    POPUP_SUCCESS
+};
+
+enum PopupResult {
+    POPUP_RESULT_NONE,
+    POPUP_RESULT_OK,
+    POPUP_RESULT_CANCEL
+};
+
+#ifdef __cplusplus
+
+/**
+ * Callback de resultado (executado no contexto LVGL, popup ja fechado)
+ */
+typedef void (*PopupCallback)(PopupResult result, void* ctx);
+
+class PopupService {
+public:
+    // Singleton
+    static PopupService* getInstance();
+
+    /**
+     * Cria o overlay e todos os objetos do popup (escondidos)
+     * Chamado uma vez apos o display; show() chama se necessario.
+     */
+    void init();
+
+    /**
+     * Exibe um popup ou o enfileira se ja houver um visivel
+     * Titulo e mensagem sao copiados (truncados em POPUP_TITLE_MAX/POPUP_MESSAGE_MAX).
+     * @param owner Dono do pedido (para closeOwnedBy)
+     * @return false se a fila estiver cheia
+     */
+    bool show(const char* title, const char* message, PopupType type,
+              bool showCancel = false, PopupCallback callback = nullptr,
+              void* ctx = nullptr, const void* owner = nullptr);
+
+    /**
+     * Fecha o popup visivel (sem callback) e exibe o proximo da fila
+     */
+    void close();
+
+    /**
+     * Fecha/descarta todos os pedidos de um dono (ex.: tela saindo)
+     */
+    void closeOwnedBy(const void* owner);
+
+    bool isVisible() const { return visible_; }
+    PopupResult getLastResult() const { return lastResult_; }
+
+    /**
+     * Tempo do ultimo show() ate o overlay ser desenhado (us)
+     */
+    uint32_t getLastShowLatencyUs() const { return lastShowUs_; }
+
+private:
+    PopupService();
+
+    // Nao permitir copia
+    PopupService(const PopupService&) = delete;
+    PopupService& operator=(const PopupService&) = delete;
+
+    struct Request {
+        char title[POPUP_TITLE_MAX];
+        char message[POPUP_MESSAGE_MAX];
+        PopupType type;
+        bool showCancel;
+        PopupCallback callback;
+        void* ctx;
+        const void* owner;
+    };
+
+    void present();
+    void hideCurrent();
+    Request& slot(int i) { return queue_[(head_ + i) % POPUP_QUEUE_SIZE]; }
+
+    static void buttonEventHandler(lv_event_t* e);
+    static void drawEventHandler(lv_event_t* e);
+
+    // Singleton
+    static PopupService* instance;
+
+    // Objetos LVGL (criados uma vez)
+    lv_obj_t* overlay_;
+    lv_obj_t* iconLabel_;
+    lv_obj_t* titleLabel_;
+    lv_obj_t* msgLabel_;
+    lv_obj_t* btnOk_;
+    lv_obj_t* btnCancel_;
+
+    // Fila de pedidos (queue_[head_] e o visivel)
+    Request queue_[POPUP_QUEUE_SIZE];
+    uint8_t head_;
+    uint8_t count_;
+    bool visible_;
+
+    PopupResult lastResult_;
+    uint32_t lastClickMs_;
+
+    // Medicao show -> visivel
+    int64_t showStartUs_;
+    bool measuring_;
+    uint32_t lastShowUs_;
+};
+
+#endif // __cplusplus
+
+#endif // UI_WIDGETS_POPUP_H
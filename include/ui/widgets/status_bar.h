@@ -23,6 +23,7 @@
 
 // Forward declarations
 class IScreenManager;
+class IBatteryService;
 
 /**
  * Dados para atualizar a barra de status
@@ -103,10 +104,19 @@ public:
      */
     void setScreenManager(IScreenManager* mgr);
 
+    /**
+     * Define o servico de bateria consultado a cada update()
+     * A leitura e lock-free; o label so e redesenhado quando o valor muda.
+     * @param svc Ponteiro para IBatteryService (nullptr oculta o indicador)
+     */
+    void setBatteryService(IBatteryService* svc);
+
 private:
     // Callbacks LVGL
-    static void updateTimerCallback(lv_timer_t* timer);
+    static void messageTimerCallback(lv_timer_t* timer);
     static void swapBtnCallback(lv_event_t* e);
+    void refreshBattery();
+    static void setTextIfChanged(lv_obj_t* label, const char* text);
 
     // Elementos UI
     lv_obj_t* container_;
@@ -116,15 +126,17 @@ private:
     lv_obj_t* tempoIgnicaoLabel_;
     lv_obj_t* tempoJornadaLabel_;
     lv_obj_t* mensagemLabel_;
+    lv_obj_t* bateriaLabel_;
 
-    // Timer
-    lv_timer_t* updateTimer_;
+    // Timer de expiracao da mensagem (one-shot)
+    lv_timer_t* messageTimer_;
 
     // Estado
-    uint32_t messageExpireTime_;
+    uint32_t lastBatteryPacked_;
 
     // Referencia para o gerenciador de telas (loose coupling)
     IScreenManager* screenManager_;
+    IBatteryService* batteryService_;
 };
 
 #endif // __cplusplus
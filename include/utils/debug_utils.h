@@ -13,6 +13,7 @@
 
 #include "esp_log.h"
 #include <stdio.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -115,6 +116,36 @@ void debug_print_task_info(void);
  */
 bool debug_check_heap(void);
 
+// ============================================================================
+// RELATORIO DE RECURSOS (ANTES/DEPOIS)
+// ============================================================================
+
+/**
+ * Foto dos recursos do sistema em um instante
+ */
+typedef struct {
+    uint32_t internalFree;  // Heap interna livre (bytes)
+    uint32_t psramFree;     // PSRAM livre (bytes)
+    uint32_t minFree;       // Menor heap livre desde o boot (bytes)
+    uint32_t taskCount;     // Numero de tasks FreeRTOS
+} debug_resource_snapshot_t;
+
+/**
+ * Captura a foto atual dos recursos
+ * @param out Estrutura a preencher
+ */
+void debug_take_resource_snapshot(debug_resource_snapshot_t* out);
+
+/**
+ * Imprime a diferenca entre duas fotos (RAM consumida e tasks criadas)
+ * @param label Nome da etapa medida
+ * @param before Foto antes da etapa
+ * @param after Foto depois da etapa
+ */
+void debug_print_resource_delta(const char* label,
+                                const debug_resource_snapshot_t* before,
+                                const debug_resource_snapshot_t* after);
+
 #ifdef __cplusplus
 }
 #endif
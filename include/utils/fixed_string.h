@@ -0,0 +1,87 @@
+/**
+ * ============================================================================
+ * STRING DE CAPACIDADE FIXA - HEADER
+ * ============================================================================
+ *
+ * Texto com buffer inline de N bytes (incluindo o terminador). Nunca
+ * aloca: o que nao cabe e truncado e a operacao retorna false.
+ *
+ * ============================================================================
+ */
+
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+
+template <size_t N>
+class FixedString {
+    static_assert(N >= 1, "FixedString precisa de espaco para o terminador");
+
+public:
+    FixedString() : len_(0) { buf_[0] = '\0'; }
+    FixedString(const char* s) : len_(0) { buf_[0] = '\0'; append(s); }
+
+    FixedString& operator=(const char* s) {
+        assign(s);
+        return *this;
+    }
+
+    bool assign(const char* s) {
+        clear();
+        return append(s);
+    }
+
+    /**
+     * Concatena s (truncando no limite)
+     * @return false se truncou
+     */
+    bool append(const char* s) {
+        if (!s) return true;
+        size_t n = strlen(s);
+        size_t room = capacity() - len_;
+        bool fits = n <= room;
+        if (!fits) n = room;
+        memcpy(buf_ + len_, s, n);
+        len_ += n;
+        buf_[len_] = '\0';
+        return fits;
+    }
+
+    bool push_back(char c) {
+        if (len_ >= capacity()) return false;
+        buf_[len_++] = c;
+        buf_[len_] = '\0';
+        return true;
+    }
+
+    void pop_back() {
+        if (len_ > 0) buf_[--len_] = '\0';
+    }
+
+    void clear() {
+        len_ = 0;
+        buf_[0] = '\0';
+    }
+
+    const char* c_str() const { return buf_; }
+    size_t length() const { return len_; }
+    size_t size() const { return len_; }
+    bool empty() const { return len_ == 0; }
+    bool full() const { return len_ >= capacity(); }
+    static constexpr size_t capacity() { return N - 1; }
+
+    const char* begin() const { return buf_; }
+    const char* end() const { return buf_ + len_; }
+
+private:
+    char buf_[N];
+    size_t len_;
+};
+
+#endif // __cplusplus
+
+#endif // FIXED_STRING_H
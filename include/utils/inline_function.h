@@ -0,0 +1,79 @@
+/**
+ * ============================================================================
+ * DELEGATE SEM ALOCACAO - HEADER
+ * ============================================================================
+ *
+ * Substituto de std::function para callbacks de UI. O callable (ponteiro
+ * de funcao ou lambda com captura pequena) e guardado inline em
+ * Capacity bytes; nao ha alocacao em construcao, copia ou chamada.
+ * Callables grandes ou nao trivialmente copiaveis sao erro de compilacao.
+ *
+ * ============================================================================
+ */
+
+#ifndef INLINE_FUNCTION_H
+#define INLINE_FUNCTION_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef __cplusplus
+
+// Suficiente para um lambda que captura [this, int]
+#ifndef INLINE_FUNCTION_CAPACITY
+    #define INLINE_FUNCTION_CAPACITY    (2 * sizeof(void*))
+#endif
+
+template <typename Signature, size_t Capacity = INLINE_FUNCTION_CAPACITY>
+class InlineFunction;
+
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+public:
+    InlineFunction() : invoke_(nullptr) {}
+    InlineFunction(std::nullptr_t) : invoke_(nullptr) {}
+
+    template <typename F, typename Fn = typename std::decay<F>::type,
+              typename = typename std::enable_if<
+                  !std::is_same<Fn, InlineFunction>::value &&
+                  !std::is_same<Fn, std::nullptr_t>::value>::type>
+    InlineFunction(F&& f) : invoke_(nullptr) {
+        static_assert(sizeof(Fn) <= Capacity, "Callable maior que a capacidade do InlineFunction");
+        static_assert(alignof(Fn) <= alignof(void*), "Alinhamento do callable nao suportado");
+        static_assert(std::is_trivially_copyable<Fn>::value &&
+                      std::is_trivially_destructible<Fn>::value,
+                      "Callable deve ser trivialmente copiavel (sem captura de objetos com heap)");
+
+        // Ponteiro de funcao nulo vira delegate vazio
+        if constexpr (std::is_pointer<typename std::remove_reference<F>::type>::value) {
+            if (f == nullptr) return;
+        }
+
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+        invoke_ = &invokeImpl<Fn>;
+    }
+
+    // Chamar vazio e erro do chamador (como std::function); conferir com operator bool
+    R operator()(Args... args) const {
+        assert(invoke_ != nullptr && "InlineFunction vazio");
+        return invoke_(const_cast<unsigned char*>(storage_), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return invoke_ != nullptr; }
+
+private:
+    template <typename Fn>
+    static R invokeImpl(void* storage, Args... args) {
+        return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+    }
+
+    R (*invoke_)(void*, Args...);
+    alignas(void*) unsigned char storage_[Capacity];
+};
+
+#endif // __cplusplus
+
+#endif // INLINE_FUNCTION_H
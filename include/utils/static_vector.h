@@ -0,0 +1,81 @@
+/**
+ * ============================================================================
+ * VETOR DE CAPACIDADE FIXA - HEADER
+ * ============================================================================
+ *
+ * Sequencia com armazenamento inline para ate N elementos. Mantem a
+ * interface minima usada pela UI (push_back, erase, iteradores) sem
+ * alocar; push_back retorna false quando cheio.
+ *
+ * ============================================================================
+ */
+
+#ifndef STATIC_VECTOR_H
+#define STATIC_VECTOR_H
+
+#include <stddef.h>
+#include <utility>
+
+#ifdef __cplusplus
+
+template <typename T, size_t N>
+class StaticVector {
+public:
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    StaticVector() : size_(0) {}
+
+    bool push_back(const T& value) {
+        if (size_ >= N) return false;
+        items_[size_++] = value;
+        return true;
+    }
+
+    bool push_back(T&& value) {
+        if (size_ >= N) return false;
+        items_[size_++] = std::move(value);
+        return true;
+    }
+
+    /**
+     * Remove o elemento mantendo a ordem dos demais
+     * @return Iterador para o elemento que ocupou a posicao removida
+     */
+    iterator erase(iterator it) {
+        iterator pos = it;
+        for (iterator next = it + 1; next != end(); ++it, ++next) {
+            *it = std::move(*next);
+        }
+        items_[--size_] = T();
+        return pos;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < size_; i++) {
+            items_[i] = T();
+        }
+        size_ = 0;
+    }
+
+    T& operator[](size_t i) { return items_[i]; }
+    const T& operator[](size_t i) const { return items_[i]; }
+
+    iterator begin() { return items_; }
+    iterator end() { return items_ + size_; }
+    const_iterator begin() const { return items_; }
+    const_iterator end() const { return items_ + size_; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ >= N; }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T items_[N];
+    size_t size_;
+};
+
+#endif // __cplusplus
+
+#endif // STATIC_VECTOR_H
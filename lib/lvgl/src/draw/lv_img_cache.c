@@ -13,6 +13,10 @@
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
 
+#ifdef LV_IMG_CACHE_DATA_INCLUDE
+    #include LV_IMG_CACHE_DATA_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -35,6 +39,9 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static uint32_t get_entry_size(const lv_img_decoder_dsc_t * dsc);
+    static _lv_img_cache_entry_t * find_victim(const _lv_img_cache_entry_t * keep, bool need_size);
+    static void close_entry(_lv_img_cache_entry_t * entry);
 #endif
 
 /**********************
@@ -42,6 +49,7 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static lv_img_cache_stats_t stats;
 #endif
 
 /**********************
@@ -96,20 +104,21 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
         }
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
-
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
+    /*The image is cached, nothing to open*/
+    if(cached_src) {
+        stats.hits++;
+        return cached_src;
     }
 
+    stats.misses++;
+
+    /*Find an entry to reuse. Select an empty entry or the one with the least life*/
+    cached_src = find_victim(NULL, false);
+
     /*Close the decoder to reuse if it was opened (has a valid source)*/
     if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
+        close_entry(cached_src);
+        stats.evictions++;
         LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
     }
     else {
@@ -137,6 +146,25 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
 
     if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
+#if LV_IMG_CACHE_DEF_SIZE
+    cached_src->size = get_entry_size(&cached_src->dec_dsc);
+    stats.entries++;
+    stats.bytes += cached_src->size;
+
+#if LV_IMG_CACHE_BUDGET
+    /*Close the least used images until the open ones fit in the budget.
+     *The new image stays even if alone it's larger than the budget: it's about to be drawn.*/
+    while(stats.bytes > LV_IMG_CACHE_BUDGET) {
+        _lv_img_cache_entry_t * victim = find_victim(cached_src, true);
+        if(victim == NULL) break;
+        close_entry(victim);
+        stats.evictions++;
+    }
+#endif
+
+    if(stats.bytes > stats.bytes_peak) stats.bytes_peak = stats.bytes;
+#endif
+
     return cached_src;
 }
 
@@ -153,10 +181,17 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
 #else
     if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
-        /*Clean the cache before free it*/
-        lv_img_cache_invalidate_src(NULL);
+        /*Close the open images through `close_entry()` so the counters follow, then free the array*/
+        _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+        uint16_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            if(cache[i].dec_dsc.src != NULL) close_entry(&cache[i]);
+        }
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+        LV_GC_ROOT(_lv_img_cache_array) = NULL;
+        entry_cnt = 0;
     }
+    LV_ASSERT(stats.entries == 0 && stats.bytes == 0);
 
     /*Reallocate the cache*/
     LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
@@ -187,7 +222,7 @@ void lv_img_cache_invalidate_src(const void * src)
     for(i = 0; i < entry_cnt; i++) {
         if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
             if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
+                close_entry(&cache[i]);
             }
 
             lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
@@ -196,6 +231,34 @@ void lv_img_cache_invalidate_src(const void * src)
 #endif
 }
 
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats_p)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    *stats_p = stats;
+#else
+    lv_memset_00(stats_p, sizeof(lv_img_cache_stats_t));
+#endif
+}
+
+void * lv_img_cache_data_alloc(size_t size)
+{
+#ifdef LV_IMG_CACHE_DATA_ALLOC
+    return LV_IMG_CACHE_DATA_ALLOC(size);
+#else
+    return lv_mem_alloc(size);
+#endif
+}
+
+void lv_img_cache_data_free(void * p)
+{
+    if(p == NULL) return;
+#ifdef LV_IMG_CACHE_DATA_FREE
+    LV_IMG_CACHE_DATA_FREE(p);
+#else
+    lv_mem_free(p);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -212,4 +275,57 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Bytes an open image holds: what the decoder reported or the size of its decoded frame.
+ * Images drawn straight from their source (e.g. a C array) hold nothing.
+ */
+static uint32_t get_entry_size(const lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->cache_size) return dsc->cache_size;
+    if(dsc->img_data == NULL) return 0;
+
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) {
+        return 0;
+    }
+
+    return lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+}
+
+/**
+ * Select the entry to close: an empty one if any, else the one with the least life.
+ * @param keep entry that can't be selected (or NULL)
+ * @param need_size true: only entries holding memory (to free budget)
+ */
+static _lv_img_cache_entry_t * find_victim(const _lv_img_cache_entry_t * keep, bool need_size)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    _lv_img_cache_entry_t * victim = NULL;
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        _lv_img_cache_entry_t * e = &cache[i];
+        if(e == keep) continue;
+
+        if(e->dec_dsc.src == NULL) {
+            if(need_size) continue;
+            return e;
+        }
+
+        if(need_size && e->size == 0) continue;
+        if(victim == NULL || e->life < victim->life) victim = e;
+    }
+
+    return victim;
+}
+
+static void close_entry(_lv_img_cache_entry_t * entry)
+{
+    lv_img_decoder_close(&entry->dec_dsc);
+
+    stats.entries--;
+    stats.bytes -= entry->size;
+
+    lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
+}
 #endif
@@ -19,6 +19,12 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*Maximum bytes held by the open images in the cache (see `lv_img_decoder_dsc_t::cache_size`).
+ *Least used entries are closed until the total fits. 0: limit only by LV_IMG_CACHE_DEF_SIZE*/
+#ifndef LV_IMG_CACHE_BUDGET
+#define LV_IMG_CACHE_BUDGET 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,8 +41,23 @@ typedef struct {
      * Decrement all lifes by one every in every ::lv_img_cache_open.
      * If life == 0 the entry can be reused*/
     int32_t life;
+
+    /** Bytes held while the entry is open (counted against LV_IMG_CACHE_BUDGET)*/
+    uint32_t size;
 } _lv_img_cache_entry_t;
 
+/**
+ * Image cache counters. Hits, misses and evictions accumulate since start-up.
+ */
+typedef struct {
+    uint32_t hits;          /**< Image found open in the cache*/
+    uint32_t misses;        /**< Image had to be opened (decoded)*/
+    uint32_t evictions;     /**< Open images closed to make room*/
+    uint32_t entries;       /**< Open images now*/
+    uint32_t bytes;         /**< Bytes held by the open images now*/
+    uint32_t bytes_peak;    /**< Highest `bytes` so far*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -67,6 +88,27 @@ void lv_img_cache_set_size(uint16_t new_slot_num);
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Get the image cache counters.
+ * @param stats pointer to a structure to fill
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Allocate memory for a decoded image frame kept by an image decoder while the image is open.
+ * Uses `LV_IMG_CACHE_DATA_ALLOC` if defined in lv_conf.h (e.g. to place frames in external RAM),
+ * else `lv_mem_alloc`. Free it with `lv_img_cache_data_free`.
+ * @param size size of the frame in bytes
+ * @return pointer to the allocated memory or NULL
+ */
+void * lv_img_cache_data_alloc(size_t size);
+
+/**
+ * Free memory allocated with `lv_img_cache_data_alloc`.
+ * @param p pointer to the frame (NULL is ignored)
+ */
+void lv_img_cache_data_free(void * p);
+
 /**********************
  *      MACROS
  **********************/
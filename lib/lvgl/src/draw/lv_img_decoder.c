@@ -156,6 +156,7 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
         dsc->img_data  = NULL;
         dsc->user_data = NULL;
         dsc->time_to_open = 0;
+        dsc->cache_size = 0;
     }
 
     if(dsc->src_type == LV_IMG_SRC_FILE)
@@ -127,6 +127,10 @@ typedef struct _lv_img_decoder_dsc_t {
 
     /**Store any custom data here is required*/
     void * user_data;
+
+    /**Bytes held while the image is open (decoded frame, decoder working memory).
+     * Can be set in `open` function; if 0 `lv_img_cache` derives it from `img_data`*/
+    uint32_t cache_size;
 } lv_img_decoder_dsc_t;
 
 /**********************
@@ -15,6 +15,27 @@
  *      DEFINES
  *********************/
 
+/*Section of the hot blend kernels, see lv_conf.h*/
+#ifndef LV_ATTRIBUTE_BLEND_IRAM
+#define LV_ATTRIBUTE_BLEND_IRAM LV_ATTRIBUTE_FAST_MEM
+#endif
+
+/*Can be set to 0 from outside to build the original per-pixel loops (conformance reference)*/
+#ifndef BLEND_RGB565_PAIRS
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_MIX_ROUND_OFS == 0
+/*RGB565 pixels are blended two per 32-bit word with the same arithmetic as `lv_color_mix()`:
+ *each pixel is spread as 0b00000GGGGGG00000RRRRR000000BBBBB so one multiply mixes all three
+ *channels with a 5 bit ratio, and the LV_COLOR_16_SWAP byte swap is undone/redone once per pair.
+ *The mixed cases have no per-pixel branches (a 0 ratio gives the background, 255 the foreground).
+ *The destination must be 4 byte aligned, so the odd first/last pixel of a row uses `lv_color_mix()`.*/
+#define BLEND_RGB565_PAIRS  1
+#else
+#define BLEND_RGB565_PAIRS  0
+#endif
+#endif /*BLEND_RGB565_PAIRS*/
+
+#define RGB565_SPREAD_MASK  0x07E0F81FU
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -68,6 +89,14 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif /*LV_DRAW_COMPLEX*/
 
+#if BLEND_RGB565_PAIRS
+static inline uint32_t rgb565_pair_native(uint32_t px2);
+static inline uint32_t rgb565_spread_lo(uint32_t px2);
+static inline uint32_t rgb565_spread_hi(uint32_t px2);
+static inline uint32_t rgb565_mix_pair(uint32_t fg_lo, uint32_t fg_hi, uint32_t bg2, uint32_t mix_lo, uint32_t mix_hi);
+static inline uint32_t rgb565_load_pair(const lv_color_t * src);
+#endif /*BLEND_RGB565_PAIRS*/
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -239,7 +268,7 @@ static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_
     }
 }
 
-static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
+static LV_ATTRIBUTE_BLEND_IRAM void fill_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                               lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
                                               const lv_opa_t * mask, lv_coord_t mask_stride)
 {
@@ -292,6 +321,29 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
         uint32_t c32 = color.full + ((uint32_t)color.full << 16);
 #endif
         /*Only the mask matters*/
+#if BLEND_RGB565_PAIRS
+        if(opa >= LV_OPA_MAX) {
+            uint32_t fg = rgb565_spread_lo(rgb565_pair_native(c32));
+            for(y = 0; y < h; y++) {
+                x = 0;
+                if((lv_uintptr_t)dest_buf & 0x3) {
+                    dest_buf[0] = lv_color_mix(color, dest_buf[0], mask[0]);
+                    x = 1;
+                }
+
+                for(; x < w - 1; x += 2) {
+                    uint32_t * d32 = (uint32_t *)&dest_buf[x];
+                    uint32_t mask2 = mask[x] | ((uint32_t)mask[x + 1] << 8);
+                    if(mask2 == 0xFFFF) *d32 = c32;
+                    else if(mask2) *d32 = rgb565_mix_pair(fg, fg, *d32, mask[x], mask[x + 1]);
+                }
+
+                if(x < w) dest_buf[x] = lv_color_mix(color, dest_buf[x], mask[x]);
+                dest_buf += dest_stride;
+                mask += mask_stride;
+            }
+        }
+#else
         if(opa >= LV_OPA_MAX) {
             int32_t x_end4 = w - 4;
             for(y = 0; y < h; y++) {
@@ -342,7 +394,37 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
                 mask += (mask_stride - w);
             }
         }
+#endif /*BLEND_RGB565_PAIRS*/
         /*With opacity*/
+#if BLEND_RGB565_PAIRS
+        else {
+            uint32_t fg = rgb565_spread_lo(rgb565_pair_native(c32));
+            for(y = 0; y < h; y++) {
+                x = 0;
+                if((lv_uintptr_t)dest_buf & 0x3) {
+                    lv_opa_t opa_tmp = mask[0] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[0] * opa) >> 8;
+                    dest_buf[0] = lv_color_mix(color, dest_buf[0], opa_tmp);
+                    x = 1;
+                }
+
+                for(; x < w - 1; x += 2) {
+                    uint32_t mask2 = mask[x] | ((uint32_t)mask[x + 1] << 8);
+                    if(mask2 == 0) continue;
+                    uint32_t opa_lo = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+                    uint32_t opa_hi = mask[x + 1] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x + 1] * opa) >> 8;
+                    uint32_t * d32 = (uint32_t *)&dest_buf[x];
+                    *d32 = rgb565_mix_pair(fg, fg, *d32, opa_lo, opa_hi);
+                }
+
+                if(x < w) {
+                    lv_opa_t opa_tmp = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+                    dest_buf[x] = lv_color_mix(color, dest_buf[x], opa_tmp);
+                }
+                dest_buf += dest_stride;
+                mask += mask_stride;
+            }
+        }
+#else
         else {
             /*Buffer the result color to avoid recalculating the same color*/
             lv_color_t last_dest_color;
@@ -371,6 +453,7 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
                 mask += (mask_stride - w);
             }
         }
+#endif /*BLEND_RGB565_PAIRS*/
     }
 }
 
@@ -638,7 +721,7 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
     }
 }
 
-static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
+static void LV_ATTRIBUTE_BLEND_IRAM map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                              lv_coord_t dest_stride, const lv_color_t * src_buf,
                                              lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
                                              lv_coord_t mask_stride)
@@ -661,9 +744,25 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
         }
         else {
             for(y = 0; y < h; y++) {
+#if BLEND_RGB565_PAIRS
+                x = 0;
+                if((lv_uintptr_t)dest_buf & 0x3) {
+                    dest_buf[0] = lv_color_mix(src_buf[0], dest_buf[0], opa);
+                    x = 1;
+                }
+
+                for(; x < w - 1; x += 2) {
+                    uint32_t * d32 = (uint32_t *)&dest_buf[x];
+                    uint32_t src2 = rgb565_pair_native(rgb565_load_pair(&src_buf[x]));
+                    *d32 = rgb565_mix_pair(rgb565_spread_lo(src2), rgb565_spread_hi(src2), *d32, opa, opa);
+                }
+
+                if(x < w) dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
+#else
                 for(x = 0; x < w; x++) {
                     dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
                 }
+#endif
                 dest_buf += dest_stride;
                 src_buf += src_stride;
             }
@@ -673,6 +772,32 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
     else {
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
+#if BLEND_RGB565_PAIRS
+            for(y = 0; y < h; y++) {
+                x = 0;
+                if((lv_uintptr_t)dest_buf & 0x3) {
+                    dest_buf[0] = lv_color_mix(src_buf[0], dest_buf[0], mask[0]);
+                    x = 1;
+                }
+
+                for(; x < w - 1; x += 2) {
+                    uint32_t * d32 = (uint32_t *)&dest_buf[x];
+                    uint32_t mask2 = mask[x] | ((uint32_t)mask[x + 1] << 8);
+                    if(mask2 == 0xFFFF) {
+                        *d32 = rgb565_load_pair(&src_buf[x]);
+                    }
+                    else if(mask2) {
+                        uint32_t src2 = rgb565_pair_native(rgb565_load_pair(&src_buf[x]));
+                        *d32 = rgb565_mix_pair(rgb565_spread_lo(src2), rgb565_spread_hi(src2), *d32, mask[x], mask[x + 1]);
+                    }
+                }
+
+                if(x < w) dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], mask[x]);
+                dest_buf += dest_stride;
+                src_buf += src_stride;
+                mask += mask_stride;
+            }
+#else
             int32_t x_end4 = w - 4;
 
             for(y = 0; y < h; y++) {
@@ -715,16 +840,41 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
                 src_buf += src_stride;
                 mask += mask_stride;
             }
+#endif /*BLEND_RGB565_PAIRS*/
         }
         /*Handle opa and mask values too*/
         else {
             for(y = 0; y < h; y++) {
+#if BLEND_RGB565_PAIRS
+                x = 0;
+                if((lv_uintptr_t)dest_buf & 0x3) {
+                    lv_opa_t opa_tmp = mask[0] >= LV_OPA_MAX ? opa : ((opa * mask[0]) >> 8);
+                    dest_buf[0] = lv_color_mix(src_buf[0], dest_buf[0], opa_tmp);
+                    x = 1;
+                }
+
+                for(; x < w - 1; x += 2) {
+                    uint32_t mask2 = mask[x] | ((uint32_t)mask[x + 1] << 8);
+                    if(mask2 == 0) continue;
+                    uint32_t opa_lo = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+                    uint32_t opa_hi = mask[x + 1] >= LV_OPA_MAX ? opa : ((opa * mask[x + 1]) >> 8);
+                    uint32_t * d32 = (uint32_t *)&dest_buf[x];
+                    uint32_t src2 = rgb565_pair_native(rgb565_load_pair(&src_buf[x]));
+                    *d32 = rgb565_mix_pair(rgb565_spread_lo(src2), rgb565_spread_hi(src2), *d32, opa_lo, opa_hi);
+                }
+
+                if(x < w) {
+                    lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+                    dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa_tmp);
+                }
+#else
                 for(x = 0; x < w; x++) {
                     if(mask[x]) {
                         lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
                         dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa_tmp);
                     }
                 }
+#endif
                 dest_buf += dest_stride;
                 src_buf += src_stride;
                 mask += mask_stride;
@@ -1050,3 +1200,53 @@ static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color
 }
 
 #endif
+
+#if BLEND_RGB565_PAIRS
+static inline uint32_t rgb565_pair_native(uint32_t px2)
+{
+#if LV_COLOR_16_SWAP
+    return ((px2 & 0x00FF00FFU) << 8) | ((px2 >> 8) & 0x00FF00FFU);
+#else
+    return px2;
+#endif
+}
+
+/*Spread the low/high pixel of a native (not swapped) pair*/
+static inline uint32_t rgb565_spread_lo(uint32_t px2)
+{
+    return ((px2 & 0xFFFFU) | (px2 << 16)) & RGB565_SPREAD_MASK;
+}
+
+static inline uint32_t rgb565_spread_hi(uint32_t px2)
+{
+    return ((px2 & 0xFFFF0000U) | (px2 >> 16)) & RGB565_SPREAD_MASK;
+}
+
+/**
+ * Mix a pair of destination pixels with spread foreground colors.
+ * @param fg_lo     foreground of the low pixel, spread
+ * @param fg_hi     foreground of the high pixel, spread
+ * @param bg2       the destination pair as stored in the buffer
+ * @param mix_lo    ratio of the low pixel (0..255 as in `lv_color_mix()`)
+ * @param mix_hi    ratio of the high pixel
+ * @return          the mixed pair as it should be stored in the buffer
+ */
+static inline uint32_t LV_ATTRIBUTE_BLEND_IRAM rgb565_mix_pair(uint32_t fg_lo, uint32_t fg_hi, uint32_t bg2,
+                                                             uint32_t mix_lo, uint32_t mix_hi)
+{
+    bg2 = rgb565_pair_native(bg2);
+    uint32_t bg_lo = rgb565_spread_lo(bg2);
+    uint32_t bg_hi = rgb565_spread_hi(bg2);
+    uint32_t lo = ((((fg_lo - bg_lo) * ((mix_lo + 4) >> 3)) >> 5) + bg_lo) & RGB565_SPREAD_MASK;
+    uint32_t hi = ((((fg_hi - bg_hi) * ((mix_hi + 4) >> 3)) >> 5) + bg_hi) & RGB565_SPREAD_MASK;
+    lo = (lo | (lo >> 16)) & 0xFFFFU;
+    hi = (hi | (hi >> 16)) & 0xFFFFU;
+    return rgb565_pair_native(lo | (hi << 16));
+}
+
+/*Load two source pixels (the source has no alignment guarantee) in buffer byte order*/
+static inline uint32_t rgb565_load_pair(const lv_color_t * src)
+{
+    return (uint32_t)src[0].full | ((uint32_t)src[1].full << 16);
+}
+#endif /*BLEND_RGB565_PAIRS*/
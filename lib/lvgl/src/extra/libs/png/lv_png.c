@@ -28,6 +28,7 @@ static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * sr
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
+static uint8_t * keep_frame(lv_img_decoder_dsc_t * dsc, uint8_t * img, uint32_t px_cnt);
 
 /**********************
  *  STATIC VARIABLES
@@ -182,7 +183,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 
             /*Convert the image to the system's color depth*/
             convert_color_depth(img_data,  png_width * png_height);
-            dsc->img_data = img_data;
+            dsc->img_data = keep_frame(dsc, img_data, png_width * png_height);
             return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
         }
     }
@@ -205,7 +206,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         /*Convert the image to the system's color depth*/
         convert_color_depth(img_data,  png_width * png_height);
 
-        dsc->img_data = img_data;
+        dsc->img_data = keep_frame(dsc, img_data, png_width * png_height);
         return LV_RES_OK;     /*Return with its pointer*/
     }
 
@@ -219,11 +220,40 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
 {
     LV_UNUSED(decoder); /*Unused*/
     if(dsc->img_data) {
-        lv_mem_free((uint8_t *)dsc->img_data);
+        /*`user_data` marks a frame moved by `keep_frame`*/
+        if(dsc->user_data) lv_img_cache_data_free((uint8_t *)dsc->img_data);
+        else lv_mem_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
+        dsc->user_data = NULL;
     }
 }
 
+/**
+ * Move the converted frame to memory from `lv_img_cache_data_alloc` (e.g. external RAM when
+ * LV_IMG_CACHE_DATA_ALLOC is set), keeping only the bytes used by the system's color depth.
+ * Keeps the decoder's buffer if there is no such allocator or it fails.
+ */
+static uint8_t * keep_frame(lv_img_decoder_dsc_t * dsc, uint8_t * img, uint32_t px_cnt)
+{
+    uint32_t size = px_cnt * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    dsc->cache_size = px_cnt * 4;
+
+#ifdef LV_IMG_CACHE_DATA_ALLOC
+    uint8_t * frame = lv_img_cache_data_alloc(size);
+    if(frame) {
+        lv_memcpy(frame, img, size);
+        lv_mem_free(img);
+        dsc->user_data = frame;
+        dsc->cache_size = size;
+        return frame;
+    }
+#else
+    LV_UNUSED(size);
+#endif
+
+    return img;
+}
+
 /**
  * If the display is not in 32 bit format (ARGB888) then covert the image to the current color depth
  * @param img the ARGB888 image
@@ -1,5 +1,5 @@
 #include "../lv_conf_internal.h"
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 || defined(LV_MEM_TLSF_POOL_SIZE)
 
 #include <limits.h>
 #include "lv_tlsf.h"
@@ -10,7 +10,11 @@
 #undef  printf
 #define printf LV_LOG_ERROR
 
-#define TLSF_MAX_POOL_SIZE LV_MEM_SIZE
+#if LV_MEM_CUSTOM == 0
+    #define TLSF_MAX_POOL_SIZE LV_MEM_SIZE
+#else
+    #define TLSF_MAX_POOL_SIZE LV_MEM_TLSF_POOL_SIZE  /*Pool of the custom allocator*/
+#endif
 
 #if !defined(_DEBUG)
     #define _DEBUG 0
@@ -1242,4 +1246,4 @@ void * lv_tlsf_realloc(lv_tlsf_t tlsf, void * ptr, size_t size)
     return p;
 }
 
-#endif /* LV_MEM_CUSTOM == 0 */
+#endif /* LV_MEM_CUSTOM == 0 || defined(LV_MEM_TLSF_POOL_SIZE) */
@@ -5,13 +5,11 @@
  */
 
 #include "button_manager.h"
-#include "jornada_manager.h"
-#include "ignicao_control.h"
+#include "ui/common/theme.h"
 #include "esp_bsp.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include "esp_timer.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
 #include <algorithm>
 #include <cstring>
 #include <cstdio>
@@ -46,12 +44,11 @@ ButtonManager::ButtonManager() :
     statusUpdateTimer(nullptr),
     statusTimer(nullptr),
     messageExpireTime(0),
-    activePopup(nullptr),
     lastPopupResult(POPUP_RESULT_NONE),
     nextButtonId(1),
+    bakedFaces_(BUTTON_FACE_BAKE),
     lastButtonClickTime_(0),
-    lastButtonClickedId_(-1),
-    retryTimer(nullptr) {
+    lastButtonClickedId_(-1) {
     
     // Inicializar configuração de mensagem
     currentMessageConfig.color = lv_color_hex(0x888888);
@@ -59,24 +56,17 @@ ButtonManager::ButtonManager() :
     currentMessageConfig.timeoutMs = 0;
     currentMessageConfig.hasTimeout = false;
     
-    // Criar mutex para sincronização
-    creationMutex = xSemaphoreCreateMutex();
-    
     // Inicializar grade
-    for (int x = 0; x < GRID_COLS; x++) {
-        for (int y = 0; y < GRID_ROWS; y++) {
-            gridOccupancy[x][y] = false;
-        }
-    }
+    clearGrid();
 }
 
 ButtonManager::~ButtonManager() {
+    reset();
+}
+
+void ButtonManager::reset(bool deleteScreen) {
     if (bsp_display_lock(200)) {
         // Limpar timers LVGL (requer display lock)
-        if (retryTimer) {
-            lv_timer_del(retryTimer);
-            retryTimer = nullptr;
-        }
         if (statusUpdateTimer) {
             lv_timer_del(statusUpdateTimer);
             statusUpdateTimer = nullptr;
@@ -87,21 +77,30 @@ ButtonManager::~ButtonManager() {
         }
 
         // Limpar botoes (sem deletar objetos LVGL — a tela pai sera deletada abaixo)
+        // Armazenamento inline: limpar nao libera nem realoca memoria
         buttons.clear();
 
         // Deletar screen LVGL (deleta todos os filhos: gridContainer, statusBar, botoes)
-        if (screen != nullptr && screen != lv_scr_act()) {
+        if (deleteScreen && screen != nullptr && screen != lv_scr_act()) {
             lv_obj_del(screen);
         }
         screen = nullptr;
+        gridContainer = nullptr;
+        statusBar = nullptr;
+        statusIgnicao = nullptr;
+        statusTempoIgnicao = nullptr;
+        statusTempoJornada = nullptr;
+        statusMensagem = nullptr;
+        PopupService::getInstance()->closeOwnedBy(this);
+        popupCallback = nullptr;
 
-        bsp_display_unlock();
-    }
+        clearGrid();
 
-    // Deletar mutex
-    if (creationMutex) {
-        vSemaphoreDelete(creationMutex);
-        creationMutex = nullptr;
+        lastButtonClickTime_ = 0;
+        lastButtonClickedId_ = -1;
+        bakedFaces_ = BUTTON_FACE_BAKE;
+
+        bsp_display_unlock();
     }
 }
 
@@ -123,6 +122,59 @@ void ButtonManager::destroyInstance() {
     }
 }
 
+// ============================================================================
+// POOL DE INSTANCIAS (TELAS)
+// ============================================================================
+
+ButtonManager* ButtonManager::pool[BUTTON_MANAGER_POOL_SIZE] = {};
+bool ButtonManager::poolInUse[BUTTON_MANAGER_POOL_SIZE] = {};
+
+ButtonManager* ButtonManager::acquire() {
+    for (int i = 0; i < BUTTON_MANAGER_POOL_SIZE; i++) {
+        if (poolInUse[i]) continue;
+
+        if (pool[i] == nullptr) {
+            pool[i] = new ButtonManager();
+        }
+        poolInUse[i] = true;
+        return pool[i];
+    }
+
+    ESP_LOGE(TAG, "Pool de ButtonManager esgotado (%d)", BUTTON_MANAGER_POOL_SIZE);
+    return nullptr;
+}
+
+void ButtonManager::release(ButtonManager* mgr, bool screenDeleted) {
+    for (int i = 0; i < BUTTON_MANAGER_POOL_SIZE; i++) {
+        if (pool[i] == mgr && poolInUse[i]) {
+            mgr->reset(!screenDeleted);
+            poolInUse[i] = false;
+            return;
+        }
+    }
+
+    ESP_LOGW(TAG, "release() de instancia fora do pool");
+}
+
+void ButtonManager::suspend() {
+    // O popup fica em lv_layer_top(): nao pode sobrar sobre a proxima tela
+    closePopup();
+
+    if (bsp_display_lock(100)) {
+        if (statusUpdateTimer) lv_timer_pause(statusUpdateTimer);
+        if (statusTimer) lv_timer_pause(statusTimer);
+        bsp_display_unlock();
+    }
+}
+
+void ButtonManager::resume() {
+    if (bsp_display_lock(100)) {
+        if (statusUpdateTimer) lv_timer_resume(statusUpdateTimer);
+        if (statusTimer) lv_timer_resume(statusTimer);
+        bsp_display_unlock();
+    }
+}
+
 // ============================================================================
 // INICIALIZAÇÃO
 // ============================================================================
@@ -136,10 +188,8 @@ void ButtonManager::createScreen() {
         // Limpar estado anterior (objetos LVGL sao filhos da tela antiga,
         // serao deletados automaticamente quando a tela antiga for removida)
         buttons.clear();
-        for (int x = 0; x < GRID_COLS; x++)
-            for (int y = 0; y < GRID_ROWS; y++)
-                gridOccupancy[x][y] = false;
-        nextButtonId = 0;
+        clearGrid();
+        nextButtonId = 1;
 
         screen = lv_obj_create(NULL);
         lv_obj_set_style_bg_color(screen, lv_color_hex(0x1a1a1a), LV_PART_MAIN);
@@ -211,314 +261,231 @@ void ButtonManager::createScreen() {
 }
 
 // ============================================================================
-// SISTEMA ROBUSTO DE CRIAÇÃO DE BOTÕES
+// CONSTRUÇÃO DECLARATIVA DA GRADE
 // ============================================================================
 
-int ButtonManager::addButton(int gridX, int gridY, const char* label, ButtonIcon icon,
-                             const char* image_src,
-                             lv_color_t color, std::function<void(int)> callback,
-                             int width, int height, lv_color_t textColor, 
-                             const lv_font_t* textFont) {
-    
-    // Tomar mutex
-    if (xSemaphoreTake(creationMutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        esp_rom_printf("ERRO: Não foi possível obter mutex para criação de botão");
-        return -1;
-    }
-    
-    // Criar estrutura do botão pendente
-    PendingButton pending;
-    pending.gridX = gridX;
-    pending.gridY = gridY;
-    pending.label = label;
-    pending.icon = icon;
-    pending.image_src = image_src;
-    pending.color = color;
-    pending.callback = callback;
-    pending.width = width;
-    pending.height = height;
-    pending.textColor = textColor;
-    pending.textFont = textFont;
-    pending.assignedId = nextButtonId++;
-    pending.retryCount = 0;
-    
-    // Tentar criar imediatamente
-    int createdId = addButtonInternal(pending);
-    
-    if (createdId > 0) {
-        esp_rom_printf("✓ Botão '%s' criado com sucesso (ID: %d)\n", label, createdId);
-        xSemaphoreGive(creationMutex);
-        return createdId;
+int ButtonManager::buildGrid(const ButtonBatchDef* defs, size_t count, int* outIds) {
+    if (outIds) {
+        for (size_t i = 0; i < count; i++) outIds[i] = -1;
     }
-    
-    // Se falhou, adicionar à lista de pendentes
-    esp_rom_printf("⚠ Botão '%s' adicionado à fila de retry\n", label);
-    pendingButtons.push_back(pending);
-    
-    // Iniciar timer de retry se não estiver rodando
-    if (!retryTimer) {
-        retryTimer = lv_timer_create(retryTimerCallback, RETRY_DELAY_MS, this);
+    if (!defs || count == 0) {
+        return 0;
     }
-    
-    xSemaphoreGive(creationMutex);
-    
-    // Retorna o ID reservado (mesmo que ainda não criado)
-    return pending.assignedId;
-}
 
-int ButtonManager::addButtonInternal(const PendingButton& btn) {
-    // Validações básicas
-    if (!isPositionValid(btn.gridX, btn.gridY) || 
-        !isPositionValid(btn.gridX + btn.width - 1, btn.gridY + btn.height - 1)) {
-        esp_rom_printf("ERRO: Posição inválida para botão '%s'\n", btn.label);
-        return -1;
-    }
-    
-    if (!isGridPositionFree(btn.gridX, btn.gridY, btn.width, btn.height)) {
-        esp_rom_printf("AVISO: Posição ocupada para botão '%s', limpando...\n", btn.label);
-        markGridPosition(btn.gridX, btn.gridY, btn.width, btn.height, false);
-        vTaskDelay(pdMS_TO_TICKS(10));
+    int64_t startUs = esp_timer_get_time();
+
+    // 1) Valida o layout inteiro antes de tocar no LVGL
+    bool occupancy[GRID_COLS][GRID_ROWS];
+    for (int x = 0; x < GRID_COLS; x++)
+        for (int y = 0; y < GRID_ROWS; y++)
+            occupancy[x][y] = gridOwner[x][y] >= 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const ButtonBatchDef& def = defs[i];
+
+        if (def.width < 1 || def.height < 1 ||
+            !isPositionValid(def.gridX, def.gridY) ||
+            !isPositionValid(def.gridX + def.width - 1, def.gridY + def.height - 1)) {
+            ESP_LOGE(TAG, "Layout invalido: '%s' fora da grade (%d,%d %dx%d)",
+                     def.label ? def.label : "", def.gridX, def.gridY, def.width, def.height);
+            return 0;
+        }
+
+        for (int cx = def.gridX; cx < def.gridX + def.width; cx++) {
+            for (int cy = def.gridY; cy < def.gridY + def.height; cy++) {
+                if (occupancy[cx][cy]) {
+                    ESP_LOGE(TAG, "Layout invalido: '%s' sobrepoe celula (%d,%d)",
+                             def.label ? def.label : "", cx, cy);
+                    return 0;
+                }
+                occupancy[cx][cy] = true;
+            }
+        }
     }
-    
-    // Tentar obter lock do display com timeout maior
-    if (!bsp_display_lock(200)) {
-        esp_rom_printf("ERRO: Não foi possível obter lock do display para '%s'\n", btn.label);
-        return -1;
+
+    // 2) Cria todos os objetos em uma unica passada com o lock
+    if (!bsp_display_lock(0)) {
+        return 0;
     }
-    
-    // Verificar se o display está pronto
+
     if (!gridContainer || !lv_obj_is_valid(gridContainer)) {
-        esp_rom_printf("ERRO: Container de grade não está pronto!");
+        ESP_LOGE(TAG, "Container de grade nao esta pronto");
         bsp_display_unlock();
-        return -1;
-    }
-    
-    // Criar novo botão
-    GridButton newButton;
-    newButton.id = btn.assignedId;
-        newButton.gridX = btn.gridX;
-        newButton.gridY = btn.gridY;
-        newButton.width = btn.width;
-        newButton.height = btn.height;
-        newButton.label = btn.label;
-        newButton.icon = btn.icon;
-        newButton.color = btn.color;
-        newButton.callback = btn.callback;
+        return 0;
+    }
+
+    size_t heapBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    int created = 0;
+    for (size_t i = 0; i < count; i++) {
+        const ButtonBatchDef& def = defs[i];
+        int buttonId = nextButtonId++;
+
+        GridButton newButton;
+        newButton.id = buttonId;
+        newButton.gridX = def.gridX;
+        newButton.gridY = def.gridY;
+        newButton.width = def.width;
+        newButton.height = def.height;
+        newButton.label = def.label;
+        newButton.icon = def.icon;
+        newButton.color = def.color;
+        newButton.imageSrc = def.image_src;
+        newButton.textColor = def.textColor;
+        newButton.textFont = def.textFont;
+        newButton.callback = def.callback;
         newButton.enabled = true;
-        
-        // Calcular posição real
-        int realX = btn.gridX * (BUTTON_WIDTH + BUTTON_MARGIN);
-        int realY = btn.gridY * (BUTTON_HEIGHT + BUTTON_MARGIN);
-        int realWidth = (BUTTON_WIDTH * btn.width) + (BUTTON_MARGIN * (btn.width - 1));
-        int realHeight = (BUTTON_HEIGHT * btn.height) + (BUTTON_MARGIN * (btn.height - 1));
-        
-        // Criar botão LVGL
-        newButton.obj = lv_btn_create(gridContainer);
+        newButton.obj = createButtonObject(def, buttonId);
+
         if (!newButton.obj) {
-            esp_rom_printf("ERRO: Falha ao criar objeto LVGL para '%s'\n", btn.label);
-            bsp_display_unlock();
-            return -1;
-        }
-        
-        // Configurar botão
-        lv_obj_set_pos(newButton.obj, realX, realY);
-        lv_obj_set_size(newButton.obj, realWidth, realHeight);
-        lv_obj_set_style_bg_color(newButton.obj, btn.color, LV_PART_MAIN);
-        lv_obj_set_style_radius(newButton.obj, 10, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(newButton.obj, LV_OPA_COVER, LV_PART_MAIN);
-        
-        lv_obj_set_flex_flow(newButton.obj, LV_FLEX_FLOW_COLUMN);
-        lv_obj_set_flex_align(newButton.obj, LV_FLEX_ALIGN_CENTER, 
-                             LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-        
-        // Adicionar imagem ou ícone
-        bool image_loaded = false;
-        if (btn.image_src != nullptr && strlen(btn.image_src) > 0) {
-            lv_img_header_t header;
-            lv_res_t res = lv_img_decoder_get_info(btn.image_src, &header);
-            
-            if (res == LV_RES_OK && header.w > 0 && header.h > 0) {
-                lv_obj_t* img = lv_img_create(newButton.obj);
-                lv_img_set_src(img, btn.image_src);
-                lv_obj_set_style_bg_opa(img, LV_OPA_TRANSP, LV_PART_MAIN);
-                lv_obj_set_style_border_width(img, 0, LV_PART_MAIN);
-                lv_obj_set_style_pad_all(img, 0, LV_PART_MAIN);
-                lv_obj_align(img, LV_ALIGN_CENTER, 0, -10);
-                image_loaded = true;
-                esp_rom_printf("✓ Imagem carregada: %s\n", btn.image_src);
-            }
+            ESP_LOGE(TAG, "Falha ao criar objeto LVGL para '%s'", newButton.label.c_str());
+            continue;
         }
-        
-        if (!image_loaded && btn.icon != ICON_NONE) {
-            createIconForButton(btn.icon, newButton.obj, btn.textColor, &lv_font_montserrat_38);
+
+        // Vetor cheio: descarta o objeto (a face e liberada no LV_EVENT_DELETE)
+        // e para, os demais tambem nao caberiam
+        if (!buttons.push_back(newButton)) {
+            ESP_LOGE(TAG, "Sem espaco para '%s' (%d botoes)",
+                     newButton.label.c_str(), (int)buttons.size());
+            lv_obj_del(newButton.obj);
+            break;
         }
-        
-        // Adicionar label
-        lv_obj_t* labelObj = lv_label_create(newButton.obj);
-        lv_label_set_text(labelObj, btn.label);
-        lv_obj_set_style_text_color(labelObj, btn.textColor, LV_PART_MAIN);
-        lv_obj_set_style_text_font(labelObj, btn.textFont, LV_PART_MAIN);
-        lv_obj_align(labelObj, LV_ALIGN_BOTTOM_MID, 0, -5);
-        
-        // Armazenar ponteiro do ButtonManager no objeto LVGL para isolamento entre telas
-        lv_obj_set_user_data(newButton.obj, this);
+        markGridPosition(def.gridX, def.gridY, def.width, def.height, buttonId);
 
-        // Adicionar callback
-        lv_obj_add_event_cb(newButton.obj, buttonEventHandler, LV_EVENT_CLICKED,
-                           (void*)(intptr_t)newButton.id);
-        
-        // Marcar posição como ocupada
-        markGridPosition(btn.gridX, btn.gridY, btn.width, btn.height, true);
-        
-        // Adicionar ao vetor de botões
-        buttons.push_back(newButton);
-        
-        bsp_display_unlock();
-        
-        // Verificar se foi criado corretamente
-        if (verifyButtonCreation(newButton.id)) {
-            return newButton.id;
-    } else {
-        esp_rom_printf("ERRO: Botão '%s' criado mas verificação falhou\n", btn.label);
-        return -1;
+        if (outIds) outIds[i] = buttonId;
+        created++;
     }
-}
 
-bool ButtonManager::verifyButtonCreation(int buttonId) {
-    auto it = std::find_if(buttons.begin(), buttons.end(),
-                          [buttonId](const GridButton& btn) { return btn.id == buttonId; });
-    
-    if (it == buttons.end()) {
-        return false;
+    size_t heapAfter = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    bsp_display_unlock();
+
+    ESP_LOGI(TAG, "Grade construida: %d/%d botoes em %lld us, heap %d bytes",
+             created, (int)count, (long long)(esp_timer_get_time() - startUs),
+             (int)(heapBefore - heapAfter));
+
+    if (bakedFaces_) {
+        ButtonFaceStats fs = ButtonFaceCache::getInstance()->getStats();
+        ESP_LOGI(TAG, "Faces: %lu botoes, %lu imagens, %lu KB na PSRAM",
+                 (unsigned long)fs.faces, (unsigned long)fs.images,
+                 (unsigned long)(fs.bytes / 1024));
     }
-    
-    // Verificar se o objeto LVGL é válido
-    if (!it->obj || !lv_obj_is_valid(it->obj)) {
-        return false;
+
+    return created;
+}
+
+lv_obj_t* ButtonManager::createButtonObject(const ButtonBatchDef& def, int buttonId) {
+    // Chamado com o lock do display tomado
+    lv_obj_t* btn = createButtonTree(def);
+    if (!btn) {
+        return nullptr;
     }
-    
-    // Verificar se tem filhos (label, ícone, etc)
-    if (lv_obj_get_child_cnt(it->obj) == 0) {
-        return false;
+
+    // Modo de faces: a propria arvore e o modelo; sem slot/PSRAM fica como arvore
+    if (bakedFaces_) {
+        ButtonFaceCache* faces = ButtonFaceCache::getInstance();
+        ButtonFace* face = faces->acquire();
+        if (face && faces->bake(face, btn, BUTTON_FACE_MASK(BUTTON_FACE_NORMAL) |
+                                           BUTTON_FACE_MASK(BUTTON_FACE_PRESSED))) {
+            faces->attach(btn, face);
+        } else {
+            faces->release(face);
+        }
     }
-    
-    return true;
+
+    // Armazenar ponteiro do ButtonManager no objeto LVGL para isolamento entre telas
+    lv_obj_set_user_data(btn, this);
+    lv_obj_add_event_cb(btn, buttonEventHandler, LV_EVENT_CLICKED, (void*)(intptr_t)buttonId);
+
+    return btn;
 }
 
-void ButtonManager::processPendingButtons() {
-    if (xSemaphoreTake(creationMutex, pdMS_TO_TICKS(50)) != pdTRUE) {
-        return;
+lv_obj_t* ButtonManager::createButtonTree(const ButtonBatchDef& def) {
+    // Botao completo (estilos, imagem/icone, label), sem eventos
+    GridCell cell = { (int8_t)def.gridX, (int8_t)def.gridY, (int8_t)def.width, (int8_t)def.height };
+    GridRect r = AppGridGeometry::rect(cell);
+
+    lv_obj_t* btn = lv_btn_create(gridContainer);
+    if (!btn) {
+        return nullptr;
     }
-    
-    std::vector<PendingButton> stillPending;
-    
-    for (auto& pending : pendingButtons) {
-        pending.retryCount++;
-        
-        if (pending.retryCount > MAX_RETRY_ATTEMPTS) {
-            esp_rom_printf("✗ Botão '%s' falhou após %d tentativas\n", 
-                         pending.label, MAX_RETRY_ATTEMPTS);
-            continue;
-        }
-        
-        esp_rom_printf("↻ Retry %d/%d para botão '%s'\n", 
-                     pending.retryCount, MAX_RETRY_ATTEMPTS, pending.label);
-        
-        int createdId = addButtonInternal(pending);
-        
-        if (createdId > 0) {
-            esp_rom_printf("✓ Botão '%s' criado com sucesso após retry\n", pending.label);
-        } else {
-            stillPending.push_back(pending);
+
+    Theme* theme = Theme::getInstance();
+    theme->applyGridButtonStyle(btn, def.color);
+    lv_obj_set_pos(btn, r.x, r.y);
+    lv_obj_set_size(btn, r.w, r.h);
+
+    // Adicionar imagem ou ícone
+    bool image_loaded = false;
+    if (def.image_src != nullptr && def.image_src[0] != '\0') {
+        lv_img_header_t header;
+        lv_res_t res = lv_img_decoder_get_info(def.image_src, &header);
+
+        if (res == LV_RES_OK && header.w > 0 && header.h > 0) {
+            lv_obj_t* img = lv_img_create(btn);
+            theme->applyImageStyle(img);
+            lv_img_set_src(img, def.image_src);
+            image_loaded = true;
         }
     }
-    
-    pendingButtons = stillPending;
-    
-    // Se não há mais pendentes, parar timer
-    if (pendingButtons.empty() && retryTimer) {
-        lv_timer_del(retryTimer);
-        retryTimer = nullptr;
-        esp_rom_printf("✓ Todos os botões foram criados com sucesso!");
+
+    if (!image_loaded && def.icon != ICON_NONE) {
+        createIconForButton(def.icon, btn, def.textColor, &lv_font_montserrat_38);
     }
-    
-    xSemaphoreGive(creationMutex);
+
+    // Adicionar label
+    lv_obj_t* labelObj = lv_label_create(btn);
+    lv_label_set_text(labelObj, def.label ? def.label : "");
+    theme->applyLabelStyle(labelObj, def.textColor, def.textFont);
+
+    return btn;
 }
 
-void ButtonManager::retryTimerCallback(lv_timer_t* timer) {
-    ButtonManager* mgr = (ButtonManager*)timer->user_data;
-    if (mgr) {
-        mgr->processPendingButtons();
+bool ButtonManager::rebakeFace(GridButton& btn, bool withDisabled) {
+    // Chamado com o lock do display tomado
+    ButtonFace* face = ButtonFaceCache::faceOf(btn.obj);
+    if (!face) {
+        return false;
     }
-}
 
-std::vector<int> ButtonManager::addButtonBatch(const std::vector<ButtonBatchDef>& buttonDefs) {
-    std::vector<int> ids;
-    
-    esp_rom_printf("Criando lote de %d botões...\n", buttonDefs.size());
-    
-    for (const auto& def : buttonDefs) {
-        int id = addButton(def.gridX, def.gridY, def.label, def.icon,
-                          def.image_src, def.color, def.callback,
-                          def.width, def.height, def.textColor, def.textFont);
-        ids.push_back(id);
+    // Modelo temporario com os dados atuais, no mesmo lugar do botao
+    ButtonBatchDef def = {btn.gridX, btn.gridY, btn.label.c_str(), btn.icon, btn.imageSrc,
+                          btn.color, nullptr, btn.width, btn.height, btn.textColor, btn.textFont};
+    lv_obj_t* stamp = createButtonTree(def);
+    if (!stamp) {
+        return true;
     }
-    
-    // Aguardar processamento de pendentes
-    int waitTime = 0;
-    while (getPendingButtonCount() > 0 && waitTime < 2000) {
-        vTaskDelay(pdMS_TO_TICKS(50));
-        waitTime += 50;
+
+    uint8_t mask = BUTTON_FACE_MASK(BUTTON_FACE_NORMAL) | BUTTON_FACE_MASK(BUTTON_FACE_PRESSED);
+    if (withDisabled || face->has(BUTTON_FACE_DISABLED)) {
+        mask |= BUTTON_FACE_MASK(BUTTON_FACE_DISABLED);
     }
-    
-    if (getPendingButtonCount() == 0) {
-        esp_rom_printf("✓ Lote de botões criado com sucesso!");
-    } else {
-        esp_rom_printf("⚠ %d botões ainda pendentes após timeout\n", getPendingButtonCount());
+    if (!ButtonFaceCache::getInstance()->bake(face, stamp, mask)) {
+        ESP_LOGW(TAG, "Falha ao refazer a face do botao %d", btn.id);
     }
-    
-    return ids;
+    lv_obj_del(stamp);
+
+    lv_obj_refresh_ext_draw_size(btn.obj);
+    lv_obj_invalidate(btn.obj);
+    return true;
 }
 
-bool ButtonManager::waitForAllButtons(const std::vector<int>& buttonIds, int timeoutMs) {
-    unsigned long startTime = millis();
-    
-    while ((millis() - startTime) < timeoutMs) {
-        bool allCreated = true;
-        
-        for (int id : buttonIds) {
-            if (!verifyButtonCreation(id)) {
-                allCreated = false;
-                break;
-            }
-        }
-        
-        if (allCreated) {
-            return true;
-        }
-        
-        vTaskDelay(pdMS_TO_TICKS(10));
-    }
-    
-    return false;
+int ButtonManager::addButton(int gridX, int gridY, const char* label, ButtonIcon icon,
+                             const char* image_src,
+                             lv_color_t color, ButtonCallback callback,
+                             int width, int height, lv_color_t textColor,
+                             const lv_font_t* textFont) {
+    ButtonBatchDef def = {gridX, gridY, label, icon, image_src, color, callback,
+                          width, height, textColor, textFont};
+    int id = -1;
+    buildGrid(&def, 1, &id);
+    return id;
 }
 
 ButtonManager::CreationStatus ButtonManager::getButtonCreationStatus(int buttonId) {
-    // Verificar se está criado
-    if (verifyButtonCreation(buttonId)) {
+    GridButton* btn = getButton(buttonId);
+    if (btn && btn->obj && lv_obj_is_valid(btn->obj)) {
         return CREATION_SUCCESS;
     }
-    
-    // Verificar se está pendente
-    auto it = std::find_if(pendingButtons.begin(), pendingButtons.end(),
-                          [buttonId](const PendingButton& btn) { 
-                              return btn.assignedId == buttonId; 
-                          });
-    
-    if (it != pendingButtons.end()) {
-        return CREATION_PENDING;
-    }
-    
     return CREATION_FAILED;
 }
 
@@ -535,7 +502,7 @@ bool ButtonManager::removeButton(int buttonId) {
     }
     
     if (bsp_display_lock(100)) {
-        markGridPosition(it->gridX, it->gridY, it->width, it->height, false);
+        markGridPosition(it->gridX, it->gridY, it->width, it->height, -1);
         
         if (it->obj) {
             lv_obj_del(it->obj);
@@ -561,11 +528,7 @@ void ButtonManager::removeAllButtons() {
         }
         buttons.clear();
         
-        for (int x = 0; x < GRID_COLS; x++) {
-            for (int y = 0; y < GRID_ROWS; y++) {
-                gridOccupancy[x][y] = false;
-            }
-        }
+        clearGrid();
         
         bsp_display_unlock();
         esp_rom_printf("All buttons removed");
@@ -583,12 +546,20 @@ bool ButtonManager::setButtonEnabled(int buttonId, bool enabled) {
     if (bsp_display_lock(100)) {
         it->enabled = enabled;
         if (it->obj) {
+            // Botao de face: a imagem desabilitada e renderizada no primeiro uso
+            ButtonFace* face = ButtonFaceCache::faceOf(it->obj);
+            if (face && !enabled && !face->has(BUTTON_FACE_DISABLED)) {
+                rebakeFace(*it, true);
+            }
+
+            // Opacidade reduzida vem do estilo de LV_STATE_DISABLED do tema
             if (enabled) {
                 lv_obj_clear_state(it->obj, LV_STATE_DISABLED);
-                lv_obj_set_style_bg_opa(it->obj, LV_OPA_COVER, LV_PART_MAIN);
             } else {
                 lv_obj_add_state(it->obj, LV_STATE_DISABLED);
-                lv_obj_set_style_bg_opa(it->obj, LV_OPA_50, LV_PART_MAIN);
+            }
+            if (face) {
+                lv_obj_invalidate(it->obj);
             }
         }
         bsp_display_unlock();
@@ -608,6 +579,11 @@ bool ButtonManager::setButtonLabel(int buttonId, const char* label) {
     
     if (bsp_display_lock(100)) {
         it->label = label;
+
+        if (rebakeFace(*it, false)) {
+            bsp_display_unlock();
+            return true;
+        }
         
         uint32_t child_count = lv_obj_get_child_cnt(it->obj);
         for (uint32_t i = 0; i < child_count; i++) {
@@ -635,6 +611,11 @@ bool ButtonManager::setButtonIcon(int buttonId, ButtonIcon icon) {
     
     if (bsp_display_lock(100)) {
         it->icon = icon;
+
+        if (rebakeFace(*it, false)) {
+            bsp_display_unlock();
+            return true;
+        }
         
         uint32_t child_count = lv_obj_get_child_cnt(it->obj);
         lv_obj_t* labelObj = nullptr;
@@ -677,8 +658,13 @@ bool ButtonManager::setButtonColor(int buttonId, lv_color_t color) {
     }
     
     if (bsp_display_lock(100)) {
-        it->color = color;
-        lv_obj_set_style_bg_color(it->obj, color, LV_PART_MAIN);
+        if (ButtonFaceCache::faceOf(it->obj)) {
+            it->color = color;
+            rebakeFace(*it, false);
+        } else {
+            Theme::getInstance()->setBgColor(it->obj, it->color, color);
+            it->color = color;
+        }
         bsp_display_unlock();
         return true;
     }
@@ -703,7 +689,7 @@ GridButton* ButtonManager::getButton(int buttonId) {
 bool ButtonManager::isGridPositionFree(int x, int y, int width, int height) {
     for (int cx = x; cx < x + width; cx++) {
         for (int cy = y; cy < y + height; cy++) {
-            if (!isPositionValid(cx, cy) || gridOccupancy[cx][cy]) {
+            if (!isPositionValid(cx, cy) || gridOwner[cx][cy] >= 0) {
                 return false;
             }
         }
@@ -711,11 +697,11 @@ bool ButtonManager::isGridPositionFree(int x, int y, int width, int height) {
     return true;
 }
 
-void ButtonManager::markGridPosition(int x, int y, int width, int height, bool occupied) {
+void ButtonManager::markGridPosition(int x, int y, int width, int height, int ownerId) {
     for (int cx = x; cx < x + width; cx++) {
         for (int cy = y; cy < y + height; cy++) {
             if (isPositionValid(cx, cy)) {
-                gridOccupancy[cx][cy] = occupied;
+                gridOwner[cx][cy] = static_cast<int16_t>(ownerId);
             }
         }
     }
@@ -738,6 +724,18 @@ bool ButtonManager::isPositionValid(int x, int y) {
     return x >= 0 && x < GRID_COLS && y >= 0 && y < GRID_ROWS;
 }
 
+void ButtonManager::clearGrid() {
+    for (int x = 0; x < GRID_COLS; x++)
+        for (int y = 0; y < GRID_ROWS; y++)
+            gridOwner[x][y] = -1;
+}
+
+int ButtonManager::getButtonAt(lv_coord_t x, lv_coord_t y) const {
+    int cell = AppGridGeometry::cellAt(x, y);
+    if (cell < 0) return -1;
+    return gridOwner[cell % GRID_COLS][cell / GRID_COLS];
+}
+
 // ============================================================================
 // CRIAÇÃO DE ÍCONES
 // ============================================================================
@@ -749,15 +747,13 @@ lv_obj_t* ButtonManager::createIconForButton(ButtonIcon icon, lv_obj_t* parent,
     lv_obj_t* iconLabel = lv_label_create(parent);
     lv_label_set_text(iconLabel, getIconText(icon));
     
-    lv_obj_set_style_text_color(iconLabel, textColor, LV_PART_MAIN);
     
     if (iconFont == &lv_font_montserrat_20) {
-        lv_obj_set_style_text_font(iconLabel, &lv_font_montserrat_24, LV_PART_MAIN);
+        iconFont = &lv_font_montserrat_24;
     } else if (iconFont == &lv_font_montserrat_14) {
-        lv_obj_set_style_text_font(iconLabel, &lv_font_montserrat_18, LV_PART_MAIN);
-    } else {
-        lv_obj_set_style_text_font(iconLabel, iconFont, LV_PART_MAIN);
+        iconFont = &lv_font_montserrat_18;
     }
+    Theme::getInstance()->applyLabelStyle(iconLabel, textColor, iconFont);
     
     return iconLabel;
 }
@@ -926,137 +922,20 @@ lv_obj_t* ButtonManager::createPopupOverlay() {
 
 void ButtonManager::showPopup(const char* title, const char* message,
                               PopupType type, bool showCancel,
-                              std::function<void(PopupResult)> callback) {
-
-    if (activePopup) {
-        closePopup();
-    }
+                              PopupResultCallback callback) {
+    PopupService* popups = PopupService::getInstance();
 
-    if (!bsp_display_lock(100)) return;
+    // Um popup por tela: o anterior deste ButtonManager e substituido
+    popups->closeOwnedBy(this);
 
     popupCallback = callback;
     lastPopupResult = POPUP_RESULT_NONE;
 
-    // Overlay padronizado (respeita StatusBar)
-    activePopup = createPopupOverlay();
-    
-    // Caixa do popup
-    lv_obj_t* popupBox = lv_obj_create(activePopup);
-    lv_obj_set_size(popupBox, 400, 250);
-    lv_obj_center(popupBox);
-    lv_obj_set_style_bg_color(popupBox, lv_color_hex(0x3a3a3a), LV_PART_MAIN);
-    lv_obj_set_style_border_width(popupBox, 3, LV_PART_MAIN);
-    lv_obj_set_style_border_color(popupBox, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_radius(popupBox, 15, LV_PART_MAIN);
-    lv_obj_clear_flag(popupBox, LV_OBJ_FLAG_SCROLLABLE);
-    
-    // Container do header
-    lv_obj_t* headerContainer = lv_obj_create(popupBox);
-    lv_obj_set_size(headerContainer, 370, 50);
-    lv_obj_align(headerContainer, LV_ALIGN_TOP_MID, 0, 10);
-    lv_obj_set_style_bg_opa(headerContainer, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(headerContainer, 0, LV_PART_MAIN);
-    lv_obj_set_flex_flow(headerContainer, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(headerContainer, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_clear_flag(headerContainer, LV_OBJ_FLAG_SCROLLABLE);
-    
-    // Ícone do popup
-    lv_obj_t* iconLabel = lv_label_create(headerContainer);
-    const char* iconText = "";
-    lv_color_t iconColor = lv_color_hex(0xFFFFFF);
-    
-    switch (type) {
-        case POPUP_INFO:
-            iconText = LV_SYMBOL_DUMMY"i";
-            iconColor = lv_color_hex(0x00AAFF);
-            break;
-        case POPUP_WARNING:
-            iconText = LV_SYMBOL_WARNING;
-            iconColor = lv_color_hex(0xFFAA00);
-            break;
-        case POPUP_ERROR:
-            iconText = LV_SYMBOL_CLOSE;
-            iconColor = lv_color_hex(0xFF0000);
-            break;
-        case POPUP_QUESTION:
-            iconText = LV_SYMBOL_DUMMY"?";
-            iconColor = lv_color_hex(0x00FF00);
-            break;
-        case POPUP_SUCCESS:
-            iconText = LV_SYMBOL_OK;             
-            iconColor = lv_color_hex(0x00FF00);
-            break;
-    }
-    
-    lv_label_set_text(iconLabel, iconText);
-    lv_obj_set_style_text_color(iconLabel, iconColor, LV_PART_MAIN);
-    lv_obj_set_style_text_font(iconLabel, &lv_font_montserrat_28, LV_PART_MAIN);
-    
-    // Título do popup
-    lv_obj_t* titleLabel = lv_label_create(headerContainer);
-    lv_label_set_text(titleLabel, title);
-    lv_obj_set_style_text_color(titleLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(titleLabel, &lv_font_montserrat_28, LV_PART_MAIN);
-    lv_obj_set_style_pad_left(titleLabel, 10, LV_PART_MAIN);
-    
-    // Mensagem do popup
-    lv_obj_t* msgLabel = lv_label_create(popupBox);
-    lv_label_set_text(msgLabel, message);
-    lv_label_set_long_mode(msgLabel, LV_LABEL_LONG_WRAP);
-    lv_obj_set_width(msgLabel, 370);
-    lv_obj_align(msgLabel, LV_ALIGN_CENTER, 0, 0);
-    lv_obj_set_style_text_align(msgLabel, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-    lv_obj_set_style_text_color(msgLabel, lv_color_hex(0xCCCCCC), LV_PART_MAIN);
-    lv_obj_set_style_text_font(msgLabel, &lv_font_montserrat_18, LV_PART_MAIN);
-    
-    // Container dos botões
-    lv_obj_t* btnContainer = lv_obj_create(popupBox);
-    lv_obj_set_size(btnContainer, 370, 60);
-    lv_obj_align(btnContainer, LV_ALIGN_BOTTOM_MID, 0, -10);
-    lv_obj_set_style_bg_opa(btnContainer, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(btnContainer, 0, LV_PART_MAIN);
-    lv_obj_set_flex_flow(btnContainer, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(btnContainer, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_style_pad_gap(btnContainer, 20, LV_PART_MAIN);
-    lv_obj_clear_flag(btnContainer, LV_OBJ_FLAG_SCROLLABLE);
-    
-    // Botão OK
-    lv_obj_t* btnOk = lv_btn_create(btnContainer);
-    lv_obj_set_size(btnOk, 120, 45);
-    lv_obj_set_style_bg_color(btnOk, lv_color_hex(0x00AA00), LV_PART_MAIN);
-    lv_obj_set_user_data(btnOk, this);
-    lv_obj_add_event_cb(btnOk, popupButtonHandler, LV_EVENT_CLICKED, (void*)(intptr_t)POPUP_RESULT_OK);
-    
-    lv_obj_t* labelOk = lv_label_create(btnOk);
-    lv_label_set_text(labelOk, "OK");
-    lv_obj_center(labelOk);
-    lv_obj_set_style_text_color(labelOk, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(labelOk, &lv_font_montserrat_20, LV_PART_MAIN);
-    
-    if (showCancel) {
-        // Botão Cancelar
-        lv_obj_t* btnCancel = lv_btn_create(btnContainer);
-        lv_obj_set_size(btnCancel, 120, 45);
-        lv_obj_set_style_bg_color(btnCancel, lv_color_hex(0xAA0000), LV_PART_MAIN);
-        lv_obj_set_user_data(btnCancel, this);
-        lv_obj_add_event_cb(btnCancel, popupButtonHandler, LV_EVENT_CLICKED, (void*)(intptr_t)POPUP_RESULT_CANCEL);
-        
-        lv_obj_t* labelCancel = lv_label_create(btnCancel);
-        lv_label_set_text(labelCancel, "Cancelar");
-        lv_obj_center(labelCancel);
-        lv_obj_set_style_text_color(labelCancel, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-        lv_obj_set_style_text_font(labelCancel, &lv_font_montserrat_20, LV_PART_MAIN);
-    }
-    
-    bsp_display_unlock();
+    popups->show(title, message, type, showCancel, popupResultHandler, this, this);
 }
 
 void ButtonManager::closePopup() {
-    if (activePopup && bsp_display_lock(100)) {
-        lv_obj_del(activePopup);
-        activePopup = nullptr;
-        bsp_display_unlock();
-    }
+    PopupService::getInstance()->closeOwnedBy(this);
 }
 
 // ============================================================================
@@ -1088,37 +967,21 @@ void ButtonManager::buttonEventHandler(lv_event_t* e) {
     GridButton* btn = mgr->getButton(buttonId);
     if (btn && btn->enabled && btn->callback) {
         esp_rom_printf("Button clicked: ID=%d, Label=%s\n", buttonId, btn->label.c_str());
+
+        // Caminho sem alocacao: coberto por test/test_button_tap.cpp
         btn->callback(buttonId);
     }
 }
 
-void ButtonManager::popupButtonHandler(lv_event_t* e) {
-    PopupResult result = (PopupResult)(intptr_t)lv_event_get_user_data(e);
-
-    // Obter o ButtonManager correto a partir do objeto LVGL (isolamento entre telas)
-    lv_obj_t* target = lv_event_get_target(e);
-    ButtonManager* mgr = static_cast<ButtonManager*>(lv_obj_get_user_data(target));
-    if (!mgr) {
-        mgr = getInstance(); // fallback para codigo legado
-    }
-
-    unsigned long currentTime = millis();
-    static unsigned long lastPopupClickTime = 0;
-
-    if ((currentTime - lastPopupClickTime) < BUTTON_DEBOUNCE_MS) {
-        esp_rom_printf("DEBOUNCE: Ignorando clique repetido no popup");
-        return;
-    }
-
-    lastPopupClickTime = currentTime;
+void ButtonManager::popupResultHandler(PopupResult result, void* ctx) {
+    // Debounce e fechamento ja feitos pelo PopupService
+    ButtonManager* mgr = static_cast<ButtonManager*>(ctx);
 
     mgr->lastPopupResult = result;
 
     if (mgr->popupCallback) {
         mgr->popupCallback(result);
     }
-
-    mgr->closePopup();
 }
 
 // ============================================================================
@@ -1137,7 +1000,7 @@ void ButtonManager::printGridOccupancy() {
     for (int y = 0; y < GRID_ROWS; y++) {
         esp_rom_printf("  ");
         for (int x = 0; x < GRID_COLS; x++) {
-            esp_rom_printf(gridOccupancy[x][y] ? "X" : ".");
+            esp_rom_printf(gridOwner[x][y] >= 0 ? "X" : ".");
             esp_rom_printf(" ");
         }
         esp_rom_printf("\n");
@@ -61,8 +61,10 @@ static esp_err_t init_filesystem(void) {
     return ESP_OK;
 }
 
+// So em build com log DEBUG: o readdir le a flash no caminho do splash
 static void list_filesystem_files(void) {
-    LOG_I(TAG, "Listando arquivos...");
+#if LOG_LOCAL_LEVEL >= ESP_LOG_DEBUG
+    LOG_D(TAG, "Listando arquivos...");
 
     DIR* dir = opendir(FS_BASE_PATH);
     if (!dir) {
@@ -75,7 +77,7 @@ static void list_filesystem_files(void) {
 
     while ((entry = readdir(dir)) != NULL) {
         if (entry->d_type == DT_REG) {
-            LOG_I(TAG, "  Arquivo: %s", entry->d_name);
+            LOG_D(TAG, "  Arquivo: %s", entry->d_name);
             count++;
         }
     }
@@ -85,8 +87,9 @@ static void list_filesystem_files(void) {
     if (count == 0) {
         LOG_W(TAG, "Nenhum arquivo encontrado");
     } else {
-        LOG_I(TAG, "Total de arquivos: %d", count);
+        LOG_D(TAG, "Total de arquivos: %d", count);
     }
+#endif
 }
 
 // ============================================================================
@@ -0,0 +1,230 @@
+/**
+ * ============================================================================
+ * ESCALONADOR DO BOOT
+ * ============================================================================
+ *
+ * Dois workers (task chamadora + task auxiliar no outro core) disputam a
+ * tabela de etapas sob um mutex. Quem nao acha etapa pronta dorme no
+ * event group ate alguma etapa pendente terminar; os bits nunca sao
+ * limpos, entao uma conclusao entre a consulta e a espera nao se perde.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "core/boot_scheduler.h"
+#include "core/boot_trace.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char* TAG = "BOOT_SCHED";
+
+// ============================================================================
+// CONSTRUCAO
+// ============================================================================
+
+BootScheduler::BootScheduler()
+    : count_(0), invalid_(false), pinning_(true),
+      started_(0), done_(0), failed_(0), runStartUs_(0),
+      mutex_(nullptr), doneBits_(nullptr), helperExit_(nullptr) {
+    memset(stages_, 0, sizeof(stages_));
+}
+
+int BootScheduler::add(const char* name, BootStageFn fn, uint32_t deps, int core, void* arg) {
+    if (count_ >= BOOT_MAX_STAGES) {
+        ESP_LOGE(TAG, "Tabela cheia, etapa '%s' descartada", name);
+        invalid_ = true;
+        return -1;
+    }
+
+    // So etapas anteriores: garante que nao ha ciclo
+    if (deps & ~(BOOT_DEP(count_) - 1)) {
+        ESP_LOGE(TAG, "Etapa '%s' depende de etapa inexistente", name);
+        invalid_ = true;
+        return -1;
+    }
+
+    Stage& s = stages_[count_];
+    s.name = name;
+    s.fn = fn;
+    s.arg = arg;
+    s.deps = deps;
+    s.core = (int8_t)core;
+    s.after = -1;
+    return count_++;
+}
+
+// ============================================================================
+// EXECUCAO
+// ============================================================================
+
+bool BootScheduler::run() {
+    if (invalid_) {
+        ESP_LOGE(TAG, "Grafo de etapas invalido");
+        return false;
+    }
+    if (count_ == 0) return true;
+
+    mutex_ = xSemaphoreCreateMutex();
+    doneBits_ = xEventGroupCreate();
+    helperExit_ = xSemaphoreCreateBinary();
+    if (!mutex_ || !doneBits_ || !helperExit_) {
+        ESP_LOGE(TAG, "Sem memoria para o escalonador");
+        if (mutex_) vSemaphoreDelete(mutex_);
+        if (doneBits_) vEventGroupDelete(doneBits_);
+        if (helperExit_) vSemaphoreDelete(helperExit_);
+        return false;
+    }
+
+    runStartUs_ = esp_timer_get_time();
+    int core = xPortGetCoreID();
+    bool helper = false;
+
+#if portNUM_PROCESSORS > 1
+    helper = xTaskCreatePinnedToCore(helperTask, "boot_worker", BOOT_WORKER_STACK_SIZE, this,
+                                     uxTaskPriorityGet(NULL), NULL, 1 - core) == pdPASS;
+#endif
+    if (!helper) {
+        ESP_LOGW(TAG, "Sem task auxiliar: etapas em sequencia no core %d", core);
+        pinning_ = false;
+    }
+
+    work(core);
+
+    // A auxiliar ainda usa o objeto ate sair do loop
+    if (helper) {
+        xSemaphoreTake(helperExit_, portMAX_DELAY);
+    }
+
+    vSemaphoreDelete(mutex_);
+    vEventGroupDelete(doneBits_);
+    vSemaphoreDelete(helperExit_);
+    mutex_ = nullptr;
+    doneBits_ = nullptr;
+    helperExit_ = nullptr;
+
+    printCriticalPath();
+    return failed_ == 0;
+}
+
+void BootScheduler::helperTask(void* arg) {
+    BootScheduler* self = static_cast<BootScheduler*>(arg);
+    self->work(xPortGetCoreID());
+
+    // Depois do give o objeto pode ja ter sido destruido
+    SemaphoreHandle_t exitSem = self->helperExit_;
+    xSemaphoreGive(exitSem);
+    vTaskDelete(NULL);
+}
+
+void BootScheduler::work(int core) {
+    const uint32_t all = BOOT_DEP(count_) - 1;
+
+    while (true) {
+        xSemaphoreTake(mutex_, portMAX_DELAY);
+        uint32_t done = done_;
+        int idx = (done == all) ? -1 : pick(core);
+        bool skip = (idx >= 0) && (stages_[idx].deps & failed_);
+        xSemaphoreGive(mutex_);
+
+        if (done == all) return;
+
+        if (idx < 0) {
+            xEventGroupWaitBits(doneBits_, all & ~done, pdFALSE, pdFALSE, portMAX_DELAY);
+            continue;
+        }
+
+        Stage& s = stages_[idx];
+        bool ok = false;
+        s.startUs = esp_timer_get_time();
+
+        if (skip) {
+            ESP_LOGW(TAG, "Etapa '%s' pulada: dependencia falhou", s.name);
+        } else {
+            int span = boot_trace_begin(s.name);
+            ok = s.fn(s.arg);
+            boot_trace_end(span);
+
+            if (!ok) {
+                ESP_LOGE(TAG, "Etapa '%s' falhou", s.name);
+            }
+        }
+
+        finish(idx, ok);
+    }
+}
+
+// Chamar com mutex_: primeira etapa pronta para este core, ja marcada
+int BootScheduler::pick(int core) {
+    for (int i = 0; i < count_; i++) {
+        Stage& s = stages_[i];
+        if (started_ & BOOT_DEP(i)) continue;
+        if ((s.deps & done_) != s.deps) continue;
+        if (pinning_ && s.core != BOOT_ANY_CORE && s.core != core) continue;
+
+        started_ |= BOOT_DEP(i);
+
+        // Pronta quando a ultima dependencia terminou (ou no inicio)
+        s.readyUs = runStartUs_;
+        for (int d = 0; d < i; d++) {
+            if ((s.deps & BOOT_DEP(d)) && stages_[d].endUs >= s.readyUs) {
+                s.readyUs = stages_[d].endUs;
+                s.after = (int8_t)d;
+            }
+        }
+        return i;
+    }
+    return -1;
+}
+
+void BootScheduler::finish(int idx, bool ok) {
+    xSemaphoreTake(mutex_, portMAX_DELAY);
+    stages_[idx].endUs = esp_timer_get_time();
+    done_ |= BOOT_DEP(idx);
+    if (!ok) failed_ |= BOOT_DEP(idx);
+    xSemaphoreGive(mutex_);
+
+    xEventGroupSetBits(doneBits_, BOOT_DEP(idx));
+}
+
+// ============================================================================
+// RELATORIO
+// ============================================================================
+
+void BootScheduler::printCriticalPath() const {
+    // Cadeia que termina na etapa mais tardia, seguindo a dependencia que
+    // a liberou por ultimo; "fila" e o tempo pronta esperando um worker
+    int last = 0;
+    for (int i = 1; i < count_; i++) {
+        if (stages_[i].endUs > stages_[last].endUs) last = i;
+    }
+
+    int chain[BOOT_MAX_STAGES];
+    int len = 0;
+    for (int i = last; i >= 0 && len < BOOT_MAX_STAGES; i = stages_[i].after) {
+        chain[len++] = i;
+    }
+
+    char line[192];
+    int pos = 0;
+    for (int k = len - 1; k >= 0 && pos < (int)sizeof(line); k--) {
+        const Stage& s = stages_[chain[k]];
+        long long runMs = (s.endUs - s.startUs) / 1000;
+        long long queueMs = (s.startUs - s.readyUs) / 1000;
+
+        pos += snprintf(line + pos, sizeof(line) - pos, "%s%s %lld ms",
+                        k == len - 1 ? "" : " -> ", s.name, runMs);
+        if (queueMs > 0 && pos < (int)sizeof(line)) {
+            pos += snprintf(line + pos, sizeof(line) - pos, " (+%lld ms fila)", queueMs);
+        }
+    }
+
+    ESP_LOGI(TAG, "%d etapas em %lld ms; caminho critico: %s", count_,
+             (long long)((stages_[last].endUs - runStartUs_) / 1000), line);
+}
@@ -0,0 +1,130 @@
+/**
+ * ============================================================================
+ * TRACE DO BOOT
+ * ============================================================================
+ *
+ * Tabela fixa de intervalos: cada boot_trace_begin reserva a proxima
+ * posicao com um contador atomico, entao tasks em cores diferentes podem
+ * abrir e fechar intervalos sem trava. Tempos em us desde o boot, em 32
+ * bits (sobram mais de uma hora de margem para o boot).
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "core/boot_trace.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <inttypes.h>
+
+static const char* TAG = "BOOT";
+
+struct BootTraceSpan {
+    const char* name;
+    uint32_t startUs;
+    uint32_t endUs;             // 0: ainda aberto
+    int8_t core;
+};
+
+static BootTraceSpan s_spans[BOOT_TRACE_MAX_SPANS];
+static std::atomic<uint32_t> s_count(0);
+static std::atomic<uint32_t> s_dropped(0);
+static std::atomic<uint32_t> s_marks[BOOT_MARK_COUNT];
+
+static inline uint32_t now_us(void) {
+    return (uint32_t)esp_timer_get_time();
+}
+
+static void print_mark(const char* label, boot_mark_t mark) {
+    uint32_t us = s_marks[mark].load();
+    if (us) {
+        ESP_LOGI(TAG, "%s: %" PRIu32 " ms", label, us / 1000);
+    } else {
+        ESP_LOGI(TAG, "%s: (nao registrado)", label);
+    }
+}
+
+// ============================================================================
+// FUNCOES PUBLICAS
+// ============================================================================
+
+extern "C" {
+
+int boot_trace_begin(const char* name) {
+    uint32_t id = s_count.fetch_add(1);
+    if (id >= BOOT_TRACE_MAX_SPANS) {
+        s_dropped++;
+        return -1;
+    }
+
+    BootTraceSpan& span = s_spans[id];
+    span.name = name;
+    span.core = (int8_t)xPortGetCoreID();
+    span.endUs = 0;
+    span.startUs = now_us();
+    return (int)id;
+}
+
+void boot_trace_end(int id) {
+    if (id < 0 || id >= BOOT_TRACE_MAX_SPANS) return;
+    s_spans[id].endUs = now_us();
+}
+
+void boot_trace_mark(boot_mark_t mark) {
+    if (mark >= BOOT_MARK_COUNT) return;
+    uint32_t expected = 0;
+    s_marks[mark].compare_exchange_strong(expected, now_us());
+}
+
+void boot_trace_report(void) {
+    uint32_t count = s_count.load();
+    if (count > BOOT_TRACE_MAX_SPANS) count = BOOT_TRACE_MAX_SPANS;
+
+    ESP_LOGI(TAG, "=== Boot: %" PRIu32 " etapas ===", count);
+    ESP_LOGI(TAG, " inicio  duracao core etapa");
+
+    uint32_t first = UINT32_MAX;
+    uint32_t last = 0;
+    uint64_t busyUs = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const BootTraceSpan& span = s_spans[i];
+        if (span.endUs == 0) {
+            ESP_LOGI(TAG, "%5" PRIu32 " ms    (aberta)  %d  %s",
+                     span.startUs / 1000, span.core, span.name);
+            continue;
+        }
+
+        uint32_t dur = span.endUs - span.startUs;
+        ESP_LOGI(TAG, "%5" PRIu32 " ms %5" PRIu32 " ms  %d  %s",
+                 span.startUs / 1000, dur / 1000, span.core, span.name);
+
+        busyUs += dur;
+        if (span.startUs < first) first = span.startUs;
+        if (span.endUs > last) last = span.endUs;
+    }
+
+    if (s_dropped.load()) {
+        ESP_LOGW(TAG, "%" PRIu32 " etapas descartadas (aumente BOOT_TRACE_MAX_SPANS)", s_dropped.load());
+    }
+
+    print_mark("Primeiro quadro", BOOT_MARK_FIRST_FRAME);
+    print_mark("Sistema interativo", BOOT_MARK_INTERACTIVE);
+
+    // Soma das etapas sobre o tempo de parede: > 1.0 quando os dois cores
+    // trabalharam ao mesmo tempo
+    if (last > first) {
+        uint32_t wallUs = last - first;
+        ESP_LOGI(TAG, "Etapas: %" PRIu32 " ms de trabalho em %" PRIu32 " ms (paralelismo %" PRIu32 ".%02" PRIu32 "x)",
+                 (uint32_t)(busyUs / 1000), wallUs / 1000,
+                 (uint32_t)(busyUs / wallUs), (uint32_t)(busyUs * 100 / wallUs % 100));
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,219 @@
+/**
+ * ============================================================================
+ * BARRAMENTO DE EVENTOS - IMPLEMENTACAO
+ * ============================================================================
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "core/event_bus.h"
+#include "utils/time_utils.h"
+#include "utils/debug_utils.h"
+#include <string.h>
+
+LOG_TAG("EVENT_BUS");
+
+// ============================================================================
+// SINGLETON
+// ============================================================================
+
+EventBus* EventBus::instance = nullptr;
+
+EventBus* EventBus::getInstance() {
+    if (instance == nullptr) {
+        instance = new EventBus();
+    }
+    return instance;
+}
+
+EventBus::EventBus()
+    : seq_(0)
+    , published_(0)
+    , delivered_(0)
+{
+    memset(subscribers_, 0, sizeof(subscribers_));
+    memset(subscriberCount_, 0, sizeof(subscriberCount_));
+    memset(typeMask_, 0, sizeof(typeMask_));
+    memset(sinkTasks_, 0, sizeof(sinkTasks_));
+    for (int c = 0; c < NUM_CORES; c++) {
+        busy_[c].store(false, std::memory_order_relaxed);
+        inflightSeq_[c].store(0, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// INSCRICAO
+// ============================================================================
+
+bool EventBus::subscribe(EventSink sink, EventType type, EventHandler handler, void* ctx) {
+    int s = static_cast<int>(sink);
+    if (s < 0 || s >= NUM_SINKS || !handler || type >= EventType::MAX_TYPES) {
+        return false;
+    }
+
+    if (subscriberCount_[s] >= EVENT_BUS_MAX_SUBSCRIBERS) {
+        LOG_E(TAG, "Tabela de inscricoes cheia (destino %d)", s);
+        return false;
+    }
+
+    Subscriber& sub = subscribers_[s][subscriberCount_[s]];
+    sub.type = type;
+    sub.handler = handler;
+    sub.ctx = ctx;
+    subscriberCount_[s]++;
+
+    typeMask_[s] |= (1u << static_cast<uint32_t>(type));
+    return true;
+}
+
+void EventBus::setSinkTask(EventSink sink, TaskHandle_t task) {
+    int s = static_cast<int>(sink);
+    if (s >= 0 && s < NUM_SINKS) {
+        sinkTasks_[s] = task;
+    }
+}
+
+// ============================================================================
+// PUBLICACAO (task produtora)
+// ============================================================================
+
+bool EventBus::publish(EventSource source, AppEvent event) {
+    int src = static_cast<int>(source);
+    if (src < 0 || src >= NUM_SOURCES) {
+        return false;
+    }
+
+    event.timestamp = time_millis();
+
+    uint32_t typeBit = 1u << static_cast<uint32_t>(event.type);
+    uint32_t acceptedSinks = 0;
+    uint32_t droppedSinks = 0;
+
+    // Interrupcoes mascaradas so neste nucleo: nenhuma outra task dele
+    // escreve no mesmo anel, e a task nao migra entre ler o nucleo e gravar
+    UBaseType_t irqState = portSET_INTERRUPT_MASK_FROM_ISR();
+    int core = xPortGetCoreID();
+
+    // Anuncia o menor seq possivel antes de pega-lo: dispatch() nao passa
+    // dele enquanto este push nao termina (ordem global entre nucleos)
+    inflightSeq_[core].store(seq_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    busy_[core].store(true, std::memory_order_seq_cst);
+    event.seq = seq_.fetch_add(1, std::memory_order_seq_cst);
+
+    for (int s = 0; s < NUM_SINKS; s++) {
+        if (!(typeMask_[s] & typeBit)) continue;
+
+        if (rings_[s][core].push(event)) {
+            acceptedSinks |= 1u << s;
+        } else {
+            droppedSinks |= 1u << s;
+        }
+    }
+    busy_[core].store(false, std::memory_order_release);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(irqState);
+
+    for (int s = 0; s < NUM_SINKS; s++) {
+        if ((acceptedSinks & (1u << s)) && sinkTasks_[s]) {
+            xTaskNotifyGive(sinkTasks_[s]);
+        }
+        if (droppedSinks & (1u << s)) {
+            LOG_W(TAG, "Anel cheio (destino %d, origem %d, core %d): evento %d descartado",
+                  s, src, core, static_cast<int>(event.type));
+        }
+    }
+
+    if (acceptedSinks) {
+        published_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return droppedSinks == 0;
+}
+
+// ============================================================================
+// ENTREGA (task consumidora)
+// ============================================================================
+
+uint32_t EventBus::dispatch(EventSink sink) {
+    int s = static_cast<int>(sink);
+    if (s < 0 || s >= NUM_SINKS) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+
+    while (true) {
+        // Tudo abaixo de limit ja esta nos aneis, exceto o que um nucleo
+        // ainda esta gravando: esse recebe seq >= inflightSeq_, entao limit
+        // desce ate ele. O que ficar acima sai na proxima volta (a
+        // notificacao do publish ainda vai acordar o destino)
+        uint32_t limit = seq_.load(std::memory_order_seq_cst);
+        for (int c = 0; c < NUM_CORES; c++) {
+            if (!busy_[c].load(std::memory_order_seq_cst)) continue;
+            uint32_t low = inflightSeq_[c].load(std::memory_order_seq_cst);
+            if ((int32_t)(low - limit) < 0) limit = low;
+        }
+
+        // Escolhe o evento mais antigo entre os nucleos (menor seq)
+        int best = -1;
+        const AppEvent* bestEvent = nullptr;
+        for (int c = 0; c < NUM_CORES; c++) {
+            const AppEvent* ev = rings_[s][c].peek();
+            if (!ev || (int32_t)(ev->seq - limit) >= 0) continue;
+            if (!bestEvent || (int32_t)(ev->seq - bestEvent->seq) < 0) {
+                best = c;
+                bestEvent = ev;
+            }
+        }
+
+        if (best < 0) break;
+
+        // Copia antes do pop: o slot pode ser reutilizado pelo produtor
+        AppEvent event = *bestEvent;
+        rings_[s][best].pop();
+
+        for (int i = 0; i < subscriberCount_[s]; i++) {
+            const Subscriber& sub = subscribers_[s][i];
+            if (sub.type == event.type) {
+                sub.handler(event, sub.ctx);
+                delivered_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        count++;
+    }
+
+    return count;
+}
+
+bool EventBus::hasPending(EventSink sink) const {
+    int s = static_cast<int>(sink);
+    if (s < 0 || s >= NUM_SINKS) {
+        return false;
+    }
+
+    for (int c = 0; c < NUM_CORES; c++) {
+        if (!rings_[s][c].empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// ESTATISTICAS
+// ============================================================================
+
+EventBusStats EventBus::getStats() const {
+    EventBusStats stats;
+    stats.published = published_.load(std::memory_order_relaxed);
+    stats.delivered = delivered_.load(std::memory_order_relaxed);
+    stats.dropped = 0;
+
+    for (int s = 0; s < NUM_SINKS; s++) {
+        for (int c = 0; c < NUM_CORES; c++) {
+            stats.dropped += rings_[s][c].dropped();
+        }
+    }
+    return stats;
+}
@@ -72,6 +72,8 @@ typedef struct {
     uint32_t time_Tvdh;                 /*!< tvdh = The display panel is not updated from the Frame Memory */
     uint32_t te_timestamp;              /*!< Tear record timestamp */
     portMUX_TYPE lock;                  /*!< Lock for read/write */
+    gpio_num_t te_gpio;                 /*!< TE input, its interrupt is only enabled while flushing */
+    bool te_active;                     /*!< TE interrupt enabled (protected by lock) */
 } bsp_lcd_tear_t;
 
 typedef struct {
@@ -136,7 +138,12 @@ static esp_err_t bsp_display_brightness_init(void)
         .duty_resolution = LEDC_TIMER_10_BIT,
         .timer_num = 1,
         .freq_hz = 5000,
+#ifdef CONFIG_PM_ENABLE
+        /* RC_FAST keeps the PWM (and the backlight) running in light sleep */
+        .clk_cfg = LEDC_USE_RC_FAST_CLK
+#else
         .clk_cfg = LEDC_AUTO_CLK
+#endif
     };
 
     BSP_ERROR_CHECK_RETURN_ERR(ledc_timer_config(&LCD_backlight_timer));
@@ -172,11 +179,32 @@ esp_err_t bsp_display_backlight_on(void)
     return bsp_display_brightness_set(100);
 }
 
+/* Enable the TE interrupt if the panel was idle; returns true when it was */
+static bool bsp_display_tear_activate(bsp_lcd_tear_t *tear_handle)
+{
+    bool was_idle = false;
+
+    portENTER_CRITICAL(&tear_handle->lock);
+    if (!tear_handle->te_active) {
+        tear_handle->te_active = true;
+        gpio_intr_enable(tear_handle->te_gpio);
+        was_idle = true;
+    }
+    portEXIT_CRITICAL(&tear_handle->lock);
+
+    return was_idle;
+}
+
 static bool bsp_display_sync_cb(void *arg)
 {
     assert(arg);
     bsp_lcd_tear_t *tear_handle = (bsp_lcd_tear_t *)arg;
 
+    /* Coming out of idle: the last TE is stale, wait for a fresh one */
+    if (bsp_display_tear_activate(tear_handle) && tear_handle->te_v_sync_sem) {
+        xSemaphoreTake(tear_handle->te_v_sync_sem, 0);
+    }
+
     if (tear_handle->te_catch_sem) {
         xSemaphoreGive(tear_handle->te_catch_sem);
     }
@@ -194,9 +222,19 @@ static void bsp_display_sync_task(void *arg)
     bsp_lcd_tear_t *tear_handle = (bsp_lcd_tear_t *)arg;
 
     while (true) {
-        if (pdPASS != xSemaphoreTake(tear_handle->te_catch_sem, pdMS_TO_TICKS(tear_handle->time_Tvdl))) {
-            xSemaphoreTake(tear_handle->te_v_sync_sem, 0);
+        /* Idle: no flush pending, TE interrupt off so the chip can sleep */
+        xSemaphoreTake(tear_handle->te_catch_sem, portMAX_DELAY);
+        bsp_display_tear_activate(tear_handle);
+
+        /* Flushing: keep TE running until a whole frame passes without one */
+        while (pdPASS == xSemaphoreTake(tear_handle->te_catch_sem, pdMS_TO_TICKS(tear_handle->time_Tvdl))) {
         }
+
+        portENTER_CRITICAL(&tear_handle->lock);
+        tear_handle->te_active = false;
+        gpio_intr_disable(tear_handle->te_gpio);
+        portEXIT_CRITICAL(&tear_handle->lock);
+        xSemaphoreTake(tear_handle->te_v_sync_sem, 0);
     }
     vTaskDelete(NULL);
 }
@@ -281,6 +319,8 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
 
         tear_ctx->lock.owner = portMUX_FREE_VAL;
         tear_ctx->lock.count = 0;
+        tear_ctx->te_gpio = (gpio_num_t)config->tear_cfg.te_gpio_num;
+        tear_ctx->te_active = false;
 
         const gpio_config_t te_detect_cfg = {
             .intr_type = config->tear_cfg.tear_intr_type,
@@ -293,6 +333,8 @@ esp_err_t bsp_display_new(const bsp_display_config_t *config, esp_lcd_panel_hand
         ESP_ERROR_CHECK(gpio_config(&te_detect_cfg));
         gpio_install_isr_service(0);
         ESP_ERROR_CHECK(gpio_isr_handler_add(config->tear_cfg.te_gpio_num, bsp_display_tear_interrupt, tear_ctx));
+        /* Enabled by the first flush (bsp_display_sync_cb) */
+        gpio_intr_disable(config->tear_cfg.te_gpio_num);
 
         BaseType_t res;
         if (config->tear_cfg.task_affinity < 0) {
@@ -399,6 +441,12 @@ static void bsp_touch_interrupt_cb(esp_lcd_touch_handle_t tp)
 
     xSemaphoreGiveFromISR(touch_handle->tp_intr_event, &xHigherPriorityTaskWoken);
 
+    /* Wake the LVGL task so the press is read and drawn without waiting for its
+     * timers (only registered when EXAMPLE_PIN_NUM_QSPI_TOUCH_INT is wired) */
+    if (lvgl_port_touch_wake_from_isr()) {
+        xHigherPriorityTaskWoken = pdTRUE;
+    }
+
     if (xHigherPriorityTaskWoken) {
         portYIELD_FROM_ISR();
     }
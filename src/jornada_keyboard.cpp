@@ -5,7 +5,8 @@
  */
 
 #include "jornada_keyboard.h"
-#include "numpad_example.h"
+#include "ui/screen_manager.h"
+#include "ui/common/theme.h"
 #include "esp_bsp.h"
 #include "esp_log.h"
 #include "esp_timer.h"
@@ -54,7 +55,6 @@ static void anim_shadow_opa_cb(void* var, int32_t v) {
 // ============================================================================
 
 JornadaKeyboard* JornadaKeyboard::instance = nullptr;
-ScreenManager* ScreenManager::instance = nullptr;
 
 // ============================================================================
 // JORNADA KEYBOARD - CONSTRUTOR E DESTRUTOR
@@ -63,7 +63,16 @@ ScreenManager* ScreenManager::instance = nullptr;
 JornadaKeyboard::JornadaKeyboard() : 
     btnManager(nullptr),
     popupMotorista(nullptr),
+    popupTitulo(nullptr),
     acaoPendente(ACAO_JORNADA) {
+
+    for (int i = 0; i < 3; i++) {
+        popupBotoes[i] = nullptr;
+        popupLabels[i] = nullptr;
+        popupLogado[i] = false;
+        popupLabelTexto[i][0] = '\0';
+    }
+    popupTituloTexto[0] = '\0';
     
     // NOTA: A struct 'BotaoAcao' no arquivo .h correspondente
     // deve ter um novo membro: 'bool animacaoAtiva;'
@@ -206,6 +215,14 @@ const char* getImagePathForAction(TipoAcao acao) {
 // CRIAÇÃO DO TECLADO
 // ============================================================================
 
+// Layout 4x3 (validado em tempo de compilacao)
+static constexpr GridCell kJornadaCells[12] = {
+    {0, 0, 1, 1}, {1, 0, 1, 1}, {2, 0, 1, 1}, {3, 0, 1, 1},  // Primeira linha
+    {0, 1, 1, 1}, {1, 1, 1, 1}, {2, 1, 1, 1}, {3, 1, 1, 1},  // Segunda linha
+    {0, 2, 1, 1}, {1, 2, 1, 1}, {2, 2, 1, 1}, {3, 2, 1, 1}   // Terceira linha
+};
+static constexpr GridLayout<AppGridGeometry, 12> kJornadaLayout(kJornadaCells);
+
 void JornadaKeyboard::createKeyboard() {
     if (!btnManager) {
         esp_rom_printf("ERRO: ButtonManager não disponível");
@@ -215,35 +232,18 @@ void JornadaKeyboard::createKeyboard() {
     // Limpa teclado anterior se existir
     clearKeyboard();
     
-    esp_rom_printf("==============================================");
-    esp_rom_printf("  CRIANDO TECLADO DE JORNADA (SISTEMA ROBUSTO)");
-    esp_rom_printf("==============================================");
-    
-    // ========================================================================
-    // MÉTODO 1: CRIAÇÃO EM LOTE (RECOMENDADO)
-    // ========================================================================
-    
-    // Definir todos os 12 botões de uma vez
-    std::vector<ButtonManager::ButtonBatchDef> buttonDefs;
-    
-    // Layout 4x3
-    int positions[12][2] = {
-        {0, 0}, {1, 0}, {2, 0}, {3, 0},  // Primeira linha
-        {0, 1}, {1, 1}, {2, 1}, {3, 1},  // Segunda linha
-        {0, 2}, {1, 2}, {2, 2}, {3, 2}   // Terceira linha
-    };
     
-    TipoAcao acoes[12] = {
+    static const TipoAcao acoes[12] = {
         ACAO_JORNADA, ACAO_REFEICAO, ACAO_ESPERA, ACAO_MANOBRA,
         ACAO_CARGA, ACAO_DESCARGA, ACAO_ABASTECER, ACAO_DESCANSAR,
         ACAO_TRANSITO_PARADO, ACAO_POLICIA, ACAO_PANE, ACAO_EMERGENCIA
     };
     
-    // Preparar definições de botões para criação em lote
+    // Definição declarativa dos 12 botões
+    ButtonManager::ButtonBatchDef buttonDefs[12];
+    
     for (int i = 0; i < 12; i++) {
         TipoAcao acao = acoes[i];
-        int x = positions[i][0];
-        int y = positions[i][1];
         
         // Atualizar dados do botão
         botoes[acao].tipo = acao;
@@ -251,112 +251,26 @@ void JornadaKeyboard::createKeyboard() {
         botoes[acao].icon = getIconForAction(acao);
         botoes[acao].color = getColorForAction(acao);
         
-        // Adicionar à lista de definições
-        ButtonManager::ButtonBatchDef def;
-        def.gridX = x;
-        def.gridY = y;
+        ButtonManager::ButtonBatchDef& def = buttonDefs[i];
         def.label = botoes[acao].label;
         def.icon = botoes[acao].icon;
         def.image_src = getImagePathForAction(acao);
         def.color = botoes[acao].color;
         def.callback = onActionButtonClick;
-        def.width = 1;
-        def.height = 1;
         def.textColor = lv_color_hex(0xFFFFFF);
         def.textFont = &lv_font_montserrat_16;
-        
-        buttonDefs.push_back(def);
     }
     
-    // Criar todos os botões em lote (com retry automático)
-    esp_rom_printf("📦 Iniciando criação em lote de 12 botões de jornada...");
-    std::vector<int> ids = btnManager->addButtonBatch(buttonDefs);
+    // Constrói a grade inteira em uma passada (síncrono, posicoes do layout)
+    int ids[12];
+    int created = btnManager->buildGrid(kJornadaLayout, buttonDefs, ids);
     
-    // Mapear IDs retornados para as ações correspondentes
     for (int i = 0; i < 12; i++) {
-        TipoAcao acao = acoes[i];
-        botoes[acao].buttonId = ids[i];
-        esp_rom_printf("  → Botão '%s' mapeado para ID %d\n", 
-                     getLabelForAction(acao), ids[i]);
+        botoes[acoes[i]].buttonId = ids[i];
     }
     
-    // ========================================================================
-    // VERIFICAÇÃO DE CRIAÇÃO
-    // ========================================================================
-    
-    esp_rom_printf("\n🔍 Verificando criação dos botões...");
-    
-    // Aguardar confirmação de criação (com timeout de 1 segundo)
-    if (btnManager->waitForAllButtons(ids, 1000)) {
-        esp_rom_printf("✅ SUCESSO: Todos os botões de jornada foram criados!");
-        
-        // Verificar status individual para debug (opcional)
-        if (true) {  // Mudar para false se não quiser debug detalhado
-            esp_rom_printf("\n📊 Status individual dos botões:");
-            for (int i = 0; i < 12; i++) {
-                TipoAcao acao = acoes[i];
-                auto status = btnManager->getButtonCreationStatus(ids[i]);
-                const char* statusStr = "";
-                const char* emoji = "";
-                
-                switch(status) {
-                    case ButtonManager::CREATION_SUCCESS:
-                        statusStr = "CRIADO";
-                        emoji = "✓";
-                        break;
-                    case ButtonManager::CREATION_PENDING:
-                        statusStr = "PENDENTE";
-                        emoji = "⏳";
-                        break;
-                    case ButtonManager::CREATION_FAILED:
-                        statusStr = "FALHOU";
-                        emoji = "✗";
-                        break;
-                }
-                
-                esp_rom_printf("  %s %s (ID: %d): %s\n", 
-                             emoji, getLabelForAction(acao), ids[i], statusStr);
-            }
-        }
-        
-    } else {
-        esp_rom_printf("⚠️ AVISO: Alguns botões podem não ter sido criados");
-        esp_rom_printf("📊 Botões pendentes: %d\n", btnManager->getPendingButtonCount());
-        
-        // Diagnóstico de falhas
-        esp_rom_printf("\n🔧 Diagnóstico de problemas:");
-        int failedCount = 0;
-        int pendingCount = 0;
-        
-        for (int i = 0; i < 12; i++) {
-            TipoAcao acao = acoes[i];
-            auto status = btnManager->getButtonCreationStatus(ids[i]);
-            
-            if (status == ButtonManager::CREATION_PENDING) {
-                pendingCount++;
-                esp_rom_printf("  ⏳ '%s' está PENDENTE\n", getLabelForAction(acao));
-            } else if (status == ButtonManager::CREATION_FAILED) {
-                failedCount++;
-                esp_rom_printf("  ✗ '%s' FALHOU na criação\n", getLabelForAction(acao));
-            }
-        }
-        
-        if (pendingCount > 0) {
-            esp_rom_printf("\n⏳ Aguardando %d botões pendentes...\n", pendingCount);
-            vTaskDelay(pdMS_TO_TICKS(500));
-            
-            // Verificar novamente após espera
-            pendingCount = btnManager->getPendingButtonCount();
-            if (pendingCount == 0) {
-                esp_rom_printf("✅ Todos os botões pendentes foram processados!");
-            } else {
-                esp_rom_printf("⚠ Ainda há %d botões pendentes após espera\n", pendingCount);
-            }
-        }
-        
-        if (failedCount > 0) {
-            esp_rom_printf("❌ ERRO: %d botões falharam definitivamente\n", failedCount);
-        }
+    if (created != 12) {
+        ESP_LOGE(TAG, "Teclado de jornada incompleto: %d/12 botoes", created);
     }
     
     // ========================================================================
@@ -370,10 +284,6 @@ void JornadaKeyboard::createKeyboard() {
     btnManager->setStatusMessage("Selecione uma acao",
                                 lv_color_hex(0x888888),
                                 &lv_font_montserrat_16);
-    
-    esp_rom_printf("\n==============================================");
-    esp_rom_printf("  TECLADO DE JORNADA PRONTO PARA USO");
-    esp_rom_printf("==============================================\n");
 }
 
 
@@ -576,11 +486,7 @@ void JornadaKeyboard::clearKeyboard() {
         }
     }
     
-    // Pequeno delay para garantir que animações sejam limpas
-    lv_task_handler();
-    vTaskDelay(pdMS_TO_TICKS(10));
-    
-    // Agora remover os botões
+    // lv_anim_del é síncrono: os botões podem ser removidos em seguida
     for (int i = 0; i < ACAO_MAX; i++) {
         if (botoes[i].buttonId != -1) {
             btnManager->removeButton(botoes[i].buttonId);
@@ -600,27 +506,23 @@ void JornadaKeyboard::clearKeyboard() {
 // POPUP DE SELEÇÃO DE MOTORISTA
 // ============================================================================
 
-void JornadaKeyboard::showMotoristaSelection(TipoAcao acao) {
-    if (popupMotorista) {
-        closeMotoristaSelection();
+bool JornadaKeyboard::criarPopupMotorista() {
+    // Reaproveita o popup enquanto a tela que o contem existir
+    if (popupMotorista && lv_obj_is_valid(popupMotorista) &&
+        lv_obj_get_screen(popupMotorista) == btnManager->getScreen()) {
+        return true;
     }
-    
-    acaoPendente = acao;
-    
-    if (!bsp_display_lock(100)) return;
-    
+
     // Overlay padronizado (respeita StatusBar)
     popupMotorista = btnManager->createPopupOverlay();
+    if (!popupMotorista) return false;
+    Theme* theme = Theme::getInstance();
     
     // Caixa do popup
     lv_obj_t* popupBox = lv_obj_create(popupMotorista);
     lv_obj_set_size(popupBox, 350, 250);
     lv_obj_center(popupBox);
-    lv_obj_set_style_bg_color(popupBox, lv_color_hex(0x3a3a3a), LV_PART_MAIN);
-    lv_obj_set_style_border_width(popupBox, 3, LV_PART_MAIN);
-    lv_obj_set_style_border_color(popupBox, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_radius(popupBox, 15, LV_PART_MAIN);
-    lv_obj_clear_flag(popupBox, LV_OBJ_FLAG_SCROLLABLE);
+    theme->applyPopupStyle(popupBox);
     
     // Botão X (cancelar)
     lv_obj_t* btnCancel = lv_btn_create(popupBox);
@@ -631,19 +533,15 @@ void JornadaKeyboard::showMotoristaSelection(TipoAcao acao) {
     lv_obj_add_event_cb(btnCancel, onCancelPopupClick, LV_EVENT_CLICKED, nullptr);
     
     lv_obj_t* labelX = lv_label_create(btnCancel);
-    lv_label_set_text(labelX, "X");
+    lv_label_set_text_static(labelX, "X");
     lv_obj_center(labelX);
-    lv_obj_set_style_text_color(labelX, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(labelX, &lv_font_montserrat_16, LV_PART_MAIN);
+    theme->applyLabelStyle(labelX, lv_color_hex(0xFFFFFF), &lv_font_montserrat_16);
     
-    // Título
-    lv_obj_t* titleLabel = lv_label_create(popupBox);
-    char titleText[50];
-    snprintf(titleText, sizeof(titleText), "Selecione o Motorista - %s", getLabelForAction(acao));
-    lv_label_set_text(titleLabel, titleText);
-    lv_obj_align(titleLabel, LV_ALIGN_TOP_MID, 0, 20);
-    lv_obj_set_style_text_color(titleLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(titleLabel, &lv_font_montserrat_18, LV_PART_MAIN);
+    // Título (texto reatribuido a cada exibicao)
+    popupTitulo = lv_label_create(popupBox);
+    lv_label_set_text_static(popupTitulo, popupTituloTexto);
+    lv_obj_align(popupTitulo, LV_ALIGN_TOP_MID, 0, 20);
+    theme->applyLabelStyle(popupTitulo, lv_color_hex(0xFFFFFF), &lv_font_montserrat_18);
     
     // Container dos botões de motorista
     lv_obj_t* btnContainer = lv_obj_create(popupBox);
@@ -656,43 +554,73 @@ void JornadaKeyboard::showMotoristaSelection(TipoAcao acao) {
     lv_obj_set_style_pad_gap(btnContainer, 10, LV_PART_MAIN);
     lv_obj_clear_flag(btnContainer, LV_OBJ_FLAG_SCROLLABLE);
     
-    // Criar 3 botões de motorista
+    // Criar 3 botões de motorista (inicialmente "nao logado")
     for (int i = 0; i < 3; i++) {
-        lv_obj_t* btnMotorista = lv_btn_create(btnContainer);
-        lv_obj_set_size(btnMotorista, 280, 40);
+        popupBotoes[i] = lv_btn_create(btnContainer);
+        lv_obj_set_size(popupBotoes[i], 280, 40);
+        theme->applyButtonStyle(popupBotoes[i], lv_color_hex(0x0088FF));
+        popupLogado[i] = false;
         
+        // Adicionar callback com o índice do motorista
+        lv_obj_add_event_cb(popupBotoes[i], onMotoristaSelectClick, LV_EVENT_CLICKED, (void*)(intptr_t)i);
+        
+        popupLabels[i] = lv_label_create(popupBotoes[i]);
+        lv_label_set_text_static(popupLabels[i], popupLabelTexto[i]);
+        lv_obj_center(popupLabels[i]);
+        theme->applyLabelStyle(popupLabels[i], lv_color_hex(0xFFFFFF), &lv_font_montserrat_16);
+    }
+
+    lv_obj_add_flag(popupMotorista, LV_OBJ_FLAG_HIDDEN);
+    return true;
+}
+
+void JornadaKeyboard::showMotoristaSelection(TipoAcao acao) {
+    acaoPendente = acao;
+    
+    if (!bsp_display_lock(100)) return;
+
+    if (!criarPopupMotorista()) {
+        bsp_display_unlock();
+        return;
+    }
+
+    Theme* theme = Theme::getInstance();
+
+    // Apenas reatribui textos e cores aos objetos existentes
+    snprintf(popupTituloTexto, sizeof(popupTituloTexto), "Selecione o Motorista - %s", getLabelForAction(acao));
+    lv_label_set_text_static(popupTitulo, popupTituloTexto);
+
+    for (int i = 0; i < 3; i++) {
         // Verificar estado do motorista NESTE BOTÃO específico
         bool estaLogado = botoes[acao].motoristas[i].logado;
         
         // Cores simples: Verde = logado, Azul = não logado
-        lv_color_t corBotao = estaLogado ? lv_color_hex(0x00AA00) : lv_color_hex(0x0088FF);
-        lv_obj_set_style_bg_color(btnMotorista, corBotao, LV_PART_MAIN);
-        
-        // Adicionar callback com o índice do motorista
-        lv_obj_add_event_cb(btnMotorista, onMotoristaSelectClick, LV_EVENT_CLICKED, (void*)(intptr_t)i);
-        
-        // Label do botão simples
-        char labelText[50];
-        if (estaLogado) {
-            snprintf(labelText, sizeof(labelText), "Motorista %d - DESLOGAR", i + 1);
-        } else {
-            snprintf(labelText, sizeof(labelText), "Motorista %d - LOGAR", i + 1);
+        if (estaLogado != popupLogado[i]) {
+            lv_color_t corAntiga = popupLogado[i] ? lv_color_hex(0x00AA00) : lv_color_hex(0x0088FF);
+            lv_color_t corBotao = estaLogado ? lv_color_hex(0x00AA00) : lv_color_hex(0x0088FF);
+            theme->setBgColor(popupBotoes[i], corAntiga, corBotao);
+            popupLogado[i] = estaLogado;
         }
-        
-        lv_obj_t* label = lv_label_create(btnMotorista);
-        lv_label_set_text(label, labelText);
-        lv_obj_center(label);
-        lv_obj_set_style_text_color(label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-        lv_obj_set_style_text_font(label, &lv_font_montserrat_16, LV_PART_MAIN);
+
+        snprintf(popupLabelTexto[i], sizeof(popupLabelTexto[i]), "Motorista %d - %s",
+                 i + 1, estaLogado ? "DESLOGAR" : "LOGAR");
+        lv_label_set_text_static(popupLabels[i], popupLabelTexto[i]);
     }
+
+    lv_obj_move_foreground(popupMotorista);
+    lv_obj_clear_flag(popupMotorista, LV_OBJ_FLAG_HIDDEN);
     
     bsp_display_unlock();
 }
 
 void JornadaKeyboard::closeMotoristaSelection() {
     if (popupMotorista && bsp_display_lock(100)) {
-        lv_obj_del(popupMotorista);
-        popupMotorista = nullptr;
+        // Esconde (nao deleta): a proxima exibicao reaproveita os objetos
+        if (lv_obj_is_valid(popupMotorista)) {
+            lv_obj_add_flag(popupMotorista, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            popupMotorista = nullptr;
+        }
         bsp_display_unlock();
     }
 }
@@ -824,245 +752,29 @@ void JornadaKeyboard::onCancelPopupClick(lv_event_t* e) {
     }
 }
 
-// ... O restante do arquivo (ScreenManager e funções globais) permanece inalterado ...
-// ============================================================================
-// SCREEN MANAGER - IMPLEMENTAÇÃO
-// ============================================================================
-
-ScreenManager::ScreenManager() : 
-    telaAtual(TELA_NUMPAD),
-    container(nullptr),
-    numpadInstance(nullptr),
-    jornadaInstance(nullptr),
-    btnScreenSwitch(nullptr) {
-}
-
-ScreenManager::~ScreenManager() {
-    // Limpar telas
-    if (numpadInstance) {
-        NumpadExample* numpad = static_cast<NumpadExample*>(numpadInstance);
-        numpad->clearNumpad();
-    }
-    
-    if (jornadaInstance) {
-        jornadaInstance->clearKeyboard();
-    }
-}
-
-ScreenManager* ScreenManager::getInstance() {
-    if (instance == nullptr) {
-        instance = new ScreenManager();
-    }
-    return instance;
-}
-
-void ScreenManager::init() {
-    esp_rom_printf("Inicializando ScreenManager...");
-    
-    // Inicializar instâncias PRIMEIRO
-    numpadInstance = NumpadExample::getInstance();
-    NumpadExample* numpad = static_cast<NumpadExample*>(numpadInstance);
-    numpad->init();
-    
-    jornadaInstance = JornadaKeyboard::getInstance();
-    jornadaInstance->init();
-    
-    // Mostrar tela inicial (numpad)
-    showNumpadScreen();
-    
-    // Criar botão com delay maior para garantir que tudo esteja pronto
-    lv_timer_t* timer = lv_timer_create([](lv_timer_t* t) {
-        ScreenManager* sm = ScreenManager::getInstance();
-        if (sm) {
-            sm->createScreenSwitchButton();
-            esp_rom_printf("Botao de troca criado apos inicializacao");
-        }
-        lv_timer_del(t);
-    }, 500, nullptr);
-    
-    esp_rom_printf("ScreenManager inicializado!");
-}
-
-// Criar botão de troca de tela
-void ScreenManager::createScreenSwitchButton() {
-    // Sempre deletar o anterior se existir
-    if (btnScreenSwitch) {
-        lv_obj_del(btnScreenSwitch);
-        btnScreenSwitch = nullptr;
-    }
-    
-    // Criar novo botão
-    lv_obj_t* screen = lv_scr_act();
-    if (!screen) {
-        esp_rom_printf("ERRO: Tela nao encontrada!");
-        return;
-    }
-    
-    // Botão de troca de tela no EXTREMO canto inferior direito
-    btnScreenSwitch = lv_btn_create(screen);
-    lv_obj_set_size(btnScreenSwitch, 60, 35);
-    // Posição absoluta no canto direito da barra de status
-    lv_obj_set_pos(btnScreenSwitch, SCREEN_WIDTH - 65, SCREEN_HEIGHT - 38);
-    lv_obj_set_style_bg_color(btnScreenSwitch, lv_color_hex(0x0088FF), LV_PART_MAIN);
-    lv_obj_set_style_radius(btnScreenSwitch, 5, LV_PART_MAIN);
-    lv_obj_set_style_border_width(btnScreenSwitch, 2, LV_PART_MAIN);
-    lv_obj_set_style_border_color(btnScreenSwitch, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    
-    // Texto simples mostrando o número da tela
-    lv_obj_t* label = lv_label_create(btnScreenSwitch);
-    char text[16];
-    snprintf(text, sizeof(text), "[%d]", telaAtual + 1);
-    lv_label_set_text(label, text);
-    lv_obj_center(label);
-    lv_obj_set_style_text_color(label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_20, LV_PART_MAIN);
-    
-    // Adicionar callback
-    lv_obj_add_event_cb(btnScreenSwitch, onScreenSwitchClick, LV_EVENT_CLICKED, nullptr);
-    
-    // Trazer para frente
-    lv_obj_move_foreground(btnScreenSwitch);
-    
-    esp_rom_printf("Botao criado! Posicao: %d,%d Tela: %d\n", 
-                  SCREEN_WIDTH - 65, SCREEN_HEIGHT - 38, telaAtual + 1);
-}
-
-// Callback para botão de troca de tela
-void ScreenManager::onScreenSwitchClick(lv_event_t* e) {
-    ScreenManager* mgr = getInstance();
-    if (!mgr) return;
-    
-    playAudioFile("/click.mp3");
-    
-    // Alternar entre as telas
-    if (mgr->telaAtual == TELA_NUMPAD) {
-        mgr->showJornadaScreen();
-    } else {
-        mgr->showNumpadScreen();
-    }
-    
-    esp_rom_printf("Tela trocada para: %d\n", mgr->telaAtual);
-}
-
-void ScreenManager::showNumpadScreen() {
-    esp_rom_printf("Mostrando tela de teclado numerico");
-    
-    // Limpar tela de jornada se existir
-    if (jornadaInstance) {
-        jornadaInstance->clearKeyboard();
-    }
-    
-    // Limpar todos os botões primeiro
-    ButtonManager* mgr = ButtonManager::getInstance();
-    if (mgr) {
-        mgr->removeAllButtons();
-    }
-    
-    // Mostrar numpad
-    if (numpadInstance) {
-        NumpadExample* numpad = static_cast<NumpadExample*>(numpadInstance);
-        numpad->createNumpad();
-    }
-    
-    telaAtual = TELA_NUMPAD;
-    
-    // Criar o botão de troca com pequeno delay para garantir que tudo esteja pronto
-    lv_timer_t* timer = lv_timer_create([](lv_timer_t* t) {
-        ScreenManager* sm = ScreenManager::getInstance();
-        if (sm) {
-            sm->createScreenSwitchButton();
-        }
-        lv_timer_del(t);
-    }, 100, nullptr);
-    
-    esp_rom_printf("Tela numpad ativada");
-}
-
-void ScreenManager::showJornadaScreen() {
-    esp_rom_printf("Mostrando tela de jornada");
-    
-    // Limpar numpad se existir
-    if (numpadInstance) {
-        NumpadExample* numpad = static_cast<NumpadExample*>(numpadInstance);
-        numpad->clearNumpad();
-    }
-    
-    // Limpar todos os botões primeiro
-    ButtonManager* mgr = ButtonManager::getInstance();
-    if (mgr) {
-        mgr->removeAllButtons();
-    }
-    
-    // Mostrar teclado de jornada
-    if (jornadaInstance) {
-        jornadaInstance->createKeyboard();
-    }
-    
-    telaAtual = TELA_JORNADA;
-    
-    // Criar o botão de troca com pequeno delay para garantir que tudo esteja pronto
-    lv_timer_t* timer = lv_timer_create([](lv_timer_t* t) {
-        ScreenManager* sm = ScreenManager::getInstance();
-        if (sm) {
-            sm->createScreenSwitchButton();
-        }
-        lv_timer_del(t);
-    }, 100, nullptr);
-    
-    esp_rom_printf("Tela jornada ativada");
-}
-
-void ScreenManager::toggleScreen() {
-    if (telaAtual == TELA_NUMPAD) {
-        showJornadaScreen();
-    } else {
-        showNumpadScreen();
-    }
-}
-
 // ============================================================================
-// FUNÇÕES HELPER GLOBAIS (extern C para acesso de main.cpp)
+// FUNÇÕES HELPER GLOBAIS (shims sobre o ScreenManagerImpl)
 // ============================================================================
 
 extern "C" void initScreenManager() {
-    esp_rom_printf("Inicializando sistema de gerenciamento de telas");
-    ScreenManager* mgr = ScreenManager::getInstance();
-    if (mgr) {
-        mgr->init();
-    } else {
-        esp_rom_printf("ERRO: Falha ao criar ScreenManager!");
-    }
+    ScreenManagerImpl::getInstance()->init();
 }
 
 void showNumpadKeyboard() {
-    ScreenManager* mgr = ScreenManager::getInstance();
-    if (mgr) {
-        mgr->showNumpadScreen();
-    } else {
-        // Fallback direto
-        NumpadExample* numpad = NumpadExample::getInstance();
-        numpad->init();
-        numpad->createNumpad();
-    }
+    ScreenManagerImpl::getInstance()->cycleTo(ScreenType::NUMPAD);
 }
 
 void showJornadaKeyboard() {
-    ScreenManager* mgr = ScreenManager::getInstance();
-    if (mgr) {
-        mgr->showJornadaScreen();
-    } else {
-        // Fallback direto
-        JornadaKeyboard* jornada = JornadaKeyboard::getInstance();
-        jornada->init();
-        jornada->createKeyboard();
-    }
+    ScreenManagerImpl::getInstance()->cycleTo(ScreenType::JORNADA);
 }
 
 // Função de teste para alternar telas via serial
 void toggleKeyboard() {
-    ScreenManager* mgr = ScreenManager::getInstance();
-    if (mgr) {
-        mgr->toggleScreen();
+    ScreenManagerImpl* mgr = ScreenManagerImpl::getInstance();
+    if (mgr->getCurrentScreen() == ScreenType::NUMPAD) {
+        mgr->cycleTo(ScreenType::JORNADA);
+    } else {
+        mgr->cycleTo(ScreenType::NUMPAD);
     }
 }
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <inttypes.h>
 #include "esp_system.h"
 #include "esp_log.h"
 #include "esp_err.h"
@@ -12,9 +13,13 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_panel_interface.h"
+#ifdef CONFIG_PM_ENABLE
+#include "esp_pm.h"
+#endif
 
 #include "lv_port.h"
 #include "lvgl.h"
@@ -38,10 +43,23 @@ static const char *TAG = "LVGL";
 typedef struct lvgl_port_ctx_s {
     SemaphoreHandle_t   lvgl_mux;
     esp_timer_handle_t  tick_timer;
+    TaskHandle_t        task;
     bool                running;
     int                 task_max_sleep_ms;
+    volatile bool       touch_pending;  /* Touch IRQ seen, read input before the timers */
+    QueueHandle_t       cmd_queue;      /* Commands posted by other tasks */
+    lvgl_port_cmd_cb    pump_cb;        /* Called on every wakeup */
+    void                *pump_arg;
+#ifdef CONFIG_PM_ENABLE
+    esp_pm_lock_handle_t pm_lock;       /* Held while the task is awake (no light sleep, max CPU) */
+#endif
 } lvgl_port_ctx_t;
 
+typedef struct {
+    lvgl_port_cmd_cb    cb;
+    void                *arg;
+} lvgl_port_cmd_t;
+
 typedef struct {
     esp_lcd_panel_io_handle_t io_handle;    /* LCD panel IO handle */
     esp_lcd_panel_handle_t    panel_handle; /* LCD panel handle */
@@ -62,7 +80,15 @@ typedef struct {
     esp_lcd_touch_handle_t  handle;        /* LCD touch IO handle */
     lv_indev_drv_t          indev_drv;     /* LVGL input device driver */
     lvgl_port_wait_cb       touch_wait_cb;  /* Callback function for touch */
+    bool                    pressed;        /* Last reported state, for press edge detection */
 } lvgl_port_touch_ctx_t;
+
+/* Latency probe: 32-bit esp_timer microseconds, 0 = not armed */
+typedef struct {
+    volatile uint32_t       irq_us;         /* First touch IRQ not yet consumed by a read */
+    uint32_t                press_irq_us;   /* Start of the press waiting for its first flush (IRQ or polled read) */
+    lvgl_port_input_stats_t stats;
+} lvgl_port_touch_probe_t;
 #endif
 
 /*******************************************************************************
@@ -70,6 +96,13 @@ typedef struct {
 *******************************************************************************/
 static lvgl_port_ctx_t lvgl_port_ctx;
 static int lvgl_port_timer_period_ms = 5;
+static lvgl_port_render_stats_t lvgl_port_render_stats;
+static lvgl_port_task_stats_t lvgl_port_task_stats;
+static StaticQueue_t lvgl_port_cmd_queue_buf;
+static uint8_t lvgl_port_cmd_queue_storage[LVGL_PORT_CMD_QUEUE_LEN * sizeof(lvgl_port_cmd_t)];
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+static lvgl_port_touch_probe_t lvgl_port_touch_probe;
+#endif
 
 /*******************************************************************************
 * Function definitions
@@ -77,14 +110,18 @@ static int lvgl_port_timer_period_ms = 5;
 static void lvgl_port_task(void *arg);
 static esp_err_t lvgl_port_tick_init(void);
 static void lvgl_port_task_deinit(void);
+static void lvgl_port_run_commands(void);
 
 // LVGL callbacks
 #if LVGL_PORT_HANDLE_FLUSH_READY
 static bool lvgl_port_flush_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
 #endif
 static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static void lvgl_port_monitor_callback(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
 #ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
 static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *data);
+static void lvgl_port_touch_process(void);
+static void lvgl_port_touch_idle_update(void);
 #endif
 /*******************************************************************************
 * Public API functions
@@ -110,12 +147,18 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     }
     lvgl_port_ctx.lvgl_mux = xSemaphoreCreateRecursiveMutex();
     ESP_GOTO_ON_FALSE(lvgl_port_ctx.lvgl_mux, ESP_ERR_NO_MEM, err, TAG, "Create LVGL mutex fail!");
+    lvgl_port_ctx.cmd_queue = xQueueCreateStatic(LVGL_PORT_CMD_QUEUE_LEN, sizeof(lvgl_port_cmd_t),
+                              lvgl_port_cmd_queue_storage, &lvgl_port_cmd_queue_buf);
+    ESP_GOTO_ON_FALSE(lvgl_port_ctx.cmd_queue, ESP_ERR_NO_MEM, err, TAG, "Create LVGL command queue fail!");
+#ifdef CONFIG_PM_ENABLE
+    ESP_GOTO_ON_ERROR(esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "lvgl", &lvgl_port_ctx.pm_lock), err, TAG, "Create LVGL PM lock fail!");
+#endif
 
     BaseType_t res;
     if (cfg->task_affinity < 0) {
-        res = xTaskCreate(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, NULL);
+        res = xTaskCreate(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, &lvgl_port_ctx.task);
     } else {
-        res = xTaskCreatePinnedToCore(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, NULL, cfg->task_affinity);
+        res = xTaskCreatePinnedToCore(lvgl_port_task, "LVGL task", cfg->task_stack, NULL, cfg->task_priority, &lvgl_port_ctx.task, cfg->task_affinity);
     }
     ESP_GOTO_ON_FALSE(res == pdPASS, ESP_FAIL, err, TAG, "Create LVGL task fail!");
 
@@ -129,6 +172,10 @@ err:
 
 esp_err_t lvgl_port_resume(void)
 {
+#if LV_TICK_CUSTOM
+    lv_timer_enable(true);
+    return ESP_OK;
+#else
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
     if (lvgl_port_ctx.tick_timer != NULL) {
@@ -137,10 +184,15 @@ esp_err_t lvgl_port_resume(void)
     }
 
     return ret;
+#endif
 }
 
 esp_err_t lvgl_port_stop(void)
 {
+#if LV_TICK_CUSTOM
+    lv_timer_enable(false);
+    return ESP_OK;
+#else
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
     if (lvgl_port_ctx.tick_timer != NULL) {
@@ -149,6 +201,7 @@ esp_err_t lvgl_port_stop(void)
     }
 
     return ret;
+#endif
 }
 
 esp_err_t lvgl_port_deinit(void)
@@ -235,6 +288,7 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
     disp_ctx->disp_drv.hor_res = disp_cfg->hres;
     disp_ctx->disp_drv.ver_res = disp_cfg->vres;
     disp_ctx->disp_drv.flush_cb = lvgl_port_flush_callback;
+    disp_ctx->disp_drv.monitor_cb = lvgl_port_monitor_callback;
 
     disp_ctx->disp_drv.draw_buf = disp_buf;
     disp_ctx->disp_drv.user_data = disp_ctx;
@@ -317,6 +371,7 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
     }
     touch_ctx->handle = touch_cfg->handle;
     touch_ctx->touch_wait_cb = touch_cfg->touch_wait_cb;
+    touch_ctx->pressed = false;
 
     /* Register a touchpad input device */
     lv_indev_drv_init(&touch_ctx->indev_drv);
@@ -366,6 +421,75 @@ void lvgl_port_flush_ready(lv_disp_t *disp)
     lv_disp_flush_ready(disp->driver);
 }
 
+void lvgl_port_get_render_stats(lvgl_port_render_stats_t *stats)
+{
+    assert(stats);
+    *stats = lvgl_port_render_stats;
+}
+
+void lvgl_port_get_task_stats(lvgl_port_task_stats_t *stats)
+{
+    assert(stats);
+    *stats = lvgl_port_task_stats;
+}
+
+bool lvgl_port_post(lvgl_port_cmd_cb cb, void *arg)
+{
+    assert(cb);
+    assert(lvgl_port_ctx.cmd_queue && "lvgl_port_init must be called first");
+
+    const lvgl_port_cmd_t cmd = {
+        .cb = cb,
+        .arg = arg,
+    };
+    if (xQueueSend(lvgl_port_ctx.cmd_queue, &cmd, 0) != pdTRUE) {
+        lvgl_port_task_stats.cmds_dropped++;
+        return false;
+    }
+    if (lvgl_port_ctx.task) {
+        xTaskNotifyGive(lvgl_port_ctx.task);
+    }
+    return true;
+}
+
+void lvgl_port_set_pump_cb(lvgl_port_cmd_cb cb, void *arg)
+{
+    lvgl_port_lock(0);
+    lvgl_port_ctx.pump_cb = cb;
+    lvgl_port_ctx.pump_arg = arg;
+    lvgl_port_unlock();
+}
+
+TaskHandle_t lvgl_port_get_task(void)
+{
+    return lvgl_port_ctx.task;
+}
+
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+bool lvgl_port_touch_wake_from_isr(void)
+{
+    BaseType_t task_woken = pdFALSE;
+
+    /* Keep the first IRQ of a touch; the read clears it */
+    if (lvgl_port_touch_probe.irq_us == 0) {
+        uint32_t now = (uint32_t)esp_timer_get_time();
+        lvgl_port_touch_probe.irq_us = now ? now : 1;
+    }
+
+    lvgl_port_ctx.touch_pending = true;
+    if (lvgl_port_ctx.task) {
+        vTaskNotifyGiveFromISR(lvgl_port_ctx.task, &task_woken);
+    }
+    return task_woken == pdTRUE;
+}
+
+void lvgl_port_get_input_stats(lvgl_port_input_stats_t *stats)
+{
+    assert(stats);
+    *stats = lvgl_port_touch_probe.stats;
+}
+#endif
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
@@ -373,20 +497,63 @@ void lvgl_port_flush_ready(lv_disp_t *disp)
 static void lvgl_port_task(void *arg)
 {
     uint32_t task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
+    int64_t period_start_us = esp_timer_get_time();
+    int64_t busy_us = 0;
+    uint32_t wakeups = 0;
 
     ESP_LOGI(TAG, "Starting LVGL task");
     lvgl_port_ctx.running = true;
     while (lvgl_port_ctx.running) {
+        wakeups++;
+#ifdef CONFIG_PM_ENABLE
+        esp_pm_lock_acquire(lvgl_port_ctx.pm_lock);
+#endif
         if (lvgl_port_lock(0)) {
+            int64_t start_us = esp_timer_get_time();
+            lvgl_port_run_commands();
+            if (lvgl_port_ctx.pump_cb) {
+                lvgl_port_ctx.pump_cb(lvgl_port_ctx.pump_arg);
+            }
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+            if (lvgl_port_ctx.touch_pending) {
+                lvgl_port_ctx.touch_pending = false;
+                lvgl_port_touch_process();
+            }
+#endif
             task_delay_ms = lv_timer_handler();
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+            lvgl_port_touch_idle_update();
+#endif
+            busy_us += esp_timer_get_time() - start_us;
             lvgl_port_unlock();
         }
+
+        /* Load report: wakeups and share of time spent running LVGL */
+        int64_t now_us = esp_timer_get_time();
+        int64_t period_us = now_us - period_start_us;
+        if (period_us >= (int64_t)LVGL_PORT_STATS_PERIOD_MS * 1000) {
+            lvgl_port_task_stats.wakeups_per_s = (uint32_t)(((int64_t)wakeups * 1000000) / period_us);
+            lvgl_port_task_stats.cpu_pct_x10 = (uint32_t)((busy_us * 1000) / period_us);
+            ESP_LOGI(TAG, "LVGL task: %" PRIu32 " wakeups/s, CPU %" PRIu32 ".%" PRIu32 "%%, cmds %" PRIu32 " (dropped %" PRIu32 ")",
+                     lvgl_port_task_stats.wakeups_per_s,
+                     lvgl_port_task_stats.cpu_pct_x10 / 10, lvgl_port_task_stats.cpu_pct_x10 % 10,
+                     lvgl_port_task_stats.cmds, lvgl_port_task_stats.cmds_dropped);
+            period_start_us = now_us;
+            busy_us = 0;
+            wakeups = 0;
+        }
+
+        /* Sleep until the next LVGL timer deadline (LV_NO_TIMER_READY -> max sleep) */
         if ((task_delay_ms > lvgl_port_ctx.task_max_sleep_ms) || (1 == task_delay_ms)) {
             task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
-        } else if (task_delay_ms < 2) {
-            task_delay_ms = 2;
+        } else if (task_delay_ms < 1) {
+            task_delay_ms = 1;
         }
-        vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+        /* Commands, queued events and touch IRQs wake the task early */
+#ifdef CONFIG_PM_ENABLE
+        esp_pm_lock_release(lvgl_port_ctx.pm_lock);
+#endif
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(task_delay_ms));
     }
 
     lvgl_port_task_deinit();
@@ -395,11 +562,28 @@ static void lvgl_port_task(void *arg)
     vTaskDelete(NULL);
 }
 
+static void lvgl_port_run_commands(void)
+{
+    lvgl_port_cmd_t cmd;
+    while (xQueueReceive(lvgl_port_ctx.cmd_queue, &cmd, 0) == pdTRUE) {
+        cmd.cb(cmd.arg);
+        lvgl_port_task_stats.cmds++;
+    }
+}
+
 static void lvgl_port_task_deinit(void)
 {
     if (lvgl_port_ctx.lvgl_mux) {
         vSemaphoreDelete(lvgl_port_ctx.lvgl_mux);
     }
+    if (lvgl_port_ctx.cmd_queue) {
+        vQueueDelete(lvgl_port_ctx.cmd_queue);
+    }
+#ifdef CONFIG_PM_ENABLE
+    if (lvgl_port_ctx.pm_lock) {
+        esp_pm_lock_delete(lvgl_port_ctx.pm_lock);
+    }
+#endif
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
 #if LV_ENABLE_GC || !LV_MEM_CUSTOM
     /* Deinitialize LVGL */
@@ -425,9 +609,46 @@ static bool lvgl_port_flush_ready_callback(esp_lcd_panel_io_handle_t panel_io, e
 }
 #endif
 
+static void lvgl_port_monitor_callback(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    lvgl_port_render_stats_t *st = &lvgl_port_render_stats;
+
+    st->frames++;
+    st->last_ms = time;
+    st->last_px = px;
+    st->total_ms += time;
+    if (time > st->max_ms) {
+        st->max_ms = time;
+    }
+    /* Exponential moving average (1/8 weight), kept in 1/8 ms to stay in integers */
+    st->avg_ms_x8 = (st->frames == 1) ? (time << 3) : (st->avg_ms_x8 - (st->avg_ms_x8 >> 3) + time);
+
+    if ((st->frames & 0xFF) == 0) {
+        ESP_LOGD(TAG, "Render: %" PRIu32 " frames, last %" PRIu32 " ms, avg %" PRIu32 " ms, max %" PRIu32 " ms",
+                 st->frames, st->last_ms, st->avg_ms_x8 >> 3, st->max_ms);
+    }
+}
+
 static void lvgl_port_flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
 {
     assert(drv != NULL);
+#ifdef ESP_LVGL_PORT_TOUCH_COMPONENT
+    /* First flush after a press: end of the touch latency probe */
+    if (lvgl_port_touch_probe.press_irq_us) {
+        lvgl_port_input_stats_t *st = &lvgl_port_touch_probe.stats;
+        uint32_t dt = (uint32_t)esp_timer_get_time() - lvgl_port_touch_probe.press_irq_us;
+        lvgl_port_touch_probe.press_irq_us = 0;
+
+        st->presses++;
+        st->last_us = dt;
+        if (dt > st->max_us) {
+            st->max_us = dt;
+        }
+        st->avg_us = (st->presses == 1) ? dt : (st->avg_us - (st->avg_us >> 3) + (dt >> 3));
+        ESP_LOGD(TAG, "Touch latency: start->read %" PRIu32 " us, start->flush %" PRIu32 " us (avg %" PRIu32 ", max %" PRIu32 ")",
+                 st->last_read_us, dt, st->avg_us, st->max_us);
+    }
+#endif
     lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)drv->user_data;
     assert(disp_ctx != NULL);
 
@@ -581,6 +802,7 @@ static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *
     uint16_t touchpad_x[1] = {0};
     uint16_t touchpad_y[1] = {0};
     uint8_t touchpad_cnt = 0;
+    uint32_t read_start_us = (uint32_t)esp_timer_get_time();
 
     /* Read data from touch controller into memory */
     bool touch_int = false;
@@ -601,17 +823,77 @@ static void lvgl_port_touchpad_read(lv_indev_drv_t *indev_drv, lv_indev_data_t *
             data->state = LV_INDEV_STATE_RELEASED;
         }
     }
+
+    /* Press edge: arm the latency probe and draw the pressed state now.
+     * With the INT line wired the probe starts at the IRQ. This board has none
+     * (EXAMPLE_PIN_NUM_QSPI_TOUCH_INT = -1): the controller is polled every
+     * read period and the probe starts at the read that saw the press */
+    uint32_t irq_us = lvgl_port_touch_probe.irq_us;
+    bool pressed = (data->state == LV_INDEV_STATE_PRESSED);
+    if (pressed && !touch_ctx->pressed) {
+        uint32_t start_us = irq_us ? irq_us : read_start_us;
+        lvgl_port_touch_probe.stats.last_read_us = (uint32_t)esp_timer_get_time() - start_us;
+        lvgl_port_touch_probe.press_irq_us = start_us ? start_us : 1;
+
+        /* Don't wait for the display refresh period */
+        lv_timer_t *refr_timer = _lv_disp_get_refr_timer(indev_drv->disp);
+        if (refr_timer) {
+            lv_timer_ready(refr_timer);
+        }
+    } else if (!pressed) {
+        lvgl_port_touch_probe.press_irq_us = 0;
+    }
+    if (touch_int) {
+        lvgl_port_touch_probe.irq_us = 0;
+    }
+    touch_ctx->pressed = pressed;
+}
+
+/* Touch IRQ path (boards with the INT line): read the pointer now and push the resulting redraw out */
+static void lvgl_port_touch_process(void)
+{
+    lv_indev_t *indev = lv_indev_get_next(NULL);
+    while (indev) {
+        if (indev->driver->type == LV_INDEV_TYPE_POINTER &&
+                indev->driver->read_cb == lvgl_port_touchpad_read && indev->driver->read_timer) {
+            lv_indev_read_timer_cb(indev->driver->read_timer);
+        }
+        indev = lv_indev_get_next(indev);
+    }
+    lv_refr_now(NULL);
+}
+
+/* Poll the touch controller slowly once the UI has been idle for a while */
+static void lvgl_port_touch_idle_update(void)
+{
+    uint32_t period = (lv_disp_get_inactive_time(NULL) >= LVGL_PORT_TOUCH_IDLE_MS) ?
+                      LVGL_PORT_TOUCH_IDLE_READ_MS : LV_INDEV_DEF_READ_PERIOD;
+
+    lv_indev_t *indev = lv_indev_get_next(NULL);
+    while (indev) {
+        lv_timer_t *timer = indev->driver->read_timer;
+        if (indev->driver->read_cb == lvgl_port_touchpad_read && timer && timer->period != period) {
+            lv_timer_set_period(timer, period);
+        }
+        indev = lv_indev_get_next(indev);
+    }
 }
 #endif
 
+#if !LV_TICK_CUSTOM
 static void lvgl_port_tick_increment(void *arg)
 {
     /* Tell LVGL how many milliseconds have elapsed */
     lv_tick_inc(lvgl_port_timer_period_ms);
 }
+#endif
 
 static esp_err_t lvgl_port_tick_init(void)
 {
+#if LV_TICK_CUSTOM
+    /* LVGL reads esp_timer directly: no periodic wakeup, time stays right across light sleep */
+    return ESP_OK;
+#else
     // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
     const esp_timer_create_args_t lvgl_tick_timer_args = {
         .callback = &lvgl_port_tick_increment,
@@ -619,4 +901,5 @@ static esp_err_t lvgl_port_tick_init(void)
     };
     ESP_RETURN_ON_ERROR(esp_timer_create(&lvgl_tick_timer_args, &lvgl_port_ctx.tick_timer), TAG, "Creating LVGL timer filed!");
     return esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_timer_period_ms * 1000);
+#endif
 }
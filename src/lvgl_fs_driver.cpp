@@ -2,15 +2,165 @@
  * ============================================================================
  * DRIVER DE FILESYSTEM LVGL - ESP-IDF (POSIX)
  * ============================================================================
+ *
+ * Os decoders de imagem abrem o mesmo arquivo várias vezes (info + open,
+ * reabertura ao trocar de tela). Para não descer até VFS/LittleFS a cada
+ * vez, o driver mantém FS_DRV_HANDLE_CACHE handles de leitura abertos
+ * depois do close da LVGL, com o tamanho (fstat) e o último bloco lido:
+ * reabrir um arquivo em cache não faz nenhuma syscall.
+ *
+ * Leituras pequenas passam por um bloco de read-ahead de FS_DRV_READAHEAD
+ * bytes; seek/tell são só aritmética sobre a posição lógica. Abrir para
+ * escrita descarta o handle em cache do mesmo caminho.
+ *
+ * Chamado apenas pela task da LVGL (dona única da LVGL), sem mutex.
  */
 
 #include "lvgl_fs_driver.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <dirent.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 static const char *TAG = "FS_DRV";
 
+// ============================================================================
+// ESTADO
+// ============================================================================
+
+typedef struct {
+    char path[FS_DRV_PATH_MAX];     // Caminho relativo (chave do cache)
+    int fd;
+    uint32_t size;                  // Tamanho em cache (fstat na abertura)
+    uint32_t pos;                   // Posição lógica vista pela LVGL
+    uint32_t fdPos;                 // Posição do fd no VFS (evita lseek redundante)
+    uint8_t *buf;                   // Bloco de read-ahead (alocado no primeiro uso)
+    uint32_t bufStart;              // Offset do bloco no arquivo
+    uint32_t bufLen;                // Bytes válidos no bloco
+    uint32_t lastUse;
+    bool inUse;                     // Aberto pela LVGL
+    bool cached;                    // Permanece aberto após o close
+    bool writable;
+    bool pooled;                    // Slot de s_files (senão, alocado avulso)
+} fs_file_t;
+
+static fs_file_t s_files[FS_DRV_HANDLE_CACHE];
+static uint32_t s_useCounter = 0;
+static lvgl_fs_stats_t s_stats;
+
+// ============================================================================
+// FUNÇÕES AUXILIARES
+// ============================================================================
+
+/**
+ * @brief Remove o prefixo "A:" que alguns chamadores deixam no caminho.
+ */
+static const char* fs_relative(const char *path) {
+    if (path[0] != '\0' && path[1] == ':') {
+        return path + 2;
+    }
+    return path;
+}
+
+static bool fs_full_path(char *out, size_t size, const char *rel) {
+    int n = snprintf(out, size, "%s%s", FS_BASE_PATH, rel);
+    return n > 0 && (size_t)n < size;
+}
+
+/**
+ * @brief Fecha o fd e libera o slot (ou o handle avulso).
+ */
+static void fs_release(fs_file_t *f) {
+    if (f->fd >= 0) {
+        close(f->fd);
+        s_stats.closes++;
+    }
+    f->fd = -1;
+    f->path[0] = '\0';
+    f->inUse = false;
+    f->cached = false;
+    f->bufLen = 0;
+
+    if (!f->pooled) {
+        heap_caps_free(f->buf);
+        lv_mem_free(f);
+    }
+}
+
+/**
+ * @brief Handle ocioso em cache para o caminho, se houver.
+ */
+static fs_file_t* fs_find_idle(const char *rel) {
+    for (int i = 0; i < FS_DRV_HANDLE_CACHE; i++) {
+        fs_file_t *f = &s_files[i];
+        if (f->cached && !f->inUse && strcmp(f->path, rel) == 0) {
+            return f;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Slot livre; sem nenhum, fecha o ocioso usado há mais tempo.
+ * Todos em uso: handle avulso, liberado no close.
+ */
+static fs_file_t* fs_alloc(void) {
+    fs_file_t *victim = NULL;
+    for (int i = 0; i < FS_DRV_HANDLE_CACHE; i++) {
+        fs_file_t *f = &s_files[i];
+        if (f->fd < 0 && !f->inUse) {
+            return f;
+        }
+        if (!f->inUse && (victim == NULL || f->lastUse < victim->lastUse)) {
+            victim = f;
+        }
+    }
+
+    if (victim) {
+        fs_release(victim);
+        return victim;
+    }
+
+    fs_file_t *f = (fs_file_t*)lv_mem_alloc(sizeof(fs_file_t));
+    if (f) {
+        memset(f, 0, sizeof(*f));
+        f->fd = -1;
+        f->pooled = false;
+    }
+    return f;
+}
+
+static bool fs_sync_pos(fs_file_t *f) {
+    if (f->fdPos == f->pos) {
+        return true;
+    }
+    s_stats.seeks++;
+    if (lseek(f->fd, f->pos, SEEK_SET) < 0) {
+        return false;
+    }
+    f->fdPos = f->pos;
+    return true;
+}
+
+/**
+ * @brief Lê direto do fd na posição lógica.
+ */
+static int fs_read_fd(fs_file_t *f, void *dst, uint32_t len) {
+    if (!fs_sync_pos(f)) {
+        return -1;
+    }
+    s_stats.reads++;
+    int n = read(f->fd, dst, len);
+    if (n > 0) {
+        f->fdPos += n;
+    }
+    return n;
+}
+
 // ============================================================================
 // FUNÇÕES DE CALLBACK POSIX PARA LVGL
 // ============================================================================
@@ -19,79 +169,276 @@ static const char *TAG = "FS_DRV";
  * @brief Tenta abrir um arquivo. Chamado pela LVGL.
  */
 static void* fs_open_cb(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode) {
-    const char *fs_mode;
+    int flags;
     if (mode == LV_FS_MODE_WR) {
-        fs_mode = "wb";
+        flags = O_WRONLY | O_CREAT | O_TRUNC;
     } else if (mode == LV_FS_MODE_RD) {
-        fs_mode = "rb";
+        flags = O_RDONLY;
     } else if (mode == (LV_FS_MODE_WR | LV_FS_MODE_RD)) {
-        fs_mode = "r+b";
+        flags = O_RDWR;
     } else {
         return NULL;
     }
 
-    // O caminho da LVGL vem como "A:/imagem.png"
-    // Construir o caminho completo para LittleFS
-    char full_path[256];
-    const char* fs_path = path;
-    if (fs_path[1] == ':') {
-        fs_path += 2; // Pula "A:"
+    // O caminho da LVGL vem como "/imagem.png" (letra do drive já removida)
+    const char *rel = fs_relative(path);
+    bool cacheable = (flags == O_RDONLY) && strlen(rel) < FS_DRV_PATH_MAX;
+
+    if (cacheable) {
+        fs_file_t *f = fs_find_idle(rel);
+        if (f) {
+            f->inUse = true;
+            f->pos = 0;
+            f->lastUse = ++s_useCounter;
+            s_stats.handleHits++;
+            ESP_LOGD(TAG, "Arquivo aberto (cache): %s", rel);
+            return f;
+        }
+    } else if (flags != O_RDONLY) {
+        // Conteúdo vai mudar: handle e bloco em cache ficariam velhos
+        fs_file_t *stale = fs_find_idle(rel);
+        if (stale) {
+            fs_release(stale);
+        }
     }
 
-    snprintf(full_path, sizeof(full_path), "/littlefs%s", fs_path);
+    char full_path[LV_FS_MAX_PATH_LENGTH];
+    if (!fs_full_path(full_path, sizeof(full_path), rel)) {
+        ESP_LOGW(TAG, "Caminho longo demais: %s", rel);
+        return NULL;
+    }
 
-    FILE* fp = fopen(full_path, fs_mode);
-    if (!fp) {
+    s_stats.opens++;
+    int fd = open(full_path, flags, 0666);
+    if (fd < 0) {
         ESP_LOGW(TAG, "Falha ao abrir: %s", full_path);
         return NULL;
     }
 
-    ESP_LOGI(TAG, "Arquivo aberto: %s", full_path);
-    return fp;
+    uint32_t size = 0;
+    if (flags != (O_WRONLY | O_CREAT | O_TRUNC)) {
+        struct stat st;
+        s_stats.stats++;
+        if (fstat(fd, &st) == 0) {
+            size = (uint32_t)st.st_size;
+        }
+    }
+
+    fs_file_t *f = fs_alloc();
+    if (!f) {
+        close(fd);
+        s_stats.closes++;
+        ESP_LOGW(TAG, "Sem memória para o handle: %s", full_path);
+        return NULL;
+    }
+
+    f->fd = fd;
+    f->size = size;
+    f->pos = 0;
+    f->fdPos = 0;
+    f->bufLen = 0;
+    f->inUse = true;
+    f->cached = cacheable && f->pooled;
+    f->writable = (flags != O_RDONLY);
+    f->lastUse = ++s_useCounter;
+    if (cacheable) {
+        strcpy(f->path, rel);
+    } else {
+        f->path[0] = '\0';
+    }
+
+    ESP_LOGD(TAG, "Arquivo aberto: %s (%lu bytes)", full_path, (unsigned long)size);
+    return f;
 }
 
 /**
  * @brief Fecha um arquivo. Chamado pela LVGL.
+ *
+ * Handles de leitura do cache continuam abertos para a próxima abertura.
  */
 static lv_fs_res_t fs_close_cb(lv_fs_drv_t *drv, void *file_p) {
-    FILE* fp = (FILE*)file_p;
-    fclose(fp);
+    fs_file_t *f = (fs_file_t*)file_p;
+    if (f->cached) {
+        f->inUse = false;
+        return LV_FS_RES_OK;
+    }
+    fs_release(f);
     return LV_FS_RES_OK;
 }
 
 /**
  * @brief Lê dados de um arquivo. Chamado pela LVGL.
+ *
+ * Pedidos menores que o bloco saem do read-ahead; maiores vão direto
+ * para o destino.
  */
 static lv_fs_res_t fs_read_cb(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br) {
-    FILE* fp = (FILE*)file_p;
-    *br = fread(buf, 1, btr, fp);
+    fs_file_t *f = (fs_file_t*)file_p;
+    uint8_t *dst = (uint8_t*)buf;
+    uint32_t done = 0;
+
+    while (done < btr) {
+        // Parte já presente no bloco
+        if (f->pos >= f->bufStart && f->pos < f->bufStart + f->bufLen) {
+            uint32_t n = f->bufStart + f->bufLen - f->pos;
+            if (n > btr - done) n = btr - done;
+            memcpy(dst + done, f->buf + (f->pos - f->bufStart), n);
+            f->pos += n;
+            done += n;
+            s_stats.bufferHits++;
+            continue;
+        }
+
+        uint32_t left = btr - done;
+        if (left >= FS_DRV_READAHEAD) {
+            int n = fs_read_fd(f, dst + done, left);
+            if (n < 0) {
+                *br = done;
+                return LV_FS_RES_FS_ERR;
+            }
+            f->pos += n;
+            done += n;
+            break;
+        }
+
+        if (!f->buf) {
+            f->buf = (uint8_t*)heap_caps_malloc(FS_DRV_READAHEAD, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            if (!f->buf) {
+                f->buf = (uint8_t*)heap_caps_malloc(FS_DRV_READAHEAD, MALLOC_CAP_8BIT);
+            }
+            if (!f->buf) {
+                // Sem bloco: leitura direta
+                int n = fs_read_fd(f, dst + done, left);
+                if (n < 0) {
+                    *br = done;
+                    return LV_FS_RES_FS_ERR;
+                }
+                f->pos += n;
+                done += n;
+                break;
+            }
+        }
+
+        f->bufStart = f->pos;
+        f->bufLen = 0;
+        int n = fs_read_fd(f, f->buf, FS_DRV_READAHEAD);
+        if (n < 0) {
+            *br = done;
+            return LV_FS_RES_FS_ERR;
+        }
+        if (n == 0) {
+            break;                  // Fim do arquivo
+        }
+        f->bufLen = n;
+    }
+
+    *br = done;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * @brief Escreve dados em um arquivo. Chamado pela LVGL.
+ */
+static lv_fs_res_t fs_write_cb(lv_fs_drv_t *drv, void *file_p, const void *buf, uint32_t btw, uint32_t *bw) {
+    fs_file_t *f = (fs_file_t*)file_p;
+    *bw = 0;
+    if (!f->writable) {
+        return LV_FS_RES_DENIED;
+    }
+    if (!fs_sync_pos(f)) {
+        return LV_FS_RES_FS_ERR;
+    }
+
+    s_stats.writes++;
+    int n = write(f->fd, buf, btw);
+    if (n < 0) {
+        return LV_FS_RES_FS_ERR;
+    }
+
+    f->fdPos += n;
+    f->pos += n;
+    if (f->pos > f->size) {
+        f->size = f->pos;
+    }
+    f->bufLen = 0;
+    *bw = n;
     return LV_FS_RES_OK;
 }
 
 /**
  * @brief Move o cursor de leitura. Chamado pela LVGL.
+ *
+ * Só atualiza a posição lógica; o lseek acontece na próxima leitura
+ * que não estiver no bloco.
  */
 static lv_fs_res_t fs_seek_cb(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence) {
-    FILE* fp = (FILE*)file_p;
-    int origin;
+    fs_file_t *f = (fs_file_t*)file_p;
+    int64_t target;
 
-    if (whence == LV_FS_SEEK_SET) origin = SEEK_SET;
-    else if (whence == LV_FS_SEEK_CUR) origin = SEEK_CUR;
-    else if (whence == LV_FS_SEEK_END) origin = SEEK_END;
+    if (whence == LV_FS_SEEK_SET) target = pos;
+    else if (whence == LV_FS_SEEK_CUR) target = (int64_t)f->pos + (int32_t)pos;
+    else if (whence == LV_FS_SEEK_END) target = (int64_t)f->size + (int32_t)pos;
     else return LV_FS_RES_INV_PARAM;
 
-    if (fseek(fp, pos, origin) == 0) {
-        return LV_FS_RES_OK;
+    if (target < 0 || target > UINT32_MAX) {
+        return LV_FS_RES_INV_PARAM;
     }
-    return LV_FS_RES_UNKNOWN;
+    f->pos = (uint32_t)target;
+    return LV_FS_RES_OK;
 }
 
 /**
  * @brief Informa a posição atual do cursor. Chamado pela LVGL.
  */
 static lv_fs_res_t fs_tell_cb(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p) {
-    FILE* fp = (FILE*)file_p;
-    *pos_p = ftell(fp);
+    fs_file_t *f = (fs_file_t*)file_p;
+    *pos_p = f->pos;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * @brief Abre um diretório. Chamado pela LVGL.
+ */
+static void* fs_dir_open_cb(lv_fs_drv_t *drv, const char *path) {
+    char full_path[LV_FS_MAX_PATH_LENGTH];
+    if (!fs_full_path(full_path, sizeof(full_path), fs_relative(path))) {
+        return NULL;
+    }
+
+    DIR *dir = opendir(full_path);
+    if (!dir) {
+        ESP_LOGW(TAG, "Falha ao abrir diretório: %s", full_path);
+        return NULL;
+    }
+    return dir;
+}
+
+/**
+ * @brief Próxima entrada do diretório. Chamado pela LVGL.
+ *
+ * Diretórios vêm com "/" na frente (convenção da LVGL); fim = fn vazio.
+ */
+static lv_fs_res_t fs_dir_read_cb(lv_fs_drv_t *drv, void *rddir_p, char *fn) {
+    DIR *dir = (DIR*)rddir_p;
+    struct dirent *entry;
+
+    do {
+        entry = readdir(dir);
+        if (!entry) {
+            fn[0] = '\0';
+            return LV_FS_RES_OK;
+        }
+    } while (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0);
+
+    snprintf(fn, LV_FS_MAX_FN_LENGTH, "%s%s", entry->d_type == DT_DIR ? "/" : "", entry->d_name);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * @brief Fecha um diretório. Chamado pela LVGL.
+ */
+static lv_fs_res_t fs_dir_close_cb(lv_fs_drv_t *drv, void *rddir_p) {
+    closedir((DIR*)rddir_p);
     return LV_FS_RES_OK;
 }
 
@@ -103,14 +450,39 @@ void lvgl_fs_init(char drive_letter) {
     static lv_fs_drv_t fs_drv;
     lv_fs_drv_init(&fs_drv);
 
+    for (int i = 0; i < FS_DRV_HANDLE_CACHE; i++) {
+        memset(&s_files[i], 0, sizeof(s_files[i]));
+        s_files[i].fd = -1;
+        s_files[i].pooled = true;
+    }
+    memset(&s_stats, 0, sizeof(s_stats));
+
     fs_drv.letter = drive_letter;
     fs_drv.open_cb = fs_open_cb;
     fs_drv.close_cb = fs_close_cb;
     fs_drv.read_cb = fs_read_cb;
+    fs_drv.write_cb = fs_write_cb;
     fs_drv.seek_cb = fs_seek_cb;
     fs_drv.tell_cb = fs_tell_cb;
+    fs_drv.dir_open_cb = fs_dir_open_cb;
+    fs_drv.dir_read_cb = fs_dir_read_cb;
+    fs_drv.dir_close_cb = fs_dir_close_cb;
 
     lv_fs_drv_register(&fs_drv);
 
-    ESP_LOGI(TAG, "Driver LittleFS para LVGL registrado na letra '%c'", drive_letter);
+    ESP_LOGI(TAG, "Driver LittleFS para LVGL registrado na letra '%c' (%d handles em cache, bloco de %d bytes)",
+             drive_letter, FS_DRV_HANDLE_CACHE, FS_DRV_READAHEAD);
+}
+
+void lvgl_fs_flush_cache(void) {
+    for (int i = 0; i < FS_DRV_HANDLE_CACHE; i++) {
+        fs_file_t *f = &s_files[i];
+        if (f->cached && !f->inUse) {
+            fs_release(f);
+        }
+    }
+}
+
+void lvgl_fs_get_stats(lvgl_fs_stats_t *stats) {
+    *stats = s_stats;
 }
@@ -0,0 +1,272 @@
+/**
+ * ============================================================================
+ * HEAP DA LVGL
+ * ============================================================================
+ *
+ * Pedidos ate LVGL_MEM_SMALL_MAX bytes vao para o pool TLSF (lv_tlsf) na
+ * RAM interna, criado na primeira alocacao (lv_init). Pedidos maiores, e
+ * os pequenos quando o pool esta cheio, vao para a PSRAM pelo heap_caps
+ * (RAM interna do sistema se nao houver PSRAM). free/realloc descobrem a
+ * origem do bloco pelo endereco.
+ *
+ * Como o lv_mem original, nao tem trava: so a task da LVGL aloca.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "lvgl_mem.h"
+#include "src/misc/lv_tlsf.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "LVGL_MEM";
+
+#define POOL_CAPS       (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define LARGE_CAPS      (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+
+static lv_tlsf_t s_tlsf;
+static uint8_t *s_pool;
+static bool s_initDone;
+static lvgl_mem_stats_t s_stats;
+
+// ============================================================================
+// TRACE
+// ============================================================================
+
+#if LVGL_MEM_TRACE
+typedef struct {
+    uintptr_t ptr;
+    uintptr_t newPtr;           // Realloc
+    uint32_t size;
+    char op;                    // 'a', 'f', 'r'
+} trace_event_t;
+
+static trace_event_t *s_trace;
+static uint32_t s_traceCount;
+static uint32_t s_traceDropped;
+
+static void trace(char op, const void *ptr, const void *newPtr, size_t size) {
+    if (!s_trace) return;
+    if (s_traceCount >= LVGL_MEM_TRACE_EVENTS) {
+        s_traceDropped++;
+        return;
+    }
+    trace_event_t *ev = &s_trace[s_traceCount++];
+    ev->op = op;
+    ev->ptr = (uintptr_t)ptr;
+    ev->newPtr = (uintptr_t)newPtr;
+    ev->size = (uint32_t)size;
+}
+#else
+#define trace(op, ptr, newPtr, size)
+#endif
+
+// ============================================================================
+// POOL
+// ============================================================================
+
+static void pool_init(void) {
+    s_initDone = true;
+
+    s_pool = heap_caps_malloc(LV_MEM_TLSF_POOL_SIZE, POOL_CAPS);
+    if (s_pool) {
+        s_tlsf = lv_tlsf_create_with_pool(s_pool, LV_MEM_TLSF_POOL_SIZE);
+        s_stats.poolSize = LV_MEM_TLSF_POOL_SIZE;
+        ESP_LOGI(TAG, "Pool de %u KB na RAM interna, blocos > %u B na PSRAM",
+                 (unsigned)(LV_MEM_TLSF_POOL_SIZE / 1024), (unsigned)LVGL_MEM_SMALL_MAX);
+    } else {
+        ESP_LOGW(TAG, "Sem RAM interna para o pool: LVGL inteira no heap_caps");
+    }
+
+#if LVGL_MEM_TRACE
+    s_trace = heap_caps_malloc(sizeof(trace_event_t) * LVGL_MEM_TRACE_EVENTS, LARGE_CAPS);
+    if (!s_trace) ESP_LOGW(TAG, "Sem memoria para o trace");
+#endif
+}
+
+static inline bool in_pool(const void *ptr) {
+    return s_pool && (const uint8_t *)ptr >= s_pool && (const uint8_t *)ptr < s_pool + LV_MEM_TLSF_POOL_SIZE;
+}
+
+static inline void pool_used_add(size_t bytes) {
+    s_stats.poolUsed += bytes;
+    s_stats.poolBlocks++;
+    if (s_stats.poolUsed > s_stats.poolPeak) s_stats.poolPeak = s_stats.poolUsed;
+}
+
+static inline void pool_used_sub(size_t bytes) {
+    s_stats.poolUsed -= bytes;
+    s_stats.poolBlocks--;
+}
+
+static inline void psram_used_add(void *ptr) {
+    s_stats.psramUsed += heap_caps_get_allocated_size(ptr);
+    if (s_stats.psramUsed > s_stats.psramPeak) s_stats.psramPeak = s_stats.psramUsed;
+}
+
+static void *pool_alloc(size_t size) {
+    if (!s_tlsf) return NULL;
+    void *ptr = lv_tlsf_malloc(s_tlsf, size);
+    if (ptr) {
+        pool_used_add(lv_tlsf_block_size(ptr));
+        s_stats.poolAllocs++;
+    } else {
+        s_stats.overflowAllocs++;
+    }
+    return ptr;
+}
+
+static void *large_alloc(size_t size) {
+    void *ptr = heap_caps_malloc(size, LARGE_CAPS);
+    if (!ptr) ptr = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    if (ptr) psram_used_add(ptr);
+    else s_stats.failedAllocs++;
+    return ptr;
+}
+
+// ============================================================================
+// API DA LVGL
+// ============================================================================
+
+void *lvgl_mem_alloc(size_t size) {
+    if (!s_initDone) pool_init();
+
+    void *ptr = NULL;
+    if (size <= LVGL_MEM_SMALL_MAX) {
+        ptr = pool_alloc(size);
+    } else {
+        s_stats.largeAllocs++;
+    }
+    if (!ptr) ptr = large_alloc(size);
+
+    trace('a', ptr, NULL, size);
+    return ptr;
+}
+
+void lvgl_mem_free(void *ptr) {
+    if (!ptr) return;
+    trace('f', ptr, NULL, 0);
+
+    if (in_pool(ptr)) {
+        pool_used_sub(lv_tlsf_block_size(ptr));
+        lv_tlsf_free(s_tlsf, ptr);
+    } else {
+        s_stats.psramUsed -= heap_caps_get_allocated_size(ptr);
+        heap_caps_free(ptr);
+    }
+}
+
+void *lvgl_mem_realloc(void *ptr, size_t size) {
+    if (!ptr) return lvgl_mem_alloc(size);
+
+    void *newPtr = NULL;
+    if (in_pool(ptr)) {
+        size_t oldSize = lv_tlsf_block_size(ptr);
+
+        // Cresce/encolhe no lugar quando da; senao o TLSF move dentro do pool
+        if (size <= LVGL_MEM_SMALL_MAX) newPtr = lv_tlsf_realloc(s_tlsf, ptr, size);
+
+        if (newPtr) {
+            s_stats.poolUsed -= oldSize;
+            s_stats.poolUsed += lv_tlsf_block_size(newPtr);
+            if (s_stats.poolUsed > s_stats.poolPeak) s_stats.poolPeak = s_stats.poolUsed;
+        } else {
+            // Grande demais para o pool (ou pool cheio): muda para a PSRAM
+            if (size > LVGL_MEM_SMALL_MAX) s_stats.largeAllocs++;
+            else s_stats.overflowAllocs++;
+            newPtr = large_alloc(size);
+            if (!newPtr) return NULL;
+            memcpy(newPtr, ptr, oldSize < size ? oldSize : size);
+            pool_used_sub(oldSize);
+            lv_tlsf_free(s_tlsf, ptr);
+        }
+    } else {
+        size_t oldSize = heap_caps_get_allocated_size(ptr);
+
+        // Encolheu para o tamanho de bloco pequeno: volta para o pool
+        if (size <= LVGL_MEM_SMALL_MAX) newPtr = pool_alloc(size);
+
+        if (newPtr) {
+            memcpy(newPtr, ptr, oldSize < size ? oldSize : size);
+            s_stats.psramUsed -= oldSize;
+            heap_caps_free(ptr);
+        } else {
+            newPtr = heap_caps_realloc(ptr, size, LARGE_CAPS);
+            if (!newPtr) newPtr = heap_caps_realloc(ptr, size, MALLOC_CAP_8BIT);
+            if (!newPtr) {
+                s_stats.failedAllocs++;
+                return NULL;
+            }
+            s_stats.psramUsed -= oldSize;
+            psram_used_add(newPtr);
+        }
+    }
+
+    trace('r', ptr, newPtr, size);
+    return newPtr;
+}
+
+// ============================================================================
+// RELATORIO
+// ============================================================================
+
+typedef struct {
+    uint32_t freeBytes;
+    uint32_t biggest;
+} pool_walk_t;
+
+static void pool_walker(void *ptr, size_t size, int used, void *user) {
+    (void)ptr;
+    pool_walk_t *walk = (pool_walk_t *)user;
+    if (used) return;
+    walk->freeBytes += (uint32_t)size;
+    if (size > walk->biggest) walk->biggest = (uint32_t)size;
+}
+
+void lvgl_mem_get_stats(lvgl_mem_stats_t *stats) {
+    *stats = s_stats;
+    stats->poolFreeBiggest = 0;
+    stats->poolFragPct = 0;
+    if (!s_tlsf) return;
+
+    pool_walk_t walk = {0, 0};
+    lv_tlsf_walk_pool(lv_tlsf_get_pool(s_tlsf), pool_walker, &walk);
+
+    stats->poolFreeBiggest = walk.biggest;
+    if (walk.freeBytes > 0) {
+        stats->poolFragPct = (uint8_t)(100 - (uint64_t)walk.biggest * 100 / walk.freeBytes);
+    }
+}
+
+void lvgl_mem_trace_dump(void) {
+#if LVGL_MEM_TRACE
+    if (!s_trace) return;
+
+    for (uint32_t i = 0; i < s_traceCount; i++) {
+        const trace_event_t *ev = &s_trace[i];
+        switch (ev->op) {
+            case 'a':
+                printf("LVMEM a %08" PRIxPTR " %" PRIu32 "\n", ev->ptr, ev->size);
+                break;
+            case 'f':
+                printf("LVMEM f %08" PRIxPTR "\n", ev->ptr);
+                break;
+            default:
+                printf("LVMEM r %08" PRIxPTR " %08" PRIxPTR " %" PRIu32 "\n", ev->ptr, ev->newPtr, ev->size);
+                break;
+        }
+    }
+    ESP_LOGI(TAG, "Trace: %" PRIu32 " operacoes, %" PRIu32 " descartadas (buffer cheio)",
+             s_traceCount, s_traceDropped);
+
+    s_traceCount = 0;
+    s_traceDropped = 0;
+#endif
+}
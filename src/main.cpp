@@ -14,6 +14,8 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
+#include <atomic>
 
 // FreeRTOS
 #include "freertos/FreeRTOS.h"
@@ -28,6 +30,9 @@
 
 // Core
 #include "core/app_init.h"
+#include "core/boot_scheduler.h"
+#include "core/boot_trace.h"
+#include "core/event_bus.h"
 
 // Utils
 #include "utils/time_utils.h"
@@ -46,10 +51,19 @@
 // Ignicao e Filesystem
 #include "ignicao_control.h"
 #include "lvgl_fs_driver.h"
+#include "lvgl_mem.h"
+
+// Bateria
+#include "services/battery/battery_service.h"
+#include "services/jornada/jornada_service.h"
+#include "services/power/power_service.h"
 
 // Nova arquitetura de telas
 #include "ui/screen_manager.h"
+#include "ui/common/glyph_cache.h"
+#include "ui/common/png_stream.h"
 #include "ui/widgets/status_bar.h"
+#include "ui/widgets/popup.h"
 #include "ui/screens/jornada_screen.h"
 #include "ui/screens/numpad_screen.h"
 #include "numpad_example.h"
@@ -67,6 +81,8 @@ static const char *TAG = "MAIN";
 static bool systemInitialized = false;
 static bool ignicaoLigada = false;
 static uint32_t ignicaoStartTime = 0;
+static std::atomic<bool> jornadaFlushRequested(false);  // Ignicao desligada: gravar totais
+static TaskHandle_t systemTaskHandle = nullptr;
 
 // StatusBar persistente (alocacao estatica)
 static StatusBar statusBar;
@@ -79,60 +95,195 @@ static NumpadScreen numpadScreen;
 static ScreenManagerImpl* screenMgr = nullptr;
 
 // ============================================================================
-// CALLBACK DE IGNICAO
+// CALLBACKS LEGADOS
 // ============================================================================
 
+// Requerido pela API legada de ignicao; executado na task IgnicaoMonitor.
+// A reacao da UI e do audio chega pelo EventBus (handlers abaixo).
 void onIgnicaoStatusChange(bool newStatus) {
-    if (!systemInitialized) return;
+    ESP_LOGD(TAG, "Ignicao: %s", newStatus ? "ON" : "OFF");
+}
 
-    if (newStatus) {
-        ESP_LOGI(TAG, "==================");
-        ESP_LOGI(TAG, "IGNICAO LIGADA");
-        ESP_LOGI(TAG, "==================");
+// Callback de jornada (requerido pelo jornada_manager)
+void onJornadaStateChange(void) {
+    ESP_LOGD(TAG, "Estado de jornada alterado");
+}
 
-        playAudioFile(AUDIO_FILE_IGN_ON);
+// ============================================================================
+// HANDLERS DO EVENTBUS
+// ============================================================================
 
+// Destino UI: executado na task LVGL, com o lock do display
+static void onIgnicaoEventUi(const AppEvent& event, void* ctx) {
+    bool on = event.ignicao.on;
+
+    ESP_LOGI(TAG, "==================");
+    ESP_LOGI(TAG, "IGNICAO %s", on ? "LIGADA" : "DESLIGADA");
+    ESP_LOGI(TAG, "==================");
+
+    if (on) {
         if (!ignicaoLigada) {
-            ignicaoStartTime = time_millis();
+            ignicaoStartTime = event.timestamp;
             ignicaoLigada = true;
         }
     } else {
-        ESP_LOGI(TAG, "==================");
-        ESP_LOGI(TAG, "IGNICAO DESLIGADA");
-        ESP_LOGI(TAG, "==================");
-
-        playAudioFile(AUDIO_FILE_IGN_OFF);
         ignicaoLigada = false;
+        // Gravacao na NVS fica na system_task (fora da task LVGL)
+        jornadaFlushRequested = true;
+        if (systemTaskHandle) {
+            xTaskNotifyGive(systemTaskHandle);
+        }
     }
 
-    // Atualiza barra de status via StatusBar diretamente
+    if (!systemInitialized) return;
+
     uint32_t tempoIgnicao = ignicaoLigada ? (time_millis() - ignicaoStartTime) : 0;
-    statusBar.setIgnicao(newStatus, tempoIgnicao);
+    statusBar.setIgnicao(on, tempoIgnicao);
 }
 
-// Callback de jornada (requerido pelo jornada_manager)
-void onJornadaStateChange(void) {
-    ESP_LOGD(TAG, "Estado de jornada alterado");
+static void onJornadaEventUi(const AppEvent& event, void* ctx) {
+    ESP_LOGD(TAG, "Jornada: motorista %d -> estado %d",
+             event.jornada.motoristaId, event.jornada.estado);
+}
+
+// Destino AUDIO: executado na task de audio (Core 1)
+static void onIgnicaoEventAudio(const AppEvent& event, void* ctx) {
+    playAudioFile(event.ignicao.on ? AUDIO_FILE_IGN_ON : AUDIO_FILE_IGN_OFF);
 }
 
 // ============================================================================
-// TASK PRINCIPAL DO SISTEMA
+// COMANDOS DA TASK LVGL
 // ============================================================================
 
-static void system_task(void *arg) {
-    // Aguarda splash terminar
-    while (!isSplashDone()) {
-        lv_timer_handler();
-        vTaskDelay(pdMS_TO_TICKS(10));
+// Executado a cada despertar da task LVGL: eventos dos servicos e tela atual
+static void uiPump(void* arg) {
+    EventBus* bus = static_cast<EventBus*>(arg);
+    if (bus->hasPending(EventSink::UI)) {
+        bus->dispatch(EventSink::UI);
     }
 
-    vTaskDelay(pdMS_TO_TICKS(100));
-    ESP_LOGI(TAG, "Completando inicializacao...");
+    if (screenMgr) {
+        screenMgr->update();
+    }
+}
+
+// Postado pela system_task a cada segundo: StatusBar com dados de ignicao
+static void statusBarTick(void* arg) {
+    bool ignicaoOn = getIgnicaoStatus();
+    uint32_t tempoIgnicao = (ignicaoLigada && ignicaoOn) ? (time_millis() - ignicaoStartTime) : 0;
+    StatusBarData data = {
+        .ignicaoOn = ignicaoOn,
+        .tempoIgnicao = tempoIgnicao,
+        .tempoJornada = 0,
+        .mensagem = nullptr
+    };
+    statusBar.update(data);
+}
+
+// Postado pela system_task a cada IMG_CACHE_REPORT_PERIOD_MS: contadores do
+// cache de imagens da LVGL (lidos na task dona da LVGL)
+static void imageCacheReport(void* arg) {
+    static lv_img_cache_stats_t last = {};
+    lv_img_cache_stats_t s;
+    lv_img_cache_get_stats(&s);
+
+    uint32_t hits = s.hits - last.hits;
+    uint32_t lookups = hits + (s.misses - last.misses);
+    ESP_LOGI(TAG, "Cache de imagens: acertos %" PRIu32 "%% (%" PRIu32 "/%" PRIu32 "), %" PRIu32
+             " evicoes, %" PRIu32 " abertas, %" PRIu32 " B (pico %" PRIu32 " B)",
+             lookups ? hits * 100 / lookups : 0, hits, lookups, s.evictions - last.evictions,
+             s.entries, s.bytes, s.bytes_peak);
+    last = s;
+}
+
+// Postado pela system_task a cada LVGL_MEM_REPORT_PERIOD_MS: uso do pool da
+// LVGL na RAM interna e do que transbordou para a PSRAM
+static void lvglMemReport(void* arg) {
+    lvgl_mem_stats_t s;
+    lvgl_mem_get_stats(&s);
 
-    // Inicializa subsistema de audio
+    ESP_LOGI(TAG, "Heap LVGL: pool %" PRIu32 "/%" PRIu32 " B (pico %" PRIu32 " B, maior livre %" PRIu32
+             " B, frag %u%%), PSRAM %" PRIu32 " B (pico %" PRIu32 " B), %" PRIu32 " grandes, %" PRIu32
+             " transbordos, %" PRIu32 " falhas",
+             s.poolUsed, s.poolSize, s.poolPeak, s.poolFreeBiggest, (unsigned)s.poolFragPct,
+             s.psramUsed, s.psramPeak, s.largeAllocs, s.overflowAllocs, s.failedAllocs);
+
+    lvgl_mem_trace_dump();
+}
+
+// ============================================================================
+// ETAPAS DO BOOT
+// ============================================================================
+// Executadas pelo BootScheduler na system_task (core 0) e na task auxiliar
+// (core 1). Etapas que registram interrupcoes ficam no core 0, como antes:
+// o ISR fica no core de quem o instala.
+
+static bool stageFilesystem(void* arg) {
+    if (!app_init_filesystem()) {
+        ESP_LOGE(TAG, "ERRO: Falha ao montar LittleFS!");
+        return false;
+    }
+    return true;
+}
+
+static bool stageDisplay(void* arg) {
+    ESP_LOGI(TAG, "Inicializando display...");
+
+    bsp_display_cfg_t cfg = {
+        .lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG(),
+        .buffer_size = DISPLAY_BUFFER_SIZE,
+        .rotate = LV_DISP_ROT_90,
+    };
+    // Task LVGL: unica dona do LVGL (timers, input, render)
+    cfg.lvgl_port_cfg.task_priority = LVGL_TASK_PRIORITY;
+    cfg.lvgl_port_cfg.task_stack = LVGL_TASK_STACK_SIZE;
+    cfg.lvgl_port_cfg.task_affinity = LVGL_TASK_CORE;
+
+    if (!bsp_display_start_with_config(&cfg)) {
+        ESP_LOGE(TAG, "ERRO: Falha ao iniciar o display!");
+        return false;
+    }
+    bsp_display_backlight_on();
+    return true;
+}
+
+// Extensoes da LVGL usadas desde o splash
+static bool stageLvglExtensions(void* arg) {
+    bsp_display_lock(0);
+
+    // Driver de filesystem LVGL
+    lvgl_fs_init('A');
+
+    // Decoders PNG: streaming por linha (consultado primeiro) e lv_png como
+    // fallback para PNG entrelacado ou em memoria
+    lv_png_init();
+    png_stream_init();
+
+    // Cache de glifos no draw_letter (antes da primeira tela)
+    GlyphCache::getInstance()->init();
+
+    bsp_display_unlock();
+
+    ESP_LOGI(TAG, "Display inicializado!");
+    return true;
+}
+
+static bool stageSplash(void* arg) {
+    ESP_LOGI(TAG, "Exibindo splash screen...");
+    createSplashScreen();
+    return true;
+}
+
+// Cria a task de audio no Core 1, que aloca os buffers e inicia o I2S
+// enquanto o display sobe
+static bool stageAudio(void* arg) {
     initSimpleAudio();
+    return true;
+}
 
+static bool stageIgnicao(void* arg) {
     // Controle de ignicao (antes da UI, para saber estado inicial)
+    // API legada: shim sobre o IgnicaoService (uma unica task de monitoramento)
     if (initIgnicaoControl(IGNICAO_DEBOUNCE_ON_S, IGNICAO_DEBOUNCE_OFF_S, true)) {
         bool initialState = getIgnicaoStatus();
         ESP_LOGI(TAG, "Estado inicial da ignicao: %s", initialState ? "ON" : "OFF");
@@ -142,9 +293,99 @@ static void system_task(void *arg) {
             ignicaoLigada = true;
         }
     }
+    return true;
+}
+
+static bool stageJornada(void* arg) {
+    // Jornada: restaura totais persistidos (RTC/NVS)
+    JornadaService::getInstance()->init();
+    return true;
+}
+
+static bool stageBattery(void* arg) {
+    // Monitoramento da bateria (ADC continuo em rajadas)
+    BatteryService* battery = BatteryService::getInstance();
+    if (battery->init()) {
+        battery->start();
+    }
+    return true;
+}
+
+// Pre-cria as telas durante a animacao do splash (troca instantanea depois).
+// Uma trava por tela: entre as duas a task LVGL volta a animar a barra.
+static bool stageScreens(void* arg) {
+    bsp_display_lock(0);
+    jornadaScreen.create();
+    bsp_display_unlock();
+
+    bsp_display_lock(0);
+    numpadScreen.create();
+    bsp_display_unlock();
+    return true;
+}
+
+// ============================================================================
+// TASK PRINCIPAL DO SISTEMA
+// ============================================================================
+
+static void system_task(void *arg) {
+    systemTaskHandle = xTaskGetCurrentTaskHandle();
+
+    // Foto dos recursos antes do boot (relatorio de RAM/tasks)
+    debug_resource_snapshot_t beforeBoot;
+    debug_take_resource_snapshot(&beforeBoot);
+
+    // Barramento de eventos: inscricoes antes de qualquer produtor
+    EventBus* bus = EventBus::getInstance();
+    bus->subscribe(EventSink::UI, EventType::IGNICAO_CHANGED, onIgnicaoEventUi);
+    bus->subscribe(EventSink::UI, EventType::JORNADA_CHANGED, onJornadaEventUi);
+    bus->subscribe(EventSink::AUDIO, EventType::IGNICAO_CHANGED, onIgnicaoEventAudio);
+
+    // Etapas na ordem do caminho critico (display -> splash -> telas); as
+    // independentes preenchem o outro core
+    BootScheduler boot;
+    int display = boot.add("display", stageDisplay, 0, 0);
+    int fs      = boot.add("fs", stageFilesystem);
+    boot.add("audio", stageAudio);
+    boot.add("jornada", stageJornada);
+    int lvglExt = boot.add("lvgl_ext", stageLvglExtensions, BOOT_DEP(display), 0);
+    int splash  = boot.add("splash", stageSplash, BOOT_DEP(lvglExt) | BOOT_DEP(fs));
+    boot.add("ignicao", stageIgnicao, 0, 0);
+    boot.add("bateria", stageBattery, 0, 0);
+    boot.add("telas", stageScreens, BOOT_DEP(splash));
+
+    if (!boot.run()) {
+        ESP_LOGE(TAG, "Boot interrompido: etapa essencial falhou");
+        boot_trace_report();
+        vTaskDelete(NULL);
+        return;
+    }
+
+    debug_resource_snapshot_t afterBoot;
+    debug_take_resource_snapshot(&afterBoot);
+    debug_print_resource_delta("boot", &beforeBoot, &afterBoot);
+
+    // Aguarda o splash terminar (animado pela task LVGL); as telas ja
+    // foram criadas durante ele
+    while (!isSplashDone()) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    ESP_LOGI(TAG, "Completando inicializacao...");
+
+    JornadaService* jornada = JornadaService::getInstance();
+    BatteryService* battery = BatteryService::getInstance();
+
+    // Construcao unica da UI: um lock para toda a arvore (a task LVGL
+    // fica parada ate a tela inicial estar pronta)
+    bsp_display_lock(0);
 
     // Cria e inicializa StatusBar no lv_layer_top()
     statusBar.create();
+    statusBar.setBatteryService(battery);
+
+    // Popup padrao pre-alocado no lv_layer_top() (show() so reatribui conteudo)
+    PopupService::getInstance()->init();
 
     // Cria e inicializa ScreenManager
     screenMgr = ScreenManagerImpl::getInstance();
@@ -154,15 +395,10 @@ static void system_task(void *arg) {
     // Conecta StatusBar ao ScreenManager (para callbacks menu/back)
     statusBar.setScreenManager(screenMgr);
 
-    // Registra telas
+    // Registra telas (ja criadas pela etapa "telas")
     screenMgr->registerScreen(&jornadaScreen);
     screenMgr->registerScreen(&numpadScreen);
 
-    // Pre-cria todas as telas no boot para troca instantanea
-    // (evita lag na primeira navegacao)
-    jornadaScreen.create();
-    numpadScreen.create();
-
     // Conecta StatusBar ao NumpadExample (preview dos digitos na barra persistente)
     NumpadExample::getInstance()->setStatusBar(&statusBar);
 
@@ -173,6 +409,15 @@ static void system_task(void *arg) {
     deleteSplashScreen();
 
     systemInitialized = true;
+    bsp_display_unlock();
+
+    // Daqui em diante a UI so e tocada pela task LVGL: eventos chegam pelo
+    // EventBus (que acorda a task) e atualizacoes periodicas por comandos
+    bus->setSinkTask(EventSink::UI, lvgl_port_get_task());
+    lvgl_port_set_pump_cb(uiPump, bus);
+
+    boot_trace_mark(BOOT_MARK_INTERACTIVE);
+    boot_trace_report();
 
     ESP_LOGI(TAG, "=================================");
     ESP_LOGI(TAG, "Sistema Pronto! (v2 Screen Manager)");
@@ -181,35 +426,46 @@ static void system_task(void *arg) {
     ESP_LOGI(TAG, "- Voltar: Retorna tela anterior");
     ESP_LOGI(TAG, "=================================");
 
-    // Loop principal
+    // Boot concluido: daqui em diante o chip dorme sempre que nenhuma
+    // trava de energia (render, audio, debounce) estiver ativa
+    PowerService* power = PowerService::getInstance();
+    power->init();
+
+    // Loop principal: tarefas de servico (1 Hz ou quando notificado)
     uint32_t lastUpdate = 0;
+    uint32_t lastImgCacheReport = time_millis();
+    uint32_t lastLvglMemReport = time_millis();
 
     while (1) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
         uint32_t now = time_millis();
 
-        // Atualizacao periodica (1 segundo) - StatusBar com dados de ignicao
         if ((now - lastUpdate) >= 1000) {
             lastUpdate = now;
 
-            bool ignicaoOn = getIgnicaoStatus();
-            uint32_t tempoIgnicao = (ignicaoLigada && ignicaoOn) ? (now - ignicaoStartTime) : 0;
-            StatusBarData data = {
-                .ignicaoOn = ignicaoOn,
-                .tempoIgnicao = tempoIgnicao,
-                .tempoJornada = 0,
-                .mensagem = nullptr
-            };
-            statusBar.update(data);
-        }
+            lvgl_port_post(statusBarTick, nullptr);
 
-        // Atualiza tela atual via ScreenManager
-        if (screenMgr) {
-            screenMgr->update();
+            // Flush agregado dos totais de jornada (tempo/limiar)
+            jornada->flushIfDue();
+
+            power->reportIfDue(now);
+            GlyphCache::getInstance()->reportIfDue(now);
+
+            if ((now - lastImgCacheReport) >= IMG_CACHE_REPORT_PERIOD_MS) {
+                lastImgCacheReport = now;
+                lvgl_port_post(imageCacheReport, nullptr);
+            }
+
+            if ((now - lastLvglMemReport) >= LVGL_MEM_REPORT_PERIOD_MS) {
+                lastLvglMemReport = now;
+                lvgl_port_post(lvglMemReport, nullptr);
+            }
         }
 
-        // Processa eventos LVGL
-        lv_timer_handler();
-        vTaskDelay(pdMS_TO_TICKS(5));
+        // Fora da task LVGL: a escrita na NVS pode levar alguns ms
+        if (jornadaFlushRequested.exchange(false)) {
+            jornada->flush();
+        }
     }
 }
 
@@ -221,37 +477,8 @@ extern "C" void app_main(void) {
     // Imprime informacoes de versao
     app_print_version();
 
-    // Inicializa filesystem
-    if (!app_init_filesystem()) {
-        ESP_LOGE(TAG, "ERRO: Falha ao montar LittleFS!");
-        return;
-    }
-
-    // Inicializa display
-    ESP_LOGI(TAG, "Inicializando display...");
-
-    bsp_display_cfg_t cfg = {
-        .lvgl_port_cfg = ESP_LVGL_PORT_INIT_CONFIG(),
-        .buffer_size = DISPLAY_BUFFER_SIZE,
-        .rotate = LV_DISP_ROT_90,
-    };
-
-    bsp_display_start_with_config(&cfg);
-    bsp_display_backlight_on();
-
-    // Inicializa driver de filesystem LVGL
-    lvgl_fs_init('A');
-
-    // Inicializa decoder PNG
-    lv_png_init();
-
-    ESP_LOGI(TAG, "Display inicializado!");
-
-    // Exibe splash screen
-    ESP_LOGI(TAG, "Exibindo splash screen...");
-    createSplashScreen();
-
-    // Cria task principal
+    // Todo o boot roda na system_task: etapas em paralelo nos dois cores
+    // e, ao fim do splash, a montagem da UI
     xTaskCreatePinnedToCore(
         system_task,
         "system_task",
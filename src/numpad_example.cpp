@@ -41,7 +41,7 @@ static NumpadExample* g_numpadInstance = nullptr;
 NumpadExample::NumpadExample() :
     btnManager(nullptr),
     statusBar_(nullptr),
-    currentNumber(""),
+    currentNumber(),
     maxDigits(11),
     displayLabel(nullptr),
     timeoutTimer(nullptr),
@@ -103,19 +103,12 @@ void NumpadExample::createNumpad() {
     
     // Limpa teclado anterior se existir
     clearNumpad();
-    currentNumber = "";
+    currentNumber.clear();
     lastDigitTime = 0;
     g_numpadInstance = this;
     
-    esp_rom_printf("==============================================");
-    esp_rom_printf("  CRIANDO TECLADO NUMÉRICO (SISTEMA ROBUSTO)");
-    esp_rom_printf("==============================================");
-    
-    // ========================================================================
-    // MÉTODO 1: CRIAÇÃO EM LOTE (RECOMENDADO)
-    // ========================================================================
-    
-    std::vector<ButtonManager::ButtonBatchDef> buttonDefs = {
+    // Definição declarativa dos 12 botões
+    const ButtonManager::ButtonBatchDef buttonDefs[12] = {
         // Primeira linha: 1, 2, 3, CANCELAR
         {0, 0, "1", ICON_NONE, nullptr, lv_color_hex(0x4444FF), onDigitClick, 
          1, 1, lv_color_hex(0xFFFFFF), &lv_font_montserrat_42},
@@ -156,9 +149,12 @@ void NumpadExample::createNumpad() {
          1, 1, lv_color_hex(0x000000), &lv_font_montserrat_16}
     };
     
-    // Criar todos os botões em lote (com retry automático)
-    esp_rom_printf("📦 Iniciando criação em lote de 12 botões...");
-    std::vector<int> ids = btnManager->addButtonBatch(buttonDefs);
+    // Constrói a grade inteira em uma passada (síncrono)
+    int ids[12];
+    int created = btnManager->buildGrid(buttonDefs, 12, ids);
+    if (created != 12) {
+        ESP_LOGE(TAG, "Teclado numerico incompleto: %d/12 botoes", created);
+    }
     
     // Mapear IDs para os arrays internos
     btnIds[1] = ids[0];   // Botão "1"
@@ -174,98 +170,6 @@ void NumpadExample::createNumpad() {
     btnIds[9] = ids[10];  // Botão "9"
     btnIds[11] = ids[11]; // ENVIAR
     
-    // ========================================================================
-    // VERIFICAÇÃO DE CRIAÇÃO
-    // ========================================================================
-    
-    esp_rom_printf("\n🔍 Verificando criação dos botões...");
-    
-    // Aguardar confirmação de criação (com timeout de 1 segundo)
-    if (btnManager->waitForAllButtons(ids, 1000)) {
-        esp_rom_printf("✅ SUCESSO: Todos os botões foram criados!");
-        
-        // Verificar status individual para debug
-        esp_rom_printf("\n📊 Status individual dos botões:");
-        const char* labels[] = {"1", "2", "3", "CANCELAR", "4", "5", "6", "0", "7", "8", "9", "ENVIAR"};
-        for (size_t i = 0; i < ids.size(); i++) {
-            auto status = btnManager->getButtonCreationStatus(ids[i]);
-            const char* statusStr = "";
-            const char* emoji = "";
-            
-            switch(status) {
-                case ButtonManager::CREATION_SUCCESS:
-                    statusStr = "CRIADO";
-                    emoji = "✓";
-                    break;
-                case ButtonManager::CREATION_PENDING:
-                    statusStr = "PENDENTE";
-                    emoji = "⏳";
-                    break;
-                case ButtonManager::CREATION_FAILED:
-                    statusStr = "FALHOU";
-                    emoji = "✗";
-                    break;
-            }
-            
-            esp_rom_printf("  %s Botão '%s' (ID: %d): %s\n", 
-                         emoji, labels[i], ids[i], statusStr);
-        }
-        
-    } else {
-        esp_rom_printf("⚠️ AVISO: Alguns botões podem não ter sido criados");
-        esp_rom_printf("📊 Botões pendentes: %d\n", btnManager->getPendingButtonCount());
-        
-        // Diagnóstico detalhado
-        esp_rom_printf("\n🔧 Diagnóstico detalhado:");
-        for (size_t i = 0; i < ids.size(); i++) {
-            auto status = btnManager->getButtonCreationStatus(ids[i]);
-            if (status != ButtonManager::CREATION_SUCCESS) {
-                esp_rom_printf("  ⚠ Botão ID %d está %s\n", 
-                             ids[i], 
-                             (status == ButtonManager::CREATION_PENDING) ? "PENDENTE" : "COM FALHA");
-            }
-        }
-        
-        // Aguardar mais um pouco se houver pendentes
-        if (btnManager->getPendingButtonCount() > 0) {
-            esp_rom_printf("\n⏳ Aguardando processamento de pendentes...");
-            vTaskDelay(pdMS_TO_TICKS(500));
-            
-            // Verificar novamente
-            int pendingCount = btnManager->getPendingButtonCount();
-            if (pendingCount == 0) {
-                esp_rom_printf("✅ Todos os botões pendentes foram processados!");
-            } else {
-                esp_rom_printf("⚠ Ainda há %d botões pendentes\n", pendingCount);
-            }
-        }
-    }
-    
-    // ========================================================================
-    // MÉTODO 2: CRIAÇÃO INDIVIDUAL (ALTERNATIVA)
-    // ========================================================================
-    /*
-    // Se preferir criar individualmente (também com retry automático):
-    btnIds[1] = btnManager->addButton(0, 0, "1", ICON_NONE, nullptr,
-                                      lv_color_hex(0x4444FF), onDigitClick, 1, 1,
-                                      lv_color_hex(0xFFFFFF), &lv_font_montserrat_42);
-    
-    // ... resto dos botões ...
-    
-    // Verificar criação individual
-    for (int i = 0; i <= 11; i++) {
-        if (btnIds[i] != -1) {
-            auto status = btnManager->getButtonCreationStatus(btnIds[i]);
-            if (status == ButtonManager::CREATION_SUCCESS) {
-                esp_rom_printf("✓ Botão %d criado com sucesso\n", i);
-            } else {
-                esp_rom_printf("⚠ Botão %d está %s\n", i,
-                             (status == ButtonManager::CREATION_PENDING) ? "pendente" : "com falha");
-            }
-        }
-    }
-    */
-    
     // ========================================================================
     // FINALIZAÇÃO
     // ========================================================================
@@ -302,7 +206,7 @@ void NumpadExample::clearNumpad() {
     }
     
     displayLabel = nullptr;
-    currentNumber = "";
+    currentNumber.clear();
     lastDigitTime = 0;
     
     esp_rom_printf("✓ Teclado numérico removido com segurança");
@@ -341,7 +245,7 @@ void NumpadExample::setStatusBar(StatusBar* bar) {
 }
 
 void NumpadExample::onExitScreen() {
-    currentNumber = "";
+    currentNumber.clear();
     lastDigitTime = 0;
     stopTimeoutTimer();
     if (statusBar_) {
@@ -364,7 +268,7 @@ void NumpadExample::timeoutTimerCallback(lv_timer_t* timer) {
         esp_rom_printf("⏱️ TIMEOUT: Limpando número");
 
         playAudioFile("/nok_click.mp3");
-        numpad->currentNumber = "";
+        numpad->currentNumber.clear();
         numpad->lastDigitTime = 0;
 
         if (numpad->statusBar_) {
@@ -381,7 +285,7 @@ void NumpadExample::timeoutTimerCallback(lv_timer_t* timer) {
 // ============================================================================
 
 void NumpadExample::addDigit(int digit) {
-    if (currentNumber.length() >= maxDigits) {
+    if ((int)currentNumber.length() >= maxDigits) {
         esp_rom_printf("Numero maximo de digitos atingido");
 
         if (statusBar_) {
@@ -394,7 +298,7 @@ void NumpadExample::addDigit(int digit) {
         return;
     }
     
-    currentNumber += std::to_string(digit);
+    currentNumber.push_back((char)('0' + digit));
     
     // Atualiza tempo do último dígito
     lastDigitTime = millis();
@@ -426,7 +330,7 @@ void NumpadExample::removeLastDigit() {
 }
 
 void NumpadExample::clearNumber() {
-    currentNumber = "";
+    currentNumber.clear();
     lastDigitTime = 0;
     updateDisplay();
     esp_rom_printf("Numero limpo");
@@ -469,7 +373,8 @@ void NumpadExample::onOkClick(int buttonId) {
     NumpadExample* numpad = getInstance();
     if (!numpad || !numpad->btnManager) return;
     
-    std::string number = numpad->getNumber();
+    // Copia local: o numero e limpo antes do log final
+    FixedString<NUMPAD_MAX_DIGITS + 1> number = numpad->currentNumber;
     
     // Verifica se há número digitado
     if (number.empty()) {
@@ -0,0 +1,69 @@
+/**
+ * ============================================================================
+ * FILTRO DE BATERIA - IMPLEMENTACAO
+ * ============================================================================
+ *
+ * Mediana por insertion sort (quadros pequenos, sem alocacao) e IIR em
+ * ponto fixo. Sem dependencias do ESP-IDF.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "services/battery/battery_filter.h"
+
+void battery_filter_init(battery_filter_t* f, uint8_t shift) {
+    if (!f) return;
+    f->state = 0;
+    f->shift = shift;
+    f->primed = false;
+}
+
+uint16_t battery_filter_median(uint16_t* samples, size_t count) {
+    if (!samples || count == 0) return 0;
+
+    // Insertion sort: quadros de ate ~100 amostras, quase ordenados (sinal DC)
+    for (size_t i = 1; i < count; i++) {
+        uint16_t key = samples[i];
+        size_t j = i;
+        while (j > 0 && samples[j - 1] > key) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = key;
+    }
+
+    if (count & 1) {
+        return samples[count / 2];
+    }
+    return (uint16_t)(((uint32_t)samples[count / 2 - 1] + samples[count / 2] + 1) / 2);
+}
+
+uint16_t battery_filter_update(battery_filter_t* f, uint16_t value) {
+    if (!f) return value;
+
+    int32_t x = (int32_t)value << BATTERY_FILTER_FRAC_BITS;
+
+    if (!f->primed) {
+        // Primeira amostra carrega o estado (evita rampa a partir de zero)
+        f->state = x;
+        f->primed = true;
+    } else {
+        f->state += (x - f->state) >> f->shift;
+    }
+
+    return battery_filter_value(f);
+}
+
+uint16_t battery_filter_value(const battery_filter_t* f) {
+    if (!f || !f->primed) return 0;
+    return (uint16_t)((f->state + (1 << (BATTERY_FILTER_FRAC_BITS - 1))) >> BATTERY_FILTER_FRAC_BITS);
+}
+
+bool battery_filter_low(bool low, uint16_t mv, uint16_t lowMv, uint16_t hystMv) {
+    if (!low && mv < lowMv) return true;
+    if (low && mv > (uint32_t)lowMv + hystMv) return false;
+    return low;
+}
@@ -0,0 +1,449 @@
+/**
+ * ============================================================================
+ * SERVICO DE BATERIA - IMPLEMENTACAO
+ * ============================================================================
+ *
+ * O ADC continuo roda apenas durante uma rajada de um quadro DMA a cada
+ * BATTERY_SAMPLE_PERIOD_MS; no resto do tempo o driver fica parado.
+ * A leitura filtrada e publicada em um unico atomico, entao a UI pode
+ * consulta-la a partir do loop LVGL sem mutex.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "services/battery/battery_service.h"
+#include "config/app_config.h"
+#include "utils/debug_utils.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "soc/soc_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+LOG_TAG("BATTERY_SVC");
+
+// ============================================================================
+// CONSTANTES
+// ============================================================================
+
+#define BATTERY_FRAME_BYTES     (BATTERY_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+#define BATTERY_CONV_TIMEOUT_MS 50
+
+#define PUB_MV_MASK             0xFFFFu
+#define PUB_LOW_BIT             (1u << 16)
+#define PUB_VALID_BIT           (1u << 17)
+
+// ============================================================================
+// IMPLEMENTACAO DA CLASSE
+// ============================================================================
+
+BatteryService* BatteryService::instance = nullptr;
+
+BatteryService::BatteryService()
+    : adcHandle(nullptr)
+    , caliHandle(nullptr)
+    , adcUnit(ADC_UNIT_1)
+    , adcChannel(ADC_CHANNEL_0)
+    , published(0)
+    , lowState(false)
+    , exitSem(nullptr)
+    , taskHandle(nullptr)
+    , callback(nullptr)
+    , initialized(false)
+    , running(false)
+    , filterTotalUs(0)
+{
+    battery_filter_init(&filter, BATTERY_IIR_SHIFT);
+    memset(&stats, 0, sizeof(stats));
+}
+
+BatteryService::~BatteryService() {
+    // stop() so volta depois que a task saiu da rajada: o ADC ja esta parado
+    stop();
+    if (adcHandle) {
+        adc_continuous_deinit(adcHandle);
+        adcHandle = nullptr;
+    }
+    if (exitSem) {
+        vSemaphoreDelete(exitSem);
+        exitSem = nullptr;
+    }
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    if (caliHandle) {
+        adc_cali_delete_scheme_curve_fitting(caliHandle);
+        caliHandle = nullptr;
+    }
+#endif
+}
+
+BatteryService* BatteryService::getInstance() {
+    if (instance == nullptr) {
+        instance = new BatteryService();
+    }
+    return instance;
+}
+
+void BatteryService::destroyInstance() {
+    if (instance != nullptr) {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+// ============================================================================
+// INICIALIZACAO
+// ============================================================================
+
+bool BatteryService::init() {
+    if (initialized) {
+        LOG_W(TAG, "Servico ja inicializado");
+        return true;
+    }
+
+    // Aviso de saida da task (stop espera antes de apagar o handle)
+    if (!exitSem) {
+        exitSem = xSemaphoreCreateBinary();
+        if (!exitSem) {
+            LOG_E(TAG, "Falha ao criar semaforo de saida");
+            return false;
+        }
+    }
+
+    esp_err_t ret = adc_continuous_io_to_channel(BAT_ADC_PIN, &adcUnit, &adcChannel);
+    if (ret != ESP_OK || adcUnit != ADC_UNIT_1) {
+        LOG_E(TAG, "GPIO%d nao e um canal do ADC1", BAT_ADC_PIN);
+        return false;
+    }
+
+    adc_continuous_handle_cfg_t handleCfg = {
+        .max_store_buf_size = BATTERY_FRAME_BYTES * 2,
+        .conv_frame_size = BATTERY_FRAME_BYTES,
+    };
+    ret = adc_continuous_new_handle(&handleCfg, &adcHandle);
+    if (ret != ESP_OK) {
+        LOG_ERR_CODE(TAG, ret);
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {
+        .atten = ADC_ATTEN_DB_12,
+        .channel = (uint8_t)adcChannel,
+        .unit = (uint8_t)adcUnit,
+        .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+
+    adc_continuous_config_t digCfg = {
+        .pattern_num = 1,
+        .adc_pattern = &pattern,
+        .sample_freq_hz = BATTERY_SAMPLE_FREQ_HZ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+    };
+    ret = adc_continuous_config(adcHandle, &digCfg);
+    if (ret != ESP_OK) {
+        LOG_ERR_CODE(TAG, ret);
+        adc_continuous_deinit(adcHandle);
+        adcHandle = nullptr;
+        return false;
+    }
+
+    adc_continuous_evt_cbs_t cbs = {};
+    cbs.on_conv_done = onConvDone;
+    adc_continuous_register_event_callbacks(adcHandle, &cbs, this);
+
+    // Calibracao (eFuse). Sem ela, cai para conversao linear aproximada.
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    adc_cali_curve_fitting_config_t caliCfg = {
+        .unit_id = adcUnit,
+        .chan = adcChannel,
+        .atten = ADC_ATTEN_DB_12,
+        .bitwidth = ADC_BITWIDTH_DEFAULT,
+    };
+    if (adc_cali_create_scheme_curve_fitting(&caliCfg, &caliHandle) != ESP_OK) {
+        caliHandle = nullptr;
+    }
+#endif
+    if (!caliHandle) {
+        LOG_W(TAG, "Calibracao do ADC indisponivel, usando conversao linear");
+    }
+
+    initialized = true;
+    LOG_I(TAG, "Bateria inicializada. GPIO%d (ADC1 canal %d), %d amostras a cada %d ms",
+          BAT_ADC_PIN, (int)adcChannel, BATTERY_FRAME_SAMPLES, BATTERY_SAMPLE_PERIOD_MS);
+
+    return true;
+}
+
+// ============================================================================
+// GETTERS (LOCK-FREE)
+// ============================================================================
+
+BatteryReading BatteryService::getReading() const {
+    uint32_t packed = published.load(std::memory_order_acquire);
+
+    BatteryReading reading;
+    reading.voltageMv = (uint16_t)(packed & PUB_MV_MASK);
+    reading.low = (packed & PUB_LOW_BIT) != 0;
+    reading.valid = (packed & PUB_VALID_BIT) != 0;
+    return reading;
+}
+
+uint16_t BatteryService::getVoltageMv() const {
+    return (uint16_t)(published.load(std::memory_order_relaxed) & PUB_MV_MASK);
+}
+
+bool BatteryService::isLow() const {
+    return (published.load(std::memory_order_relaxed) & PUB_LOW_BIT) != 0;
+}
+
+void BatteryService::setCallback(BatteryCallback cb) {
+    // Registrar antes de start(); a task apenas le o ponteiro
+    callback = cb;
+}
+
+BatteryStats BatteryService::getStats() const {
+    // Escritas apenas pela task; os campos sao palavras alinhadas,
+    // uma copia levemente defasada e aceitavel para diagnostico
+    return stats;
+}
+
+void BatteryService::publish(uint16_t voltageMv, bool low) {
+    uint32_t packed = (uint32_t)voltageMv | PUB_VALID_BIT | (low ? PUB_LOW_BIT : 0);
+    published.store(packed, std::memory_order_release);
+}
+
+// ============================================================================
+// CONTROLE DE TASK
+// ============================================================================
+
+void BatteryService::start() {
+    if (!initialized) {
+        LOG_E(TAG, "Servico nao inicializado");
+        return;
+    }
+
+    if (running.load()) {
+        LOG_W(TAG, "Amostragem ja em execucao");
+        return;
+    }
+
+    running.store(true);
+
+    BaseType_t result = xTaskCreatePinnedToCore(
+        samplingTask,
+        "BatteryMonitor",
+        BATTERY_TASK_STACK_SIZE,
+        this,
+        BATTERY_TASK_PRIORITY,
+        &taskHandle,
+        BATTERY_TASK_CORE
+    );
+
+    if (result != pdPASS) {
+        running.store(false);
+        taskHandle = nullptr;
+        LOG_E(TAG, "Falha ao criar task de amostragem");
+        return;
+    }
+
+    LOG_I(TAG, "Amostragem iniciada");
+}
+
+void BatteryService::stop() {
+    if (!running.load() || !taskHandle) {
+        return;
+    }
+
+    // Mesmo aperto de mao do IgnicaoService: a task nao se apaga, avisa em
+    // exitSem depois da ultima rajada e se suspende; o handle continua
+    // valido para o notify e so este lado o apaga. Espera sem limite: uma
+    // rajada dura no maximo BATTERY_CONV_TIMEOUT_MS, e voltar antes
+    // deixaria duas tasks (battery_stop/battery_start) no mesmo ADC
+    running.store(false);
+    xTaskNotifyGive(taskHandle);
+    xSemaphoreTake(exitSem, portMAX_DELAY);
+
+    TaskHandle_t handle = taskHandle;
+    taskHandle = nullptr;
+    vTaskDelete(handle);
+
+    LOG_I(TAG, "Amostragem parada");
+}
+
+bool BatteryService::isRunning() const {
+    return running.load();
+}
+
+// ============================================================================
+// TASK DE AMOSTRAGEM
+// ============================================================================
+
+bool IRAM_ATTR BatteryService::onConvDone(adc_continuous_handle_t handle,
+                                          const adc_continuous_evt_data_t* edata,
+                                          void* userData) {
+    BatteryService* self = static_cast<BatteryService*>(userData);
+    BaseType_t woken = pdFALSE;
+    if (self->taskHandle) {
+        vTaskNotifyGiveFromISR(self->taskHandle, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+void BatteryService::samplingTask(void* arg) {
+    BatteryService* self = static_cast<BatteryService*>(arg);
+
+    LOG_I(TAG, "Task de amostragem iniciada no Core %d", xPortGetCoreID());
+
+    while (self->running.load()) {
+        self->sampleBurst();
+
+        // O notify do stop() pode ter sido consumido pela rajada
+        if (!self->running.load()) break;
+
+        // Dorme ate o proximo periodo (ou ate stop() notificar)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BATTERY_SAMPLE_PERIOD_MS));
+    }
+
+    // Ultima acao: stop() apaga a task depois do aviso
+    xSemaphoreGive(self->exitSem);
+    vTaskSuspend(nullptr);
+}
+
+void BatteryService::sampleBurst() {
+    uint8_t frame[BATTERY_FRAME_BYTES];
+    uint32_t length = 0;
+
+    // Descarta notificacoes pendentes antes da rajada
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    if (adc_continuous_start(adcHandle) != ESP_OK) {
+        stats.errors++;
+        return;
+    }
+
+    esp_err_t ret = ESP_ERR_TIMEOUT;
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BATTERY_CONV_TIMEOUT_MS)) > 0) {
+        ret = adc_continuous_read(adcHandle, frame, sizeof(frame), &length, 0);
+    }
+
+    adc_continuous_stop(adcHandle);
+    adc_continuous_flush_pool(adcHandle);
+
+    if (ret != ESP_OK || length == 0) {
+        stats.errors++;
+        return;
+    }
+
+    processFrame(frame, length);
+}
+
+void BatteryService::processFrame(const uint8_t* data, uint32_t length) {
+    int64_t t0 = esp_timer_get_time();
+
+    uint16_t samples[BATTERY_FRAME_SAMPLES];
+    size_t count = 0;
+
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length && count < BATTERY_FRAME_SAMPLES;
+         i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t* p = reinterpret_cast<const adc_digi_output_data_t*>(&data[i]);
+        if (p->type2.channel == (uint32_t)adcChannel) {
+            samples[count++] = (uint16_t)p->type2.data;
+        }
+    }
+
+    if (count == 0) {
+        stats.errors++;
+        return;
+    }
+
+    // Mediana no dominio bruto, calibracao uma vez por quadro
+    uint16_t rawMedian = battery_filter_median(samples, count);
+    uint16_t pinMv = rawToMv(rawMedian);
+    uint16_t batMv = (uint16_t)(((uint32_t)pinMv * BATTERY_DIVIDER_NUM) / BATTERY_DIVIDER_DEN);
+    uint16_t filtered = battery_filter_update(&filter, batMv);
+
+    // Bateria fraca com histerese
+    bool wasLow = lowState;
+    lowState = battery_filter_low(lowState, filtered, BATTERY_LOW_MV, BATTERY_LOW_HYST_MV);
+
+    publish(filtered, lowState);
+
+    // Custo de CPU do processamento do quadro
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - t0);
+    stats.frames++;
+    stats.samples += count;
+    stats.lastRawMv = pinMv;
+    filterTotalUs += elapsed;
+    stats.filterAvgUs = (uint32_t)(filterTotalUs / stats.frames);
+    if (elapsed > stats.filterMaxUs) {
+        stats.filterMaxUs = elapsed;
+    }
+
+    if ((stats.frames % BATTERY_REPORT_FRAMES) == 0) {
+        LOG_I(TAG, "Bateria: %u mV (pino %u mV) | quadros=%lu erros=%lu | CPU/quadro: med=%lu us max=%lu us",
+              filtered, pinMv, (unsigned long)stats.frames, (unsigned long)stats.errors,
+              (unsigned long)stats.filterAvgUs, (unsigned long)stats.filterMaxUs);
+    }
+
+    if (lowState != wasLow) {
+        LOG_W(TAG, "Bateria %s: %u mV", lowState ? "FRACA" : "normalizada", filtered);
+        if (callback) {
+            callback(lowState, filtered);
+        }
+    }
+}
+
+uint16_t BatteryService::rawToMv(uint16_t raw) const {
+    int mv = 0;
+    if (caliHandle && adc_cali_raw_to_voltage(caliHandle, raw, &mv) == ESP_OK) {
+        return (uint16_t)mv;
+    }
+    // Aproximacao linear para atenuacao de 12 dB (~3100 mV em fundo de escala)
+    return (uint16_t)(((uint32_t)raw * 3100) / ((1u << SOC_ADC_DIGI_MAX_BITWIDTH) - 1));
+}
+
+// ============================================================================
+// INTERFACE C
+// ============================================================================
+
+static BatteryService* g_batteryService = nullptr;
+
+extern "C" {
+
+bool battery_init(void) {
+    g_batteryService = BatteryService::getInstance();
+    return g_batteryService->init();
+}
+
+uint16_t battery_get_voltage_mv(void) {
+    if (g_batteryService) {
+        return g_batteryService->getVoltageMv();
+    }
+    return 0;
+}
+
+bool battery_is_low(void) {
+    if (g_batteryService) {
+        return g_batteryService->isLow();
+    }
+    return false;
+}
+
+void battery_start(void) {
+    if (g_batteryService) {
+        g_batteryService->start();
+    }
+}
+
+void battery_stop(void) {
+    if (g_batteryService) {
+        g_batteryService->stop();
+    }
+}
+
+} // extern "C"
@@ -13,10 +13,12 @@
  */
 
 #include "services/ignicao/ignicao_service.h"
+#include "core/event_bus.h"
 #include "config/app_config.h"
 #include "utils/time_utils.h"
 #include "utils/debug_utils.h"
 #include "driver/gpio.h"
+#include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
@@ -35,6 +37,7 @@ IgnicaoService::IgnicaoService()
     , debounceOn(IGNICAO_DEBOUNCE_ON_S)
     , debounceOff(IGNICAO_DEBOUNCE_OFF_S)
     , mutex(nullptr)
+    , exitSem(nullptr)
     , taskHandle(nullptr)
     , callback(nullptr)
     , initialized(false)
@@ -43,16 +46,22 @@ IgnicaoService::IgnicaoService()
     , lastPinState(false)
     , targetState(false)
     , debounceStartTime(0)
+    , debounceLock("ignicao")
 {
     memset(&stats, 0, sizeof(stats));
 }
 
 IgnicaoService::~IgnicaoService() {
     stop();
+    gpio_isr_handler_remove((gpio_num_t)IGNICAO_PIN);
     if (mutex) {
         vSemaphoreDelete(mutex);
         mutex = nullptr;
     }
+    if (exitSem) {
+        vSemaphoreDelete(exitSem);
+        exitSem = nullptr;
+    }
 }
 
 IgnicaoService* IgnicaoService::getInstance() {
@@ -96,6 +105,13 @@ bool IgnicaoService::init(float debounceOnSec, float debounceOffSec) {
         return false;
     }
 
+    // Aviso de saida da task (stop espera antes de apagar o handle)
+    exitSem = xSemaphoreCreateBinary();
+    if (exitSem == nullptr) {
+        LOG_E(TAG, "Falha ao criar semaforo de saida");
+        return false;
+    }
+
     // Configurar GPIO
     gpio_config_t io_conf = {
         .pin_bit_mask = (1ULL << IGNICAO_PIN),
@@ -106,6 +122,13 @@ bool IgnicaoService::init(float debounceOnSec, float debounceOffSec) {
     };
     gpio_config(&io_conf);
 
+    // Borda do pino acorda a task de monitoramento (ISR ja pode estar instalado pelo BSP)
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        LOG_E(TAG, "Falha ao instalar servico de ISR: %s", esp_err_to_name(err));
+    }
+    gpio_isr_handler_add((gpio_num_t)IGNICAO_PIN, pinIsr, this);
+
     // Ler estado inicial
     bool initialState = gpio_get_level((gpio_num_t)IGNICAO_PIN);
     status = initialState;
@@ -173,6 +196,11 @@ void IgnicaoService::getDebounce(float* debounceOnOut, float* debounceOffOut) co
 }
 
 void IgnicaoService::setCallback(IgnicaoCallback cb) {
+    if (!mutex) {
+        callback = cb;
+        return;
+    }
+
     if (xSemaphoreTake(mutex, portMAX_DELAY) == pdTRUE) {
         callback = cb;
         xSemaphoreGive(mutex);
@@ -203,6 +231,8 @@ IgnicaoStats IgnicaoService::getStats() const {
 }
 
 void IgnicaoService::resetStats() {
+    if (!initialized) return;
+
     if (xSemaphoreTake(mutex, portMAX_DELAY) == pdTRUE) {
         stats.totalOnTime = 0;
         stats.totalOffTime = 0;
@@ -229,6 +259,13 @@ void IgnicaoService::start() {
         return;
     }
 
+    if (taskHandle) {
+        LOG_W(TAG, "Task anterior ainda nao encerrou");
+        return;
+    }
+
+    running = true;
+
     BaseType_t result = xTaskCreatePinnedToCore(
         monitorTask,
         "IgnicaoMonitor",
@@ -240,11 +277,11 @@ void IgnicaoService::start() {
     );
 
     if (result != pdPASS) {
+        running = false;
         LOG_E(TAG, "Falha ao criar task de monitoramento");
         return;
     }
 
-    running = true;
     LOG_I(TAG, "Monitoramento iniciado");
 }
 
@@ -253,14 +290,21 @@ void IgnicaoService::stop() {
         return;
     }
 
+    // A task nao se apaga: ao ver running == false ela avisa em exitSem e
+    // se suspende, entao o handle continua valido para o notify e so este
+    // lado o apaga (restart via shim legado)
     running = false;
-    vTaskDelay(pdMS_TO_TICKS(IGNICAO_CHECK_INTERVAL + 50));
+    xTaskNotifyGive(taskHandle);
 
-    if (taskHandle) {
-        vTaskDelete(taskHandle);
-        taskHandle = nullptr;
+    if (xSemaphoreTake(exitSem, pdMS_TO_TICKS(IGNICAO_CHECK_INTERVAL * 5)) != pdTRUE) {
+        LOG_E(TAG, "Task de monitoramento nao encerrou");
+        return;
     }
 
+    TaskHandle_t handle = taskHandle;
+    taskHandle = nullptr;
+    vTaskDelete(handle);
+
     LOG_I(TAG, "Monitoramento parado");
 }
 
@@ -283,10 +327,48 @@ void IgnicaoService::monitorTask(void* arg) {
 
     while (self->running) {
         self->processDebounce();
-        vTaskDelay(pdMS_TO_TICKS(IGNICAO_CHECK_INTERVAL));
+
+        if (self->debounceInProgress) {
+            // Debounce em andamento: amostragem periodica, sem light sleep
+            self->debounceLock.acquire();
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IGNICAO_CHECK_INTERVAL));
+        } else {
+            // Ocioso: dorme ate o pino mudar (o nivel armado tambem acorda
+            // o chip do light sleep)
+            self->debounceLock.release();
+            self->armPinWakeup();
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IGNICAO_IDLE_CHECK_MS));
+        }
+    }
+
+    gpio_intr_disable((gpio_num_t)IGNICAO_PIN);
+    self->debounceLock.release();
+
+    // stop() apaga a task depois do aviso
+    xSemaphoreGive(self->exitSem);
+    vTaskSuspend(nullptr);
+}
+
+void IgnicaoService::armPinWakeup() {
+    // Interrupcao por nivel oposto ao ultimo estado lido: e o unico tipo
+    // que acorda do light sleep; a ISR desarma ate a proxima volta
+    gpio_int_type_t level = lastPinState ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL;
+    gpio_wakeup_enable((gpio_num_t)IGNICAO_PIN, level);
+    gpio_intr_enable((gpio_num_t)IGNICAO_PIN);
+}
+
+void IgnicaoService::pinIsr(void* arg) {
+    IgnicaoService* self = static_cast<IgnicaoService*>(arg);
+    BaseType_t woken = pdFALSE;
+
+    gpio_intr_disable((gpio_num_t)IGNICAO_PIN);
+    if (self->taskHandle) {
+        vTaskNotifyGiveFromISR(self->taskHandle, &woken);
     }
 
-    vTaskDelete(nullptr);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
 }
 
 void IgnicaoService::processDebounce() {
@@ -335,6 +417,12 @@ void IgnicaoService::processDebounce() {
                 IgnicaoCallback cb = callback;
                 xSemaphoreGive(mutex);
 
+                // UI e audio reagem no proprio contexto via EventBus
+                AppEvent ev = {};
+                ev.type = EventType::IGNICAO_CHANGED;
+                ev.ignicao.on = targetState;
+                EventBus::getInstance()->publish(EventSource::IGNICAO, ev);
+
                 if (cb) {
                     cb(targetState);
                 }
@@ -13,6 +13,7 @@
  */
 
 #include "services/jornada/jornada_service.h"
+#include "core/event_bus.h"
 #include "config/app_config.h"
 #include "utils/time_utils.h"
 #include "utils/debug_utils.h"
@@ -96,8 +97,14 @@ void JornadaService::init() {
         motoristas[i].ativo = false;
     }
 
+    // Totais persistidos (RTC em reset a quente, NVS em boot a frio)
+    if (store.begin()) {
+        restoreFromStore();
+    }
+
     initialized = true;
-    LOG_I(TAG, "Servico de jornada inicializado (max %d motoristas)", MAX_MOTORISTAS);
+    LOG_I(TAG, "Servico de jornada inicializado (max %d motoristas, %d restaurados)",
+          MAX_MOTORISTAS, getNumMotoristasAtivos());
 }
 
 // ============================================================================
@@ -142,6 +149,8 @@ bool JornadaService::addMotorista(int id, const char* nome) {
             motoristas[i].tempoTotalAbastecimento = 0;
             motoristas[i].ativo = true;
 
+            store.update(i, motoristas[i], time_millis(), true);
+            publishChange(id, EstadoJornada::INATIVO);
             JornadaCallback cb = callback;
             xSemaphoreGive(mutex);
 
@@ -172,6 +181,8 @@ void JornadaService::removeMotorista(int id) {
         motoristas[idx].ativo = false;
         motoristas[idx].id = 0;
 
+        store.update(idx, motoristas[idx], time_millis(), true);
+        publishChange(id, EstadoJornada::INATIVO);
         JornadaCallback cb = callback;
         xSemaphoreGive(mutex);
 
@@ -255,6 +266,8 @@ bool JornadaService::iniciarEstado(int id, EstadoJornada estado) {
     motoristas[idx].estadoAtual = estado;
     motoristas[idx].tempoInicio = time_millis();
 
+    store.update(idx, motoristas[idx], motoristas[idx].tempoInicio, true);
+    publishChange(id, estado);
     JornadaCallback cb = callback;
     xSemaphoreGive(mutex);
 
@@ -292,6 +305,8 @@ bool JornadaService::finalizarEstado(int id) {
     motoristas[idx].estadoAtual = EstadoJornada::INATIVO;
     motoristas[idx].tempoInicio = 0;
 
+    store.update(idx, motoristas[idx], time_millis(), true);
+    publishChange(id, EstadoJornada::INATIVO);
     JornadaCallback cb = callback;
     xSemaphoreGive(mutex);
 
@@ -373,16 +388,109 @@ uint32_t JornadaService::getTempoEstadoAtual(int id) const {
 }
 
 void JornadaService::setCallback(JornadaCallback cb) {
+    if (!mutex) {
+        callback = cb;
+        return;
+    }
+
     if (xSemaphoreTake(mutex, portMAX_DELAY) == pdTRUE) {
         callback = cb;
         xSemaphoreGive(mutex);
     }
 }
 
+// ============================================================================
+// PERSISTENCIA
+// ============================================================================
+
+bool JornadaService::flushIfDue() {
+    if (!initialized) return false;
+
+    bool ok = false;
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        ok = flushLocked(false);
+        xSemaphoreGive(mutex);
+    }
+    return ok;
+}
+
+bool JornadaService::flush() {
+    if (!initialized) return false;
+
+    bool ok = false;
+    if (xSemaphoreTake(mutex, portMAX_DELAY) == pdTRUE) {
+        ok = flushLocked(true);
+        xSemaphoreGive(mutex);
+    }
+    return ok;
+}
+
+JornadaPersistStats JornadaService::getPersistStats() const {
+    JornadaPersistStats stats = {};
+    if (!initialized) return stats;
+
+    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        stats = store.getStats();
+        xSemaphoreGive(mutex);
+    }
+    return stats;
+}
+
 // ============================================================================
 // METODOS PRIVADOS
 // ============================================================================
 
+void JornadaService::restoreFromStore() {
+    const JornadaPersistImage& img = store.image();
+
+    for (int i = 0; i < MAX_MOTORISTAS; i++) {
+        const JornadaPersistSlot& slot = img.slots[i];
+        if (!slot.ativo) continue;
+
+        // O estado em curso nao sobrevive ao reboot: o tempo ate o ultimo
+        // flush ja esta somado aos totais
+        DadosMotorista& m = motoristas[i];
+        m.id = slot.id;
+        strncpy(m.nome, slot.nome, MAX_NOME_MOTORISTA - 1);
+        m.nome[MAX_NOME_MOTORISTA - 1] = '\0';
+        m.estadoAtual = EstadoJornada::INATIVO;
+        m.tempoInicio = 0;
+        m.tempoTotalJornada = slot.totais[0];
+        m.tempoTotalManobra = slot.totais[1];
+        m.tempoTotalRefeicao = slot.totais[2];
+        m.tempoTotalEspera = slot.totais[3];
+        m.tempoTotalDescarga = slot.totais[4];
+        m.tempoTotalAbastecimento = slot.totais[5];
+        m.ativo = true;
+    }
+}
+
+bool JornadaService::flushLocked(bool force) {
+    // Chamado com o mutex tomado
+    uint32_t now = time_millis();
+
+    bool running = false;
+    for (int i = 0; i < MAX_MOTORISTAS; i++) {
+        if (motoristas[i].ativo && motoristas[i].estadoAtual != EstadoJornada::INATIVO) {
+            running = true;
+            break;
+        }
+    }
+
+    if (!force && !store.flushDue(now, running)) {
+        return true;
+    }
+
+    // Soma o tempo dos estados em curso antes de gravar
+    if (running) {
+        for (int i = 0; i < MAX_MOTORISTAS; i++) {
+            store.update(i, motoristas[i], now, false);
+        }
+    }
+
+    return store.flush(now);
+}
+
 int JornadaService::findMotoristaIndex(int id) const {
     for (int i = 0; i < MAX_MOTORISTAS; i++) {
         if (motoristas[i].ativo && motoristas[i].id == id) {
@@ -392,6 +500,15 @@ int JornadaService::findMotoristaIndex(int id) const {
     return -1;
 }
 
+void JornadaService::publishChange(int id, EstadoJornada estado) {
+    // Chamado com o mutex tomado: eventos na ordem das mudancas de estado
+    AppEvent ev = {};
+    ev.type = EventType::JORNADA_CHANGED;
+    ev.jornada.motoristaId = (int16_t)id;
+    ev.jornada.estado = static_cast<uint8_t>(estado);
+    EventBus::getInstance()->publish(EventSource::JORNADA, ev);
+}
+
 void JornadaService::atualizarTempoAcumulado(int idx) {
     if (idx < 0 || idx >= MAX_MOTORISTAS) return;
 
@@ -0,0 +1,212 @@
+/**
+ * ============================================================================
+ * PERSISTENCIA DE JORNADA - IMPLEMENTACAO
+ * ============================================================================
+ *
+ * O espelho fica em RTC_NOINIT: um reset a quente (watchdog, panic,
+ * esp_restart) preserva os totais sem tocar na flash. A NVS recebe a
+ * mesma imagem como um unico blob, entao uma queda de energia durante o
+ * flush deixa a versao anterior ou a nova, nunca uma mistura.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "services/jornada/jornada_store.h"
+#include "utils/debug_utils.h"
+#include "esp_attr.h"
+#include "esp_rom_crc.h"
+#include "nvs_flash.h"
+#include <stddef.h>
+#include <string.h>
+
+LOG_TAG("JORNADA_NVS");
+
+// ============================================================================
+// CONSTANTES
+// ============================================================================
+
+#define JORNADA_PERSIST_MAGIC   0x4A524E44u     // "JRND"
+
+// Espelho em memoria RTC (nao e zerado no boot)
+RTC_NOINIT_ATTR static JornadaPersistImage s_rtcImage;
+
+// ============================================================================
+// IMPLEMENTACAO DA CLASSE
+// ============================================================================
+
+JornadaStore::JornadaStore()
+    : mirror(&s_rtcImage)
+    , nvs(0)
+    , nvsOpen(false)
+    , dirty(false)
+    , dirtySince(0)
+    , pendingChanges(0)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+bool JornadaStore::begin() {
+    esp_err_t ret = nvs_flash_init_partition(NVS_PARTITION_LABEL);
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        LOG_W(TAG, "Particao %s incompativel, apagando", NVS_PARTITION_LABEL);
+        nvs_flash_erase_partition(NVS_PARTITION_LABEL);
+        ret = nvs_flash_init_partition(NVS_PARTITION_LABEL);
+    }
+
+    if (ret == ESP_OK) {
+        ret = nvs_open_from_partition(NVS_PARTITION_LABEL, NVS_NS_JORNADA,
+                                      NVS_READWRITE, &nvs);
+        nvsOpen = (ret == ESP_OK);
+    }
+
+    if (!nvsOpen) {
+        LOG_E(TAG, "Falha ao abrir NVS: %s", esp_err_to_name(ret));
+    }
+
+    // Ultimo flush gravado
+    JornadaPersistImage stored;
+    size_t len = sizeof(stored);
+    bool storedValid = nvsOpen &&
+        nvs_get_blob(nvs, NVS_KEY_JORNADA_TOTAIS, &stored, &len) == ESP_OK &&
+        len == sizeof(stored) && isValid(stored);
+
+    if (isValid(*mirror)) {
+        // Reset a quente: o espelho pode ter mudancas ainda nao gravadas.
+        // Vencer o limiar grava no primeiro flushDue() (fora do boot); so o
+        // dirtySince esperaria o intervalo inteiro, com o relogio recem-zerado
+        stats.restoredFrom = JornadaRestoreSource::RTC;
+        if (!storedValid || stored.crc != mirror->crc) {
+            dirty = true;
+            dirtySince = 0;
+            pendingChanges = JORNADA_FLUSH_THRESHOLD;
+        }
+    } else if (storedValid) {
+        memcpy(mirror, &stored, sizeof(stored));
+        stats.restoredFrom = JornadaRestoreSource::NVS;
+    } else {
+        format(*mirror);
+        stats.restoredFrom = JornadaRestoreSource::NONE;
+    }
+
+    LOG_I(TAG, "Totais restaurados de %s (geracao %lu%s)",
+          stats.restoredFrom == JornadaRestoreSource::RTC ? "RTC" :
+          stats.restoredFrom == JornadaRestoreSource::NVS ? "NVS" : "nenhum",
+          (unsigned long)mirror->generation, dirty ? ", pendente" : "");
+
+    return stats.restoredFrom != JornadaRestoreSource::NONE;
+}
+
+void JornadaStore::update(int idx, const DadosMotorista& m, uint32_t now, bool countChange) {
+    if (idx < 0 || idx >= MAX_MOTORISTAS) return;
+
+    JornadaPersistSlot slot;
+    memset(&slot, 0, sizeof(slot));
+
+    if (m.ativo) {
+        slot.id = (int16_t)m.id;
+        slot.ativo = 1;
+        strncpy(slot.nome, m.nome, MAX_NOME_MOTORISTA - 1);
+
+        slot.totais[0] = m.tempoTotalJornada;
+        slot.totais[1] = m.tempoTotalManobra;
+        slot.totais[2] = m.tempoTotalRefeicao;
+        slot.totais[3] = m.tempoTotalEspera;
+        slot.totais[4] = m.tempoTotalDescarga;
+        slot.totais[5] = m.tempoTotalAbastecimento;
+
+        // Estado em curso: soma o tempo decorrido ao total efetivo
+        int e = static_cast<int>(m.estadoAtual);
+        if (e >= 1 && e <= JORNADA_NUM_TOTAIS) {
+            slot.totais[e - 1] += now - m.tempoInicio;
+        }
+    }
+
+    if (memcmp(&mirror->slots[idx], &slot, sizeof(slot)) == 0) {
+        return;
+    }
+
+    memcpy(&mirror->slots[idx], &slot, sizeof(slot));
+    mirror->crc = computeCrc(*mirror);
+
+    if (!dirty) {
+        dirty = true;
+        dirtySince = now;
+    }
+
+    if (countChange) {
+        pendingChanges++;
+        stats.changes++;
+    }
+}
+
+bool JornadaStore::flushDue(uint32_t now, bool running) const {
+    if (dirty && (pendingChanges >= JORNADA_FLUSH_THRESHOLD ||
+                  (now - dirtySince) >= JORNADA_FLUSH_INTERVAL_MS)) {
+        return true;
+    }
+
+    // Sem mudancas, mas o estado em curso segue acumulando tempo
+    return running && (now - stats.lastFlushMs) >= JORNADA_FLUSH_INTERVAL_MS;
+}
+
+bool JornadaStore::flush(uint32_t now) {
+    if (!dirty) {
+        return true;
+    }
+
+    if (!nvsOpen) {
+        return false;
+    }
+
+    mirror->generation++;
+    mirror->crc = computeCrc(*mirror);
+
+    esp_err_t ret = nvs_set_blob(nvs, NVS_KEY_JORNADA_TOTAIS, mirror, sizeof(*mirror));
+    if (ret == ESP_OK) {
+        ret = nvs_commit(nvs);
+    }
+
+    if (ret != ESP_OK) {
+        stats.errors++;
+        LOG_E(TAG, "Falha no flush: %s", esp_err_to_name(ret));
+        return false;
+    }
+
+    stats.flushes++;
+    stats.lastFlushMs = now;
+
+    LOG_I(TAG, "Flush #%lu: %lu mudancas agregadas (total %lu mudancas)",
+          (unsigned long)stats.flushes, (unsigned long)pendingChanges,
+          (unsigned long)stats.changes);
+
+    dirty = false;
+    pendingChanges = 0;
+    return true;
+}
+
+// ============================================================================
+// METODOS PRIVADOS
+// ============================================================================
+
+bool JornadaStore::isValid(const JornadaPersistImage& img) {
+    return img.magic == JORNADA_PERSIST_MAGIC &&
+           img.version == NVS_JORNADA_VERSION &&
+           img.size == sizeof(JornadaPersistImage) &&
+           img.crc == computeCrc(img);
+}
+
+uint32_t JornadaStore::computeCrc(const JornadaPersistImage& img) {
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(&img),
+                            offsetof(JornadaPersistImage, crc));
+}
+
+void JornadaStore::format(JornadaPersistImage& img) {
+    memset(&img, 0, sizeof(img));
+    img.magic = JORNADA_PERSIST_MAGIC;
+    img.version = NVS_JORNADA_VERSION;
+    img.size = sizeof(JornadaPersistImage);
+    img.crc = computeCrc(img);
+}
@@ -0,0 +1,203 @@
+/**
+ * ============================================================================
+ * SERVICO DE ENERGIA - IMPLEMENTACAO
+ * ============================================================================
+ *
+ * Com CONFIG_FREERTOS_USE_TICKLESS_IDLE a task idle para o tick e, se
+ * nenhuma trava esp_pm estiver ativa, entra em light sleep ate o proximo
+ * deadline do FreeRTOS ou ate um GPIO armado. O callback de saida do sono
+ * conta as causas de wakeup e o tempo dormido para o relatorio.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "services/power/power_service.h"
+#include "config/app_config.h"
+#include "utils/debug_utils.h"
+#include "esp_attr.h"
+#include "esp_sleep.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+LOG_TAG("POWER_SVC");
+
+// ============================================================================
+// TRAVA DE ENERGIA
+// ============================================================================
+
+PowerLock::PowerLock(const char* name, bool cpuMax)
+    : name_(name)
+    , cpuMax_(cpuMax)
+    , held_(false)
+#ifdef CONFIG_PM_ENABLE
+    , handle_(nullptr)
+#endif
+{
+}
+
+void PowerLock::acquire() {
+    if (held_) return;
+
+#ifdef CONFIG_PM_ENABLE
+    if (!handle_) {
+        esp_pm_lock_type_t type = cpuMax_ ? ESP_PM_CPU_FREQ_MAX : ESP_PM_NO_LIGHT_SLEEP;
+        if (esp_pm_lock_create(type, 0, name_, &handle_) != ESP_OK) {
+            LOG_E(TAG, "Falha ao criar trava '%s'", name_);
+            handle_ = nullptr;
+            return;
+        }
+    }
+    esp_pm_lock_acquire(handle_);
+#endif
+
+    held_ = true;
+}
+
+void PowerLock::release() {
+    if (!held_) return;
+
+#ifdef CONFIG_PM_ENABLE
+    if (handle_) {
+        esp_pm_lock_release(handle_);
+    }
+#endif
+
+    held_ = false;
+}
+
+// ============================================================================
+// IMPLEMENTACAO DA CLASSE
+// ============================================================================
+
+PowerService* PowerService::instance = nullptr;
+
+PowerService::PowerService()
+    : initialized_(false)
+    , lightSleep_(false)
+    , lastReportMs_(0)
+    , lastSleepUs_(0)
+    , lastSleeps_(0)
+{
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+PowerService* PowerService::getInstance() {
+    if (instance == nullptr) {
+        instance = new PowerService();
+    }
+    return instance;
+}
+
+// ============================================================================
+// INICIALIZACAO
+// ============================================================================
+
+bool PowerService::init() {
+    if (initialized_) {
+        LOG_W(TAG, "Servico ja inicializado");
+        return true;
+    }
+
+#ifdef CONFIG_PM_ENABLE
+    esp_pm_config_t pmConfig = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = POWER_CPU_MIN_FREQ_MHZ,
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+        .light_sleep_enable = POWER_LIGHT_SLEEP_ENABLE != 0,
+#else
+        .light_sleep_enable = false,
+#endif
+    };
+
+    esp_err_t err = esp_pm_configure(&pmConfig);
+    if (err != ESP_OK) {
+        LOG_E(TAG, "esp_pm_configure falhou: %s", esp_err_to_name(err));
+        return false;
+    }
+    lightSleep_ = pmConfig.light_sleep_enable;
+
+    // GPIOs armados com gpio_wakeup_enable() (ignicao) acordam do light sleep
+    esp_sleep_enable_gpio_wakeup();
+
+#if CONFIG_PM_LIGHT_SLEEP_CALLBACKS
+    esp_pm_sleep_cbs_register_config_t cbs = {};
+    cbs.exit_cb = onSleepExit;
+    cbs.exit_cb_user_arg = this;
+    esp_pm_light_sleep_register_cbs(&cbs);
+#endif
+
+    LOG_I(TAG, "DFS %d-%d MHz, light sleep %s",
+          POWER_CPU_MIN_FREQ_MHZ, CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+          lightSleep_ ? "automatico" : "desligado");
+#else
+    LOG_W(TAG, "CONFIG_PM_ENABLE desligado: sem DFS/light sleep");
+#endif
+
+    initialized_ = true;
+    return true;
+}
+
+// ============================================================================
+// CONTABILIDADE DO SONO
+// ============================================================================
+
+// Roda na task idle, logo apos acordar (interrupcoes ainda mascaradas)
+esp_err_t IRAM_ATTR PowerService::onSleepExit(int64_t sleepTimeUs, void* arg) {
+    PowerService* self = static_cast<PowerService*>(arg);
+
+    self->stats_.sleeps++;
+    self->stats_.sleepUs += (uint64_t)sleepTimeUs;
+
+    switch (esp_sleep_get_wakeup_cause()) {
+        case ESP_SLEEP_WAKEUP_TIMER:
+            self->stats_.wakeTimer++;
+            break;
+        case ESP_SLEEP_WAKEUP_GPIO:
+            self->stats_.wakeGpio++;
+            break;
+        default:
+            self->stats_.wakeOther++;
+            break;
+    }
+
+    return ESP_OK;
+}
+
+// ============================================================================
+// RELATORIO
+// ============================================================================
+
+void PowerService::reportIfDue(uint32_t nowMs) {
+    if (!initialized_) return;
+
+    if (lastReportMs_ == 0) {
+        lastReportMs_ = nowMs;
+        return;
+    }
+
+    uint32_t periodMs = nowMs - lastReportMs_;
+    if (periodMs < POWER_REPORT_PERIOD_MS) return;
+
+    PowerStats snap = stats_;
+    uint64_t slept = snap.sleepUs - lastSleepUs_;
+    stats_.residencyPctX10 = (uint32_t)(slept / periodMs);  // us / ms = 0.1%
+
+    LOG_I(TAG, "Light sleep: %" PRIu32 ".%" PRIu32 "%% do tempo, %" PRIu32 " entradas em %" PRIu32 " s",
+          stats_.residencyPctX10 / 10, stats_.residencyPctX10 % 10,
+          snap.sleeps - lastSleeps_, periodMs / 1000);
+    LOG_I(TAG, "Wakeups (total): timer %" PRIu32 ", gpio %" PRIu32 ", outros %" PRIu32,
+          snap.wakeTimer, snap.wakeGpio, snap.wakeOther);
+
+#if CONFIG_PM_PROFILING
+    // Tempo em cada modo e por trava (render/audio/debounce/drivers)
+    esp_pm_dump_locks(stdout);
+#endif
+
+    lastReportMs_ = nowMs;
+    lastSleepUs_ = snap.sleepUs;
+    lastSleeps_ = snap.sleeps;
+}
@@ -15,6 +15,9 @@
 
 #include "simple_audio_manager.h"
 #include "pincfg.h"
+#include "core/event_bus.h"
+#include "core/boot_trace.h"
+#include "services/power/power_service.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
 #include "esp_check.h"
@@ -83,6 +86,9 @@ static AudioManager_t* g_audio = NULL;
 bool isPlayingAudio = false;
 SemaphoreHandle_t audioMutex = NULL;
 
+// Trava de energia da reproducao (CPU no maximo, sem light sleep)
+static PowerLock s_audio_power_lock("audio", true);
+
 // ============================================================================
 // FUNÇÕES AUXILIARES DE MEMÓRIA
 // ============================================================================
@@ -150,14 +156,8 @@ static esp_err_t audio_init_i2s(AudioManager_t* audio) {
         return ret;
     }
 
-    ret = i2s_channel_enable(audio->i2s_handle);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Falha ao habilitar I2S: %s", esp_err_to_name(ret));
-        i2s_del_channel(audio->i2s_handle);
-        audio->i2s_handle = NULL;
-        return ret;
-    }
-
+    // Canal fica desabilitado fora da reproducao: habilitado, o driver
+    // segura uma trava de energia que impede o light sleep
     audio->i2s_initialized = true;
     audio->current_sample_rate = 44100;
     ESP_LOGI(TAG, "I2S inicializado com sucesso (44100Hz)");
@@ -332,8 +332,8 @@ static void audio_play_file(AudioManager_t* audio, const char* filepath) {
     bool first_frame = true;
 
     while (buffer_len > 0) {
-        // Verifica stop
-        if (audio->stop_requested) {
+        // Verifica stop (pedido direto ou evento novo para o audio)
+        if (audio->stop_requested || EventBus::getInstance()->hasPending(EventSink::AUDIO)) {
             ESP_LOGI(TAG, "Reproducao interrompida");
             break;
         }
@@ -451,9 +451,13 @@ static void audio_task(void* arg) {
 
     ESP_LOGI(TAG, "Audio task iniciada no Core %d", xPortGetCoreID());
 
+    // Buffers e I2S aqui, no Core 1, em paralelo com o resto do boot
+    int bootSpan = boot_trace_begin("audio_hw");
+
     // Aloca buffers
     if (audio_alloc_buffers(audio) != ESP_OK) {
         ESP_LOGE(TAG, "Falha ao alocar buffers!");
+        boot_trace_end(bootSpan);
         vTaskDelete(NULL);
         return;
     }
@@ -461,16 +465,24 @@ static void audio_task(void* arg) {
     // Inicializa I2S
     if (audio_init_i2s(audio) != ESP_OK) {
         ESP_LOGE(TAG, "Falha ao inicializar I2S!");
+        boot_trace_end(bootSpan);
         vTaskDelete(NULL);
         return;
     }
 
+    boot_trace_end(bootSpan);
+
     AudioRequest_t request;
     char filepath[128];
 
     while (true) {
-        // Espera por solicitação
-        if (xQueueReceive(audio->queue, &request, pdMS_TO_TICKS(100)) == pdTRUE) {
+        // Entrega eventos do barramento (handlers rodam aqui, no Core 1)
+        EventBus::getInstance()->dispatch(EventSink::AUDIO);
+
+        // Espera por solicitação (playAudioFile e o EventBus notificam a task)
+        if (xQueueReceive(audio->queue, &request, 0) != pdTRUE) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        } else {
             // Pega o mais recente se houver mais na fila
             AudioRequest_t newest = request;
             while (xQueueReceive(audio->queue, &request, 0) == pdTRUE) {
@@ -488,8 +500,15 @@ static void audio_task(void* arg) {
                 xSemaphoreGive(audio->mutex);
             }
 
-            // Reproduz
-            audio_play_file(audio, filepath);
+            // Reproduz (CPU no maximo e I2S ligado apenas durante o arquivo)
+            s_audio_power_lock.acquire();
+            if (i2s_channel_enable(audio->i2s_handle) == ESP_OK) {
+                audio_play_file(audio, filepath);
+                i2s_channel_disable(audio->i2s_handle);
+            } else {
+                ESP_LOGE(TAG, "Falha ao habilitar I2S");
+            }
+            s_audio_power_lock.release();
 
             // Marca como não reproduzindo
             if (xSemaphoreTake(audio->mutex, portMAX_DELAY) == pdTRUE) {
@@ -565,6 +584,9 @@ extern "C" void initSimpleAudio(void) {
         return;
     }
 
+    // Task de audio e a consumidora do destino AUDIO do barramento
+    EventBus::getInstance()->setSinkTask(EventSink::AUDIO, g_audio->task_handle);
+
     g_audio->initialized = true;
     ESP_LOGI(TAG, "Sistema de audio inicializado (Core %d)", AUDIO_TASK_CORE);
 }
@@ -610,6 +632,11 @@ extern "C" void playAudioFile(const char* filename) {
         xQueueSend(g_audio->queue, &request, 0);
     }
 
+    // Acorda a task de audio
+    if (g_audio->task_handle) {
+        xTaskNotifyGive(g_audio->task_handle);
+    }
+
     ESP_LOGI(TAG, "Audio solicitado: %s", filename);
 }
 
@@ -5,8 +5,11 @@
  */
 
 #include "simple_splash.h"
+#include "ui/common/asset_store.h"
+#include "core/boot_trace.h"
 #include "esp_bsp.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include <stdio.h>
 
 static const char *TAG = "SPLASH";
@@ -20,6 +23,10 @@ lv_obj_t* splash_screen = NULL;
 lv_timer_t* splash_timer = NULL;
 static lv_obj_t* loading_bar = NULL;
 
+// Medicao do tempo ate o primeiro quadro
+static int64_t splash_create_us = 0;
+static bool splash_logo_from_assets = false;
+
 // ============================================================================
 // FUNCOES INTERNAS
 // ============================================================================
@@ -31,6 +38,22 @@ static void splash_timer_cb(lv_timer_t* timer) {
     removeSplashScreen();
 }
 
+/**
+ * Primeiro desenho do splash: registra o tempo desde o boot e desde a criacao
+ */
+static void splash_draw_cb(lv_event_t* e) {
+    if (splash_create_us == 0) return;
+
+    boot_trace_mark(BOOT_MARK_FIRST_FRAME);
+
+    int64_t now = esp_timer_get_time();
+    ESP_LOGI(TAG, "Primeiro quadro: %lld ms desde o boot, %lld ms apos criar (logo: %s)",
+             (long long)(now / 1000), (long long)((now - splash_create_us) / 1000),
+             splash_logo_from_assets ? "asset RGB565" : "PNG");
+    splash_create_us = 0;
+    lv_obj_remove_event_cb(lv_event_get_target(e), splash_draw_cb);
+}
+
 // ============================================================================
 // FUNCOES PUBLICAS
 // ============================================================================
@@ -52,10 +75,21 @@ void createSplashScreen() {
         lv_obj_set_style_bg_opa(splash_screen, LV_OPA_COVER, LV_PART_MAIN);
 
         // --------------------------------------------------------------------------
-        // LOGO SPLASH (carrega PNG do LittleFS - drive A:)
+        // LOGO SPLASH (asset RGB565 da particao mapeada; PNG do LittleFS como fallback)
         // --------------------------------------------------------------------------
+        splash_create_us = esp_timer_get_time();
+        lv_obj_add_event_cb(splash_screen, splash_draw_cb, LV_EVENT_DRAW_POST_END, NULL);
+
+        AssetStore* assets = AssetStore::getInstance();
+        const lv_img_dsc_t* logo = assets->init() ? assets->get("logo_splash") : NULL;
+        splash_logo_from_assets = (logo != NULL);
+
         lv_obj_t* img = lv_img_create(splash_screen);
-        lv_img_set_src(img, "A:/logo_splash.png");
+        if (logo) {
+            lv_img_set_src(img, logo);
+        } else {
+            lv_img_set_src(img, "A:/logo_splash.png");
+        }
         lv_obj_align(img, LV_ALIGN_CENTER, 0, -20);  // Centralizado, acima da barra de loading
 
         // --------------------------------------------------------------------------
@@ -0,0 +1,248 @@
+/**
+ * ============================================================================
+ * ASSETS DE IMAGEM PRE-COMPILADOS
+ * ============================================================================
+ *
+ * Leitura do indice gerado por tools/assets/img_compile.py (formato
+ * descrito no proprio script). Imagens sem compressao nao custam nada
+ * alem do mapeamento; RLE e expandido no primeiro get().
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "ui/common/asset_store.h"
+#include "esp_partition.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char* TAG = "ASSETS";
+
+// ============================================================================
+// FORMATO DA PARTICAO
+// ============================================================================
+
+#define ASSET_MAGIC             0x5341564Cu     // 'LVAS'
+#define ASSET_VERSION           1
+
+#define ASSET_FORMAT_RGB565     0
+#define ASSET_FORMAT_RGB565A8   1
+
+#define ASSET_COMPRESS_NONE     0
+#define ASSET_COMPRESS_RLE      1
+
+#define ASSET_FLAG_SWAP16       0x01
+
+struct __attribute__((packed)) AssetHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+};
+
+struct __attribute__((packed)) AssetRecord {
+    char name[ASSET_NAME_MAX];
+    uint8_t format;
+    uint8_t compression;
+    uint8_t flags;
+    uint8_t reserved;
+    uint16_t width;
+    uint16_t height;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t rawSize;
+};
+
+static_assert(sizeof(AssetHeader) == 8, "Cabecalho difere do compilador de assets");
+static_assert(sizeof(AssetRecord) == 52, "Entrada difere do compilador de assets");
+static_assert(LV_COLOR_DEPTH == 16, "Assets sao gerados em RGB565");
+
+// ============================================================================
+// INSTANCIA SINGLETON
+// ============================================================================
+
+AssetStore* AssetStore::instance = nullptr;
+
+AssetStore* AssetStore::getInstance() {
+    if (instance == nullptr) {
+        instance = new AssetStore();
+    }
+    return instance;
+}
+
+AssetStore::AssetStore()
+    : base_(nullptr)
+    , size_(0)
+    , count_(0)
+{
+    memset(entries_, 0, sizeof(entries_));
+}
+
+// ============================================================================
+// INICIALIZACAO
+// ============================================================================
+
+bool AssetStore::init() {
+    if (count_ > 0) return true;
+
+    const esp_partition_t* part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ASSET_PARTITION_LABEL);
+    if (!part) {
+        ESP_LOGW(TAG, "Particao '%s' nao encontrada", ASSET_PARTITION_LABEL);
+        return false;
+    }
+
+    const void* ptr = nullptr;
+    esp_partition_mmap_handle_t handle;
+    esp_err_t err = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &ptr, &handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Falha ao mapear '%s': %s", ASSET_PARTITION_LABEL, esp_err_to_name(err));
+        return false;
+    }
+
+    base_ = static_cast<const uint8_t*>(ptr);
+    size_ = part->size;
+
+    // Falha depois do mmap: desfaz o mapeamento e volta ao estado inicial
+    auto fail = [&]() {
+        esp_partition_munmap(handle);
+        base_ = nullptr;
+        size_ = 0;
+        count_ = 0;
+        memset(entries_, 0, sizeof(entries_));
+        return false;
+    };
+
+    const AssetHeader* hdr = reinterpret_cast<const AssetHeader*>(base_);
+    if (hdr->magic != ASSET_MAGIC || hdr->version != ASSET_VERSION) {
+        ESP_LOGW(TAG, "Particao '%s' sem assets validos (gravar com o build)", ASSET_PARTITION_LABEL);
+        return fail();
+    }
+    if (sizeof(AssetHeader) + (uint32_t)hdr->count * sizeof(AssetRecord) > size_) {
+        ESP_LOGE(TAG, "Indice maior que a particao");
+        return fail();
+    }
+
+    const AssetRecord* rec = reinterpret_cast<const AssetRecord*>(base_ + sizeof(AssetHeader));
+    for (uint16_t i = 0; i < hdr->count; i++, rec++) {
+        if (count_ >= ASSET_MAX_ENTRIES) {
+            ESP_LOGW(TAG, "Indice com %u imagens, limite %d", hdr->count, ASSET_MAX_ENTRIES);
+            break;
+        }
+
+        uint32_t bpp = (rec->format == ASSET_FORMAT_RGB565A8) ? 3 : 2;
+        bool swapped = (rec->flags & ASSET_FLAG_SWAP16) != 0;
+
+        if (rec->offset > size_ || rec->size > size_ - rec->offset ||
+            rec->rawSize != (uint32_t)rec->width * rec->height * bpp) {
+            ESP_LOGE(TAG, "Entrada %u corrompida", i);
+            continue;
+        }
+        if (swapped != (LV_COLOR_16_SWAP != 0)) {
+            ESP_LOGE(TAG, "'%.*s': troca de bytes difere de LV_COLOR_16_SWAP", ASSET_NAME_MAX, rec->name);
+            continue;
+        }
+
+        Entry& e = entries_[count_++];
+        memcpy(e.name, rec->name, ASSET_NAME_MAX);
+        e.name[ASSET_NAME_MAX - 1] = '\0';
+        e.compression = rec->compression;
+        e.payload = base_ + rec->offset;
+        e.payloadSize = rec->size;
+
+        e.dsc.header.always_zero = 0;
+        e.dsc.header.cf = (rec->format == ASSET_FORMAT_RGB565A8) ? LV_IMG_CF_TRUE_COLOR_ALPHA
+                                                                 : LV_IMG_CF_TRUE_COLOR;
+        e.dsc.header.w = rec->width;
+        e.dsc.header.h = rec->height;
+        e.dsc.data_size = rec->rawSize;
+
+        // Sem compressao: pixels servidos direto da flash mapeada
+        if (e.compression == ASSET_COMPRESS_NONE) {
+            e.dsc.data = e.payload;
+            e.ready = true;
+        }
+    }
+
+    if (count_ == 0) {
+        ESP_LOGW(TAG, "Nenhuma imagem valida na particao '%s'", ASSET_PARTITION_LABEL);
+        return fail();
+    }
+
+    ESP_LOGI(TAG, "%u imagens na particao '%s'", count_, ASSET_PARTITION_LABEL);
+    return true;
+}
+
+// ============================================================================
+// CONSULTA
+// ============================================================================
+
+const lv_img_dsc_t* AssetStore::get(const char* name) {
+    if (!name) return nullptr;
+
+    for (uint16_t i = 0; i < count_; i++) {
+        Entry& e = entries_[i];
+        if (strcmp(e.name, name) != 0) continue;
+
+        if (!e.ready && !expand(e)) {
+            return nullptr;
+        }
+        return &e.dsc;
+    }
+
+    return nullptr;
+}
+
+/**
+ * RLE por pixel (ver rle_encode no compilador): controle c com bit 7 =
+ * repeticao de (c & 0x7F) + 1 pixels, senao c + 1 pixels literais
+ */
+bool AssetStore::expand(Entry& e) {
+    if (e.compression != ASSET_COMPRESS_RLE) {
+        ESP_LOGE(TAG, "'%s': compressao %u nao suportada", e.name, e.compression);
+        return false;
+    }
+
+    uint32_t unit = (e.dsc.header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA) ? 3 : 2;
+    uint8_t* out = static_cast<uint8_t*>(
+        heap_caps_malloc(e.dsc.data_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!out) {
+        ESP_LOGE(TAG, "'%s': sem memoria para %u bytes", e.name, (unsigned)e.dsc.data_size);
+        return false;
+    }
+
+    const uint8_t* in = e.payload;
+    const uint8_t* inEnd = e.payload + e.payloadSize;
+    uint32_t pos = 0;
+
+    while (in < inEnd && pos < e.dsc.data_size) {
+        uint8_t c = *in++;
+        uint32_t n = (uint32_t)(c & 0x7F) + 1;
+
+        if (c & 0x80) {
+            if (in + unit > inEnd || pos + n * unit > e.dsc.data_size) break;
+            for (uint32_t k = 0; k < n; k++, pos += unit) {
+                memcpy(out + pos, in, unit);
+            }
+            in += unit;
+        } else {
+            uint32_t bytes = n * unit;
+            if (in + bytes > inEnd || pos + bytes > e.dsc.data_size) break;
+            memcpy(out + pos, in, bytes);
+            in += bytes;
+            pos += bytes;
+        }
+    }
+
+    if (pos != e.dsc.data_size) {
+        ESP_LOGE(TAG, "'%s': RLE truncado (%u de %u bytes)", e.name, (unsigned)pos, (unsigned)e.dsc.data_size);
+        heap_caps_free(out);
+        return false;
+    }
+
+    e.dsc.data = out;
+    e.ready = true;
+    return true;
+}
@@ -0,0 +1,377 @@
+/**
+ * ============================================================================
+ * FACES PRE-RENDERIZADAS DE BOTOES
+ * ============================================================================
+ *
+ * bake() coloca o botao modelo em cada estado com as transicoes do tema
+ * desligadas (skip_trans), renderiza com lv_snapshot em TRUE_COLOR_ALPHA
+ * num buffer de rascunho e guarda na PSRAM como RGB565A8 (plano de cor
+ * seguido do plano de alfa, caminho direto do blend da LVGL), mais uma
+ * copia TRUE_COLOR do maior retangulo opaco do centro (o miolo).
+ *
+ * O botao convertido por attach() fica sem filhos nem estilos: no
+ * LV_EVENT_DRAW_MAIN o miolo e copiado linha a linha sem mistura e so a
+ * moldura (sombra e cantos arredondados) passa pelo alfa. Nada passa pelo
+ * cache de imagens.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "ui/common/button_face.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char* TAG = "BTN_FACE";
+
+#if LV_COLOR_DEPTH != 16
+#error "Faces de botoes exigem LV_COLOR_DEPTH 16 (RGB565A8)"
+#endif
+
+#define SNAP_CF     LV_IMG_CF_TRUE_COLOR_ALPHA
+#define FACE_CF     LV_IMG_CF_RGB565A8
+
+static const lv_state_t kFaceStates[BUTTON_FACE_STATES] = {
+    LV_STATE_DEFAULT,
+    LV_STATE_PRESSED,
+    LV_STATE_DISABLED
+};
+
+// ============================================================================
+// INSTANCIA SINGLETON
+// ============================================================================
+
+ButtonFaceCache* ButtonFaceCache::instance = nullptr;
+
+ButtonFaceCache* ButtonFaceCache::getInstance() {
+    if (instance == nullptr) {
+        instance = new ButtonFaceCache();
+    }
+    return instance;
+}
+
+ButtonFaceCache::ButtonFaceCache()
+    : scratch_(nullptr)
+    , scratchSize_(0) {
+    memset(pool_, 0, sizeof(pool_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+// ============================================================================
+// POOL
+// ============================================================================
+
+ButtonFace* ButtonFaceCache::acquire() {
+    for (int i = 0; i < BUTTON_FACE_POOL; i++) {
+        if (!pool_[i].inUse) {
+            memset(&pool_[i], 0, sizeof(ButtonFace));
+            pool_[i].inUse = true;
+            stats_.faces++;
+            return &pool_[i];
+        }
+    }
+
+    ESP_LOGW(TAG, "Pool de faces esgotado (%d)", BUTTON_FACE_POOL);
+    return nullptr;
+}
+
+void ButtonFaceCache::release(ButtonFace* face) {
+    if (!face || !face->inUse) return;
+
+    for (int s = 0; s < BUTTON_FACE_STATES; s++) {
+        freeImage(face, (ButtonFaceState)s);
+    }
+    face->inUse = false;
+    stats_.faces--;
+}
+
+// ============================================================================
+// RENDERIZACAO
+// ============================================================================
+
+bool ButtonFaceCache::bake(ButtonFace* face, lv_obj_t* stamp, uint8_t stateMask) {
+    if (!face || !stamp) return false;
+
+    bool ok = true;
+    for (int s = 0; s < BUTTON_FACE_STATES && ok; s++) {
+        if (!(stateMask & BUTTON_FACE_MASK(s))) continue;
+
+        lv_obj_clear_state(stamp, LV_STATE_PRESSED | LV_STATE_DISABLED);
+        lv_obj_add_state(stamp, kFaceStates[s]);
+
+        // Valores finais do estado, sem o inicio das transicoes do tema
+        // (criar a transicao zera skip_trans, entao vem depois da troca)
+        stamp->skip_trans = 1;
+        lv_obj_refresh_ext_draw_size(stamp);
+        ok = render(face, stamp, (ButtonFaceState)s);
+    }
+
+    lv_obj_clear_state(stamp, LV_STATE_PRESSED | LV_STATE_DISABLED);
+    stamp->skip_trans = 0;
+
+    return ok;
+}
+
+/**
+ * Maior retangulo opaco que contem o centro: a sequencia opaca da linha
+ * do meio, estendida para cima e para baixo enquanto continuar opaca.
+ * Le o snapshot intercalado (cor, alfa). Retorna false se o centro tem
+ * transparencia (ex.: face desabilitada).
+ */
+static bool findOpaqueBody(const uint8_t* px, lv_coord_t w, lv_coord_t h, lv_area_t* body) {
+    const uint8_t* alpha = px + LV_IMG_PX_SIZE_ALPHA_BYTE - 1;
+    auto opaque = [&](lv_coord_t x, lv_coord_t y) {
+        return alpha[((uint32_t)y * w + x) * LV_IMG_PX_SIZE_ALPHA_BYTE] >= LV_OPA_MAX;
+    };
+
+    lv_coord_t cx = w / 2;
+    lv_coord_t cy = h / 2;
+    if (w == 0 || h == 0 || !opaque(cx, cy)) return false;
+
+    body->x1 = cx;
+    body->x2 = cx;
+    while (body->x1 > 0 && opaque(body->x1 - 1, cy)) body->x1--;
+    while (body->x2 < w - 1 && opaque(body->x2 + 1, cy)) body->x2++;
+
+    auto rowOpaque = [&](lv_coord_t y) {
+        for (lv_coord_t x = body->x1; x <= body->x2; x++) {
+            if (!opaque(x, y)) return false;
+        }
+        return true;
+    };
+
+    body->y1 = cy;
+    body->y2 = cy;
+    while (body->y1 > 0 && rowOpaque(body->y1 - 1)) body->y1--;
+    while (body->y2 < h - 1 && rowOpaque(body->y2 + 1)) body->y2++;
+
+    return true;
+}
+
+bool ButtonFaceCache::render(ButtonFace* face, lv_obj_t* stamp, ButtonFaceState state) {
+    int64_t t0 = esp_timer_get_time();
+
+    // Mesmo tamanho em TRUE_COLOR_ALPHA e RGB565A8 (3 bytes por pixel)
+    uint32_t snapSize = lv_snapshot_buf_size_needed(stamp, SNAP_CF);
+    if (snapSize == 0) return false;
+
+    if (snapSize > scratchSize_) {
+        heap_caps_free(scratch_);
+        scratchSize_ = 0;
+        scratch_ = (uint8_t*)heap_caps_malloc(snapSize, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!scratch_) {
+            ESP_LOGE(TAG, "Sem PSRAM para rascunho (%lu bytes)", (unsigned long)snapSize);
+            return false;
+        }
+        scratchSize_ = snapSize;
+    }
+
+    lv_img_dsc_t snap;
+    if (lv_snapshot_take_to_buf(stamp, SNAP_CF, &snap, scratch_, scratchSize_) != LV_RES_OK) {
+        return false;
+    }
+
+    lv_coord_t w = snap.header.w;
+    lv_coord_t h = snap.header.h;
+    lv_area_t bodyArea;
+    bool hasBody = findOpaqueBody(scratch_, w, h, &bodyArea);
+    uint32_t bodySize = hasBody ? lv_area_get_size(&bodyArea) * sizeof(lv_color_t) : 0;
+
+    // Face e miolo no mesmo bloco
+    ButtonFaceImage& fi = face->state[state];
+    uint32_t need = snapSize + bodySize;
+    if (fi.img.data && fi.img.data_size != need) {
+        freeImage(face, state);
+    }
+
+    uint8_t* buf = (uint8_t*)fi.img.data;
+    if (!buf) {
+        buf = (uint8_t*)heap_caps_malloc(need, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!buf) {
+            ESP_LOGE(TAG, "Sem PSRAM para face (%lu bytes)", (unsigned long)need);
+            return false;
+        }
+        stats_.images++;
+        stats_.bytes += need;
+    }
+
+    // Pixels intercalados (cor, alfa) -> plano de cor + plano de alfa
+    const uint8_t* src = scratch_;
+    lv_color_t* color = (lv_color_t*)buf;
+    lv_opa_t* alpha = buf + (uint32_t)w * h * sizeof(lv_color_t);
+    for (uint32_t i = 0; i < (uint32_t)w * h; i++) {
+        memcpy(&color[i], src, sizeof(lv_color_t));
+        alpha[i] = src[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        src += LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+
+    fi.img = snap;
+    fi.img.header.cf = FACE_CF;
+    fi.img.data = buf;
+    fi.img.data_size = need;        // Inclui o miolo (contabilidade e reuso)
+    fi.ext = _lv_obj_get_ext_draw_size(stamp);
+
+    memset(&fi.body, 0, sizeof(fi.body));
+    memset(&fi.bodyArea, 0, sizeof(fi.bodyArea));
+    if (hasBody) {
+        lv_coord_t bw = lv_area_get_width(&bodyArea);
+        lv_coord_t bh = lv_area_get_height(&bodyArea);
+        lv_color_t* bodyPx = (lv_color_t*)(buf + snapSize);
+        for (lv_coord_t y = 0; y < bh; y++) {
+            memcpy(&bodyPx[(uint32_t)y * bw], &color[(uint32_t)(bodyArea.y1 + y) * w + bodyArea.x1],
+                   bw * sizeof(lv_color_t));
+        }
+
+        fi.body.header.always_zero = 0;
+        fi.body.header.w = bw;
+        fi.body.header.h = bh;
+        fi.body.header.cf = LV_IMG_CF_TRUE_COLOR;
+        fi.body.data = (const uint8_t*)bodyPx;
+        fi.body.data_size = bodySize;
+        fi.bodyArea = bodyArea;
+    }
+
+    stats_.bakes++;
+    stats_.bakeUs += (uint64_t)(esp_timer_get_time() - t0);
+    return true;
+}
+
+void ButtonFaceCache::freeImage(ButtonFace* face, ButtonFaceState state) {
+    ButtonFaceImage& fi = face->state[state];
+    if (!fi.img.data) return;
+
+    stats_.images--;
+    stats_.bytes -= fi.img.data_size;
+    heap_caps_free((void*)fi.img.data);
+    memset(&fi, 0, sizeof(fi));
+}
+
+/**
+ * Desenha a parte `part` de uma imagem posicionada em `coords`
+ * (lv_draw_img_decoded espera o recorte ja limitado a area desenhada)
+ */
+static void drawPart(lv_draw_ctx_t* drawCtx, const lv_draw_img_dsc_t* dsc, const lv_area_t* coords,
+                     const lv_img_dsc_t* img, const lv_area_t* part) {
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, drawCtx->clip_area, part)) return;
+
+    const lv_area_t* clipOrig = drawCtx->clip_area;
+    drawCtx->clip_area = &clip;
+    lv_draw_img_decoded(drawCtx, dsc, coords, img->data, img->header.cf);
+    drawCtx->clip_area = clipOrig;
+}
+
+// ============================================================================
+// BOTAO DE FACE
+// ============================================================================
+
+void ButtonFaceCache::attach(lv_obj_t* btn, ButtonFace* face) {
+    if (!btn || !face) return;
+
+    // Posicao e tamanho sao estilos locais: remove_style_all tambem os apaga.
+    // O raio fica para o que for desenhado ao vivo por cima da face
+    // (sombra pulsante, contorno de foco) seguir os cantos da imagem.
+    lv_coord_t x = lv_obj_get_style_x(btn, LV_PART_MAIN);
+    lv_coord_t y = lv_obj_get_style_y(btn, LV_PART_MAIN);
+    lv_coord_t w = lv_obj_get_style_width(btn, LV_PART_MAIN);
+    lv_coord_t h = lv_obj_get_style_height(btn, LV_PART_MAIN);
+    lv_coord_t radius = lv_obj_get_style_radius(btn, LV_PART_MAIN);
+
+    lv_obj_clean(btn);
+    lv_obj_remove_style_all(btn);
+
+    lv_obj_set_pos(btn, x, y);
+    lv_obj_set_size(btn, w, h);
+    lv_obj_set_style_radius(btn, radius, LV_PART_MAIN);
+
+    lv_obj_add_event_cb(btn, eventCallback, LV_EVENT_ALL, face);
+    lv_obj_refresh_ext_draw_size(btn);
+    lv_obj_invalidate(btn);
+}
+
+ButtonFace* ButtonFaceCache::faceOf(lv_obj_t* btn) {
+    if (!btn) return nullptr;
+    return static_cast<ButtonFace*>(lv_obj_get_event_user_data(btn, eventCallback));
+}
+
+void ButtonFaceCache::eventCallback(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t* btn = lv_event_get_target(e);
+    ButtonFace* face = static_cast<ButtonFace*>(lv_event_get_user_data(e));
+
+    switch (code) {
+        case LV_EVENT_DRAW_MAIN: {
+            lv_state_t st = lv_obj_get_state(btn);
+            ButtonFaceState s = BUTTON_FACE_NORMAL;
+            if ((st & LV_STATE_DISABLED) && face->has(BUTTON_FACE_DISABLED)) {
+                s = BUTTON_FACE_DISABLED;
+            } else if ((st & LV_STATE_PRESSED) && face->has(BUTTON_FACE_PRESSED)) {
+                s = BUTTON_FACE_PRESSED;
+            }
+
+            const ButtonFaceImage& fi = face->state[s];
+            if (!fi.img.data) return;
+
+            lv_area_t area;
+            lv_obj_get_coords(btn, &area);
+            lv_area_increase(&area, fi.ext, fi.ext);
+
+            lv_draw_ctx_t* drawCtx = lv_event_get_draw_ctx(e);
+            lv_draw_img_dsc_t dsc;
+            lv_draw_img_dsc_init(&dsc);
+            dsc.opa = lv_obj_get_style_opa(btn, LV_PART_MAIN);
+
+            if (!fi.body.data) {
+                drawPart(drawCtx, &dsc, &area, &fi.img, &area);
+                instance->stats_.blits++;
+                break;
+            }
+
+            // Miolo sem mistura; moldura em volta (cima, baixo, esquerda, direita) com alfa
+            lv_area_t body = fi.bodyArea;
+            lv_area_move(&body, area.x1, area.y1);
+            drawPart(drawCtx, &dsc, &body, &fi.body, &body);
+
+            lv_area_t frame[4] = {
+                { area.x1, area.y1, area.x2, (lv_coord_t)(body.y1 - 1) },
+                { area.x1, (lv_coord_t)(body.y2 + 1), area.x2, area.y2 },
+                { area.x1, body.y1, (lv_coord_t)(body.x1 - 1), body.y2 },
+                { (lv_coord_t)(body.x2 + 1), body.y1, area.x2, body.y2 }
+            };
+            for (int i = 0; i < 4; i++) {
+                if (frame[i].x1 <= frame[i].x2 && frame[i].y1 <= frame[i].y2) {
+                    drawPart(drawCtx, &dsc, &area, &fi.img, &frame[i]);
+                }
+            }
+            instance->stats_.blits++;
+            break;
+        }
+
+        case LV_EVENT_REFR_EXT_DRAW_SIZE: {
+            lv_coord_t ext = 0;
+            for (int s = 0; s < BUTTON_FACE_STATES; s++) {
+                if (face->state[s].ext > ext) ext = face->state[s].ext;
+            }
+            lv_event_set_ext_draw_size(e, ext);
+            break;
+        }
+
+        // Sem estilos por estado a LVGL nao redesenha na troca: invalida aqui
+        case LV_EVENT_PRESSED:
+        case LV_EVENT_RELEASED:
+        case LV_EVENT_PRESS_LOST:
+            lv_obj_invalidate(btn);
+            break;
+
+        case LV_EVENT_DELETE:
+            instance->release(face);
+            break;
+
+        default:
+            break;
+    }
+}
@@ -0,0 +1,514 @@
+/**
+ * ============================================================================
+ * CACHE DE GLIFOS
+ * ============================================================================
+ *
+ * Substitui draw_ctx->draw_letter. Acerto: indice direto (ASCII) ou hash,
+ * move a entrada para a cabeca do LRU e desenha o bitmap A8. Falta: busca
+ * o glifo pela API de fontes da LVGL, expande para A8 e insere, liberando
+ * as entradas menos usadas ate caber em GLYPH_CACHE_BUDGET. Glifos sem
+ * descritor, subpixel ou com bpp desconhecido seguem para o
+ * lv_draw_sw_letter original. Letras opacas sem mascara vao direto para o
+ * buffer pela rampa de cores; as demais montam a mascara e passam pelo
+ * lv_draw_sw_blend.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "ui/common/glyph_cache.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "sdkconfig.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include <inttypes.h>
+#include <string.h>
+
+static const char* TAG = "GLYPH_CACHE";
+
+#define ASCII_FIRST     0x20
+#define ASCII_LAST      (ASCII_FIRST + GlyphCache::asciiCount - 1)
+#define NO_ENTRY        ((int16_t)-1)
+
+static_assert(GLYPH_CACHE_ENTRIES < INT16_MAX, "Indices do cache sao int16_t");
+
+// ============================================================================
+// INSTANCIA SINGLETON
+// ============================================================================
+
+GlyphCache* GlyphCache::instance = nullptr;
+
+GlyphCache* GlyphCache::getInstance() {
+    if (instance == nullptr) {
+        instance = new GlyphCache();
+    }
+    return instance;
+}
+
+GlyphCache::GlyphCache()
+    : baseDrawLetter_(nullptr)
+    , entries_(nullptr)
+    , head_(NO_ENTRY)
+    , tail_(NO_ENTRY)
+    , freeList_(NO_ENTRY)
+    , fontCount_(0)
+    , rampValid_(false)
+    , lastReportMs_(0)
+{
+    memset(fonts_, 0, sizeof(fonts_));
+    memset(ascii_, 0xFF, sizeof(ascii_));       // NO_ENTRY
+    memset(buckets_, 0xFF, sizeof(buckets_));
+    memset(&stats_, 0, sizeof(stats_));
+    memset(&lastStats_, 0, sizeof(lastStats_));
+}
+
+// ============================================================================
+// INICIALIZACAO
+// ============================================================================
+
+bool GlyphCache::init() {
+    if (baseDrawLetter_) return true;
+
+    lv_disp_t* disp = lv_disp_get_default();
+    if (!disp || !disp->driver->draw_ctx) {
+        ESP_LOGE(TAG, "Display LVGL nao inicializado");
+        return false;
+    }
+
+#if GLYPH_CACHE_ENABLE
+    size_t size = sizeof(Entry) * GLYPH_CACHE_ENTRIES;
+    entries_ = static_cast<Entry*>(heap_caps_calloc(1, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!entries_) {
+        entries_ = static_cast<Entry*>(heap_caps_calloc(1, size, MALLOC_CAP_8BIT));
+    }
+    if (!entries_) {
+        ESP_LOGE(TAG, "Sem memoria para %u entradas", (unsigned)GLYPH_CACHE_ENTRIES);
+        return false;
+    }
+
+    // Todas as entradas comecam na lista livre (encadeada por next)
+    for (int16_t i = 0; i < GLYPH_CACHE_ENTRIES; i++) {
+        entries_[i].next = (i + 1 < GLYPH_CACHE_ENTRIES) ? i + 1 : NO_ENTRY;
+    }
+    freeList_ = 0;
+#endif
+
+    baseDrawLetter_ = disp->driver->draw_ctx->draw_letter;
+    disp->driver->draw_ctx->draw_letter = drawLetter;
+
+#if GLYPH_CACHE_ENABLE
+    ESP_LOGI(TAG, "%d glifos, %d KB de bitmaps A8", GLYPH_CACHE_ENTRIES, GLYPH_CACHE_BUDGET / 1024);
+#else
+    ESP_LOGI(TAG, "Cache desligado: apenas medindo o desenho de letras");
+#endif
+    return true;
+}
+
+// ============================================================================
+// DESENHO
+// ============================================================================
+
+void GlyphCache::drawLetter(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                            const lv_point_t* pos, uint32_t letter) {
+    GlyphCache* self = instance;
+    uint32_t start = esp_cpu_get_cycle_count();
+
+#if GLYPH_CACHE_ENABLE
+    if (!self->drawCached(drawCtx, dsc, pos, letter))
+#endif
+    {
+        self->baseDrawLetter_(drawCtx, dsc, pos, letter);
+    }
+
+    self->stats_.letters++;
+    self->stats_.drawCycles += esp_cpu_get_cycle_count() - start;
+}
+
+/**
+ * @return false se a letra deve ir para o lv_draw_sw_letter original
+ */
+bool GlyphCache::drawCached(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                            const lv_point_t* pos, uint32_t letter) {
+    int slot = fontSlot(dsc->font);
+    if (slot < 0) return false;
+
+    int16_t idx = find(slot, letter);
+    if (idx == NO_ENTRY) {
+        idx = insert(slot, dsc->font, letter);
+        if (idx == NO_ENTRY) return false;
+        stats_.misses++;
+    } else {
+        touch(idx);
+        stats_.hits++;
+    }
+
+    const Entry& e = entries_[idx];
+    if (e.bitmap == nullptr) return true;      // Espaco / glifo vazio
+
+    // Mesmo posicionamento e recorte do lv_draw_sw_letter
+    lv_point_t gpos;
+    gpos.x = pos->x + e.dsc.ofs_x;
+    gpos.y = pos->y + (dsc->font->line_height - dsc->font->base_line) - e.dsc.box_h - e.dsc.ofs_y;
+
+    const lv_area_t* clip = drawCtx->clip_area;
+    if (gpos.x + e.dsc.box_w < clip->x1 || gpos.x > clip->x2 ||
+        gpos.y + e.dsc.box_h < clip->y1 || gpos.y > clip->y2) {
+        return true;
+    }
+
+#if GLYPH_CACHE_RAMP
+    if (drawRamp(drawCtx, dsc, &gpos, e)) return true;
+#endif
+    drawA8(drawCtx, dsc, &gpos, e);
+    return true;
+}
+
+/**
+ * Letra opaca sobre o buffer RGB565 do draw_ctx, sem mascaras: mistura
+ * cada pixel direto no destino. Onde o destino e a cor de fundo da rampa
+ * o pixel sai da tabela; onde nao e (letra vizinha, gradiente) usa
+ * lv_color_mix. Mesmo resultado do fill_normal com mascara.
+ * @return false se a letra deve seguir pelo drawA8
+ */
+bool GlyphCache::drawRamp(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                          const lv_point_t* gpos, const Entry& e) {
+    if (!e.levels16 || dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL) {
+        return false;
+    }
+
+    // Buffer comum: sem set_px_cb, sem camada ARGB, sem blend de GPU
+    lv_disp_t* disp = _lv_refr_get_disp_refreshing();
+    if (disp->driver->set_px_cb || disp->driver->screen_transp || !disp->driver->antialiasing) {
+        return false;
+    }
+    if (reinterpret_cast<lv_draw_sw_ctx_t*>(drawCtx)->blend != lv_draw_sw_blend_basic) {
+        return false;
+    }
+
+    const lv_area_t* clip = drawCtx->clip_area;
+    lv_area_t area;
+    area.x1 = LV_MAX(gpos->x, clip->x1);
+    area.y1 = LV_MAX(gpos->y, clip->y1);
+    area.x2 = LV_MIN(gpos->x + e.dsc.box_w - 1, clip->x2);
+    area.y2 = LV_MIN(gpos->y + e.dsc.box_h - 1, clip->y2);
+    if (area.x1 > area.x2 || area.y1 > area.y2) return true;
+    if (lv_draw_mask_is_any(&area)) return false;
+
+    if (drawCtx->wait_for_finish) drawCtx->wait_for_finish(drawCtx);
+
+    const lv_area_t* bufArea = drawCtx->buf_area;
+    const int32_t stride = lv_area_get_width(bufArea);
+    const int32_t boxW = e.dsc.box_w;
+    const int32_t w = lv_area_get_width(&area);
+    lv_color_t* dst = static_cast<lv_color_t*>(drawCtx->buf) +
+                      stride * (area.y1 - bufArea->y1) + (area.x1 - bufArea->x1);
+    const uint8_t* src = e.bitmap + (area.y1 - gpos->y) * boxW + (area.x1 - gpos->x);
+
+    // Fundo: pixel do canto da caixa (a rampa anterior costuma servir)
+    const lv_color_t fg = dsc->color;
+    if (!rampValid_ || rampFg_.full != fg.full || rampBg_.full != dst->full) {
+        buildRamp(fg, *dst);
+    }
+    const lv_color_t bg = rampBg_;
+
+    for (int32_t y = area.y1; y <= area.y2; y++, src += boxW, dst += stride) {
+        for (int32_t x = 0; x < w; x++) {
+            uint8_t a = src[x];
+            if (a == LV_OPA_TRANSP) continue;
+            if (a == LV_OPA_COVER) dst[x] = fg;
+            else if (dst[x].full == bg.full) dst[x] = ramp_[a >> 4];
+            else dst[x] = lv_color_mix(fg, dst[x], a);
+        }
+    }
+
+    stats_.rampLetters++;
+    return true;
+}
+
+/**
+ * Cores para os 16 niveis de alfa dos glifos (k * 17, igual a
+ * _lv_bpp4_opa_table; 1 e 2 bpp caem nos mesmos niveis). k * 17 >> 4 == k.
+ */
+void GlyphCache::buildRamp(lv_color_t fg, lv_color_t bg) {
+    for (uint32_t k = 0; k < 16; k++) {
+        ramp_[k] = lv_color_mix(fg, bg, (lv_opa_t)(k * 17));
+    }
+    rampFg_ = fg;
+    rampBg_ = bg;
+    rampValid_ = true;
+}
+
+/**
+ * draw_letter_normal da LVGL para bitmap A8: a linha do glifo ja e a
+ * mascara (escalada por opa quando translucido)
+ */
+void GlyphCache::drawA8(lv_draw_ctx_t* drawCtx, const lv_draw_label_dsc_t* dsc,
+                        const lv_point_t* gpos, const Entry& e) {
+    const lv_area_t* clip = drawCtx->clip_area;
+    const int32_t boxW = e.dsc.box_w;
+    const int32_t boxH = e.dsc.box_h;
+    const lv_opa_t opa = dsc->opa;
+
+    int32_t colStart = gpos->x >= clip->x1 ? 0 : clip->x1 - gpos->x;
+    int32_t colEnd   = gpos->x + boxW <= clip->x2 ? boxW : clip->x2 - gpos->x + 1;
+    int32_t rowStart = gpos->y >= clip->y1 ? 0 : clip->y1 - gpos->y;
+    int32_t rowEnd   = gpos->y + boxH <= clip->y2 ? boxH : clip->y2 - gpos->y + 1;
+    int32_t w = colEnd - colStart;
+
+    lv_draw_sw_blend_dsc_t blend;
+    lv_memset_00(&blend, sizeof(blend));
+    blend.color = dsc->color;
+    blend.opa = opa;
+    blend.blend_mode = dsc->blend_mode;
+
+    lv_coord_t horRes = lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
+    uint32_t maskSize = boxW * boxH > horRes ? horRes : boxW * boxH;
+    lv_opa_t* mask = static_cast<lv_opa_t*>(lv_mem_buf_get(maskSize));
+    blend.mask_buf = mask;
+
+    lv_area_t fill;
+    fill.x1 = colStart + gpos->x;
+    fill.x2 = colEnd + gpos->x - 1;
+    fill.y1 = rowStart + gpos->y;
+    fill.y2 = fill.y1;
+    blend.blend_area = &fill;
+    blend.mask_area = &fill;
+
+    lv_area_t maskArea = fill;
+    maskArea.y2 = maskArea.y1 + rowEnd;
+    bool maskAny = lv_draw_mask_is_any(&maskArea);
+
+    const uint8_t* src = e.bitmap + rowStart * boxW + colStart;
+    uint32_t maskPos = 0;
+
+    for (int32_t row = rowStart; row < rowEnd; row++, src += boxW) {
+        lv_opa_t* dst = mask + maskPos;
+
+        if (opa >= LV_OPA_MAX) {
+            memcpy(dst, src, w);
+        } else {
+            for (int32_t i = 0; i < w; i++) {
+                uint8_t px = src[i];
+                dst[i] = px == LV_OPA_COVER ? opa : (lv_opa_t)((px * opa) >> 8);
+            }
+        }
+
+        if (maskAny) {
+            blend.mask_res = lv_draw_mask_apply(dst, fill.x1, fill.y2, w);
+            if (blend.mask_res == LV_DRAW_MASK_RES_TRANSP) {
+                lv_memset_00(dst, w);
+            }
+        }
+
+        maskPos += w;
+        if (maskPos + w < maskSize) {
+            fill.y2++;
+        } else {
+            blend.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            lv_draw_sw_blend(drawCtx, &blend);
+            fill.y1 = fill.y2 + 1;
+            fill.y2 = fill.y1;
+            maskPos = 0;
+        }
+    }
+
+    // Restante
+    if (fill.y1 != fill.y2) {
+        fill.y2--;
+        blend.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        lv_draw_sw_blend(drawCtx, &blend);
+    }
+
+    lv_mem_buf_release(mask);
+}
+
+// ============================================================================
+// INDICE
+// ============================================================================
+
+int GlyphCache::fontSlot(const lv_font_t* font) {
+    for (uint8_t i = 0; i < fontCount_; i++) {
+        if (fonts_[i] == font) return i;
+    }
+    if (fontCount_ >= GLYPH_CACHE_MAX_FONTS) return -1;
+
+    fonts_[fontCount_] = font;
+    return fontCount_++;
+}
+
+/**
+ * Cabeca da cadeia da chave: posicao fixa na tabela ASCII da fonte ou
+ * balde do hash para os demais codepoints
+ */
+int16_t* GlyphCache::indexSlot(int slot, uint32_t letter) {
+    if (letter >= ASCII_FIRST && letter <= ASCII_LAST) {
+        return &ascii_[slot][letter - ASCII_FIRST];
+    }
+    uint32_t h = (letter * 2654435761u) ^ (uint32_t)slot;
+    return &buckets_[(h >> 16) & (bucketCount - 1)];
+}
+
+int16_t GlyphCache::find(int slot, uint32_t letter) {
+    int16_t idx = *indexSlot(slot, letter);
+    while (idx != NO_ENTRY) {
+        const Entry& e = entries_[idx];
+        if (e.letter == letter && e.fontSlot == slot) return idx;
+        idx = e.hashNext;
+    }
+    return NO_ENTRY;
+}
+
+// ============================================================================
+// INSERCAO / LRU
+// ============================================================================
+
+/**
+ * Busca o glifo na fonte, expande para A8 e insere na cabeca do LRU
+ * @return NO_ENTRY se o glifo nao puder ser cacheado
+ */
+int16_t GlyphCache::insert(int slot, const lv_font_t* font, uint32_t letter) {
+    lv_font_glyph_dsc_t g;
+    if (!lv_font_get_glyph_dsc(font, &g, letter, '\0')) return NO_ENTRY;
+
+    uint32_t bpp = (g.bpp == 3) ? 4 : g.bpp;
+    if (g.resolved_font->subpx || (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8)) {
+        return NO_ENTRY;
+    }
+
+    const uint8_t* map = nullptr;
+    uint32_t size = (uint32_t)g.box_w * g.box_h;
+    if (size > 0) {
+        if (size > GLYPH_CACHE_BUDGET / 4) return NO_ENTRY;    // Glifo gigante: nao cacheia
+        map = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+        if (!map) return NO_ENTRY;
+    }
+
+    // Libera espaco: entrada livre + bytes dentro do orcamento
+    while (tail_ != NO_ENTRY && (freeList_ == NO_ENTRY || stats_.bytes + size > GLYPH_CACHE_BUDGET)) {
+        evict(tail_);
+    }
+    if (freeList_ == NO_ENTRY) return NO_ENTRY;
+
+    uint8_t* bitmap = nullptr;
+    if (size > 0) {
+        bitmap = static_cast<uint8_t*>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        if (!bitmap) return NO_ENTRY;
+
+        // Desempacota com a mesma escala das tabelas _lv_bppN_opa_table
+        static const uint8_t scale[9] = {0, 255, 85, 0, 17, 0, 0, 0, 1};
+        const uint32_t mask = (1u << bpp) - 1;
+        uint32_t bit = 0;
+        uint8_t* out = bitmap;
+        for (int32_t y = 0; y < g.box_h; y++) {
+            for (int32_t x = 0; x < g.box_w; x++, bit += bpp) {
+                uint32_t v = (map[bit >> 3] >> (8 - bpp - (bit & 7))) & mask;
+                *out++ = (uint8_t)(v * scale[bpp]);
+            }
+        }
+    }
+
+    int16_t idx = freeList_;
+    Entry& e = entries_[idx];
+    freeList_ = e.next;
+
+    e.font = font;
+    e.letter = letter;
+    e.dsc = g;
+    e.dsc.bpp = 8;
+    e.bitmap = bitmap;
+    e.fontSlot = (uint8_t)slot;
+    e.levels16 = bpp <= 4;
+
+    int16_t* chain = indexSlot(slot, letter);
+    e.hashNext = *chain;
+    *chain = idx;
+
+    e.prev = NO_ENTRY;
+    e.next = head_;
+    if (head_ != NO_ENTRY) entries_[head_].prev = idx;
+    head_ = idx;
+    if (tail_ == NO_ENTRY) tail_ = idx;
+
+    stats_.entries++;
+    stats_.bytes += size;
+    return idx;
+}
+
+void GlyphCache::unlink(int16_t idx) {
+    Entry& e = entries_[idx];
+    if (e.prev != NO_ENTRY) entries_[e.prev].next = e.next; else head_ = e.next;
+    if (e.next != NO_ENTRY) entries_[e.next].prev = e.prev; else tail_ = e.prev;
+}
+
+void GlyphCache::touch(int16_t idx) {
+    if (idx == head_) return;
+
+    unlink(idx);
+    Entry& e = entries_[idx];
+    e.prev = NO_ENTRY;
+    e.next = head_;
+    entries_[head_].prev = idx;
+    head_ = idx;
+}
+
+void GlyphCache::evict(int16_t idx) {
+    Entry& e = entries_[idx];
+
+    // Remove da cadeia do indice
+    int16_t* link = indexSlot(e.fontSlot, e.letter);
+    while (*link != idx) link = &entries_[*link].hashNext;
+    *link = e.hashNext;
+
+    unlink(idx);
+
+    stats_.bytes -= (uint32_t)e.dsc.box_w * e.dsc.box_h;
+    stats_.entries--;
+    stats_.evictions++;
+
+    heap_caps_free(e.bitmap);
+    e.bitmap = nullptr;
+    e.next = freeList_;
+    freeList_ = idx;
+}
+
+// ============================================================================
+// RELATORIO
+// ============================================================================
+
+void GlyphCache::reportIfDue(uint32_t nowMs) {
+    if (!baseDrawLetter_) return;
+
+    if (lastReportMs_ == 0) {
+        lastReportMs_ = nowMs;
+        return;
+    }
+    if (nowMs - lastReportMs_ < GLYPH_CACHE_REPORT_PERIOD_MS) return;
+
+    // Atualizado pela task LVGL; uma copia levemente defasada basta
+    GlyphCacheStats snap = stats_;
+    uint32_t letters = snap.letters - lastStats_.letters;
+    uint64_t cycles = snap.drawCycles - lastStats_.drawCycles;
+
+    if (letters > 0) {
+        uint32_t nsPerLetter = (uint32_t)(cycles * 1000 / CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ / letters);
+        ESP_LOGI(TAG, "%" PRIu32 " letras no periodo, %" PRIu32 ".%02" PRIu32 " us/letra",
+                 letters, nsPerLetter / 1000, (nsPerLetter % 1000) / 10);
+    }
+
+#if GLYPH_CACHE_ENABLE
+    uint32_t hits = snap.hits - lastStats_.hits;
+    uint32_t lookups = hits + (snap.misses - lastStats_.misses);
+    ESP_LOGI(TAG, "Acertos %" PRIu32 "%% (%" PRIu32 "/%" PRIu32 "), %" PRIu32 " evicoes, %" PRIu32 " glifos, %" PRIu32 " B",
+             lookups ? hits * 100 / lookups : 0, hits, lookups,
+             snap.evictions - lastStats_.evictions, snap.entries, snap.bytes);
+#if GLYPH_CACHE_RAMP
+    ESP_LOGI(TAG, "%" PRIu32 " letras direto no buffer (rampa)", snap.rampLetters - lastStats_.rampLetters);
+#endif
+#endif
+
+    lastReportMs_ = nowMs;
+    lastStats_ = snap;
+}
@@ -0,0 +1,614 @@
+/**
+ * ============================================================================
+ * DECODER PNG EM STREAMING
+ * ============================================================================
+ *
+ * open() le apenas os chunks anteriores ao IDAT (IHDR, PLTE, tRNS) e deixa
+ * o arquivo aberto. read_line() descomprime ate a linha pedida, desfaz o
+ * filtro usando a linha anterior e converte o trecho [x, x + len) para o
+ * formato da LVGL. Linhas sao lidas em ordem; pedir uma linha acima da
+ * atual reinicia o inflate no primeiro IDAT (a LVGL desenha cada area de
+ * cima para baixo, entao isso so ocorre uma vez por area redesenhada).
+ * Imagens pequenas passam por todas as linhas no open e viram um buffer
+ * comum (img_data), sem estado de inflate aberto.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "ui/common/png_stream.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "miniz.h"
+#include <string.h>
+
+static const char* TAG = "PNG_STREAM";
+
+static_assert(LV_COLOR_DEPTH == 16, "Decoder gera RGB565");
+
+// ============================================================================
+// ESTADO DO DECODER
+// ============================================================================
+
+#define PNG_CHUNK_IHDR  0x49484452u
+#define PNG_CHUNK_PLTE  0x504C5445u
+#define PNG_CHUNK_TRNS  0x74524E53u
+#define PNG_CHUNK_IDAT  0x49444154u
+
+#define PNG_COLOR_GRAY          0
+#define PNG_COLOR_RGB           2
+#define PNG_COLOR_PALETTE       3
+#define PNG_COLOR_GRAY_ALPHA    4
+#define PNG_COLOR_RGBA          6
+
+struct PngInfo {
+    uint32_t width;
+    uint32_t height;
+    uint8_t depth;
+    uint8_t colorType;
+    uint8_t interlace;
+    bool hasTrns;
+    uint32_t idatPos;       // Offset dos dados do primeiro IDAT
+    uint32_t idatLen;
+};
+
+struct PngStream {
+    lv_fs_file_t file;
+    PngInfo info;
+
+    // Formato
+    uint8_t channels;
+    uint8_t filterBpp;      // Distancia do filtro em bytes (minimo 1)
+    uint32_t stride;        // Bytes por linha, sem o byte de filtro
+    bool alpha;             // Saida TRUE_COLOR_ALPHA
+
+    // Paleta ja convertida (tipo 3) ou chave de transparencia (tipos 0/2)
+    lv_color_t palette[256];
+    uint8_t paletteAlpha[256];
+    uint16_t trnsKey[3];
+
+    // Entrada: IDATs consecutivos lidos em blocos
+    uint32_t chunkLeft;
+    bool inputEnd;
+    const uint8_t* inPtr;
+    size_t inAvail;
+    uint8_t in[PNG_STREAM_INPUT_SIZE];
+
+    // Inflate com janela circular de TINFL_LZ_DICT_SIZE
+    tinfl_decompressor* inflater;
+    uint8_t* window;
+    uint32_t windowOfs;
+    const uint8_t* outPtr;
+    size_t outAvail;
+    bool inflateDone;
+
+    // Linha atual e anterior (byte de filtro + stride)
+    uint8_t* cur;
+    uint8_t* prev;
+    int32_t row;            // Ultima linha decodificada (-1 = nenhuma)
+};
+
+// ============================================================================
+// LEITURA DO ARQUIVO
+// ============================================================================
+
+static inline uint32_t be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static bool read_exact(lv_fs_file_t* f, void* buf, uint32_t len) {
+    uint32_t rn = 0;
+    return lv_fs_read(f, buf, len, &rn) == LV_FS_RES_OK && rn == len;
+}
+
+static bool has_png_ext(const char* fn) {
+    return strcmp(lv_fs_get_ext(fn), "png") == 0;
+}
+
+/**
+ * Percorre os chunks ate o primeiro IDAT. Com stream != nullptr tambem
+ * carrega PLTE/tRNS ja convertidos.
+ */
+static bool read_header(lv_fs_file_t* f, PngInfo* info, PngStream* stream) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t buf[25];
+
+    if (!read_exact(f, buf, 8) || memcmp(buf, signature, 8) != 0) return false;
+
+    // IHDR obrigatoriamente primeiro: tamanho(4) tipo(4) dados(13) crc(4)
+    if (!read_exact(f, buf, 25) || be32(buf + 4) != PNG_CHUNK_IHDR) return false;
+
+    memset(info, 0, sizeof(*info));
+    info->width = be32(buf + 8);
+    info->height = be32(buf + 12);
+    info->depth = buf[16];
+    info->colorType = buf[17];
+    info->interlace = buf[20];
+
+    uint8_t plte[256 * 3];
+    uint32_t plteCount = 0;
+    uint32_t pos = 8 + 25;
+
+    for (;;) {
+        if (!read_exact(f, buf, 8)) return false;
+        uint32_t len = be32(buf);
+        uint32_t type = be32(buf + 4);
+        pos += 8;
+
+        if (type == PNG_CHUNK_IDAT) {
+            info->idatPos = pos;
+            info->idatLen = len;
+            break;
+        }
+
+        if (type == PNG_CHUNK_TRNS) {
+            info->hasTrns = true;
+        }
+
+        if (stream && type == PNG_CHUNK_PLTE && len <= sizeof(plte)) {
+            if (!read_exact(f, plte, len)) return false;
+            plteCount = len / 3;
+        } else if (stream && type == PNG_CHUNK_TRNS && len <= sizeof(stream->paletteAlpha)) {
+            uint8_t trns[256];
+            if (!read_exact(f, trns, len)) return false;
+            if (info->colorType == PNG_COLOR_PALETTE) {
+                memcpy(stream->paletteAlpha, trns, len);
+            } else {
+                for (uint32_t i = 0; i < 3 && i * 2 + 1 < len; i++) {
+                    stream->trnsKey[i] = (uint16_t)((trns[i * 2] << 8) | trns[i * 2 + 1]);
+                }
+            }
+        }
+
+        pos += len + 4;     // Dados + CRC
+        if (lv_fs_seek(f, pos, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+    }
+
+    if (stream) {
+        for (uint32_t i = 0; i < plteCount; i++) {
+            stream->palette[i] = lv_color_make(plte[i * 3], plte[i * 3 + 1], plte[i * 3 + 2]);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Combinacoes de profundidade/tipo aceitas; o resto fica para o lv_png
+ */
+static bool is_supported(const PngInfo* info) {
+    if (info->width == 0 || info->height == 0) return false;
+    if (info->width > LV_COORD_MAX || info->height > LV_COORD_MAX) return false;
+    if (info->interlace != 0) return false;
+
+    switch (info->colorType) {
+        case PNG_COLOR_GRAY:
+            return info->depth == 1 || info->depth == 2 || info->depth == 4 ||
+                   info->depth == 8 || info->depth == 16;
+        case PNG_COLOR_PALETTE:
+            return info->depth == 1 || info->depth == 2 || info->depth == 4 || info->depth == 8;
+        case PNG_COLOR_RGB:
+        case PNG_COLOR_GRAY_ALPHA:
+        case PNG_COLOR_RGBA:
+            return info->depth == 8 || info->depth == 16;
+        default:
+            return false;
+    }
+}
+
+static bool has_alpha(const PngInfo* info) {
+    return info->colorType == PNG_COLOR_GRAY_ALPHA || info->colorType == PNG_COLOR_RGBA || info->hasTrns;
+}
+
+// ============================================================================
+// INFLATE
+// ============================================================================
+
+/**
+ * Le o proximo bloco de IDAT; ao fim de um chunk pula o CRC e so continua
+ * se o seguinte tambem for IDAT
+ */
+static bool fill_input(PngStream* s) {
+    while (s->chunkLeft == 0) {
+        uint8_t hdr[12];    // CRC do chunk atual + tamanho + tipo do proximo
+        if (!read_exact(&s->file, hdr, sizeof(hdr)) || be32(hdr + 8) != PNG_CHUNK_IDAT) {
+            s->inputEnd = true;
+            return false;
+        }
+        s->chunkLeft = be32(hdr + 4);
+    }
+
+    uint32_t n = s->chunkLeft < sizeof(s->in) ? s->chunkLeft : sizeof(s->in);
+    if (!read_exact(&s->file, s->in, n)) {
+        s->inputEnd = true;
+        return false;
+    }
+
+    s->chunkLeft -= n;
+    s->inPtr = s->in;
+    s->inAvail = n;
+    return true;
+}
+
+/**
+ * Copia os proximos len bytes descomprimidos para dst
+ */
+static bool inflate_read(PngStream* s, uint8_t* dst, uint32_t len) {
+    while (len > 0) {
+        if (s->outAvail > 0) {
+            uint32_t n = s->outAvail < len ? (uint32_t)s->outAvail : len;
+            memcpy(dst, s->outPtr, n);
+            dst += n;
+            len -= n;
+            s->outPtr += n;
+            s->outAvail -= n;
+            continue;
+        }
+
+        if (s->inflateDone) return false;
+
+        if (s->inAvail == 0 && !s->inputEnd) {
+            fill_input(s);
+        }
+
+        size_t inBytes = s->inAvail;
+        size_t outBytes = TINFL_LZ_DICT_SIZE - s->windowOfs;
+        mz_uint32 flags = TINFL_FLAG_PARSE_ZLIB_HEADER;
+        if (!s->inputEnd) flags |= TINFL_FLAG_HAS_MORE_INPUT;
+
+        tinfl_status st = tinfl_decompress(s->inflater, s->inPtr, &inBytes, s->window,
+                                           s->window + s->windowOfs, &outBytes, flags);
+
+        s->inPtr += inBytes;
+        s->inAvail -= inBytes;
+        s->outPtr = s->window + s->windowOfs;
+        s->outAvail = outBytes;
+        s->windowOfs = (s->windowOfs + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+
+        if (st < TINFL_STATUS_DONE) {
+            ESP_LOGE(TAG, "Inflate falhou (%d)", (int)st);
+            return false;
+        }
+        if (st == TINFL_STATUS_DONE) {
+            s->inflateDone = true;
+        } else if (st == TINFL_STATUS_NEEDS_MORE_INPUT && s->inputEnd && outBytes == 0) {
+            ESP_LOGE(TAG, "IDAT truncado");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Volta para a primeira linha (inflate do inicio do primeiro IDAT)
+ */
+static bool rewind_stream(PngStream* s) {
+    if (lv_fs_seek(&s->file, s->info.idatPos, LV_FS_SEEK_SET) != LV_FS_RES_OK) return false;
+
+    tinfl_init(s->inflater);
+    s->chunkLeft = s->info.idatLen;
+    s->inputEnd = false;
+    s->inPtr = s->in;
+    s->inAvail = 0;
+    s->windowOfs = 0;
+    s->outPtr = s->window;
+    s->outAvail = 0;
+    s->inflateDone = false;
+
+    // A linha "anterior" da primeira e toda zero. decode_next_row troca
+    // cur e prev antes de descomprimir, entao quem vira prev e o cur.
+    memset(s->cur, 0, s->stride + 1);
+    s->row = -1;
+    return true;
+}
+
+// ============================================================================
+// LINHAS
+// ============================================================================
+
+static inline uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int p = (int)a + b - c;
+    int pa = p > a ? p - a : a - p;
+    int pb = p > b ? p - b : b - p;
+    int pc = p > c ? p - c : c - p;
+    if (pa <= pb && pa <= pc) return a;
+    return pb <= pc ? b : c;
+}
+
+/**
+ * Descomprime e desfaz o filtro da proxima linha (resultado em s->cur)
+ */
+static bool decode_next_row(PngStream* s) {
+    uint8_t* tmp = s->prev;
+    s->prev = s->cur;
+    s->cur = tmp;
+
+    if (!inflate_read(s, s->cur, s->stride + 1)) return false;
+
+    uint8_t* x = s->cur + 1;
+    const uint8_t* p = s->prev + 1;
+    const uint32_t n = s->stride;
+    const uint32_t bpp = s->filterBpp;
+    uint32_t i;
+
+    switch (s->cur[0]) {
+        case 0:
+            break;
+        case 1:
+            for (i = bpp; i < n; i++) x[i] += x[i - bpp];
+            break;
+        case 2:
+            for (i = 0; i < n; i++) x[i] += p[i];
+            break;
+        case 3:
+            for (i = 0; i < bpp; i++) x[i] += p[i] >> 1;
+            for (; i < n; i++) x[i] += (uint8_t)(((uint32_t)x[i - bpp] + p[i]) >> 1);
+            break;
+        case 4:
+            for (i = 0; i < bpp; i++) x[i] += p[i];
+            for (; i < n; i++) x[i] += paeth(x[i - bpp], p[i], p[i - bpp]);
+            break;
+        default:
+            ESP_LOGE(TAG, "Filtro %u invalido na linha %ld", s->cur[0], (long)(s->row + 1));
+            return false;
+    }
+
+    s->row++;
+    return true;
+}
+
+/**
+ * Amostra i da linha (1/2/4/8 bits ou 16 bits big-endian)
+ */
+static inline uint16_t sample_at(const uint8_t* line, uint32_t i, uint8_t depth) {
+    if (depth == 8) return line[i];
+    if (depth == 16) return (uint16_t)((line[i * 2] << 8) | line[i * 2 + 1]);
+
+    uint32_t bit = i * depth;
+    uint8_t shift = (uint8_t)(8 - depth - (bit & 7));
+    return (line[bit >> 3] >> shift) & ((1u << depth) - 1);
+}
+
+/**
+ * Amostra reduzida para 8 bits
+ */
+static inline uint8_t to8(uint16_t v, uint8_t depth) {
+    if (depth == 8) return (uint8_t)v;
+    if (depth == 16) return (uint8_t)(v >> 8);
+    return (uint8_t)(v * 255u / ((1u << depth) - 1));
+}
+
+/**
+ * Converte pixels [x, x + len) da linha atual para RGB565 (+ A8)
+ */
+static void convert_row(const PngStream* s, uint32_t x, uint32_t len, uint8_t* out) {
+    const uint8_t* line = s->cur + 1;
+    const uint8_t depth = s->info.depth;
+    const uint8_t ch = s->channels;
+    const uint32_t pxSize = s->alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+
+    for (uint32_t i = x; i < x + len; i++, out += pxSize) {
+        lv_color_t c;
+        uint8_t a = 0xFF;
+
+        switch (s->info.colorType) {
+            case PNG_COLOR_PALETTE: {
+                uint16_t idx = sample_at(line, i, depth);
+                c = s->palette[idx];
+                a = s->paletteAlpha[idx];
+                break;
+            }
+            case PNG_COLOR_GRAY: {
+                uint16_t v = sample_at(line, i, depth);
+                uint8_t g = to8(v, depth);
+                c = lv_color_make(g, g, g);
+                if (s->info.hasTrns && v == s->trnsKey[0]) a = 0;
+                break;
+            }
+            case PNG_COLOR_GRAY_ALPHA: {
+                uint8_t g = to8(sample_at(line, i * 2, depth), depth);
+                c = lv_color_make(g, g, g);
+                a = to8(sample_at(line, i * 2 + 1, depth), depth);
+                break;
+            }
+            default: {     // RGB / RGBA
+                uint16_t r = sample_at(line, i * ch, depth);
+                uint16_t g = sample_at(line, i * ch + 1, depth);
+                uint16_t b = sample_at(line, i * ch + 2, depth);
+                c = lv_color_make(to8(r, depth), to8(g, depth), to8(b, depth));
+                if (ch == 4) {
+                    a = to8(sample_at(line, i * ch + 3, depth), depth);
+                } else if (s->info.hasTrns && r == s->trnsKey[0] && g == s->trnsKey[1] && b == s->trnsKey[2]) {
+                    a = 0;
+                }
+                break;
+            }
+        }
+
+        memcpy(out, &c, sizeof(c));
+        if (s->alpha) out[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a;
+    }
+}
+
+// ============================================================================
+// CALLBACKS DO DECODER LVGL
+// ============================================================================
+
+static void stream_free(PngStream* s) {
+    if (!s) return;
+    if (s->file.drv) lv_fs_close(&s->file);
+    heap_caps_free(s->window);
+    heap_caps_free(s->inflater);
+    lv_mem_free(s->cur);
+    lv_mem_free(s->prev);
+    lv_mem_free(s);
+}
+
+/**
+ * Janela e estado do inflate na PSRAM quando houver (acesso sequencial)
+ */
+static void* alloc_work(size_t size) {
+    void* p = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return p ? p : heap_caps_malloc(size, MALLOC_CAP_8BIT);
+}
+
+static inline uint32_t pixel_size(const PngStream* s) {
+    return s->alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+}
+
+/**
+ * Decodifica a imagem inteira no formato da LVGL (linha a linha, sem o
+ * quadro RGBA de 32 bits do lodepng)
+ */
+static uint8_t* decode_all(PngStream* s, uint32_t size) {
+    uint8_t* pixels = static_cast<uint8_t*>(alloc_work(size));
+    if (!pixels) return nullptr;
+
+    const uint32_t lineBytes = s->info.width * pixel_size(s);
+    for (uint32_t y = 0; y < s->info.height; y++) {
+        if (!decode_next_row(s)) {
+            heap_caps_free(pixels);
+            return nullptr;
+        }
+        convert_row(s, 0, s->info.width, pixels + y * lineBytes);
+    }
+    return pixels;
+}
+
+static lv_res_t decoder_info(lv_img_decoder_t* dec, const void* src, lv_img_header_t* header) {
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+
+    const char* fn = static_cast<const char*>(src);
+    if (!has_png_ext(fn)) return LV_RES_INV;
+
+    lv_fs_file_t f;
+    if (lv_fs_open(&f, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+
+    PngInfo info;
+    bool ok = read_header(&f, &info, nullptr) && is_supported(&info);
+    lv_fs_close(&f);
+    if (!ok) return LV_RES_INV;
+
+    header->always_zero = 0;
+    header->cf = has_alpha(&info) ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+    header->w = (lv_coord_t)info.width;
+    header->h = (lv_coord_t)info.height;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_open(lv_img_decoder_t* dec, lv_img_decoder_dsc_t* dsc) {
+    if (dsc->src_type != LV_IMG_SRC_FILE) return LV_RES_INV;
+
+    const char* fn = static_cast<const char*>(dsc->src);
+    if (!has_png_ext(fn)) return LV_RES_INV;
+
+    PngStream* s = static_cast<PngStream*>(lv_mem_alloc(sizeof(PngStream)));
+    if (!s) return LV_RES_INV;
+    memset(s, 0, sizeof(*s));
+    memset(s->paletteAlpha, 0xFF, sizeof(s->paletteAlpha));
+
+    if (lv_fs_open(&s->file, fn, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        lv_mem_free(s);
+        return LV_RES_INV;
+    }
+
+    if (!read_header(&s->file, &s->info, s) || !is_supported(&s->info)) {
+        stream_free(s);
+        return LV_RES_INV;
+    }
+
+    static const uint8_t channelsByType[7] = {1, 0, 3, 1, 2, 0, 4};
+    s->channels = channelsByType[s->info.colorType];
+    uint32_t bitsPerPixel = (uint32_t)s->channels * s->info.depth;
+    s->filterBpp = (uint8_t)(bitsPerPixel >= 8 ? bitsPerPixel / 8 : 1);
+    s->stride = (s->info.width * bitsPerPixel + 7) / 8;
+    s->alpha = has_alpha(&s->info);
+
+    s->inflater = static_cast<tinfl_decompressor*>(alloc_work(sizeof(tinfl_decompressor)));
+    s->window = static_cast<uint8_t*>(alloc_work(TINFL_LZ_DICT_SIZE));
+    s->cur = static_cast<uint8_t*>(lv_mem_alloc(s->stride + 1));
+    s->prev = static_cast<uint8_t*>(lv_mem_alloc(s->stride + 1));
+
+    if (!s->inflater || !s->window || !s->cur || !s->prev || !rewind_stream(s)) {
+        ESP_LOGE(TAG, "Sem memoria para %s", fn);
+        stream_free(s);
+        return LV_RES_INV;
+    }
+
+    // Com full_refresh toda imagem visivel e redesenhada a cada quadro: as
+    // pequenas ficam decodificadas (no cache de imagens) em vez de passar
+    // pelo inflate de novo; so as grandes continuam em streaming
+    uint32_t pixelBytes = s->info.width * s->info.height * pixel_size(s);
+    if (pixelBytes <= PNG_STREAM_FULL_DECODE_MAX) {
+        uint32_t w = s->info.width;
+        uint32_t h = s->info.height;
+        uint8_t* pixels = decode_all(s, pixelBytes);
+        stream_free(s);
+        if (!pixels) {
+            ESP_LOGE(TAG, "Falha ao decodificar %s", fn);
+            return LV_RES_INV;
+        }
+
+        ESP_LOGI(TAG, "%s %lux%lu: decodificado (%lu B)", fn,
+                 (unsigned long)w, (unsigned long)h, (unsigned long)pixelBytes);
+        dsc->img_data = pixels;
+        dsc->user_data = NULL;
+        dsc->cache_size = pixelBytes;
+        return LV_RES_OK;
+    }
+
+    uint32_t work = sizeof(PngStream) + sizeof(tinfl_decompressor) + TINFL_LZ_DICT_SIZE + 2 * (s->stride + 1);
+    ESP_LOGI(TAG, "%s %lux%lu: %lu B de trabalho (quadro inteiro: %lu B)", fn,
+             (unsigned long)s->info.width, (unsigned long)s->info.height, (unsigned long)work,
+             (unsigned long)(s->info.width * s->info.height * 4));
+
+    // Sem img_data: a LVGL pede as linhas por read_line. O cache de imagens
+    // conta a memoria de trabalho no LV_IMG_CACHE_BUDGET enquanto fica aberto.
+    dsc->img_data = NULL;
+    dsc->user_data = s;
+    dsc->cache_size = work;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_read_line(lv_img_decoder_t* dec, lv_img_decoder_dsc_t* dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf) {
+    PngStream* s = static_cast<PngStream*>(dsc->user_data);
+    if (!s || x < 0 || y < 0 || len <= 0) return LV_RES_INV;
+    if ((uint32_t)y >= s->info.height || (uint32_t)(x + len) > s->info.width) return LV_RES_INV;
+
+    if (y < s->row && !rewind_stream(s)) return LV_RES_INV;
+
+    while (s->row < y) {
+        if (!decode_next_row(s)) return LV_RES_INV;
+    }
+
+    convert_row(s, (uint32_t)x, (uint32_t)len, buf);
+    return LV_RES_OK;
+}
+
+static void decoder_close(lv_img_decoder_t* dec, lv_img_decoder_dsc_t* dsc) {
+    if (dsc->user_data) {
+        stream_free(static_cast<PngStream*>(dsc->user_data));
+    } else {
+        heap_caps_free(const_cast<uint8_t*>(dsc->img_data));
+    }
+    dsc->user_data = NULL;
+    dsc->img_data = NULL;
+}
+
+// ============================================================================
+// REGISTRO
+// ============================================================================
+
+void png_stream_init(void) {
+    lv_img_decoder_t* dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, decoder_info);
+    lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_close_cb(dec, decoder_close);
+
+    ESP_LOGI(TAG, "Decoder PNG em streaming registrado");
+}
@@ -27,7 +27,11 @@ Theme* Theme::getInstance() {
     return instance;
 }
 
-Theme::Theme() {
+Theme::Theme()
+    : stylesReady(false)
+    , bgStyleCount(0)
+    , textStyleCount(0)
+{
     initColors();
 }
 
@@ -53,6 +57,119 @@ void Theme::initColors() {
     textMuted = lv_color_hex(THEME_TEXT_MUTED);
 }
 
+void Theme::initStyles() {
+    if (stylesReady) return;
+
+    lv_style_init(&styleButton);
+    lv_style_set_bg_opa(&styleButton, LV_OPA_COVER);
+    lv_style_set_radius(&styleButton, 10);
+    lv_style_set_border_width(&styleButton, 0);
+    lv_style_set_shadow_width(&styleButton, 0);
+
+    lv_style_init(&styleGridButton);
+    lv_style_set_bg_opa(&styleGridButton, LV_OPA_COVER);
+    lv_style_set_radius(&styleGridButton, 10);
+    lv_style_set_layout(&styleGridButton, LV_LAYOUT_FLEX);
+    lv_style_set_flex_flow(&styleGridButton, LV_FLEX_FLOW_COLUMN);
+    lv_style_set_flex_main_place(&styleGridButton, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_cross_place(&styleGridButton, LV_FLEX_ALIGN_CENTER);
+    lv_style_set_flex_track_place(&styleGridButton, LV_FLEX_ALIGN_CENTER);
+
+    lv_style_init(&styleDisabled);
+    lv_style_set_bg_opa(&styleDisabled, LV_OPA_50);
+
+    lv_style_init(&styleImage);
+    lv_style_set_bg_opa(&styleImage, LV_OPA_TRANSP);
+    lv_style_set_border_width(&styleImage, 0);
+    lv_style_set_pad_all(&styleImage, 0);
+
+    lv_style_init(&styleContainer);
+    lv_style_set_bg_opa(&styleContainer, LV_OPA_COVER);
+    lv_style_set_border_width(&styleContainer, 0);
+    lv_style_set_radius(&styleContainer, 0);
+
+    lv_style_init(&stylePopup);
+    lv_style_set_bg_color(&stylePopup, bgTertiary);
+    lv_style_set_bg_opa(&stylePopup, LV_OPA_COVER);
+    lv_style_set_border_width(&stylePopup, 3);
+    lv_style_set_border_color(&stylePopup, textPrimary);
+    lv_style_set_radius(&stylePopup, 15);
+
+    stylesReady = true;
+}
+
+// ============================================================================
+// FOLHA DE ESTILOS POR COR
+// ============================================================================
+
+lv_style_t* Theme::findBgStyle(lv_color_t color) {
+    uint32_t key = lv_color_to32(color);
+    for (int i = 0; i < bgStyleCount; i++) {
+        if (lv_color_to32(bgStyles[i].color) == key) {
+            return &bgStyles[i].style;
+        }
+    }
+    return nullptr;
+}
+
+lv_style_t* Theme::getBgStyle(lv_color_t color) {
+    lv_style_t* style = findBgStyle(color);
+    if (style || bgStyleCount >= THEME_MAX_BG_STYLES) {
+        return style;
+    }
+
+    BgStyleSlot& slot = bgStyles[bgStyleCount++];
+    slot.color = color;
+    lv_style_init(&slot.style);
+    lv_style_set_bg_color(&slot.style, color);
+    return &slot.style;
+}
+
+lv_style_t* Theme::getTextStyle(lv_color_t color, const lv_font_t* font) {
+    uint32_t key = lv_color_to32(color);
+    for (int i = 0; i < textStyleCount; i++) {
+        if (textStyles[i].font == font && lv_color_to32(textStyles[i].color) == key) {
+            return &textStyles[i].style;
+        }
+    }
+
+    if (textStyleCount >= THEME_MAX_TEXT_STYLES) {
+        return nullptr;
+    }
+
+    TextStyleSlot& slot = textStyles[textStyleCount++];
+    slot.color = color;
+    slot.font = font;
+    lv_style_init(&slot.style);
+    lv_style_set_text_color(&slot.style, color);
+    if (font) {
+        lv_style_set_text_font(&slot.style, font);
+    }
+    return &slot.style;
+}
+
+void Theme::addBgStyle(lv_obj_t* obj, lv_color_t color) {
+    lv_style_t* style = getBgStyle(color);
+    if (style) {
+        lv_obj_add_style(obj, style, LV_PART_MAIN);
+    } else {
+        // Tabela cheia: cor fora da paleta vira estilo local
+        lv_obj_set_style_bg_color(obj, color, LV_PART_MAIN);
+    }
+}
+
+void Theme::setBgColor(lv_obj_t* obj, lv_color_t oldColor, lv_color_t newColor) {
+    if (!obj) return;
+
+    lv_style_t* old = findBgStyle(oldColor);
+    if (old) {
+        lv_obj_remove_style(obj, old, LV_PART_MAIN);
+    }
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_COLOR, LV_PART_MAIN);
+
+    addBgStyle(obj, newColor);
+}
+
 // ============================================================================
 // CORES POR ESTADO DE JORNADA
 // ============================================================================
@@ -95,16 +212,20 @@ lv_color_t Theme::getColorForAction(int action) {
 void Theme::applyButtonStyle(lv_obj_t* btn, lv_color_t bgColor) {
     if (!btn) return;
 
-    lv_obj_set_style_bg_color(btn, bgColor, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_radius(btn, 10, LV_PART_MAIN);
-    lv_obj_set_style_border_width(btn, 0, LV_PART_MAIN);
-    lv_obj_set_style_shadow_width(btn, 0, LV_PART_MAIN);
+    initStyles();
+    lv_obj_add_style(btn, &styleButton, LV_PART_MAIN);
+    addBgStyle(btn, bgColor);
 }
 
 void Theme::applyLabelStyle(lv_obj_t* label, lv_color_t textColor, const lv_font_t* font) {
     if (!label) return;
 
+    lv_style_t* style = getTextStyle(textColor, font);
+    if (style) {
+        lv_obj_add_style(label, style, LV_PART_MAIN);
+        return;
+    }
+
     lv_obj_set_style_text_color(label, textColor, LV_PART_MAIN);
     if (font) {
         lv_obj_set_style_text_font(label, font, LV_PART_MAIN);
@@ -114,24 +235,36 @@ void Theme::applyLabelStyle(lv_obj_t* label, lv_color_t textColor, const lv_font
 void Theme::applyContainerStyle(lv_obj_t* container, lv_color_t bgColor) {
     if (!container) return;
 
-    lv_obj_set_style_bg_color(container, bgColor, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(container, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_width(container, 0, LV_PART_MAIN);
-    lv_obj_set_style_radius(container, 0, LV_PART_MAIN);
+    initStyles();
+    lv_obj_add_style(container, &styleContainer, LV_PART_MAIN);
+    addBgStyle(container, bgColor);
     lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
 }
 
 void Theme::applyPopupStyle(lv_obj_t* popup) {
     if (!popup) return;
 
-    lv_obj_set_style_bg_color(popup, bgTertiary, LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(popup, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_width(popup, 3, LV_PART_MAIN);
-    lv_obj_set_style_border_color(popup, textPrimary, LV_PART_MAIN);
-    lv_obj_set_style_radius(popup, 15, LV_PART_MAIN);
+    initStyles();
+    lv_obj_add_style(popup, &stylePopup, LV_PART_MAIN);
     lv_obj_clear_flag(popup, LV_OBJ_FLAG_SCROLLABLE);
 }
 
+void Theme::applyGridButtonStyle(lv_obj_t* btn, lv_color_t bgColor) {
+    if (!btn) return;
+
+    initStyles();
+    lv_obj_add_style(btn, &styleGridButton, LV_PART_MAIN);
+    lv_obj_add_style(btn, &styleDisabled, LV_PART_MAIN | LV_STATE_DISABLED);
+    addBgStyle(btn, bgColor);
+}
+
+void Theme::applyImageStyle(lv_obj_t* img) {
+    if (!img) return;
+
+    initStyles();
+    lv_obj_add_style(img, &styleImage, LV_PART_MAIN);
+}
+
 // ============================================================================
 // INTERFACE C
 // ============================================================================
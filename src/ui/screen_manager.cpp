@@ -3,8 +3,10 @@
  * GERENCIADOR DE TELAS - IMPLEMENTACAO
  * ============================================================================
  *
- * Navegacao baseada em pilha com troca instantanea (sem animacao).
- * Cada tela eh 100% isolada (ButtonManager proprio).
+ * Navegacao baseada em pilha com transicao slide a partir de snapshots.
+ * Cada tela eh 100% isolada (ButtonManager proprio, vindo do pool).
+ * Ao perder o foco a tela segue sua ScreenRetention: telas retidas
+ * voltam sem alocar; cada troca registra o delta e a fragmentacao do heap.
  *
  * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
  * Desenvolvido por Mario Stanski Jr
@@ -17,6 +19,7 @@
 #include "config/app_config.h"
 #include "esp_bsp.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
 #include <string.h>
 
 static const char* TAG = "SCREEN_MGR";
@@ -45,6 +48,8 @@ ScreenManagerImpl::ScreenManagerImpl()
 {
     memset(screens_, 0, sizeof(screens_));
     memset(navStack_, 0, sizeof(navStack_));
+    memset(suspended_, 0, sizeof(suspended_));
+    memset(&navStats_, 0, sizeof(navStats_));
 }
 
 // ============================================================================
@@ -56,6 +61,7 @@ void ScreenManagerImpl::init() {
 
     for (int i = 0; i < static_cast<int>(ScreenType::MAX_SCREENS); i++) {
         screens_[i] = nullptr;
+        suspended_[i] = false;
     }
 
     stackTop_ = -1;
@@ -115,27 +121,8 @@ void ScreenManagerImpl::navigateTo(ScreenType type) {
     navStack_[stackTop_] = currentScreen_;
     ESP_LOGI(TAG, "Push na pilha: tipo=%d (profundidade=%d)", static_cast<int>(currentScreen_), stackTop_ + 1);
 
-    // Chamar onExit na tela que esta saindo
-    if (currentScreenPtr != nullptr) {
-        currentScreenPtr->onExit();
-    }
-
-    // Criar a nova tela se necessario
-    if (!targetScreen->isCreated()) {
-        targetScreen->create();
-    }
-
-    // Chamar onEnter na nova tela
-    targetScreen->onEnter();
-
-    // Troca instantanea (sem animacao)
-    lv_obj_t* newLvScreen = targetScreen->getLvScreen();
-    if (newLvScreen != nullptr) {
-        if (bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
-            lv_scr_load(newLvScreen);
-            bsp_display_unlock();
-        }
-    }
+    // Transicao slide-left; a tela que sai fica na pilha conforme sua politica
+    switchScreen(currentScreenPtr, targetScreen, TransitionDir::LEFT);
 
     // Atualizar tela atual
     currentScreen_ = type;
@@ -164,11 +151,6 @@ bool ScreenManagerImpl::goBack() {
     ESP_LOGI(TAG, "Pop da pilha: voltando para tipo=%d (profundidade=%d)",
              static_cast<int>(previousType), stackTop_ + 1);
 
-    // Chamar onExit na tela que esta saindo
-    if (leavingScreen != nullptr) {
-        leavingScreen->onExit();
-    }
-
     // Obter a tela anterior
     IScreen* previousScreen = screens_[static_cast<int>(previousType)];
     if (previousScreen == nullptr) {
@@ -176,27 +158,8 @@ bool ScreenManagerImpl::goBack() {
         return false;
     }
 
-    // Criar a tela anterior se necessario
-    if (!previousScreen->isCreated()) {
-        previousScreen->create();
-    }
-
-    // Chamar onEnter na tela restaurada
-    previousScreen->onEnter();
-
-    // Troca instantanea (sem animacao)
-    lv_obj_t* prevLvScreen = previousScreen->getLvScreen();
-    if (prevLvScreen != nullptr) {
-        if (bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
-            lv_scr_load(prevLvScreen);
-            bsp_display_unlock();
-        }
-    }
-
-    // Destruir a tela que estamos saindo (liberar memoria)
-    if (leavingScreen != nullptr) {
-        leavingScreen->destroy();
-    }
+    // Transicao slide-right; a tela que sai e retida ou destruida conforme sua politica
+    switchScreen(leavingScreen, previousScreen, TransitionDir::RIGHT);
 
     // Atualizar tela atual
     currentScreen_ = previousType;
@@ -228,32 +191,11 @@ void ScreenManagerImpl::cycleTo(ScreenType type) {
 
     IScreen* leavingScreen = screens_[static_cast<int>(currentScreen_)];
 
-    // 1. Sair da tela atual (para timers, fecha popups)
-    if (leavingScreen != nullptr) {
-        leavingScreen->onExit();
-    }
-
-    // 2. Criar tela destino apenas na primeira vez (manter viva depois)
-    if (!targetScreen->isCreated()) {
-        targetScreen->create();
-    }
-
-    // 3. Entrar na tela destino
-    targetScreen->onEnter();
-
-    // 4. Troca instantanea (sem animacao)
-    lv_obj_t* newLvScreen = targetScreen->getLvScreen();
-    if (newLvScreen != nullptr) {
-        if (bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
-            lv_scr_load(newLvScreen);
-            bsp_display_unlock();
-        }
-    }
-
-    // 5. NAO deletar tela anterior (ambas permanecem na memoria para troca instantanea)
+    // Transicao slide-left (a tela anterior segue a sua politica de retencao)
+    switchScreen(leavingScreen, targetScreen, TransitionDir::LEFT);
     currentScreen_ = type;
 
-    ESP_LOGI(TAG, "Ciclou para tela tipo=%d (instantaneo)", idx);
+    ESP_LOGI(TAG, "Ciclou para tela tipo=%d (slide-left)", idx);
 }
 
 // ============================================================================
@@ -304,15 +246,13 @@ void ScreenManagerImpl::showInitialScreen(ScreenType type) {
     }
 
     // Criar se necessario
-    if (!screen->isCreated()) {
-        screen->create();
-    }
+    activateScreen(screen);
 
     // Carregar sem animacao
     lv_obj_t* lvScreen = screen->getLvScreen();
     if (lvScreen != nullptr) {
         if (bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
-            lv_scr_load(lvScreen);
+            transition_.run(lv_scr_act(), lvScreen, TransitionDir::NONE);
             bsp_display_unlock();
         }
     }
@@ -326,6 +266,97 @@ void ScreenManagerImpl::showInitialScreen(ScreenType type) {
     ESP_LOGI(TAG, "Tela inicial carregada: tipo=%d", idx);
 }
 
+// ============================================================================
+// TROCA DE TELA E POLITICA DE RETENCAO
+// ============================================================================
+
+void ScreenManagerImpl::switchScreen(IScreen* leaving, IScreen* target, TransitionDir dir) {
+    size_t heapBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    // 1. Sair da tela atual (para timers, fecha popups)
+    if (leaving != nullptr) {
+        leaving->onExit();
+    }
+
+    // 2. Criar a tela destino ou retomar a retida
+    activateScreen(target);
+
+    // 3. Entrar na tela destino
+    target->onEnter();
+
+    // 4. Transicao a partir de snapshots (a tela que sai fica congelada na imagem)
+    lv_obj_t* newLvScreen = target->getLvScreen();
+    if (newLvScreen != nullptr) {
+        if (bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
+            transition_.run(lv_scr_act(), newLvScreen, dir);
+            bsp_display_unlock();
+        }
+    }
+
+    // 5. Aplicar a politica da tela que saiu (ja nao e a tela ativa;
+    //    durante a animacao so o snapshot dela e desenhado)
+    if (leaving != nullptr && leaving != target) {
+        retireScreen(leaving);
+    }
+
+    navStats_.transitions++;
+    recordHeap(heapBefore);
+}
+
+void ScreenManagerImpl::activateScreen(IScreen* screen) {
+    int idx = static_cast<int>(screen->getType());
+
+    if (!screen->isCreated()) {
+        screen->create();
+        suspended_[idx] = false;
+        navStats_.creates++;
+    } else if (suspended_[idx]) {
+        screen->resume();
+        suspended_[idx] = false;
+        navStats_.resumes++;
+    }
+}
+
+void ScreenManagerImpl::retireScreen(IScreen* screen) {
+    int idx = static_cast<int>(screen->getType());
+
+    switch (screen->getRetention()) {
+        case ScreenRetention::KEEP_ALIVE:
+            break;
+
+        case ScreenRetention::SUSPEND:
+            if (screen->isCreated() && !suspended_[idx]) {
+                screen->suspend();
+                suspended_[idx] = true;
+            }
+            break;
+
+        case ScreenRetention::DESTROY:
+            if (screen->isCreated()) {
+                screen->destroy();
+                suspended_[idx] = false;
+                navStats_.destroys++;
+            }
+            break;
+    }
+}
+
+void ScreenManagerImpl::recordHeap(size_t heapBefore) {
+    size_t freeNow = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+
+    navStats_.lastHeapDelta = (int32_t)heapBefore - (int32_t)freeNow;
+    navStats_.heapFree = freeNow;
+    navStats_.heapMinFree = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+    navStats_.largestFreeBlock = largest;
+    navStats_.fragmentationPct = freeNow ? (uint8_t)(100 - (largest * 100) / freeNow) : 0;
+
+    ESP_LOGI(TAG, "Troca #%lu: heap %+ld bytes, livre %u (min %u), maior bloco %u, frag %u%%",
+             (unsigned long)navStats_.transitions, (long)navStats_.lastHeapDelta,
+             (unsigned)navStats_.heapFree, (unsigned)navStats_.heapMinFree,
+             (unsigned)navStats_.largestFreeBlock, (unsigned)navStats_.fragmentationPct);
+}
+
 // ============================================================================
 // INTERFACE C (WRAPPERS)
 // ============================================================================
@@ -0,0 +1,197 @@
+/**
+ * ============================================================================
+ * TRANSICAO DE TELAS - IMPLEMENTACAO
+ * ============================================================================
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "ui/screen_transition.h"
+#include "lv_port.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char* TAG = "SCREEN_TRANS";
+
+// ============================================================================
+// CONSTRUTOR
+// ============================================================================
+
+ScreenTransition::ScreenTransition()
+    : bufSize_(0)
+    , screen_(nullptr)
+    , target_(nullptr)
+    , dir_(TransitionDir::NONE)
+    , running_(false)
+    , startUs_(0)
+    , startFrames_(0)
+    , startRenderMs_(0)
+{
+    buf_[0] = buf_[1] = nullptr;
+    img_[0] = img_[1] = nullptr;
+    memset(dsc_, 0, sizeof(dsc_));
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+// ============================================================================
+// TRANSICAO
+// ============================================================================
+
+void ScreenTransition::run(lv_obj_t* from, lv_obj_t* to, TransitionDir dir) {
+    if (to == nullptr) return;
+
+    // Uma transicao por vez: a anterior termina na hora
+    if (running_) {
+        finish();
+        from = lv_scr_act();
+    }
+
+    if (dir == TransitionDir::NONE || SCREEN_TRANSITION_TIME_MS == 0 ||
+        from == nullptr || from == to) {
+        lv_scr_load(to);
+        return;
+    }
+
+    if (!ensureBuffers(from, to)) {
+        stats_.fallbacks++;
+        lv_scr_load(to);
+        return;
+    }
+
+    // Renderiza as duas arvores uma unica vez
+    int64_t t0 = esp_timer_get_time();
+    lv_obj_update_layout(to);
+    if (lv_snapshot_take_to_buf(from, LV_IMG_CF_TRUE_COLOR, &dsc_[0], buf_[0], bufSize_) != LV_RES_OK ||
+        lv_snapshot_take_to_buf(to, LV_IMG_CF_TRUE_COLOR, &dsc_[1], buf_[1], bufSize_) != LV_RES_OK) {
+        ESP_LOGW(TAG, "Snapshot falhou, troca instantanea");
+        stats_.fallbacks++;
+        lv_scr_load(to);
+        return;
+    }
+    stats_.snapshotUs = (uint32_t)(esp_timer_get_time() - t0);
+
+    ensureScreen();
+
+    // O cache de imagens guarda o descritor: invalida antes de reusar o buffer
+    lv_img_cache_invalidate_src(&dsc_[0]);
+    lv_img_cache_invalidate_src(&dsc_[1]);
+    lv_img_set_src(img_[0], &dsc_[0]);
+    lv_img_set_src(img_[1], &dsc_[1]);
+
+    target_ = to;
+    dir_ = dir;
+    running_ = true;
+    animExecCallback(this, 0);
+    lv_scr_load(screen_);
+
+    lvgl_port_render_stats_t rs;
+    lvgl_port_get_render_stats(&rs);
+    startFrames_ = rs.frames;
+    startRenderMs_ = rs.total_ms;
+    startUs_ = esp_timer_get_time();
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, this);
+    lv_anim_set_values(&a, 0, lv_disp_get_hor_res(NULL));
+    lv_anim_set_time(&a, SCREEN_TRANSITION_TIME_MS);
+    lv_anim_set_delay(&a, SCREEN_TRANSITION_DELAY_MS);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_set_exec_cb(&a, animExecCallback);
+    lv_anim_set_ready_cb(&a, animReadyCallback);
+    lv_anim_start(&a);
+}
+
+void ScreenTransition::finish() {
+    if (!running_) return;
+
+    // Remove a animacao sem disparar o ready_cb
+    lv_anim_del(this, animExecCallback);
+    running_ = false;
+
+    lv_scr_load(target_);
+    target_ = nullptr;
+
+    lvgl_port_render_stats_t rs;
+    lvgl_port_get_render_stats(&rs);
+    stats_.count++;
+    stats_.frames = rs.frames - startFrames_;
+    stats_.renderMs = rs.total_ms - startRenderMs_;
+    stats_.durationMs = (uint32_t)((esp_timer_get_time() - startUs_) / 1000);
+
+    uint32_t fps = stats_.durationMs ? (stats_.frames * 1000) / stats_.durationMs : 0;
+    uint32_t load = stats_.durationMs ? (stats_.renderMs * 100) / stats_.durationMs : 0;
+    ESP_LOGI(TAG, "Transicao: %lu frames em %lu ms (%lu fps), render %lu ms (%lu%% CPU), snapshots %lu us",
+             (unsigned long)stats_.frames, (unsigned long)stats_.durationMs, (unsigned long)fps,
+             (unsigned long)stats_.renderMs, (unsigned long)load, (unsigned long)stats_.snapshotUs);
+}
+
+// ============================================================================
+// METODOS PRIVADOS
+// ============================================================================
+
+bool ScreenTransition::ensureBuffers(lv_obj_t* from, lv_obj_t* to) {
+    uint32_t need = lv_snapshot_buf_size_needed(from, LV_IMG_CF_TRUE_COLOR);
+    uint32_t needTo = lv_snapshot_buf_size_needed(to, LV_IMG_CF_TRUE_COLOR);
+    if (needTo > need) need = needTo;
+
+    if (need == 0) return false;
+    if (need <= bufSize_) return true;
+
+    // Telas sao sempre do tamanho do display: na pratica aloca uma vez
+    heap_caps_free(buf_[0]);
+    heap_caps_free(buf_[1]);
+    buf_[0] = (uint8_t*)heap_caps_malloc(need, MALLOC_CAP_SPIRAM);
+    buf_[1] = (uint8_t*)heap_caps_malloc(need, MALLOC_CAP_SPIRAM);
+
+    if (!buf_[0] || !buf_[1]) {
+        ESP_LOGE(TAG, "Sem PSRAM para snapshots (2 x %lu bytes)", (unsigned long)need);
+        heap_caps_free(buf_[0]);
+        heap_caps_free(buf_[1]);
+        buf_[0] = buf_[1] = nullptr;
+        bufSize_ = 0;
+        return false;
+    }
+
+    bufSize_ = need;
+    ESP_LOGI(TAG, "Buffers de snapshot: 2 x %lu bytes na PSRAM", (unsigned long)need);
+    return true;
+}
+
+void ScreenTransition::ensureScreen() {
+    if (screen_) return;
+
+    screen_ = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(screen_, lv_color_hex(0x1a1a1a), LV_PART_MAIN);
+    lv_obj_clear_flag(screen_, LV_OBJ_FLAG_SCROLLABLE);
+
+    for (int i = 0; i < 2; i++) {
+        img_[i] = lv_img_create(screen_);
+        lv_obj_set_pos(img_[i], 0, 0);
+        lv_obj_clear_flag(img_[i], LV_OBJ_FLAG_CLICKABLE);
+    }
+}
+
+void ScreenTransition::animExecCallback(void* var, int32_t v) {
+    ScreenTransition* self = static_cast<ScreenTransition*>(var);
+    lv_coord_t w = lv_disp_get_hor_res(NULL);
+
+    if (self->dir_ == TransitionDir::LEFT) {
+        lv_obj_set_x(self->img_[0], -v);
+        lv_obj_set_x(self->img_[1], w - v);
+    } else {
+        lv_obj_set_x(self->img_[0], v);
+        lv_obj_set_x(self->img_[1], v - w);
+    }
+}
+
+void ScreenTransition::animReadyCallback(lv_anim_t* a) {
+    ScreenTransition* self = static_cast<ScreenTransition*>(a->var);
+    // A animacao ja terminou: finish() apenas carrega o destino e mede
+    self->finish();
+}
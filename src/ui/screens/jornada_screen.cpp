@@ -52,8 +52,8 @@ void JornadaScreen::create() {
 
     ESP_LOGI(TAG, "Criando JornadaScreen...");
 
-    // Cria ButtonManager proprio desta tela (isolamento total)
-    btnManager_ = new ButtonManager();
+    // ButtonManager proprio desta tela (isolamento total), vindo do pool
+    btnManager_ = ButtonManager::acquire();
     jornadaKb_ = JornadaKeyboard::getInstance();
 
     if (!btnManager_ || !jornadaKb_) {
@@ -64,6 +64,9 @@ void JornadaScreen::create() {
     // Inicializa ButtonManager (cria screen e gridContainer internos)
     btnManager_->init();
 
+    // Grade fixa: cada botao vira uma face pre-renderizada na PSRAM
+    btnManager_->setBakedFaces(true);
+
     // Inicializa JornadaKeyboard com ButtonManager desta tela (nao o singleton)
     jornadaKb_->init(btnManager_);
 
@@ -89,9 +92,9 @@ void JornadaScreen::destroy() {
         jornadaKb_->clearKeyboard();
     }
 
-    // Deleta o ButtonManager proprio desta tela (deleta screen LVGL e botoes)
+    // Devolve o ButtonManager ao pool (deleta screen LVGL e botoes)
     if (btnManager_) {
-        delete btnManager_;
+        ButtonManager::release(btnManager_);
         btnManager_ = nullptr;
     }
     screen_ = nullptr;
@@ -138,6 +141,23 @@ lv_obj_t* JornadaScreen::getLvScreen() const {
     return screen_;
 }
 
+ScreenRetention JornadaScreen::getRetention() const {
+    // Troca frequente entre telas: manter a arvore LVGL, sem realocar
+    return ScreenRetention::SUSPEND;
+}
+
+void JornadaScreen::suspend() {
+    if (btnManager_) {
+        btnManager_->suspend();
+    }
+}
+
+void JornadaScreen::resume() {
+    if (btnManager_) {
+        btnManager_->resume();
+    }
+}
+
 // ============================================================================
 // METODOS INTERNOS
 // ============================================================================
@@ -146,7 +166,11 @@ void JornadaScreen::invalidate() {
     screen_ = nullptr;
     created_ = false;
     jornadaKb_ = nullptr;
-    btnManager_ = nullptr;
+    // LVGL ja deletou a tela: apenas devolve o ButtonManager ao pool
+    if (btnManager_) {
+        ButtonManager::release(btnManager_, true);
+        btnManager_ = nullptr;
+    }
     ESP_LOGI(TAG, "JornadaScreen invalidada (sem cleanup LVGL)");
 }
 
@@ -52,8 +52,8 @@ void NumpadScreen::create() {
 
     ESP_LOGI(TAG, "Criando NumpadScreen...");
 
-    // Cria ButtonManager proprio desta tela (isolamento total)
-    btnManager_ = new ButtonManager();
+    // ButtonManager proprio desta tela (isolamento total), vindo do pool
+    btnManager_ = ButtonManager::acquire();
     numpad_ = NumpadExample::getInstance();
 
     if (!btnManager_ || !numpad_) {
@@ -64,6 +64,9 @@ void NumpadScreen::create() {
     // Inicializa ButtonManager (cria screen e gridContainer internos)
     btnManager_->init();
 
+    // Grade fixa: cada botao vira uma face pre-renderizada na PSRAM
+    btnManager_->setBakedFaces(true);
+
     // Inicializa NumpadExample com ButtonManager desta tela (nao o singleton)
     numpad_->init(btnManager_);
 
@@ -89,9 +92,9 @@ void NumpadScreen::destroy() {
         numpad_->clearNumpad();
     }
 
-    // Deleta o ButtonManager proprio desta tela (deleta screen LVGL e botoes)
+    // Devolve o ButtonManager ao pool (deleta screen LVGL e botoes)
     if (btnManager_) {
-        delete btnManager_;
+        ButtonManager::release(btnManager_);
         btnManager_ = nullptr;
     }
     screen_ = nullptr;
@@ -136,6 +139,23 @@ lv_obj_t* NumpadScreen::getLvScreen() const {
     return screen_;
 }
 
+ScreenRetention NumpadScreen::getRetention() const {
+    // Troca frequente entre telas: manter a arvore LVGL, sem realocar
+    return ScreenRetention::SUSPEND;
+}
+
+void NumpadScreen::suspend() {
+    if (btnManager_) {
+        btnManager_->suspend();
+    }
+}
+
+void NumpadScreen::resume() {
+    if (btnManager_) {
+        btnManager_->resume();
+    }
+}
+
 // ============================================================================
 // METODOS INTERNOS
 // ============================================================================
@@ -144,8 +164,12 @@ void NumpadScreen::invalidate() {
     screen_ = nullptr;
     created_ = false;
     numpad_ = nullptr;
-    // Nao deletar btnManager_ aqui -- invalidate assume que LVGL ja limpou
-    btnManager_ = nullptr;
+    // Nao deletar a tela aqui -- invalidate assume que LVGL ja limpou;
+    // apenas devolve o ButtonManager ao pool
+    if (btnManager_) {
+        ButtonManager::release(btnManager_, true);
+        btnManager_ = nullptr;
+    }
     ESP_LOGI(TAG, "NumpadScreen invalidada (sem cleanup LVGL)");
 }
 
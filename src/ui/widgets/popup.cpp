@@ -0,0 +1,327 @@
+/**
+ * ============================================================================
+ * WIDGET POPUP - IMPLEMENTACAO
+ * ============================================================================
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "ui/widgets/popup.h"
+#include "ui/common/theme.h"
+#include "esp_bsp.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char* TAG = "POPUP";
+
+// ============================================================================
+// SINGLETON
+// ============================================================================
+
+PopupService* PopupService::instance = nullptr;
+
+PopupService* PopupService::getInstance() {
+    if (instance == nullptr) {
+        instance = new PopupService();
+    }
+    return instance;
+}
+
+PopupService::PopupService()
+    : overlay_(nullptr)
+    , iconLabel_(nullptr)
+    , titleLabel_(nullptr)
+    , msgLabel_(nullptr)
+    , btnOk_(nullptr)
+    , btnCancel_(nullptr)
+    , head_(0)
+    , count_(0)
+    , visible_(false)
+    , lastResult_(POPUP_RESULT_NONE)
+    , lastClickMs_(0)
+    , showStartUs_(0)
+    , measuring_(false)
+    , lastShowUs_(0)
+{
+    memset(queue_, 0, sizeof(queue_));
+}
+
+// ============================================================================
+// CRIACAO (uma vez, em lv_layer_top())
+// ============================================================================
+
+void PopupService::init() {
+    if (overlay_) return;
+
+    if (!bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
+        ESP_LOGE(TAG, "Falha ao obter lock do display para criar popup");
+        return;
+    }
+
+    Theme* theme = Theme::getInstance();
+
+    // Overlay escuro sobre a area da grade (respeita a StatusBar)
+    overlay_ = lv_obj_create(lv_layer_top());
+    lv_obj_set_size(overlay_, DISPLAY_WIDTH, GRID_AREA_HEIGHT);
+    lv_obj_align(overlay_, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_set_style_bg_color(overlay_, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(overlay_, LV_OPA_70, LV_PART_MAIN);
+    lv_obj_set_style_border_width(overlay_, 0, LV_PART_MAIN);
+    lv_obj_set_style_radius(overlay_, 0, LV_PART_MAIN);
+    lv_obj_clear_flag(overlay_, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(overlay_, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_event_cb(overlay_, drawEventHandler, LV_EVENT_DRAW_POST_END, this);
+
+    // Caixa do popup
+    lv_obj_t* box = lv_obj_create(overlay_);
+    lv_obj_set_size(box, 400, 250);
+    lv_obj_center(box);
+    theme->applyPopupStyle(box);
+
+    // Header: icone + titulo
+    lv_obj_t* header = lv_obj_create(box);
+    lv_obj_set_size(header, 370, 50);
+    lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 10);
+    lv_obj_set_style_bg_opa(header, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(header, 0, LV_PART_MAIN);
+    lv_obj_set_flex_flow(header, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(header, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
+
+    iconLabel_ = lv_label_create(header);
+    lv_label_set_text_static(iconLabel_, "");
+    lv_obj_set_style_text_color(iconLabel_, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+    lv_obj_set_style_text_font(iconLabel_, &lv_font_montserrat_28, LV_PART_MAIN);
+
+    titleLabel_ = lv_label_create(header);
+    lv_label_set_text_static(titleLabel_, "");
+    theme->applyLabelStyle(titleLabel_, lv_color_hex(0xFFFFFF), &lv_font_montserrat_28);
+    lv_obj_set_style_pad_left(titleLabel_, 10, LV_PART_MAIN);
+
+    // Mensagem
+    msgLabel_ = lv_label_create(box);
+    lv_label_set_text_static(msgLabel_, "");
+    lv_label_set_long_mode(msgLabel_, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(msgLabel_, 370);
+    lv_obj_align(msgLabel_, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_text_align(msgLabel_, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+    theme->applyLabelStyle(msgLabel_, lv_color_hex(0xCCCCCC), &lv_font_montserrat_18);
+
+    // Botoes
+    lv_obj_t* btnContainer = lv_obj_create(box);
+    lv_obj_set_size(btnContainer, 370, 60);
+    lv_obj_align(btnContainer, LV_ALIGN_BOTTOM_MID, 0, -10);
+    lv_obj_set_style_bg_opa(btnContainer, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(btnContainer, 0, LV_PART_MAIN);
+    lv_obj_set_flex_flow(btnContainer, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(btnContainer, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_gap(btnContainer, 20, LV_PART_MAIN);
+    lv_obj_clear_flag(btnContainer, LV_OBJ_FLAG_SCROLLABLE);
+
+    btnOk_ = lv_btn_create(btnContainer);
+    lv_obj_set_size(btnOk_, 120, 45);
+    theme->applyButtonStyle(btnOk_, lv_color_hex(0x00AA00));
+    lv_obj_add_event_cb(btnOk_, buttonEventHandler, LV_EVENT_CLICKED, (void*)(intptr_t)POPUP_RESULT_OK);
+
+    lv_obj_t* labelOk = lv_label_create(btnOk_);
+    lv_label_set_text_static(labelOk, "OK");
+    lv_obj_center(labelOk);
+    theme->applyLabelStyle(labelOk, lv_color_hex(0xFFFFFF), &lv_font_montserrat_20);
+
+    btnCancel_ = lv_btn_create(btnContainer);
+    lv_obj_set_size(btnCancel_, 120, 45);
+    theme->applyButtonStyle(btnCancel_, lv_color_hex(0xAA0000));
+    lv_obj_add_event_cb(btnCancel_, buttonEventHandler, LV_EVENT_CLICKED, (void*)(intptr_t)POPUP_RESULT_CANCEL);
+
+    lv_obj_t* labelCancel = lv_label_create(btnCancel_);
+    lv_label_set_text_static(labelCancel, "Cancelar");
+    lv_obj_center(labelCancel);
+    theme->applyLabelStyle(labelCancel, lv_color_hex(0xFFFFFF), &lv_font_montserrat_20);
+
+    bsp_display_unlock();
+
+    ESP_LOGI(TAG, "Popup criado em lv_layer_top() (fila de %d)", POPUP_QUEUE_SIZE);
+}
+
+// ============================================================================
+// EXIBIR / FECHAR
+// ============================================================================
+
+bool PopupService::show(const char* title, const char* message, PopupType type,
+                        bool showCancel, PopupCallback callback,
+                        void* ctx, const void* owner) {
+    if (!overlay_) {
+        init();
+        if (!overlay_) return false;
+    }
+
+    if (count_ >= POPUP_QUEUE_SIZE) {
+        ESP_LOGW(TAG, "Fila de popups cheia, descartando '%s'", title ? title : "");
+        return false;
+    }
+
+    Request& req = slot(count_);
+    strncpy(req.title, title ? title : "", sizeof(req.title) - 1);
+    req.title[sizeof(req.title) - 1] = '\0';
+    strncpy(req.message, message ? message : "", sizeof(req.message) - 1);
+    req.message[sizeof(req.message) - 1] = '\0';
+    req.type = type;
+    req.showCancel = showCancel;
+    req.callback = callback;
+    req.ctx = ctx;
+    req.owner = owner;
+    count_++;
+
+    if (!visible_) {
+        present();
+    }
+    return true;
+}
+
+void PopupService::close() {
+    if (!visible_) return;
+
+    hideCurrent();
+    if (count_ > 0) {
+        present();
+    }
+}
+
+void PopupService::closeOwnedBy(const void* owner) {
+    if (count_ == 0) return;
+
+    // Compacta a fila mantendo a ordem dos pedidos de outros donos
+    bool currentRemoved = visible_ && slot(0).owner == owner;
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (slot(i).owner == owner) continue;
+        if (kept != i) {
+            slot(kept) = slot(i);
+        }
+        kept++;
+    }
+    count_ = kept;
+
+    if (currentRemoved) {
+        // O slot 0 agora e outro pedido (ou nenhum): reapresenta
+        visible_ = false;
+        measuring_ = false;
+        if (bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
+            lv_obj_add_flag(overlay_, LV_OBJ_FLAG_HIDDEN);
+            bsp_display_unlock();
+        }
+        if (count_ > 0) {
+            present();
+        }
+    }
+}
+
+// ============================================================================
+// METODOS PRIVADOS
+// ============================================================================
+
+void PopupService::present() {
+    const Request& req = slot(0);
+
+    const char* iconText = "";
+    lv_color_t iconColor = lv_color_hex(0xFFFFFF);
+
+    switch (req.type) {
+        case POPUP_INFO:
+            iconText = LV_SYMBOL_DUMMY"i";
+            iconColor = lv_color_hex(0x00AAFF);
+            break;
+        case POPUP_WARNING:
+            iconText = LV_SYMBOL_WARNING;
+            iconColor = lv_color_hex(0xFFAA00);
+            break;
+        case POPUP_ERROR:
+            iconText = LV_SYMBOL_CLOSE;
+            iconColor = lv_color_hex(0xFF0000);
+            break;
+        case POPUP_QUESTION:
+            iconText = LV_SYMBOL_DUMMY"?";
+            iconColor = lv_color_hex(0x00FF00);
+            break;
+        case POPUP_SUCCESS:
+            iconText = LV_SYMBOL_OK;
+            iconColor = lv_color_hex(0x00FF00);
+            break;
+    }
+
+    if (!bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) return;
+
+    showStartUs_ = esp_timer_get_time();
+    measuring_ = true;
+
+    // Textos estaticos: o label aponta para o slot da fila (sem copia)
+    lv_label_set_text_static(iconLabel_, iconText);
+    lv_obj_set_style_text_color(iconLabel_, iconColor, LV_PART_MAIN);
+    lv_label_set_text_static(titleLabel_, req.title);
+    lv_label_set_text_static(msgLabel_, req.message);
+
+    if (req.showCancel) {
+        lv_obj_clear_flag(btnCancel_, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(btnCancel_, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    lastResult_ = POPUP_RESULT_NONE;
+    visible_ = true;
+    lv_obj_move_foreground(overlay_);
+    lv_obj_clear_flag(overlay_, LV_OBJ_FLAG_HIDDEN);
+
+    bsp_display_unlock();
+}
+
+void PopupService::hideCurrent() {
+    if (bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
+        lv_obj_add_flag(overlay_, LV_OBJ_FLAG_HIDDEN);
+        bsp_display_unlock();
+    }
+
+    visible_ = false;
+    measuring_ = false;
+    head_ = (head_ + 1) % POPUP_QUEUE_SIZE;
+    count_--;
+}
+
+void PopupService::buttonEventHandler(lv_event_t* e) {
+    PopupService* self = getInstance();
+    if (!self->visible_) return;
+
+    uint32_t now = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    if ((now - self->lastClickMs_) < BUTTON_DEBOUNCE_MS) {
+        return;
+    }
+    self->lastClickMs_ = now;
+
+    PopupResult result = (PopupResult)(intptr_t)lv_event_get_user_data(e);
+    PopupCallback callback = self->slot(0).callback;
+    void* ctx = self->slot(0).ctx;
+
+    self->lastResult_ = result;
+    self->hideCurrent();
+
+    // O callback pode abrir outro popup: ele entra na fila normalmente
+    if (callback) {
+        callback(result, ctx);
+    }
+
+    if (!self->visible_ && self->count_ > 0) {
+        self->present();
+    }
+}
+
+void PopupService::drawEventHandler(lv_event_t* e) {
+    PopupService* self = static_cast<PopupService*>(lv_event_get_user_data(e));
+    if (!self->measuring_) return;
+
+    self->measuring_ = false;
+    self->lastShowUs_ = (uint32_t)(esp_timer_get_time() - self->showStartUs_);
+    ESP_LOGD(TAG, "Popup visivel em %lu us", (unsigned long)self->lastShowUs_);
+}
@@ -14,6 +14,7 @@
 
 #include "ui/widgets/status_bar.h"
 #include "interfaces/i_screen.h"
+#include "interfaces/i_battery.h"
 #include "ui/common/theme.h"
 #include "config/app_config.h"
 #include "utils/time_utils.h"
@@ -36,9 +37,11 @@ StatusBar::StatusBar()
     , tempoIgnicaoLabel_(nullptr)
     , tempoJornadaLabel_(nullptr)
     , mensagemLabel_(nullptr)
-    , updateTimer_(nullptr)
-    , messageExpireTime_(0)
+    , bateriaLabel_(nullptr)
+    , messageTimer_(nullptr)
+    , lastBatteryPacked_(0)
     , screenManager_(nullptr)
+    , batteryService_(nullptr)
 {
 }
 
@@ -96,13 +99,20 @@ void StatusBar::create() {
     lv_obj_set_style_text_color(ignicaoLabel_, theme->getTextPrimary(), LV_PART_MAIN);
     lv_obj_set_style_text_font(ignicaoLabel_, &lv_font_montserrat_10, LV_PART_MAIN);
 
-    // ---- Tempo de ignicao ----
+    // ---- Tempo de ignicao (linha superior) ----
     tempoIgnicaoLabel_ = lv_label_create(container_);
     lv_label_set_text(tempoIgnicaoLabel_, "");
-    lv_obj_align(tempoIgnicaoLabel_, LV_ALIGN_LEFT_MID, 42, 0);
+    lv_obj_align(tempoIgnicaoLabel_, LV_ALIGN_LEFT_MID, 42, -8);
     lv_obj_set_style_text_color(tempoIgnicaoLabel_, theme->getTextSecondary(), LV_PART_MAIN);
     lv_obj_set_style_text_font(tempoIgnicaoLabel_, &lv_font_montserrat_12, LV_PART_MAIN);
 
+    // ---- Tensao da bateria (linha inferior) ----
+    bateriaLabel_ = lv_label_create(container_);
+    lv_label_set_text(bateriaLabel_, "");
+    lv_obj_align(bateriaLabel_, LV_ALIGN_LEFT_MID, 42, 9);
+    lv_obj_set_style_text_color(bateriaLabel_, theme->getTextSecondary(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(bateriaLabel_, &lv_font_montserrat_12, LV_PART_MAIN);
+
     // ---- Tempo de jornada ----
     tempoJornadaLabel_ = lv_label_create(container_);
     lv_label_set_text(tempoJornadaLabel_, "");
@@ -135,8 +145,9 @@ void StatusBar::create() {
     lv_obj_set_style_text_color(swapLabel, theme->getTextPrimary(), LV_PART_MAIN);
     lv_obj_set_style_text_font(swapLabel, &lv_font_montserrat_14, LV_PART_MAIN);
 
-    // ---- Timer de atualizacao ----
-    updateTimer_ = lv_timer_create(updateTimerCallback, STATUS_BAR_UPDATE_MS, this);
+    // ---- Timer de expiracao de mensagem (pausado sem mensagem ativa) ----
+    messageTimer_ = lv_timer_create(messageTimerCallback, STATUS_MESSAGE_TIMEOUT, this);
+    lv_timer_pause(messageTimer_);
 
     bsp_display_unlock();
 
@@ -148,9 +159,9 @@ void StatusBar::create() {
 // ============================================================================
 
 void StatusBar::destroy() {
-    if (updateTimer_) {
-        lv_timer_del(updateTimer_);
-        updateTimer_ = nullptr;
+    if (messageTimer_) {
+        lv_timer_del(messageTimer_);
+        messageTimer_ = nullptr;
     }
 
     if (container_ && bsp_display_lock(DISPLAY_LOCK_TIMEOUT)) {
@@ -162,6 +173,8 @@ void StatusBar::destroy() {
         tempoIgnicaoLabel_ = nullptr;
         tempoJornadaLabel_ = nullptr;
         mensagemLabel_ = nullptr;
+        bateriaLabel_ = nullptr;
+        lastBatteryPacked_ = 0;
         bsp_display_unlock();
     }
 
@@ -181,8 +194,9 @@ void StatusBar::update(const StatusBarData& data) {
 
     Theme* theme = Theme::getInstance();
 
-    // Atualizar indicador de ignicao
-    if (ignicaoIndicator_ && ignicaoLabel_) {
+    // Atualizar indicador de ignicao (so na mudanca: UI parada nao redesenha)
+    if (ignicaoIndicator_ && ignicaoLabel_ &&
+        strcmp(lv_label_get_text(ignicaoLabel_), data.ignicaoOn ? "ON" : "OFF") != 0) {
         if (data.ignicaoOn) {
             lv_obj_set_style_bg_color(ignicaoIndicator_, theme->getColorSuccess(), LV_PART_MAIN);
             lv_label_set_text(ignicaoLabel_, "ON");
@@ -201,7 +215,7 @@ void StatusBar::update(const StatusBarData& data) {
             snprintf(buffer, sizeof(buffer), "Ignicao: %s", timeStr);
             lv_label_set_text(tempoIgnicaoLabel_, buffer);
         } else {
-            lv_label_set_text(tempoIgnicaoLabel_, "");
+            setTextIfChanged(tempoIgnicaoLabel_, "");
         }
     }
 
@@ -214,7 +228,7 @@ void StatusBar::update(const StatusBarData& data) {
             snprintf(buffer, sizeof(buffer), "Jornada M1: %s", timeStr);
             lv_label_set_text(tempoJornadaLabel_, buffer);
         } else {
-            lv_label_set_text(tempoJornadaLabel_, "");
+            setTextIfChanged(tempoJornadaLabel_, "");
         }
     }
 
@@ -223,6 +237,8 @@ void StatusBar::update(const StatusBarData& data) {
         lv_label_set_text(mensagemLabel_, data.mensagem);
     }
 
+    refreshBattery();
+
     bsp_display_unlock();
 }
 
@@ -249,10 +265,15 @@ void StatusBar::setMessage(const char* message, lv_color_t color, const lv_font_
         lv_obj_set_style_text_font(mensagemLabel_, font, LV_PART_MAIN);
     }
 
-    if (timeoutMs > 0 && message && strlen(message) > 0) {
-        messageExpireTime_ = time_millis() + timeoutMs;
-    } else {
-        messageExpireTime_ = 0;
+    // Expiracao por timer one-shot: sem mensagem, nenhum wakeup periodico
+    if (messageTimer_) {
+        if (timeoutMs > 0 && message && strlen(message) > 0) {
+            lv_timer_set_period(messageTimer_, timeoutMs);
+            lv_timer_reset(messageTimer_);
+            lv_timer_resume(messageTimer_);
+        } else {
+            lv_timer_pause(messageTimer_);
+        }
     }
 
     bsp_display_unlock();
@@ -260,7 +281,6 @@ void StatusBar::setMessage(const char* message, lv_color_t color, const lv_font_
 
 void StatusBar::clearMessage() {
     setMessage("", lv_color_hex(THEME_TEXT_MUTED), &lv_font_montserrat_20, 0);
-    messageExpireTime_ = 0;
 }
 
 // ============================================================================
@@ -271,18 +291,58 @@ void StatusBar::setScreenManager(IScreenManager* mgr) {
     screenManager_ = mgr;
 }
 
+void StatusBar::setBatteryService(IBatteryService* svc) {
+    batteryService_ = svc;
+    lastBatteryPacked_ = 0;
+}
+
+// ============================================================================
+// BATERIA
+// ============================================================================
+
+void StatusBar::setTextIfChanged(lv_obj_t* label, const char* text) {
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+
+void StatusBar::refreshBattery() {
+    if (!bateriaLabel_ || !batteryService_) return;
+
+    BatteryReading reading = batteryService_->getReading();
+    if (!reading.valid) return;
+
+    // Redesenhar apenas quando a leitura exibida muda (resolucao de 10 mV)
+    uint32_t packed = (uint32_t)(reading.voltageMv / 10) | (reading.low ? 0x10000u : 0) | 0x20000u;
+    if (packed == lastBatteryPacked_) return;
+    bool wasLow = (lastBatteryPacked_ & 0x10000u) != 0;
+    lastBatteryPacked_ = packed;
+
+    Theme* theme = Theme::getInstance();
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%s %u.%02uV",
+             reading.low ? LV_SYMBOL_BATTERY_1 : LV_SYMBOL_BATTERY_FULL,
+             reading.voltageMv / 1000, (reading.voltageMv % 1000) / 10);
+    lv_label_set_text(bateriaLabel_, buffer);
+    lv_obj_set_style_text_color(bateriaLabel_,
+                                reading.low ? theme->getColorError() : theme->getTextSecondary(),
+                                LV_PART_MAIN);
+
+    if (reading.low && !wasLow) {
+        setMessage("BATERIA FRACA", theme->getColorError(), &lv_font_montserrat_20, POPUP_DEFAULT_TIMEOUT);
+    }
+}
+
 // ============================================================================
 // CALLBACKS
 // ============================================================================
 
-void StatusBar::updateTimerCallback(lv_timer_t* timer) {
+void StatusBar::messageTimerCallback(lv_timer_t* timer) {
     StatusBar* self = static_cast<StatusBar*>(timer->user_data);
     if (!self) return;
 
-    // Verificar expiracao de mensagem
-    if (self->messageExpireTime_ > 0 && time_millis() >= self->messageExpireTime_) {
-        self->clearMessage();
-    }
+    // Dispara uma vez no fim do timeout; clearMessage() pausa o timer
+    self->clearMessage();
 }
 
 void StatusBar::swapBtnCallback(lv_event_t* e) {
@@ -63,3 +63,28 @@ bool debug_check_heap(void) {
     }
     return ok;
 }
+
+// ============================================================================
+// RELATORIO DE RECURSOS
+// ============================================================================
+
+void debug_take_resource_snapshot(debug_resource_snapshot_t* out) {
+    if (!out) return;
+    out->internalFree = (uint32_t)heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    out->psramFree = (uint32_t)heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    out->minFree = (uint32_t)esp_get_minimum_free_heap_size();
+    out->taskCount = (uint32_t)uxTaskGetNumberOfTasks();
+}
+
+void debug_print_resource_delta(const char* label,
+                                const debug_resource_snapshot_t* before,
+                                const debug_resource_snapshot_t* after) {
+    if (!before || !after) return;
+
+    LOG_I(TAG, "[%s] RAM interna: %lu -> %lu (%+ld bytes) | PSRAM: %+ld bytes | tasks: %lu -> %lu",
+          label ? label : "?",
+          (unsigned long)before->internalFree, (unsigned long)after->internalFree,
+          (long)after->internalFree - (long)before->internalFree,
+          (long)after->psramFree - (long)before->psramFree,
+          (unsigned long)before->taskCount, (unsigned long)after->taskCount);
+}
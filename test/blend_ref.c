@@ -0,0 +1,20 @@
+/**
+ * ============================================================================
+ * REFERENCIA ESCALAR DO BLEND
+ * ============================================================================
+ *
+ * O mesmo lv_draw_sw_blend.c da LVGL compilado com BLEND_RGB565_PAIRS 0
+ * (os lacos pixel a pixel originais) e com as funcoes publicas renomeadas,
+ * para o test_blend comparar contra os kernels em pares.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#define BLEND_RGB565_PAIRS      0
+#define lv_draw_sw_blend        ref_blend
+#define lv_draw_sw_blend_basic  ref_blend_basic
+
+#include "src/draw/sw/lv_draw_sw_blend.c"
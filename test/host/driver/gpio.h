@@ -0,0 +1,72 @@
+/**
+ * Stand-in de host para driver/gpio.h: niveis definidos pelo teste e
+ * interrupcao por nivel chamando o handler na thread de quem mudou o pino
+ * ou habilitou a interrupcao (host_gpio.cpp)
+ */
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+#include "esp_err.h"
+#include <stdint.h>
+
+#define GPIO_NUM_MAX    49
+
+typedef int gpio_num_t;
+
+typedef enum {
+    GPIO_MODE_DISABLE = 0,
+    GPIO_MODE_INPUT,
+    GPIO_MODE_OUTPUT,
+} gpio_mode_t;
+
+typedef enum {
+    GPIO_PULLUP_DISABLE = 0,
+    GPIO_PULLUP_ENABLE,
+} gpio_pullup_t;
+
+typedef enum {
+    GPIO_PULLDOWN_DISABLE = 0,
+    GPIO_PULLDOWN_ENABLE,
+} gpio_pulldown_t;
+
+typedef enum {
+    GPIO_INTR_DISABLE = 0,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_ANYEDGE,
+    GPIO_INTR_LOW_LEVEL,
+    GPIO_INTR_HIGH_LEVEL,
+} gpio_int_type_t;
+
+typedef struct {
+    uint64_t pin_bit_mask;
+    gpio_mode_t mode;
+    gpio_pullup_t pull_up_en;
+    gpio_pulldown_t pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+typedef void (*gpio_isr_t)(void* arg);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t gpio_config(const gpio_config_t* config);
+int gpio_get_level(gpio_num_t pin);
+esp_err_t gpio_install_isr_service(int flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t pin, gpio_isr_t handler, void* arg);
+esp_err_t gpio_isr_handler_remove(gpio_num_t pin);
+esp_err_t gpio_intr_enable(gpio_num_t pin);
+esp_err_t gpio_intr_disable(gpio_num_t pin);
+esp_err_t gpio_wakeup_enable(gpio_num_t pin, gpio_int_type_t type);
+
+// Muda o nivel do pino; dispara o handler se a interrupcao por esse nivel
+// estiver habilitada
+void host_gpio_set_level(gpio_num_t pin, int level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_DRIVER_GPIO_H
@@ -0,0 +1,15 @@
+/**
+ * Stand-in de host para esp_attr.h: secoes de memoria viram variaveis
+ * comuns (RTC_NOINIT sobrevive enquanto o processo vive, como um reset a
+ * quente)
+ */
+#ifndef HOST_ESP_ATTR_H
+#define HOST_ESP_ATTR_H
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define RTC_DATA_ATTR
+#define EXT_RAM_BSS_ATTR
+
+#endif // HOST_ESP_ATTR_H
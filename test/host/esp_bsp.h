@@ -0,0 +1,22 @@
+/**
+ * Stand-in de host para esp_bsp.h: so a trava do display (host_esp.cpp)
+ */
+#ifndef HOST_ESP_BSP_H
+#define HOST_ESP_BSP_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool bsp_display_lock(uint32_t timeout_ms);
+void bsp_display_unlock(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_ESP_BSP_H
@@ -0,0 +1,42 @@
+/**
+ * Stand-in de host para esp_heap_caps.h, com contadores de alocacao para
+ * os testes verificarem caminhos sem heap (host_heap.cpp)
+ */
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_DEFAULT      (1 << 12)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* heap_caps_malloc(size_t size, uint32_t caps);
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps);
+void heap_caps_free(void* ptr);
+size_t heap_caps_get_allocated_size(void* ptr);
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+
+// Alocacoes feitas por heap_caps_* desde o inicio do processo
+uint32_t host_heap_alloc_count(void);
+
+// Bytes alocados por heap_caps_* ainda nao liberados, e o maior valor
+// desde o ultimo host_heap_reset_peak()
+size_t host_heap_bytes_in_use(void);
+size_t host_heap_peak_bytes(void);
+void host_heap_reset_peak(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_ESP_HEAP_CAPS_H
@@ -0,0 +1,16 @@
+/**
+ * Stand-in de host para esp_log.h: erros e avisos no stderr, o resto mudo
+ */
+#ifndef HOST_ESP_LOG_H
+#define HOST_ESP_LOG_H
+
+#include "esp_rom_sys.h"
+#include <stdio.h>
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) do { if (0) printf("I %s: " fmt "\n", tag, ##__VA_ARGS__); } while (0)
+#define ESP_LOGD(tag, fmt, ...) do { if (0) printf("D %s: " fmt "\n", tag, ##__VA_ARGS__); } while (0)
+#define ESP_LOGV(tag, fmt, ...) do { if (0) printf("V %s: " fmt "\n", tag, ##__VA_ARGS__); } while (0)
+
+#endif // HOST_ESP_LOG_H
@@ -0,0 +1,72 @@
+/**
+ * Stand-in de host para esp_pm.h: travas com contagem como no IDF (cada
+ * acquire pede um release) e contadores por nome para os testes
+ * (host_pm.cpp)
+ */
+#ifndef HOST_ESP_PM_H
+#define HOST_ESP_PM_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum {
+    ESP_PM_CPU_FREQ_MAX,
+    ESP_PM_APB_FREQ_MAX,
+    ESP_PM_NO_LIGHT_SLEEP,
+} esp_pm_lock_type_t;
+
+typedef struct HostPmLock* esp_pm_lock_handle_t;
+
+typedef struct {
+    int max_freq_mhz;
+    int min_freq_mhz;
+    bool light_sleep_enable;
+} esp_pm_config_t;
+
+typedef esp_err_t (*esp_pm_light_sleep_cb_t)(int64_t sleep_time_us, void* arg);
+
+typedef struct {
+    esp_pm_light_sleep_cb_t enter_cb;
+    esp_pm_light_sleep_cb_t exit_cb;
+    void* enter_cb_user_arg;
+    void* exit_cb_user_arg;
+} esp_pm_sleep_cbs_register_config_t;
+
+/**
+ * Contadores das travas criadas com um nome
+ */
+typedef struct {
+    uint32_t creates;           // esp_pm_lock_create com esse nome
+    esp_pm_lock_type_t type;    // Tipo da ultima criada
+    int count;                  // Acquires ainda sem release
+    uint32_t acquires;
+    uint32_t releases;
+    uint32_t underflows;        // Release sem acquire (ESP_ERR_INVALID_STATE)
+} host_pm_lock_info_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t esp_pm_configure(const void* config);
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t type, int arg, const char* name,
+                             esp_pm_lock_handle_t* handle);
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle);
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle);
+esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle);
+esp_err_t esp_pm_dump_locks(FILE* stream);
+esp_err_t esp_pm_light_sleep_register_cbs(esp_pm_sleep_cbs_register_config_t* cbs);
+
+// false se nenhuma trava com esse nome foi criada
+bool host_pm_lock_info(const char* name, host_pm_lock_info_t* info);
+
+// Faz o proximo esp_pm_lock_create falhar (ESP_ERR_NO_MEM)
+void host_pm_fail_next_create(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_ESP_PM_H
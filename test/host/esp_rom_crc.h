@@ -0,0 +1,20 @@
+/**
+ * Stand-in de host para esp_rom_crc.h: CRC32 little-endian da ROM
+ * (host_nvs.cpp)
+ */
+#ifndef HOST_ESP_ROM_CRC_H
+#define HOST_ESP_ROM_CRC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_ESP_ROM_CRC_H
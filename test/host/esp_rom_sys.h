@@ -0,0 +1,12 @@
+/**
+ * Stand-in de host para esp_rom_sys.h: printf da ROM mudo
+ */
+#ifndef HOST_ESP_ROM_SYS_H
+#define HOST_ESP_ROM_SYS_H
+
+static inline int esp_rom_printf(const char* fmt, ...) {
+    (void)fmt;
+    return 0;
+}
+
+#endif // HOST_ESP_ROM_SYS_H
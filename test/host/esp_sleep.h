@@ -0,0 +1,31 @@
+/**
+ * Stand-in de host para esp_sleep.h: o host nunca dorme (host_pm.cpp)
+ */
+#ifndef HOST_ESP_SLEEP_H
+#define HOST_ESP_SLEEP_H
+
+#include "esp_err.h"
+
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED,
+    ESP_SLEEP_WAKEUP_ALL,
+    ESP_SLEEP_WAKEUP_EXT0,
+    ESP_SLEEP_WAKEUP_EXT1,
+    ESP_SLEEP_WAKEUP_TIMER,
+    ESP_SLEEP_WAKEUP_TOUCHPAD,
+    ESP_SLEEP_WAKEUP_ULP,
+    ESP_SLEEP_WAKEUP_GPIO,
+} esp_sleep_source_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void);
+esp_sleep_source_t esp_sleep_get_wakeup_cause(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_ESP_SLEEP_H
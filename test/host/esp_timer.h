@@ -0,0 +1,26 @@
+/**
+ * Stand-in de host para esp_timer.h: relogio monotonico que os testes
+ * podem adiantar (host_esp.cpp)
+ */
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+// Soma ms ao relogio (debounce, timeouts) sem esperar de verdade
+void host_timer_advance_ms(uint32_t ms);
+
+// Volta o relogio a zero, como depois de um reset
+void host_timer_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_ESP_TIMER_H
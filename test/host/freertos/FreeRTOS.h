@@ -0,0 +1,63 @@
+/**
+ * Stand-in de host para FreeRTOS.h: tipos, constantes, o spinlock portMUX
+ * e os nucleos (trava de verdade: os testes usam threads como tasks)
+ */
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define pdPASS                  pdTRUE
+#define pdFAIL                  pdFALSE
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS      1
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define portNUM_PROCESSORS      2
+
+typedef struct {
+    volatile int owner;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { 0 }
+#define portMUX_INITIALIZE(mux)         ((mux)->owner = 0)
+
+static inline void host_mux_take(portMUX_TYPE* mux) {
+    while (__atomic_exchange_n(&mux->owner, 1, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static inline void host_mux_give(portMUX_TYPE* mux) {
+    __atomic_store_n(&mux->owner, 0, __ATOMIC_RELEASE);
+}
+
+#define portENTER_CRITICAL(mux)         host_mux_take(mux)
+#define portEXIT_CRITICAL(mux)          host_mux_give(mux)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Nucleo da thread atual (0 ate host_set_core_id). Mascarar as
+ * interrupcoes trava o nucleo: como no alvo, nenhuma outra task do mesmo
+ * nucleo roda ate liberar; threads de nucleos diferentes seguem livres.
+ */
+BaseType_t xPortGetCoreID(void);
+void host_set_core_id(BaseType_t core);
+UBaseType_t host_core_mask(void);
+void host_core_unmask(UBaseType_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()       host_core_mask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    host_core_unmask(x)
+
+#endif // HOST_FREERTOS_H
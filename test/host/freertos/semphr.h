@@ -0,0 +1,28 @@
+/**
+ * Stand-in de host para semphr.h: mutex e semaforo binario com espera de
+ * verdade (threads como tasks), sem heranca de prioridade (host_esp.cpp)
+ */
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct HostSemaphore* SemaphoreHandle_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+
+// Timeout em ticks (1 ms) de relogio real; portMAX_DELAY espera para sempre
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_FREERTOS_SEMPHR_H
@@ -0,0 +1,58 @@
+/**
+ * Stand-in de host para task.h: handles, notificacoes e esperas
+ * (host_esp.cpp)
+ *
+ * Tasks criadas com xTaskCreate* rodam em threads e bloqueiam de verdade
+ * em ulTaskNotifyTake. vTaskSuspend(NULL) so volta para encerrar a thread
+ * quando outra task a apaga; a memoria de uma task apagada nao e reusada,
+ * entao notificar um handle velho e detectado (host_task_stale_notifies).
+ */
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+struct HostTaskImpl;
+
+// Uma "task" montada a mao nos testes so guarda as notificacoes recebidas;
+// as criadas por xTaskCreate* tem impl (thread, espera, estado)
+struct HostTask {
+    uint32_t notifications;
+    struct HostTaskImpl* impl;
+};
+typedef struct HostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define taskENTER_CRITICAL(mux)     portENTER_CRITICAL(mux)
+#define taskEXIT_CRITICAL(mux)      portEXIT_CRITICAL(mux)
+#define portYIELD_FROM_ISR()        do { } while (0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack,
+                                   void* arg, UBaseType_t prio, TaskHandle_t* handle,
+                                   BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack,
+                       void* arg, UBaseType_t prio, TaskHandle_t* handle);
+void vTaskDelete(TaskHandle_t task);
+void vTaskSuspend(TaskHandle_t task);
+
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken);
+
+// Timeout em ticks (1 ms) de relogio real
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+
+// Threads de task ainda vivas, tasks criadas e notificacoes a tasks apagadas
+uint32_t host_task_alive_count(void);
+uint32_t host_task_created_count(void);
+uint32_t host_task_stale_notifies(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_FREERTOS_TASK_H
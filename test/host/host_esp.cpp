@@ -0,0 +1,75 @@
+/**
+ * esp_timer, trava do display e nucleos do host
+ */
+#include "esp_bsp.h"
+#include "esp_timer.h"
+#include "lv_port.h"
+#include "freertos/task.h"
+#include "esp_err.h"
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <time.h>
+
+// Lido pelas threads de task enquanto o teste adianta o relogio
+static std::atomic<int64_t> s_offsetUs;
+
+// Nucleo de cada thread e uma trava por nucleo (interrupcoes mascaradas)
+static thread_local BaseType_t t_core;
+static std::mutex s_coreLock[portNUM_PROCESSORS];
+
+extern "C" {
+
+static int64_t monotonic_us(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (int64_t)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+}
+
+int64_t esp_timer_get_time(void) {
+    return monotonic_us() + s_offsetUs;
+}
+
+void host_timer_advance_ms(uint32_t ms) {
+    s_offsetUs += (int64_t)ms * 1000;
+}
+
+void host_timer_reset(void) {
+    s_offsetUs = -monotonic_us();
+}
+
+// A UI dos testes de host roda em uma thread so
+bool bsp_display_lock(uint32_t timeout_ms) {
+    return true;
+}
+
+void bsp_display_unlock(void) {
+}
+
+// Sem monitor de display no host: a transicao mede so a duracao
+void lvgl_port_get_render_stats(lvgl_port_render_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+BaseType_t xPortGetCoreID(void) {
+    return t_core;
+}
+
+void host_set_core_id(BaseType_t core) {
+    t_core = core;
+}
+
+UBaseType_t host_core_mask(void) {
+    s_coreLock[t_core].lock();
+    return 0;
+}
+
+void host_core_unmask(UBaseType_t state) {
+    s_coreLock[t_core].unlock();
+}
+
+const char* esp_err_to_name(esp_err_t code) {
+    return code == ESP_OK ? "ESP_OK" : "ESP_ERR";
+}
+
+} // extern "C"
@@ -0,0 +1,106 @@
+/**
+ * GPIO do host: nivel, handler e interrupcao por nivel de cada pino
+ */
+#include "driver/gpio.h"
+#include <mutex>
+
+struct HostPin {
+    int level;
+    gpio_int_type_t type;
+    bool intrEnabled;
+    gpio_isr_t handler;
+    void* arg;
+};
+
+static std::mutex s_gpioLock;
+static HostPin s_pins[GPIO_NUM_MAX];
+static bool s_isrService;
+
+// Com a trava tomada: o handler e chamado depois de solta-la (ele mesmo
+// desabilita a interrupcao)
+static bool level_fires(const HostPin& p) {
+    if (!p.intrEnabled || !p.handler) return false;
+    return (p.type == GPIO_INTR_HIGH_LEVEL && p.level) ||
+           (p.type == GPIO_INTR_LOW_LEVEL && !p.level);
+}
+
+static void fire_if_level(gpio_num_t pin) {
+    gpio_isr_t handler = nullptr;
+    void* arg = nullptr;
+    {
+        std::lock_guard<std::mutex> lk(s_gpioLock);
+        if (level_fires(s_pins[pin])) {
+            handler = s_pins[pin].handler;
+            arg = s_pins[pin].arg;
+        }
+    }
+    if (handler) handler(arg);
+}
+
+extern "C" {
+
+esp_err_t gpio_config(const gpio_config_t* config) {
+    std::lock_guard<std::mutex> lk(s_gpioLock);
+    for (int pin = 0; pin < GPIO_NUM_MAX; pin++) {
+        if (config->pin_bit_mask & (1ULL << pin)) s_pins[pin].type = config->intr_type;
+    }
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t pin) {
+    std::lock_guard<std::mutex> lk(s_gpioLock);
+    return s_pins[pin].level;
+}
+
+esp_err_t gpio_install_isr_service(int flags) {
+    std::lock_guard<std::mutex> lk(s_gpioLock);
+    if (s_isrService) return ESP_ERR_INVALID_STATE;
+    s_isrService = true;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t pin, gpio_isr_t handler, void* arg) {
+    std::lock_guard<std::mutex> lk(s_gpioLock);
+    s_pins[pin].handler = handler;
+    s_pins[pin].arg = arg;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t pin) {
+    std::lock_guard<std::mutex> lk(s_gpioLock);
+    s_pins[pin].handler = nullptr;
+    s_pins[pin].arg = nullptr;
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t pin) {
+    {
+        std::lock_guard<std::mutex> lk(s_gpioLock);
+        s_pins[pin].intrEnabled = true;
+    }
+    // Nivel ja presente dispara na hora
+    fire_if_level(pin);
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t pin) {
+    std::lock_guard<std::mutex> lk(s_gpioLock);
+    s_pins[pin].intrEnabled = false;
+    return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t pin, gpio_int_type_t type) {
+    std::lock_guard<std::mutex> lk(s_gpioLock);
+    s_pins[pin].type = type;
+    return ESP_OK;
+}
+
+void host_gpio_set_level(gpio_num_t pin, int level) {
+    {
+        std::lock_guard<std::mutex> lk(s_gpioLock);
+        s_pins[pin].level = level ? 1 : 0;
+    }
+    fire_if_level(pin);
+}
+
+} // extern "C"
@@ -0,0 +1,88 @@
+/**
+ * heap_caps_* do host sobre malloc, contando alocacoes e bytes em uso
+ */
+#include "esp_heap_caps.h"
+#include <malloc.h>
+#include <stdlib.h>
+
+static uint32_t s_allocs;
+static size_t s_inUse;
+static size_t s_peak;
+
+// Bytes contados pelo tamanho util do bloco (o mesmo na alocacao e no free)
+static void track_alloc(void* p) {
+    if (!p) return;
+    s_inUse += malloc_usable_size(p);
+    if (s_inUse > s_peak) s_peak = s_inUse;
+}
+
+static void track_free(void* p) {
+    if (p) s_inUse -= malloc_usable_size(p);
+}
+
+extern "C" {
+
+void* heap_caps_malloc(size_t size, uint32_t caps) {
+    s_allocs++;
+    void* p = malloc(size);
+    track_alloc(p);
+    return p;
+}
+
+void* heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    s_allocs++;
+    void* p = calloc(n, size);
+    track_alloc(p);
+    return p;
+}
+
+void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps) {
+    s_allocs++;
+    size_t old = ptr ? malloc_usable_size(ptr) : 0;
+    void* p = realloc(ptr, size);
+    if (p) {
+        s_inUse -= old;
+        track_alloc(p);
+    }
+    return p;
+}
+
+void heap_caps_free(void* ptr) {
+    track_free(ptr);
+    free(ptr);
+}
+
+size_t heap_caps_get_allocated_size(void* ptr) {
+    return malloc_usable_size(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    return mallinfo2().fordblks;
+}
+
+// Sem historico nem mapa de blocos no host: o livre atual serve para os dois
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return mallinfo2().fordblks;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return mallinfo2().fordblks;
+}
+
+uint32_t host_heap_alloc_count(void) {
+    return s_allocs;
+}
+
+size_t host_heap_bytes_in_use(void) {
+    return s_inUse;
+}
+
+size_t host_heap_peak_bytes(void) {
+    return s_peak;
+}
+
+void host_heap_reset_peak(void) {
+    s_peak = s_inUse;
+}
+
+} // extern "C"
@@ -0,0 +1,98 @@
+/**
+ * NVS em memoria e CRC32 da ROM
+ */
+#include "nvs_flash.h"
+#include "esp_rom_crc.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <string.h>
+
+// Chave "particao/namespace/chave"; o handle e o indice + 1 em s_handles
+static std::map<std::string, std::vector<uint8_t>> s_blobs;
+static std::vector<std::string> s_handles;
+static uint32_t s_sets;
+static uint32_t s_commits;
+
+static const std::string* handle_prefix(nvs_handle_t handle) {
+    if (handle == 0 || handle > s_handles.size()) return nullptr;
+    return &s_handles[handle - 1];
+}
+
+extern "C" {
+
+esp_err_t nvs_flash_init_partition(const char* part) {
+    return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase_partition(const char* part) {
+    std::string prefix = std::string(part) + "/";
+    for (auto it = s_blobs.begin(); it != s_blobs.end();) {
+        it = it->first.compare(0, prefix.size(), prefix) == 0 ? s_blobs.erase(it) : ++it;
+    }
+    s_sets = 0;
+    s_commits = 0;
+    return ESP_OK;
+}
+
+esp_err_t nvs_open_from_partition(const char* part, const char* ns,
+                                  nvs_open_mode_t mode, nvs_handle_t* handle) {
+    s_handles.push_back(std::string(part) + "/" + ns + "/");
+    *handle = (nvs_handle_t)s_handles.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out, size_t* len) {
+    const std::string* prefix = handle_prefix(handle);
+    if (!prefix) return ESP_ERR_INVALID_ARG;
+
+    auto it = s_blobs.find(*prefix + key);
+    if (it == s_blobs.end()) return ESP_ERR_NVS_NOT_FOUND;
+
+    if (out) {
+        if (*len < it->second.size()) return ESP_ERR_NVS_INVALID_LENGTH;
+        memcpy(out, it->second.data(), it->second.size());
+    }
+    *len = it->second.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t len) {
+    const std::string* prefix = handle_prefix(handle);
+    if (!prefix) return ESP_ERR_INVALID_ARG;
+
+    const uint8_t* p = static_cast<const uint8_t*>(value);
+    s_blobs[*prefix + key].assign(p, p + len);
+    s_sets++;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    if (!handle_prefix(handle)) return ESP_ERR_INVALID_ARG;
+    s_commits++;
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t handle) {
+}
+
+uint32_t host_nvs_set_count(void) {
+    return s_sets;
+}
+
+uint32_t host_nvs_commit_count(void) {
+    return s_commits;
+}
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    crc = ~crc;
+    for (uint32_t i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+} // extern "C"
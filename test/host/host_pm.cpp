@@ -0,0 +1,105 @@
+/**
+ * Travas esp_pm e sono do host
+ */
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#include <mutex>
+#include <string.h>
+#include <vector>
+
+struct HostPmLock {
+    const char* name;
+    esp_pm_lock_type_t type;
+    int count;
+    uint32_t acquires;
+    uint32_t releases;
+    uint32_t underflows;
+};
+
+static std::mutex s_pmLock;
+static std::vector<HostPmLock*> s_locks;
+static bool s_failNextCreate;
+
+extern "C" {
+
+esp_err_t esp_pm_configure(const void* config) {
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t type, int arg, const char* name,
+                             esp_pm_lock_handle_t* handle) {
+    std::lock_guard<std::mutex> lk(s_pmLock);
+    if (s_failNextCreate) {
+        s_failNextCreate = false;
+        return ESP_ERR_NO_MEM;
+    }
+
+    HostPmLock* lock = new HostPmLock();
+    lock->name = name;
+    lock->type = type;
+    s_locks.push_back(lock);
+    *handle = lock;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle) {
+    std::lock_guard<std::mutex> lk(s_pmLock);
+    handle->count++;
+    handle->acquires++;
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle) {
+    std::lock_guard<std::mutex> lk(s_pmLock);
+    if (handle->count == 0) {
+        handle->underflows++;
+        return ESP_ERR_INVALID_STATE;
+    }
+    handle->count--;
+    handle->releases++;
+    return ESP_OK;
+}
+
+// A trava apagada continua na lista: os contadores sao por nome
+esp_err_t esp_pm_lock_delete(esp_pm_lock_handle_t handle) {
+    std::lock_guard<std::mutex> lk(s_pmLock);
+    return handle->count == 0 ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t esp_pm_dump_locks(FILE* stream) {
+    return ESP_OK;
+}
+
+esp_err_t esp_pm_light_sleep_register_cbs(esp_pm_sleep_cbs_register_config_t* cbs) {
+    return ESP_OK;
+}
+
+bool host_pm_lock_info(const char* name, host_pm_lock_info_t* info) {
+    std::lock_guard<std::mutex> lk(s_pmLock);
+    memset(info, 0, sizeof(*info));
+    for (const HostPmLock* lock : s_locks) {
+        if (strcmp(lock->name, name) != 0) continue;
+        info->creates++;
+        info->type = lock->type;
+        info->count += lock->count;
+        info->acquires += lock->acquires;
+        info->releases += lock->releases;
+        info->underflows += lock->underflows;
+    }
+    return info->creates > 0;
+}
+
+void host_pm_fail_next_create(void) {
+    std::lock_guard<std::mutex> lk(s_pmLock);
+    s_failNextCreate = true;
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup(void) {
+    return ESP_OK;
+}
+
+esp_sleep_source_t esp_sleep_get_wakeup_cause(void) {
+    return ESP_SLEEP_WAKEUP_UNDEFINED;
+}
+
+} // extern "C"
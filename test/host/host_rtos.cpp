@@ -0,0 +1,220 @@
+/**
+ * Tasks e semaforos do FreeRTOS sobre threads do host
+ */
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+// Semaforo de contagem: mutex comeca em 1, binario em 0
+struct HostSemaphore {
+    std::mutex lock;
+    std::condition_variable cv;
+    int count;
+};
+
+struct HostTaskImpl {
+    std::mutex lock;
+    std::condition_variable cv;
+    bool deleted;
+    bool suspended;
+    bool exited;
+};
+
+// Lancado dentro da task apagada para desenrolar ate o fim da thread
+struct HostTaskExit {
+};
+
+static std::mutex s_deadLock;
+static std::set<TaskHandle_t> s_deadTasks;
+static std::atomic<uint32_t> s_alive;
+static std::atomic<uint32_t> s_created;
+static std::atomic<uint32_t> s_stale;
+
+static thread_local TaskHandle_t t_self;
+static thread_local HostTask t_anon;    // Threads que nao sao tasks (main)
+
+static TaskHandle_t current_task() {
+    if (t_self) return t_self;
+    if (!t_anon.impl) t_anon.impl = new HostTaskImpl();
+    return &t_anon;
+}
+
+static bool is_dead(TaskHandle_t task) {
+    std::lock_guard<std::mutex> lk(s_deadLock);
+    return s_deadTasks.count(task) != 0;
+}
+
+static void mark_dead(TaskHandle_t task) {
+    std::lock_guard<std::mutex> lk(s_deadLock);
+    s_deadTasks.insert(task);
+}
+
+extern "C" {
+
+// ============================================================================
+// TASKS
+// ============================================================================
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack,
+                                   void* arg, UBaseType_t prio, TaskHandle_t* handle,
+                                   BaseType_t core) {
+    // Nunca liberada: o endereco de uma task apagada nao volta em outra
+    TaskHandle_t task = new HostTask();
+    task->impl = new HostTaskImpl();
+    if (handle) *handle = task;
+
+    s_created++;
+    s_alive++;
+    std::thread([task, fn, arg, core] {
+        t_self = task;
+        host_set_core_id(core);
+        try {
+            fn(arg);
+        } catch (const HostTaskExit&) {
+        }
+        std::lock_guard<std::mutex> lk(task->impl->lock);
+        task->impl->exited = true;
+        task->impl->cv.notify_all();
+        s_alive--;
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack,
+                       void* arg, UBaseType_t prio, TaskHandle_t* handle) {
+    return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, handle, 0);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (!task || task == t_self) {
+        mark_dead(t_self);
+        throw HostTaskExit();
+    }
+
+    // A thread so termina na proxima chamada bloqueante; se ja esta
+    // suspensa, espera ela sair
+    mark_dead(task);
+    std::unique_lock<std::mutex> lk(task->impl->lock);
+    task->impl->deleted = true;
+    task->impl->cv.notify_all();
+    if (task->impl->suspended) {
+        task->impl->cv.wait(lk, [task] { return task->impl->exited; });
+    }
+}
+
+void vTaskSuspend(TaskHandle_t task) {
+    // So a propria task se suspende; volta apenas para encerrar
+    HostTaskImpl* impl = t_self->impl;
+    std::unique_lock<std::mutex> lk(impl->lock);
+    impl->suspended = true;
+    impl->cv.wait(lk, [impl] { return impl->deleted; });
+    throw HostTaskExit();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    host_timer_advance_ms(ticks * portTICK_PERIOD_MS);
+}
+
+// ============================================================================
+// NOTIFICACOES
+// ============================================================================
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if (is_dead(task)) {
+        s_stale++;
+        return pdFAIL;
+    }
+
+    if (!task->impl) {
+        __atomic_add_fetch(&task->notifications, 1, __ATOMIC_RELAXED);
+        return pdPASS;
+    }
+
+    std::lock_guard<std::mutex> lk(task->impl->lock);
+    task->notifications++;
+    task->impl->cv.notify_all();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* woken) {
+    xTaskNotifyGive(task);
+    if (woken) *woken = pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+    TaskHandle_t task = current_task();
+    HostTaskImpl* impl = task->impl;
+    std::unique_lock<std::mutex> lk(impl->lock);
+
+    auto ready = [task, impl] { return task->notifications > 0 || impl->deleted; };
+    if (ticks == portMAX_DELAY) {
+        impl->cv.wait(lk, ready);
+    } else {
+        impl->cv.wait_for(lk, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), ready);
+    }
+    if (impl->deleted) throw HostTaskExit();
+
+    uint32_t value = task->notifications;
+    if (value > 0) task->notifications = clear ? 0 : value - 1;
+    return value;
+}
+
+uint32_t host_task_alive_count(void) {
+    return s_alive;
+}
+
+uint32_t host_task_created_count(void) {
+    return s_created;
+}
+
+uint32_t host_task_stale_notifies(void) {
+    return s_stale;
+}
+
+// ============================================================================
+// SEMAFOROS
+// ============================================================================
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    SemaphoreHandle_t sem = new HostSemaphore();
+    sem->count = 1;
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    SemaphoreHandle_t sem = new HostSemaphore();
+    sem->count = 0;
+    return sem;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem) {
+    delete sem;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks) {
+    std::unique_lock<std::mutex> lk(sem->lock);
+    auto ready = [sem] { return sem->count > 0; };
+    if (ticks == portMAX_DELAY) {
+        sem->cv.wait(lk, ready);
+    } else if (!sem->cv.wait_for(lk, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), ready)) {
+        return pdFALSE;
+    }
+    sem->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+    std::lock_guard<std::mutex> lk(sem->lock);
+    if (sem->count > 0) return pdFALSE;
+    sem->count++;
+    sem->cv.notify_one();
+    return pdTRUE;
+}
+
+} // extern "C"
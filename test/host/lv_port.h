@@ -0,0 +1,30 @@
+/**
+ * Stand-in de host para lv_port.h: so as estatisticas de render usadas
+ * pela transicao de telas (host_esp.cpp conta os quadros do teste)
+ */
+#ifndef HOST_LV_PORT_H
+#define HOST_LV_PORT_H
+
+#include "lvgl.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t frames;
+    uint32_t last_ms;
+    uint32_t last_px;
+    uint32_t avg_ms_x8;
+    uint32_t max_ms;
+    uint32_t total_ms;
+} lvgl_port_render_stats_t;
+
+void lvgl_port_get_render_stats(lvgl_port_render_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_LV_PORT_H
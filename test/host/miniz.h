@@ -0,0 +1,67 @@
+/**
+ * Stand-in de host para o tinfl da ROM do ESP32 (miniz), sobre a zlib.
+ * So o subconjunto usado pelo png_stream.
+ */
+#ifndef HOST_MINIZ_H
+#define HOST_MINIZ_H
+
+#include <zlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef uint8_t mz_uint8;
+typedef uint32_t mz_uint32;
+
+#define TINFL_LZ_DICT_SIZE 32768
+
+enum {
+    TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+    TINFL_FLAG_HAS_MORE_INPUT = 2,
+};
+
+typedef enum {
+    TINFL_STATUS_BAD_PARAM = -3,
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2,
+} tinfl_status;
+
+// init guarda TINFL_HOST_READY: o estado vem de heap nao inicializado
+#define TINFL_HOST_READY 0x5A17
+
+typedef struct {
+    int init;
+    z_stream zs;
+} tinfl_decompressor;
+
+#define tinfl_init(r) do { if ((r)->init == TINFL_HOST_READY) inflateEnd(&(r)->zs); (r)->init = 0; } while (0)
+
+static inline tinfl_status tinfl_decompress(tinfl_decompressor* r, const mz_uint8* in, size_t* inSize,
+                                            mz_uint8* start, mz_uint8* next, size_t* outSize,
+                                            mz_uint32 flags) {
+    (void)start;
+    if (r->init != TINFL_HOST_READY) {
+        memset(&r->zs, 0, sizeof(r->zs));
+        inflateInit(&r->zs);
+        r->init = TINFL_HOST_READY;
+    }
+
+    r->zs.next_in = (Bytef*)in;
+    r->zs.avail_in = (uInt)*inSize;
+    r->zs.next_out = next;
+    r->zs.avail_out = (uInt)*outSize;
+
+    int ret = inflate(&r->zs, Z_NO_FLUSH);
+    *inSize -= r->zs.avail_in;
+    *outSize -= r->zs.avail_out;
+
+    if (ret == Z_STREAM_END) return TINFL_STATUS_DONE;
+    if (ret != Z_OK && ret != Z_BUF_ERROR) return TINFL_STATUS_FAILED;
+    if (r->zs.avail_out == 0) return TINFL_STATUS_HAS_MORE_OUTPUT;
+    if (!(flags & TINFL_FLAG_HAS_MORE_INPUT)) return TINFL_STATUS_FAILED;
+    return TINFL_STATUS_NEEDS_MORE_INPUT;
+}
+
+#endif // HOST_MINIZ_H
@@ -0,0 +1,39 @@
+/**
+ * Stand-in de host para nvs.h: blobs em memoria por particao/namespace,
+ * com contadores de escrita e commit para os testes medirem o desgaste da
+ * flash (host_nvs.cpp)
+ */
+#ifndef HOST_NVS_H
+#define HOST_NVS_H
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t nvs_handle_t;
+
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE
+} nvs_open_mode_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t nvs_open_from_partition(const char* part, const char* ns,
+                                  nvs_open_mode_t mode, nvs_handle_t* handle);
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out, size_t* len);
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char* key, const void* value, size_t len);
+esp_err_t nvs_commit(nvs_handle_t handle);
+void nvs_close(nvs_handle_t handle);
+
+// Contadores desde o inicio do processo (ou o ultimo erase)
+uint32_t host_nvs_set_count(void);
+uint32_t host_nvs_commit_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NVS_H
@@ -0,0 +1,20 @@
+/**
+ * Stand-in de host para nvs_flash.h: particoes em memoria (host_nvs.cpp)
+ */
+#ifndef HOST_NVS_FLASH_H
+#define HOST_NVS_FLASH_H
+
+#include "nvs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t nvs_flash_init_partition(const char* part);
+esp_err_t nvs_flash_erase_partition(const char* part);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_NVS_FLASH_H
@@ -0,0 +1,13 @@
+/**
+ * Stand-in de host para sdkconfig.h: opcoes do sdkconfig.defaults que os
+ * modulos testados leem
+ */
+#ifndef HOST_SDKCONFIG_H
+#define HOST_SDKCONFIG_H
+
+#define CONFIG_PM_ENABLE                        1
+#define CONFIG_FREERTOS_USE_TICKLESS_IDLE       1
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ         240
+#define CONFIG_PM_LIGHT_SLEEP_CALLBACKS         1
+
+#endif // HOST_SDKCONFIG_H
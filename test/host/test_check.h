@@ -0,0 +1,20 @@
+/**
+ * Verificacao minima dos testes de host: conta falhas e segue
+ */
+#ifndef HOST_TEST_CHECK_H
+#define HOST_TEST_CHECK_H
+
+#include <stdio.h>
+
+static int g_testFailures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+            g_testFailures++; \
+        } \
+    } while (0)
+
+#define TEST_RESULT() (g_testFailures == 0 ? 0 : (fprintf(stderr, "%d falhas\n", g_testFailures), 1))
+
+#endif // HOST_TEST_CHECK_H
@@ -0,0 +1,166 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - FILTRO DE BATERIA
+ * ============================================================================
+ *
+ * Passa rajadas sinteticas do ADC (ja em mV da bateria, um quadro de
+ * BATTERY_FRAME_SAMPLES por periodo) pelo mesmo caminho do BatteryService:
+ * mediana do quadro, IIR e bateria fraca com histerese. Formas de onda:
+ * picos no quadro, queda curta sob carga (partida), descarga lenta ate o
+ * limiar e recuperacao com ruido em torno da histerese.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "services/battery/battery_filter.h"
+#include "config/app_config.h"
+#include "test_check.h"
+
+#include <stdlib.h>
+
+// ============================================================================
+// SIMULACAO DO SERVICO
+// ============================================================================
+
+struct Sim {
+    battery_filter_t filter;
+    bool low;
+    int transitions;
+    uint16_t mv;
+};
+
+static uint32_t g_seed = 1;
+
+static int noise(int amplitude) {
+    g_seed = g_seed * 1103515245u + 12345u;
+    return (int)((g_seed >> 16) % (2 * amplitude + 1)) - amplitude;
+}
+
+static void sim_init(Sim* sim) {
+    battery_filter_init(&sim->filter, BATTERY_IIR_SHIFT);
+    sim->low = false;
+    sim->transitions = 0;
+    sim->mv = 0;
+}
+
+/**
+ * Um quadro em torno de mv, com ruido e spikes amostras substituidas por
+ * picos (0 ou fundo de escala do divisor)
+ */
+static uint16_t sim_frame(Sim* sim, int mv, int spikes) {
+    uint16_t frame[BATTERY_FRAME_SAMPLES];
+    for (int i = 0; i < BATTERY_FRAME_SAMPLES; i++) {
+        frame[i] = (uint16_t)(mv + noise(15));
+    }
+    for (int i = 0; i < spikes; i++) {
+        int at = (i * 37 + 11) % BATTERY_FRAME_SAMPLES;
+        frame[at] = (i & 1) ? 0 : (uint16_t)(3100 * BATTERY_DIVIDER_NUM / BATTERY_DIVIDER_DEN);
+    }
+
+    uint16_t median = battery_filter_median(frame, BATTERY_FRAME_SAMPLES);
+    sim->mv = battery_filter_update(&sim->filter, median);
+
+    bool low = battery_filter_low(sim->low, sim->mv, BATTERY_LOW_MV, BATTERY_LOW_HYST_MV);
+    if (low != sim->low) sim->transitions++;
+    sim->low = low;
+    return sim->mv;
+}
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+static void test_median() {
+    uint16_t odd[] = {5, 1, 4, 2, 3};
+    CHECK(battery_filter_median(odd, 5) == 3);
+
+    uint16_t even[] = {10, 40, 20, 30};
+    CHECK(battery_filter_median(even, 4) == 25);
+
+    CHECK(battery_filter_median(nullptr, 0) == 0);
+}
+
+static void test_spikes() {
+    Sim sim;
+    sim_init(&sim);
+
+    // 20 de 64 amostras como picos: a mediana ignora, o IIR nem ve
+    int worst = 0;
+    for (int f = 0; f < 60; f++) {
+        int err = abs((int)sim_frame(&sim, 3900, 20) - 3900);
+        if (err > worst) worst = err;
+    }
+    if (worst > 10) fprintf(stderr, "picos: erro maximo %d mV\n", worst);
+    CHECK(worst <= 10);
+    CHECK(!sim.low && sim.transitions == 0);
+}
+
+static void test_sag_under_load() {
+    Sim sim;
+    sim_init(&sim);
+    for (int f = 0; f < 20; f++) sim_frame(&sim, 3900, 2);
+
+    // Tres quadros a 3200 mV (partida do motor): o IIR segura acima do limiar
+    uint16_t lowest = 0xFFFF;
+    for (int f = 0; f < 3; f++) {
+        uint16_t mv = sim_frame(&sim, 3200, 4);
+        if (mv < lowest) lowest = mv;
+    }
+    CHECK(lowest > BATTERY_LOW_MV);
+    CHECK(lowest < 3900 - 150);     // mas a queda aparece
+
+    for (int f = 0; f < 40; f++) sim_frame(&sim, 3900, 2);
+    CHECK(abs((int)sim.mv - 3900) <= 10);
+    CHECK(!sim.low && sim.transitions == 0);
+}
+
+static void test_slow_discharge_and_hysteresis() {
+    Sim sim;
+    sim_init(&sim);
+
+    // Descarga de 1 mV por quadro de 3700 ate 3300
+    int inputCross = -1;
+    int lowAt = -1;
+    int f = 0;
+    for (int mv = 3700; mv >= 3300; mv--, f++) {
+        sim_frame(&sim, mv, 3);
+        if (inputCross < 0 && mv < BATTERY_LOW_MV) inputCross = f;
+        if (lowAt < 0 && sim.low) lowAt = f;
+    }
+
+    // Entra em bateria fraca uma vez, com o atraso do IIR (~2^shift quadros)
+    CHECK(sim.low);
+    CHECK(sim.transitions == 1);
+    CHECK(lowAt >= inputCross && lowAt - inputCross <= (2 << BATTERY_IIR_SHIFT));
+
+    // Ruido de +-40 mV em torno do meio da faixa de histerese: nao sai
+    const int mid = BATTERY_LOW_MV + BATTERY_LOW_HYST_MV / 2;
+    for (int i = 0; i < 200; i++) {
+        sim_frame(&sim, mid + ((i & 1) ? 40 : -40), 3);
+    }
+    CHECK(sim.low && sim.transitions == 1);
+
+    // Carga ate acima da histerese: sai uma vez, so depois do limiar de saida
+    for (int i = 0; i < 60; i++) {
+        sim_frame(&sim, BATTERY_LOW_MV + BATTERY_LOW_HYST_MV + 100, 3);
+    }
+    CHECK(!sim.low && sim.transitions == 2);
+    CHECK(sim.mv > BATTERY_LOW_MV + BATTERY_LOW_HYST_MV);
+
+    // Funcao pura: limites exatos
+    CHECK(battery_filter_low(false, BATTERY_LOW_MV - 1, BATTERY_LOW_MV, BATTERY_LOW_HYST_MV));
+    CHECK(!battery_filter_low(false, BATTERY_LOW_MV, BATTERY_LOW_MV, BATTERY_LOW_HYST_MV));
+    CHECK(battery_filter_low(true, BATTERY_LOW_MV + BATTERY_LOW_HYST_MV, BATTERY_LOW_MV, BATTERY_LOW_HYST_MV));
+    CHECK(!battery_filter_low(true, BATTERY_LOW_MV + BATTERY_LOW_HYST_MV + 1, BATTERY_LOW_MV, BATTERY_LOW_HYST_MV));
+}
+
+int main() {
+    test_median();
+    test_spikes();
+    test_sag_under_load();
+    test_slow_discharge_and_hysteresis();
+    return TEST_RESULT();
+}
@@ -0,0 +1,147 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - BLEND RGB565 EM PARES
+ * ============================================================================
+ *
+ * Compara lv_draw_sw_blend_basic (fill_normal/map_normal com dois pixels
+ * por palavra) com a referencia escalar (blend_ref.c) em casos aleatorios:
+ * com e sem mascara, com e sem imagem de origem, opacidades nas bordas de
+ * LV_OPA_MAX, larguras impares e buffers desalinhados. O resultado tem que
+ * ser identico bit a bit.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "lvgl.h"
+#include "src/core/lv_refr.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "test_check.h"
+
+#include <string.h>
+
+extern "C" void ref_blend_basic(lv_draw_ctx_t* draw_ctx, const lv_draw_sw_blend_dsc_t* dsc);
+
+// ============================================================================
+// BUFFERS E SORTEIO
+// ============================================================================
+
+#define BUF_W   160
+#define BUF_H   64
+#define CASES   20000
+
+static lv_color_t g_out[BUF_W * BUF_H];
+static lv_color_t g_ref[BUF_W * BUF_H];
+static lv_color_t g_src[BUF_W * BUF_H];
+static lv_opa_t g_mask[BUF_W * BUF_H];
+static lv_opa_t g_maskCopy[BUF_W * BUF_H];
+
+static uint32_t rnd() {
+    static uint32_t s = 12345;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+/**
+ * Tipo 0: valores quaisquer (antialiasing); tipo 1: maioria 0 ou 255,
+ * como glifos e imagens com alfa
+ */
+static lv_opa_t rnd_mask(int kind) {
+    uint32_t r = rnd() % 8;
+    if (kind == 0) return (lv_opa_t)rnd();
+    if (r < 3) return LV_OPA_TRANSP;
+    if (r < 6) return LV_OPA_COVER;
+    return (lv_opa_t)rnd();
+}
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+static void test_conformance(lv_draw_sw_ctx_t* ctx) {
+    static const lv_opa_t opas[] = {255, 254, 253, 252, 200, 128, 64, 3, 0};
+    int mismatches = 0;
+
+    for (int i = 0; i < CASES; i++) {
+        for (int p = 0; p < BUF_W * BUF_H; p++) {
+            g_ref[p].full = (uint16_t)rnd();
+            g_src[p].full = (uint16_t)rnd();
+        }
+        memcpy(g_out, g_ref, sizeof(g_ref));
+
+        // Buffer de largura variavel: muda o stride e o alinhamento das linhas
+        lv_area_t bufArea = {0, 0, (lv_coord_t)(20 + rnd() % (BUF_W - 21)), BUF_H - 1};
+        lv_coord_t bufW = lv_area_get_width(&bufArea);
+        lv_area_t area;
+        area.x1 = (lv_coord_t)(rnd() % bufW);
+        area.x2 = (lv_coord_t)(area.x1 + rnd() % (bufW - area.x1));
+        area.y1 = (lv_coord_t)(rnd() % 20);
+        area.y2 = (lv_coord_t)(area.y1 + rnd() % 20);
+
+        bool hasMask = rnd() % 3 != 0;
+        bool hasSrc = rnd() % 2;
+        int kind = rnd() % 2;
+        for (int p = 0; p < BUF_W * BUF_H; p++) g_mask[p] = rnd_mask(kind);
+        lv_opa_t opa = (rnd() % 4) ? opas[rnd() % 9] : (lv_opa_t)rnd();
+
+        lv_draw_sw_blend_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.blend_area = &area;
+        dsc.opa = opa;
+        dsc.color.full = (uint16_t)rnd();
+        dsc.src_buf = hasSrc ? g_src : NULL;
+        dsc.mask_buf = hasMask ? g_mask : NULL;
+        dsc.mask_area = &area;
+        dsc.mask_res = hasMask ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+        ctx->base_draw.clip_area = &area;
+        ctx->base_draw.buf_area = &bufArea;
+
+        // A LVGL pode mexer na mascara; cada lado recebe a mesma
+        memcpy(g_maskCopy, g_mask, sizeof(g_mask));
+        ctx->base_draw.buf = g_ref;
+        ref_blend_basic(&ctx->base_draw, &dsc);
+        memcpy(g_mask, g_maskCopy, sizeof(g_mask));
+        ctx->base_draw.buf = g_out;
+        lv_draw_sw_blend_basic(&ctx->base_draw, &dsc);
+
+        if (memcmp(g_out, g_ref, sizeof(g_ref)) != 0) {
+            if (mismatches++ < 5) {
+                fprintf(stderr, "diferente: src %d mask %d tipo %d opa %d area %d,%d %d,%d stride %d\n",
+                        hasSrc, hasMask, kind, opa, area.x1, area.y1, area.x2, area.y2, bufW);
+            }
+        }
+    }
+
+    if (mismatches) {
+        fprintf(stderr, "%d de %d casos diferentes\n", mismatches, CASES);
+    }
+    CHECK(mismatches == 0);
+}
+
+int main() {
+    static lv_disp_draw_buf_t drawBuf;
+    static lv_disp_drv_t dispDrv;
+
+    lv_init();
+    lv_disp_draw_buf_init(&drawBuf, g_out, NULL, BUF_W * BUF_H);
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = BUF_W;
+    dispDrv.ver_res = BUF_H;
+    dispDrv.draw_buf = &drawBuf;
+    lv_disp_t* disp = lv_disp_drv_register(&dispDrv);
+
+    // O blend consulta o display em refresh (set_px_cb, tela transparente)
+    _lv_refr_set_disp_refreshing(disp);
+
+    lv_draw_sw_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    test_conformance(&ctx);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,383 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - TOQUE SEM ALOCACAO
+ * ============================================================================
+ *
+ * Monta o teclado numerico de verdade (ButtonManager + NumpadExample +
+ * StatusBar sobre a LVGL do firmware) e simula toques com um indev de
+ * ponteiro: pressiona no centro do botao, solta e roda o lv_timer_handler
+ * (evento, callback e redesenho, com faces pre-renderizadas como na tela
+ * real). Depois do aquecimento, nenhum toque pode chamar operator new nem
+ * heap_caps_*.
+ *
+ * Tambem cobre StaticVector::erase e InlineFunction, que o caminho usa, e o
+ * buildGrid: layout invalido nao cria nada, cada grade cria exatamente os
+ * objetos dos botoes (com e sem faces), reconstruir nao deixa objeto nem
+ * bloco do heap da LVGL para tras, e a construcao nao espera (tempo
+ * medido e impresso).
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "button_manager.h"
+#include "numpad_example.h"
+#include "ui/common/button_face.h"
+#include "ui/widgets/status_bar.h"
+#include "lvgl_mem.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "test_check.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <new>
+
+// ============================================================================
+// CONTADOR DE operator new
+// ============================================================================
+
+static uint32_t g_newCount;
+
+void* operator new(size_t size) {
+    g_newCount++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+static uint32_t alloc_count() {
+    return g_newCount + host_heap_alloc_count();
+}
+
+// ============================================================================
+// DISPLAY E TOQUE DO HOST
+// ============================================================================
+
+#define HOST_W  SCREEN_WIDTH
+#define HOST_H  SCREEN_HEIGHT
+
+static lv_color_t g_buf[HOST_W * HOST_H];
+static lv_point_t g_touchPoint;
+static bool g_touchPressed;
+static int g_audioCalls;
+
+static void flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* px) {
+    lv_disp_flush_ready(drv);
+}
+
+static void touch_read_cb(lv_indev_drv_t* drv, lv_indev_data_t* data) {
+    data->point = g_touchPoint;
+    data->state = g_touchPressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+extern "C" void playAudioFile(const char* filename) {
+    g_audioCalls++;
+}
+
+static void host_display_init() {
+    static lv_disp_draw_buf_t drawBuf;
+    static lv_disp_drv_t dispDrv;
+    static lv_indev_drv_t indevDrv;
+
+    lv_init();
+    lv_disp_draw_buf_init(&drawBuf, g_buf, NULL, HOST_W * HOST_H);
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = HOST_W;
+    dispDrv.ver_res = HOST_H;
+    dispDrv.flush_cb = flush_cb;
+    dispDrv.draw_buf = &drawBuf;
+    dispDrv.full_refresh = 1;
+    lv_disp_drv_register(&dispDrv);
+
+    lv_indev_drv_init(&indevDrv);
+    indevDrv.type = LV_INDEV_TYPE_POINTER;
+    indevDrv.read_cb = touch_read_cb;
+    lv_indev_drv_register(&indevDrv);
+}
+
+static void run_lvgl(uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += 10) {
+        host_timer_advance_ms(10);
+        lv_timer_handler();
+    }
+}
+
+/**
+ * Pressiona e solta no centro do objeto, com o intervalo do debounce
+ */
+static void tap(lv_obj_t* obj) {
+    lv_area_t a;
+    lv_obj_get_coords(obj, &a);
+    g_touchPoint.x = (lv_coord_t)((a.x1 + a.x2) / 2);
+    g_touchPoint.y = (lv_coord_t)((a.y1 + a.y2) / 2);
+
+    g_touchPressed = true;
+    run_lvgl(60);
+    g_touchPressed = false;
+    run_lvgl(BUTTON_DEBOUNCE_MS + 60);
+}
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+static void test_static_vector_erase() {
+    StaticVector<int, 8> v;
+    for (int i = 0; i < 6; i++) v.push_back(i);
+
+    // Apaga os pares no padrao "it = erase(it)": nenhum elemento pulado
+    for (StaticVector<int, 8>::iterator it = v.begin(); it != v.end();) {
+        if (*it % 2 == 0) {
+            it = v.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    CHECK(v.size() == 3);
+    CHECK(v[0] == 1 && v[1] == 3 && v[2] == 5);
+
+    // Ultimo elemento: retorna end()
+    CHECK(v.erase(v.begin() + 2) == v.end());
+    CHECK(v.size() == 2);
+
+    for (int i = 0; i < 6; i++) v.push_back(i);
+    CHECK(v.full());
+    CHECK(!v.push_back(99));
+}
+
+static int g_calledWith;
+
+static void record(int id) {
+    g_calledWith = id;
+}
+
+static void test_inline_function() {
+    InlineFunction<void(int)> empty;
+    CHECK(!empty);
+
+    void (*nullFn)(int) = nullptr;
+    InlineFunction<void(int)> fromNull(nullFn);
+    CHECK(!fromNull);
+
+    uint32_t before = alloc_count();
+    InlineFunction<void(int)> fn(record);
+    InlineFunction<void(int)> copy = fn;
+    copy(7);
+    CHECK(g_calledWith == 7);
+
+    int offset = 100;
+    InlineFunction<void(int)> lambda([offset](int id) { g_calledWith = id + offset; });
+    lambda(5);
+    CHECK(g_calledWith == 105);
+    CHECK(alloc_count() == before);
+}
+
+static lv_obj_t* find_button(ButtonManager* mgr, const char* label) {
+    for (int id = 0; id <= GRID_TOTAL_BUTTONS; id++) {
+        GridButton* btn = mgr->getButton(id);
+        if (btn && strcmp(btn->label.c_str(), label) == 0) return btn->obj;
+    }
+    return nullptr;
+}
+
+static void test_numpad_tap() {
+    host_display_init();
+
+    StatusBar statusBar;
+    statusBar.create();
+
+    ButtonManager* mgr = ButtonManager::acquire();
+    CHECK(mgr != nullptr);
+    if (!mgr) return;
+    mgr->init();
+    mgr->setBakedFaces(true);   // Como a NumpadScreen
+
+    // Os callbacks do teclado usam o singleton
+    NumpadExample* numpad = NumpadExample::getInstance();
+    numpad->init(mgr);
+    numpad->setStatusBar(&statusBar);
+    numpad->createNumpad();
+
+    lv_obj_t* one = find_button(mgr, "1");
+    lv_obj_t* five = find_button(mgr, "5");
+    lv_obj_t* cancel = find_button(mgr, "CANCELAR");
+    CHECK(one && five && cancel);
+    if (!one || !five || !cancel) return;
+
+    // IDs comecam em 1 tambem depois de createScreen (0 nao e um botao)
+    CHECK(mgr->getButton(0) == nullptr);
+    CHECK(mgr->getButton(1) != nullptr);
+
+    // Face pre-renderizada, com o raio da arvore para a sombra ao vivo
+    CHECK(ButtonFaceCache::faceOf(one) != nullptr);
+    CHECK(lv_obj_get_style_radius(one, LV_PART_MAIN) > 0);
+
+    lv_scr_load(lv_obj_get_screen(one));
+    run_lvgl(200);
+
+    // Aquecimento: buffers da LVGL, textos da barra de status
+    tap(one);
+    tap(five);
+    tap(cancel);
+    int audioBefore = g_audioCalls;
+
+    uint32_t before = alloc_count();
+    for (int i = 0; i < 8; i++) {
+        tap(i % 2 ? five : one);
+    }
+    tap(cancel);
+    uint32_t allocs = alloc_count() - before;
+
+    if (allocs) {
+        fprintf(stderr, "toques alocaram %u vezes\n", (unsigned)allocs);
+    }
+    CHECK(allocs == 0);
+
+    // Os toques chegaram aos callbacks (um som por digito)
+    CHECK(g_audioCalls - audioBefore >= 8);
+}
+
+// ============================================================================
+// CONSTRUCAO DA GRADE
+// ============================================================================
+
+#define BUILD_ROUNDS    20
+
+static uint32_t count_tree(lv_obj_t* obj) {
+    uint32_t n = 1;
+    uint32_t cnt = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < cnt; i++) n += count_tree(lv_obj_get_child(obj, i));
+    return n;
+}
+
+static uint32_t pool_blocks() {
+    lvgl_mem_stats_t s;
+    lvgl_mem_get_stats(&s);
+    return s.poolBlocks;
+}
+
+static void on_grid_click(int id) {
+}
+
+// Grade cheia: digitos e dois botoes com icone. Arvore: botao, icone e
+// label; com faces os filhos viram a imagem e sobra so o botao
+static uint32_t make_defs(ButtonManager::ButtonBatchDef (&defs)[GRID_TOTAL_BUTTONS], bool baked) {
+    static const char* LABELS[GRID_TOTAL_BUTTONS] = {
+        "1", "2", "3", "CANCELAR", "4", "5", "6", "0", "7", "8", "9", "ENVIAR",
+    };
+    uint32_t objects = 0;
+    for (int i = 0; i < GRID_TOTAL_BUTTONS; i++) {
+        bool action = (i % GRID_COLS) == GRID_COLS - 1 && i / GRID_COLS != 1;
+        defs[i] = {i % GRID_COLS, i / GRID_COLS, LABELS[i],
+                   action ? (i < GRID_COLS ? ICON_CANCEL : ICON_CHECK) : ICON_NONE,
+                   nullptr, lv_color_hex(action ? 0xFF4444 : 0x4444FF), on_grid_click,
+                   1, 1, lv_color_hex(0xFFFFFF),
+                   action ? &lv_font_montserrat_16 : &lv_font_montserrat_42};
+        objects += baked ? 1 : (action ? 3 : 2);
+    }
+    return objects;
+}
+
+// O caminho antigo dormia vTaskDelay(50) entre botoes e esperava a fila de
+// retry. No host o vTaskDelay so adianta o esp_timer: o que o esp_timer anda
+// alem do relogio real e espera, e tem de ser zero
+struct BuildTime {
+    int64_t us;
+    int64_t sleptUs;
+};
+
+static BuildTime build_grid(ButtonManager* mgr, const ButtonManager::ButtonBatchDef* defs, int* ids, int* created) {
+    auto t0 = std::chrono::steady_clock::now();
+    int64_t e0 = esp_timer_get_time();
+    *created = mgr->buildGrid(defs, GRID_TOTAL_BUTTONS, ids);
+    int64_t e1 = esp_timer_get_time();
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+    return {us, (e1 - e0) - us};
+}
+
+static void test_build_grid(ButtonManager* mgr, bool baked) {
+    ButtonManager::ButtonBatchDef defs[GRID_TOTAL_BUTTONS];
+    uint32_t perGrid = make_defs(defs, baked);
+    mgr->setBakedFaces(baked);
+
+    lv_obj_t* screen = mgr->getScreen();
+    uint32_t base = count_tree(screen);
+    uint32_t blocks = pool_blocks();
+    int ids[GRID_TOTAL_BUTTONS];
+    int created;
+
+    // Layout invalido (ultimo botao sobre o primeiro): nada e criado
+    ButtonManager::ButtonBatchDef bad[GRID_TOTAL_BUTTONS];
+    memcpy(bad, defs, sizeof(bad));
+    bad[GRID_TOTAL_BUTTONS - 1].gridX = 0;
+    bad[GRID_TOTAL_BUTTONS - 1].gridY = 0;
+    build_grid(mgr, bad, ids, &created);
+    CHECK(created == 0);
+    CHECK(ids[0] == -1 && ids[GRID_TOTAL_BUTTONS - 1] == -1);
+    CHECK(count_tree(screen) == base);
+    CHECK(pool_blocks() == blocks);
+
+    // Primeira grade: so os objetos dos botoes (estilos e faces sao
+    // compartilhados e podem ser criados aqui, uma vez)
+    BuildTime first = build_grid(mgr, defs, ids, &created);
+    CHECK(created == GRID_TOTAL_BUTTONS);
+    CHECK(count_tree(screen) == base + perGrid);
+    for (int i = 0; i < GRID_TOTAL_BUTTONS; i++) {
+        GridButton* btn = mgr->getButton(ids[i]);
+        CHECK(btn && btn->obj && lv_obj_get_parent(lv_obj_get_parent(btn->obj)) == screen);
+        CHECK(btn && (ButtonFaceCache::faceOf(btn->obj) != nullptr) == baked);
+    }
+    mgr->removeAllButtons();
+    CHECK(count_tree(screen) == base);
+    blocks = pool_blocks();
+
+    // Reconstrucoes: mesmo numero de objetos, e o heap da LVGL volta ao
+    // mesmo numero de blocos a cada remocao
+    int64_t worst = first.us;
+    int64_t slept = first.sleptUs;
+    int64_t sum = 0;
+    for (int r = 0; r < BUILD_ROUNDS; r++) {
+        BuildTime t = build_grid(mgr, defs, ids, &created);
+        CHECK(created == GRID_TOTAL_BUTTONS);
+        CHECK(count_tree(screen) == base + perGrid);
+        mgr->removeAllButtons();
+        CHECK(count_tree(screen) == base);
+        CHECK(pool_blocks() == blocks);
+        sum += t.us;
+        if (t.us > worst) worst = t.us;
+        if (t.sleptUs > slept) slept = t.sleptUs;
+    }
+
+    printf("buildGrid (%s): %d botoes, %u objetos, primeira %lld us, media %lld us, pior %lld us, "
+           "espera %lld us\n", baked ? "faces" : "arvore", GRID_TOTAL_BUTTONS, (unsigned)perGrid,
+           (long long)first.us, (long long)(sum / BUILD_ROUNDS), (long long)worst, (long long)slept);
+    CHECK(slept < portTICK_PERIOD_MS * 1000);
+}
+
+int main() {
+    test_static_vector_erase();
+    test_inline_function();
+    test_numpad_tap();
+
+    ButtonManager* mgr = ButtonManager::acquire();
+    CHECK(mgr != nullptr);
+    if (mgr) {
+        mgr->init();
+        test_build_grid(mgr, false);
+        test_build_grid(mgr, true);
+    }
+    return TEST_RESULT();
+}
@@ -0,0 +1,261 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - BARRAMENTO DE EVENTOS
+ * ============================================================================
+ *
+ * Mascaras por destino, ordem entre origens, anel cheio e notificacao da
+ * task consumidora. O ultimo caso poe tres threads publicando em dois
+ * nucleos simulados (duas no mesmo nucleo e na mesma origem) enquanto
+ * outra consome, sem trava entre nucleos: a entrega tem que sair em seq
+ * crescente e cada produtor tem que ser visto na ordem em que publicou.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "core/event_bus.h"
+#include "test_check.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// REGISTRO DOS HANDLERS
+// ============================================================================
+
+struct Received {
+    std::vector<AppEvent> events;
+};
+
+static Received g_uiIgnicao;
+static Received g_uiJornada;
+static Received g_audio;
+
+static void on_event(const AppEvent& event, void* ctx) {
+    static_cast<Received*>(ctx)->events.push_back(event);
+}
+
+static void reset_received() {
+    g_uiIgnicao.events.clear();
+    g_uiJornada.events.clear();
+    g_audio.events.clear();
+}
+
+static AppEvent ignicao_event(bool on) {
+    AppEvent ev = {};
+    ev.type = EventType::IGNICAO_CHANGED;
+    ev.ignicao.on = on;
+    return ev;
+}
+
+static AppEvent jornada_event(int16_t id, uint8_t estado) {
+    AppEvent ev = {};
+    ev.type = EventType::JORNADA_CHANGED;
+    ev.jornada.motoristaId = id;
+    ev.jornada.estado = estado;
+    return ev;
+}
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+static void test_masks(EventBus* bus) {
+    reset_received();
+
+    // Audio nao assina JORNADA: o evento nem entra no anel dele
+    CHECK(bus->publish(EventSource::JORNADA, jornada_event(3, 1)));
+    CHECK(bus->hasPending(EventSink::UI));
+    CHECK(!bus->hasPending(EventSink::AUDIO));
+
+    CHECK(bus->publish(EventSource::IGNICAO, ignicao_event(true)));
+    CHECK(bus->hasPending(EventSink::AUDIO));
+
+    CHECK(bus->dispatch(EventSink::UI) == 2);
+    CHECK(bus->dispatch(EventSink::AUDIO) == 1);
+    CHECK(!bus->hasPending(EventSink::UI));
+
+    CHECK(g_uiJornada.events.size() == 1 && g_uiJornada.events[0].jornada.motoristaId == 3);
+    CHECK(g_uiIgnicao.events.size() == 1 && g_uiIgnicao.events[0].ignicao.on);
+    CHECK(g_audio.events.size() == 1 && g_audio.events[0].type == EventType::IGNICAO_CHANGED);
+
+    // Origem invalida
+    CHECK(!bus->publish(EventSource::MAX_SOURCES, ignicao_event(false)));
+}
+
+static void test_order_between_sources(EventBus* bus) {
+    reset_received();
+
+    bus->publish(EventSource::JORNADA, jornada_event(1, 0));
+    bus->publish(EventSource::IGNICAO, ignicao_event(true));
+    bus->publish(EventSource::JORNADA, jornada_event(2, 0));
+    bus->publish(EventSource::IGNICAO, ignicao_event(false));
+
+    // Handlers diferentes, mas a entrega intercala por seq
+    std::vector<uint32_t> seqs;
+    CHECK(bus->dispatch(EventSink::UI) == 4);
+    for (const AppEvent& ev : g_uiJornada.events) seqs.push_back(ev.seq);
+    for (const AppEvent& ev : g_uiIgnicao.events) seqs.push_back(ev.seq);
+    CHECK(seqs.size() == 4);
+    if (seqs.size() == 4) {
+        CHECK(seqs[0] + 2 == seqs[1]);      // jornada 1, jornada 2
+        CHECK(seqs[2] == seqs[0] + 1);      // ignicao entre elas
+        CHECK(seqs[3] == seqs[1] + 1);
+    }
+    bus->dispatch(EventSink::AUDIO);
+}
+
+static void test_overflow(EventBus* bus) {
+    reset_received();
+    EventBusStats before = bus->getStats();
+
+    int accepted = 0;
+    for (int i = 0; i < EVENT_BUS_RING_SIZE + 4; i++) {
+        if (bus->publish(EventSource::JORNADA, jornada_event((int16_t)i, 0))) accepted++;
+    }
+    CHECK(accepted == EVENT_BUS_RING_SIZE);
+
+    EventBusStats after = bus->getStats();
+    CHECK(after.dropped - before.dropped == 4);
+    CHECK(after.published - before.published == EVENT_BUS_RING_SIZE);
+
+    // Os descartados sao os novos: os primeiros chegam inteiros e em ordem
+    CHECK(bus->dispatch(EventSink::UI) == EVENT_BUS_RING_SIZE);
+    CHECK(g_uiJornada.events.size() == EVENT_BUS_RING_SIZE);
+    for (size_t i = 0; i < g_uiJornada.events.size(); i++) {
+        CHECK(g_uiJornada.events[i].jornada.motoristaId == (int16_t)i);
+    }
+
+    // Com espaco de novo, publica normalmente
+    CHECK(bus->publish(EventSource::JORNADA, jornada_event(99, 0)));
+    CHECK(bus->dispatch(EventSink::UI) == 1);
+}
+
+static void test_sink_notify(EventBus* bus) {
+    HostTask ui = {0};
+    HostTask audio = {0};
+    bus->setSinkTask(EventSink::UI, &ui);
+    bus->setSinkTask(EventSink::AUDIO, &audio);
+
+    bus->publish(EventSource::JORNADA, jornada_event(1, 0));
+    CHECK(ui.notifications == 1 && audio.notifications == 0);
+    bus->publish(EventSource::IGNICAO, ignicao_event(true));
+    CHECK(ui.notifications == 2 && audio.notifications == 1);
+
+    bus->setSinkTask(EventSink::UI, nullptr);
+    bus->setSinkTask(EventSink::AUDIO, nullptr);
+    bus->dispatch(EventSink::UI);
+    bus->dispatch(EventSink::AUDIO);
+}
+
+/**
+ * Produtores concorrentes: duas threads na origem JORNADA no nucleo 0 e
+ * uma na IGNICAO no nucleo 1; o consumidor confere a ordem enquanto elas
+ * publicam. Anel
+ * cheio descarta (o produtor nao repete), entao cada produtor pode ter
+ * buracos, mas nunca volta atras. motoristaId leva produtor (bits 12-14)
+ * e contador (bits 0-11), tambem nos eventos de ignicao (o bus copia o
+ * evento inteiro).
+ */
+struct Order {
+    bool first;
+    uint32_t lastSeq;
+    int last[4];
+    int outOfOrder;
+    int producerBackwards;
+    int count;
+};
+
+static void check_order(const AppEvent& ev, void* ctx) {
+    Order* o = static_cast<Order*>(ctx);
+    if (!o->first && (int32_t)(ev.seq - o->lastSeq) <= 0) o->outOfOrder++;
+    o->first = false;
+    o->lastSeq = ev.seq;
+
+    int p = ev.jornada.motoristaId >> 12;
+    int counter = ev.jornada.motoristaId & 0xFFF;
+    if (p < 1 || p > 3) {
+        o->producerBackwards++;
+        return;
+    }
+    int step = (counter - o->last[p]) & 0xFFF;
+    if (o->last[p] >= 0 && (step == 0 || step >= 0x800)) o->producerBackwards++;
+    o->last[p] = counter;
+    o->count++;
+}
+
+static void test_concurrent_producers(EventBus* bus) {
+    const int perProducer = 20000;
+    std::atomic<int> running(3);
+    std::atomic<bool> go(false);
+    std::atomic<int> accepted(0);
+
+    auto producer = [&](EventSource source, int tag, int core) {
+        host_set_core_id(core);
+        while (!go.load()) {
+        }
+        for (int i = 0; i < perProducer; i++) {
+            AppEvent ev = source == EventSource::IGNICAO ? ignicao_event(true)
+                                                          : jornada_event(0, 0);
+            ev.jornada.motoristaId = (int16_t)((tag << 12) | (i & 0xFFF));
+            if (bus->publish(source, ev)) {
+                accepted.fetch_add(1);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        running.fetch_sub(1);
+    };
+
+    Order order = {};
+    order.first = true;
+    for (int p = 0; p < 4; p++) order.last[p] = -1;
+
+    // Inscricoes extras so para este caso (a tabela tem folga)
+    CHECK(bus->subscribe(EventSink::UI, EventType::JORNADA_CHANGED, check_order, &order));
+    CHECK(bus->subscribe(EventSink::UI, EventType::IGNICAO_CHANGED, check_order, &order));
+    reset_received();
+
+    std::thread a(producer, EventSource::JORNADA, 1, 0);
+    std::thread b(producer, EventSource::JORNADA, 2, 0);
+    std::thread c(producer, EventSource::IGNICAO, 3, 1);
+    go.store(true);
+
+    // Consome na thread principal (papel das tasks LVGL e de audio)
+    while (running.load() > 0) {
+        bus->dispatch(EventSink::UI);
+        bus->dispatch(EventSink::AUDIO);
+    }
+    a.join();
+    b.join();
+    c.join();
+    bus->dispatch(EventSink::UI);
+    bus->dispatch(EventSink::AUDIO);
+
+    if (order.outOfOrder || order.producerBackwards) {
+        fprintf(stderr, "concorrente: %d fora de ordem, %d voltas de produtor\n",
+                order.outOfOrder, order.producerBackwards);
+    }
+    CHECK(order.count > perProducer);
+    CHECK(order.outOfOrder == 0);
+    CHECK(order.producerBackwards == 0);
+}
+
+int main() {
+    EventBus* bus = EventBus::getInstance();
+    CHECK(bus->subscribe(EventSink::UI, EventType::IGNICAO_CHANGED, on_event, &g_uiIgnicao));
+    CHECK(bus->subscribe(EventSink::UI, EventType::JORNADA_CHANGED, on_event, &g_uiJornada));
+    CHECK(bus->subscribe(EventSink::AUDIO, EventType::IGNICAO_CHANGED, on_event, &g_audio));
+    CHECK(!bus->subscribe(EventSink::UI, EventType::MAX_TYPES, on_event, nullptr));
+
+    test_masks(bus);
+    test_order_between_sources(bus);
+    test_overflow(bus);
+    test_sink_notify(bus);
+    test_concurrent_producers(bus);
+
+    return TEST_RESULT();
+}
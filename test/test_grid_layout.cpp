@@ -0,0 +1,227 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - LAYOUT DE GRADE
+ * ============================================================================
+ *
+ * GridGeometry/GridLayout (include/ui/common/grid_layout.h) nas grades 4x3
+ * (teclados do aplicativo), 3x4 e 5x4: posicao e tamanho dos botoes, donos
+ * das celulas, hit-test nas bordas e na margem entre dois botoes diferentes
+ * (fica com o botao da esquerda/de cima), e rejeicao de layouts que
+ * sobrepoem botoes ou saem da grade: erro de compilacao no constexpr,
+ * valid() falso em tempo de execucao.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "ui/common/grid_layout.h"
+#include "test_check.h"
+
+#include <type_traits>
+
+// ============================================================================
+// LAYOUT CONSTANTE OU NAO
+// ============================================================================
+
+/**
+ * true se GridLayout<Geometry, N>(Cells) e uma expressao constante; o
+ * layout invalido chama layoutInvalido() e deixa de ser (SFINAE)
+ */
+template <typename Geometry, size_t N, const GridCell (&Cells)[N], typename = void>
+struct IsConstantLayout : std::false_type {};
+
+template <typename Geometry, size_t N, const GridCell (&Cells)[N]>
+struct IsConstantLayout<Geometry, N, Cells,
+    std::void_t<std::integral_constant<bool, GridLayout<Geometry, N>(Cells).valid()>>>
+    : std::true_type {};
+
+typedef GridFitGeometry<3, 4> Geometry3x4;
+typedef GridFitGeometry<5, 4> Geometry5x4;
+
+// ============================================================================
+// 4x3 (teclados do aplicativo)
+// ============================================================================
+
+constexpr GridCell kCells4x3[] = {
+    {0, 0, 1, 1}, {1, 0, 1, 1}, {2, 0, 2, 1},
+    {0, 1, 1, 2}, {1, 1, 3, 2},
+};
+constexpr GridLayout<AppGridGeometry, 5> kLayout4x3(kCells4x3);
+
+// Tudo constexpr: se compilar, a tabela sai pronta do compilador
+static_assert(kLayout4x3.valid(), "4x3 valido");
+static_assert(kLayout4x3.rect(2).x == 2 * (GRID_BUTTON_WIDTH + GRID_BUTTON_MARGIN), "4x3: posicao");
+static_assert(kLayout4x3.hitTest(0, 0) == 0, "4x3: origem");
+
+static void test_4x3() {
+    typedef AppGridGeometry G;
+    const GridLayout<G, 5>& l = kLayout4x3;
+
+    CHECK(G::width == 4 * GRID_BUTTON_WIDTH + 3 * GRID_BUTTON_MARGIN);
+    CHECK(G::height == 3 * GRID_BUTTON_HEIGHT + 2 * GRID_BUTTON_MARGIN);
+
+    // Botao largo (2 celulas) e alto (2 linhas)
+    CHECK(l.rect(2).x == 2 * G::pitchX && l.rect(2).y == 0);
+    CHECK(l.rect(2).w == 2 * GRID_BUTTON_WIDTH + GRID_BUTTON_MARGIN);
+    CHECK(l.rect(3).h == 2 * GRID_BUTTON_HEIGHT + GRID_BUTTON_MARGIN);
+    CHECK(l.rect(4).w == 3 * GRID_BUTTON_WIDTH + 2 * GRID_BUTTON_MARGIN);
+
+    CHECK(l.ownerAt(2, 0) == 2 && l.ownerAt(3, 0) == 2);
+    CHECK(l.ownerAt(0, 2) == 3 && l.ownerAt(3, 2) == 4);
+    CHECK(l.ownerAt(-1, 0) == -1 && l.ownerAt(4, 0) == -1 && l.ownerAt(0, 3) == -1);
+
+    // Cantos e fora da grade
+    CHECK(l.hitTest(0, 0) == 0);
+    CHECK(l.hitTest(G::width - 1, G::height - 1) == 4);
+    CHECK(l.hitTest(G::width, 0) == -1);
+    CHECK(l.hitTest(0, G::height) == -1);
+    CHECK(l.hitTest(-1, 5) == -1);
+
+    // Margem entre dois botoes diferentes: fica com o da esquerda / de cima
+    const int gapX = GRID_BUTTON_WIDTH + GRID_BUTTON_MARGIN / 2;
+    const int gapY = GRID_BUTTON_HEIGHT + GRID_BUTTON_MARGIN / 2;
+    CHECK(l.hitTest(gapX, 5) == 0);                       // Entre 0 e 1
+    CHECK(l.hitTest(G::pitchX - 1, 5) == 0);              // Ultimo pixel da margem
+    CHECK(l.hitTest(G::pitchX, 5) == 1);                  // Primeiro pixel do 1
+    CHECK(l.hitTest(5, gapY) == 0);                       // Entre 0 e 3
+    CHECK(l.hitTest(G::pitchX + 5, gapY) == 1);           // Entre 1 e 4
+    CHECK(l.hitTest(G::pitchX + 5, G::pitchY) == 4);
+
+    // Margem interna de um botao multi-celula e dele
+    CHECK(l.hitTest(3 * G::pitchX - 1, 5) == 2);
+    CHECK(l.hitTest(5, 2 * G::pitchY - 1) == 3);
+}
+
+// ============================================================================
+// 3x4
+// ============================================================================
+
+constexpr GridCell kCells3x4[] = {
+    {0, 0, 3, 1}, {0, 1, 1, 1}, {1, 1, 1, 1}, {2, 1, 1, 3},
+};
+constexpr GridLayout<Geometry3x4, 4> kLayout3x4(kCells3x4);
+static_assert(kLayout3x4.valid(), "3x4 valido");
+
+static void test_3x4() {
+    typedef Geometry3x4 G;
+    const GridLayout<G, 4>& l = kLayout3x4;
+
+    CHECK(G::cols == 3 && G::rows == 4 && G::cellCount == 12);
+    CHECK(G::width <= DISPLAY_WIDTH - 2 * GRID_PADDING);
+    CHECK(G::height <= GRID_AREA_HEIGHT - 2 * GRID_PADDING);
+
+    CHECK(l.rect(0).w == G::width);
+    CHECK(l.rect(3).x == 2 * G::pitchX && l.rect(3).y == G::pitchY);
+    CHECK(l.rect(3).y + l.rect(3).h == G::height);
+
+    CHECK(l.ownerAt(2, 0) == 0 && l.ownerAt(2, 3) == 3);
+    CHECK(l.ownerAt(0, 3) == -1 && l.ownerAt(1, 2) == -1);
+    CHECK(l.hitTest(0, 3 * G::pitchY) == -1);
+    CHECK(l.hitTest(G::width - 1, G::height - 1) == 3);
+
+    // Margem entre o botao largo de cima e os de baixo
+    CHECK(l.hitTest(G::pitchX + 5, G::pitchY - 1) == 0);
+    CHECK(l.hitTest(G::pitchX + 5, G::pitchY) == 2);
+
+    // Margem entre 1 e 2, e entre 2 e 3
+    CHECK(l.hitTest(G::pitchX - 1, G::pitchY + 5) == 1);
+    CHECK(l.hitTest(2 * G::pitchX - 1, G::pitchY + 5) == 2);
+    CHECK(l.hitTest(2 * G::pitchX, G::pitchY + 5) == 3);
+}
+
+// ============================================================================
+// 5x4
+// ============================================================================
+
+constexpr GridCell kCells5x4[] = {
+    {0, 0, 1, 1}, {4, 3, 1, 1}, {1, 1, 3, 2}, {1, 0, 1, 1},
+};
+constexpr GridLayout<Geometry5x4, 4> kLayout5x4(kCells5x4);
+static_assert(kLayout5x4.valid(), "5x4 valido");
+
+static void test_5x4() {
+    typedef Geometry5x4 G;
+    const GridLayout<G, 4>& l = kLayout5x4;
+
+    CHECK(G::cellCount == 20);
+    CHECK(G::width <= DISPLAY_WIDTH - 2 * GRID_PADDING);
+    CHECK(G::height <= GRID_AREA_HEIGHT - 2 * GRID_PADDING);
+
+    CHECK(l.hitTest(G::width - 1, G::height - 1) == 1);
+    CHECK(l.hitTest(2 * G::pitchX, 2 * G::pitchY) == 2);
+    CHECK(l.ownerAt(4, 0) == -1);
+    CHECK(l.rect(2).w == 3 * (G::pitchX) - GRID_BUTTON_MARGIN);
+
+    // Margem entre 0 e 3 (lado a lado) e entre 3 e 2 (um sobre o outro)
+    CHECK(l.hitTest(G::pitchX - 1, 0) == 0);
+    CHECK(l.hitTest(G::pitchX, 0) == 3);
+    CHECK(l.hitTest(G::pitchX + 1, G::pitchY - 1) == 3);
+    CHECK(l.hitTest(G::pitchX + 1, G::pitchY) == 2);
+
+    // Percorre todos os pixels: o hit-test bate com os retangulos, e a
+    // margem fica com a celula anterior (ou ninguem se ela estiver livre)
+    int bad = 0;
+    for (int y = 0; y < G::height; y++) {
+        for (int x = 0; x < G::width; x++) {
+            int col = x / G::pitchX;
+            int row = y / G::pitchY;
+            if (l.hitTest(x, y) != l.ownerAt(col, row)) bad++;
+
+            for (size_t i = 0; i < l.size(); i++) {
+                const GridRect& r = l.rect(i);
+                bool inside = x >= r.x && x < r.x + r.w && y >= r.y && y < r.y + r.h;
+                if (inside && l.hitTest(x, y) != (int)i) bad++;
+            }
+        }
+    }
+    CHECK(bad == 0);
+}
+
+// ============================================================================
+// REJEICAO
+// ============================================================================
+
+constexpr GridCell kOverlap4x3[] = {{0, 0, 2, 1}, {1, 0, 1, 2}};
+constexpr GridCell kOutside4x3[] = {{3, 0, 2, 1}};
+constexpr GridCell kOverlap3x4[] = {{0, 0, 3, 1}, {2, 0, 1, 4}};
+constexpr GridCell kOutside3x4[] = {{0, 3, 1, 2}};
+constexpr GridCell kOverlap5x4[] = {{1, 1, 3, 2}, {3, 2, 2, 2}};
+constexpr GridCell kOutside5x4[] = {{-1, 0, 1, 1}};
+constexpr GridCell kEmpty5x4[] = {{0, 0, 0, 1}};
+
+// Layout valido compila; sobreposto ou fora da grade nao
+static_assert(IsConstantLayout<AppGridGeometry, 5, kCells4x3>::value, "4x3 valido e constante");
+static_assert(!IsConstantLayout<AppGridGeometry, 2, kOverlap4x3>::value, "4x3 sobreposto");
+static_assert(!IsConstantLayout<AppGridGeometry, 1, kOutside4x3>::value, "4x3 fora");
+static_assert(!IsConstantLayout<Geometry3x4, 2, kOverlap3x4>::value, "3x4 sobreposto");
+static_assert(!IsConstantLayout<Geometry3x4, 1, kOutside3x4>::value, "3x4 fora");
+static_assert(!IsConstantLayout<Geometry5x4, 2, kOverlap5x4>::value, "5x4 sobreposto");
+static_assert(!IsConstantLayout<Geometry5x4, 1, kOutside5x4>::value, "5x4 fora");
+static_assert(!IsConstantLayout<Geometry5x4, 1, kEmpty5x4>::value, "5x4 sem area");
+
+static void test_rejection() {
+    // Em tempo de execucao o mesmo layout fica invalido
+    CHECK(!(GridLayout<AppGridGeometry, 2>(kOverlap4x3).valid()));
+    CHECK(!(GridLayout<AppGridGeometry, 1>(kOutside4x3).valid()));
+    CHECK(!(GridLayout<Geometry3x4, 2>(kOverlap3x4).valid()));
+    CHECK(!(GridLayout<Geometry3x4, 1>(kOutside3x4).valid()));
+    CHECK(!(GridLayout<Geometry5x4, 2>(kOverlap5x4).valid()));
+    CHECK(!(GridLayout<Geometry5x4, 1>(kOutside5x4).valid()));
+    CHECK(!(GridLayout<Geometry5x4, 1>(kEmpty5x4).valid()));
+    CHECK((GridLayout<Geometry5x4, 4>(kCells5x4).valid()));
+
+    // A celula disputada fica com o primeiro botao
+    GridLayout<AppGridGeometry, 2> overlap(kOverlap4x3);
+    CHECK(overlap.ownerAt(1, 0) == 0);
+    CHECK(overlap.ownerAt(1, 1) == 1);
+}
+
+int main() {
+    test_4x3();
+    test_3x4();
+    test_5x4();
+    test_rejection();
+    return TEST_RESULT();
+}
@@ -0,0 +1,239 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - TRAVA DE ENERGIA E PARADA DA TASK DE IGNICAO
+ * ============================================================================
+ *
+ * PowerLock contra um esp_pm que conta como o do IDF (cada acquire pede um
+ * release): acquire/release repetidos nao empilham, a trava e criada uma
+ * vez so e uma falha na criacao nao deixa o PowerLock achando que segura.
+ *
+ * IgnicaoService com a task de monitoramento numa thread e o pino
+ * simulado: borda, debounce com a trava "ignicao" segura, confirmacao e
+ * trava solta. stop() acorda a task, espera o aviso em exitSem e so entao
+ * apaga o handle; nenhuma notificacao pode chegar a uma task ja apagada,
+ * nem com start/stop em sequencia rapida ou no meio de um debounce.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "services/ignicao/ignicao_service.h"
+#include "config/app_config.h"
+#include "services/power/power_service.h"
+#include "driver/gpio.h"
+#include "esp_pm.h"
+#include "test_check.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#define DEBOUNCE_S      0.2f
+#define WAIT_MS         2000
+#define RESTART_CYCLES  50
+
+// Tempo maximo de stop(): o timeout dele e IGNICAO_CHECK_INTERVAL * 5
+#define STOP_MAX_MS     (IGNICAO_CHECK_INTERVAL * 5)
+
+// ============================================================================
+// AUXILIARES
+// ============================================================================
+
+static bool wait_for(const std::function<bool()>& cond, uint32_t timeoutMs = WAIT_MS) {
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (std::chrono::steady_clock::now() > end) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static host_pm_lock_info_t lock_info(const char* name) {
+    host_pm_lock_info_t info;
+    host_pm_lock_info(name, &info);
+    return info;
+}
+
+static double stop_ms(IgnicaoService* svc) {
+    auto t0 = std::chrono::steady_clock::now();
+    svc->stop();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static std::atomic<int> g_callbacks;
+static std::atomic<bool> g_lastStatus;
+
+static void on_ignicao(bool on) {
+    g_lastStatus = on;
+    g_callbacks++;
+}
+
+// ============================================================================
+// POWERLOCK
+// ============================================================================
+
+static void test_power_lock() {
+    host_pm_lock_info_t info;
+
+    // Criada so no primeiro acquire; release antes disso nao faz nada
+    PowerLock render("teste_render", true);
+    render.release();
+    CHECK(!host_pm_lock_info("teste_render", &info));
+    CHECK(!render.isHeld());
+
+    // acquire repetido segura uma vez so
+    render.acquire();
+    render.acquire();
+    render.acquire();
+    info = lock_info("teste_render");
+    CHECK(render.isHeld());
+    CHECK(info.creates == 1 && info.type == ESP_PM_CPU_FREQ_MAX);
+    CHECK(info.count == 1 && info.acquires == 1);
+
+    // release repetido solta uma vez so, sem release a mais no IDF
+    render.release();
+    render.release();
+    info = lock_info("teste_render");
+    CHECK(!render.isHeld());
+    CHECK(info.count == 0 && info.releases == 1 && info.underflows == 0);
+
+    // Ciclos reusam a mesma trava
+    for (int i = 0; i < 100; i++) {
+        render.acquire();
+        render.release();
+    }
+    info = lock_info("teste_render");
+    CHECK(info.creates == 1 && info.acquires == 101 && info.releases == 101 && info.count == 0);
+
+    // Sem cpuMax: so impede o light sleep
+    PowerLock debounce("teste_debounce");
+    debounce.acquire();
+    info = lock_info("teste_debounce");
+    CHECK(info.type == ESP_PM_NO_LIGHT_SLEEP && info.count == 1);
+    debounce.release();
+
+    // Falha ao criar: nao segura, e o proximo acquire tenta de novo
+    PowerLock fragil("teste_fragil");
+    host_pm_fail_next_create();
+    fragil.acquire();
+    CHECK(!fragil.isHeld());
+    CHECK(!host_pm_lock_info("teste_fragil", &info));
+    fragil.release();
+    fragil.acquire();
+    info = lock_info("teste_fragil");
+    CHECK(fragil.isHeld());
+    CHECK(info.creates == 1 && info.count == 1 && info.underflows == 0);
+    fragil.release();
+    CHECK(lock_info("teste_fragil").count == 0);
+}
+
+// ============================================================================
+// IGNICAO
+// ============================================================================
+
+static void test_ignicao_debounce(IgnicaoService* svc) {
+    uint32_t stale = host_task_stale_notifies();
+    host_pm_lock_info_t before = lock_info("ignicao");
+
+    svc->start();
+    CHECK(svc->isRunning());
+    CHECK(host_task_alive_count() == 1);
+
+    // Borda: a ISR acorda a task, o debounce segura a trava e confirma
+    host_gpio_set_level(IGNICAO_PIN, 1);
+    CHECK(wait_for([] { return lock_info("ignicao").count == 1; }));
+    CHECK(wait_for([] { return g_callbacks == 1; }));
+    CHECK(svc->getStatus() && g_lastStatus);
+
+    // Confirmado: a trava e solta na volta seguinte e fica solta
+    CHECK(wait_for([] { return lock_info("ignicao").count == 0; }));
+    host_pm_lock_info_t after = lock_info("ignicao");
+    CHECK(after.creates <= 1);
+    CHECK(after.acquires - before.acquires == 1);
+    CHECK(after.underflows == 0);
+
+    // Parada: a task esta ociosa (espera de IGNICAO_IDLE_CHECK_MS) e o
+    // notify de stop() a acorda na hora
+    double ms = stop_ms(svc);
+    printf("ignicao: stop() com a task ociosa em %.2f ms\n", ms);
+    CHECK(ms < STOP_MAX_MS);
+    CHECK(!svc->isRunning());
+    CHECK(wait_for([] { return host_task_alive_count() == 0; }));
+    CHECK(host_task_stale_notifies() == stale);
+    CHECK(lock_info("ignicao").count == 0);
+}
+
+static void test_ignicao_stop_in_debounce(IgnicaoService* svc) {
+    uint32_t stale = host_task_stale_notifies();
+    int callbacks = g_callbacks;
+
+    svc->start();
+
+    // Borda de desligar e stop() no meio do debounce: a task solta a trava
+    // antes de avisar, e o estado nao muda
+    host_gpio_set_level(IGNICAO_PIN, 0);
+    CHECK(wait_for([] { return lock_info("ignicao").count == 1; }));
+    double ms = stop_ms(svc);
+    printf("ignicao: stop() no meio do debounce em %.2f ms\n", ms);
+    CHECK(ms < STOP_MAX_MS);
+    CHECK(lock_info("ignicao").count == 0);
+    CHECK(wait_for([] { return host_task_alive_count() == 0; }));
+    CHECK(host_task_stale_notifies() == stale);
+    CHECK(g_callbacks == callbacks);
+    CHECK(svc->getStatus());
+
+    // De volta ao nivel confirmado para o proximo caso
+    host_gpio_set_level(IGNICAO_PIN, 1);
+}
+
+static void test_ignicao_restart(IgnicaoService* svc) {
+    uint32_t created = host_task_created_count();
+    uint32_t stale = host_task_stale_notifies();
+    double worst = 0;
+
+    // start/stop sem pausa e com pausas curtas, com bordas no meio: cada
+    // stop() libera o handle, entao cada start() cria uma task nova
+    for (int i = 0; i < RESTART_CYCLES; i++) {
+        svc->start();
+        if (i % 3 == 1) std::this_thread::sleep_for(std::chrono::microseconds(200 * (i % 7)));
+        if (i % 5 == 2) host_gpio_set_level(IGNICAO_PIN, i % 2);
+        double ms = stop_ms(svc);
+        if (ms > worst) worst = ms;
+        CHECK(!svc->isRunning());
+    }
+    host_gpio_set_level(IGNICAO_PIN, 1);
+
+    printf("ignicao: %d start/stop, pior stop() em %.2f ms\n", RESTART_CYCLES, worst);
+    CHECK(host_task_created_count() - created == RESTART_CYCLES);
+    CHECK(worst < STOP_MAX_MS);
+    CHECK(wait_for([] { return host_task_alive_count() == 0; }));
+    CHECK(host_task_stale_notifies() == stale);
+    CHECK(lock_info("ignicao").count == 0);
+    CHECK(lock_info("ignicao").underflows == 0);
+
+    // stop() repetido e inofensivo
+    svc->stop();
+    CHECK(host_task_stale_notifies() == stale);
+}
+
+int main() {
+    test_power_lock();
+
+    host_gpio_set_level(IGNICAO_PIN, 0);
+    IgnicaoService* svc = IgnicaoService::getInstance();
+    CHECK(svc->init(DEBOUNCE_S, DEBOUNCE_S));
+    svc->setCallback(on_ignicao);
+
+    test_ignicao_debounce(svc);
+    test_ignicao_stop_in_debounce(svc);
+    test_ignicao_restart(svc);
+
+    // O destrutor para a task (ja parada) e remove o handler do pino
+    IgnicaoService::destroyInstance();
+    CHECK(host_task_alive_count() == 0);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,262 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - CACHE DE IMAGENS AO ALTERNAR TELAS
+ * ============================================================================
+ *
+ * Benchmark do lv_img_cache com a LVGL do firmware (LV_IMG_CACHE_DEF_SIZE,
+ * LV_IMG_CACHE_BUDGET do lv_conf.h). Um decoder falso entrega quadros
+ * RGB565 do tamanho pedido na fonte ("B:/fundo_3_400x300"), alocados com
+ * lv_img_cache_data_alloc como o lv_png. Cada tela tem um fundo grande,
+ * icones proprios, icones comuns (barra de status) e o logo como variavel
+ * (sem memoria no cache, como o logo_splash da AssetStore).
+ *
+ * Alterna as telas varias vezes e mostra acertos, faltas, evicoes, pico de
+ * bytes, o tempo por troca e quantas vezes os icones comuns foram
+ * decodificados (a eviccao por vida da LVGL nao os protege). Confere que o
+ * pico nunca passa do orcamento, que os fundos (que juntos passam do
+ * orcamento) sao evictados e que tudo e fechado no fim.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "lvgl.h"
+#include "button_manager.h"
+#include "esp_timer.h"
+#include "test_check.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+// ============================================================================
+// CENARIO
+// ============================================================================
+
+#define NUM_SCREENS      6
+#define ICONS_PER_SCREEN 6
+#define COMMON_ICONS     2
+#define CYCLES           10
+
+#define BG_W    400
+#define BG_H    300
+#define ICON_W  48
+#define ICON_H  48
+
+static char g_bgSrc[NUM_SCREENS][32];
+static char g_iconSrc[NUM_SCREENS][ICONS_PER_SCREEN][32];
+static char g_commonSrc[COMMON_ICONS][32];
+
+static uint16_t g_logoPx[ICON_W * ICON_H];
+static lv_img_dsc_t g_logo;
+
+// ============================================================================
+// DISPLAY DO HOST
+// ============================================================================
+
+static lv_color_t g_buf[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+static void flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* px) {
+    lv_disp_flush_ready(drv);
+}
+
+static void host_display_init() {
+    static lv_disp_draw_buf_t drawBuf;
+    static lv_disp_drv_t dispDrv;
+
+    lv_init();
+    lv_disp_draw_buf_init(&drawBuf, g_buf, NULL, SCREEN_WIDTH * SCREEN_HEIGHT);
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = SCREEN_WIDTH;
+    dispDrv.ver_res = SCREEN_HEIGHT;
+    dispDrv.flush_cb = flush_cb;
+    dispDrv.draw_buf = &drawBuf;
+    dispDrv.full_refresh = 1;
+    lv_disp_drv_register(&dispDrv);
+}
+
+// ============================================================================
+// DECODER FALSO ("B:/<nome>_<w>x<h>")
+// ============================================================================
+
+static uint32_t g_opens;
+static uint32_t g_closes;
+static uint32_t g_statusOpens;
+
+static bool parse_size(const void* src, uint32_t* w, uint32_t* h) {
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return false;
+    const char* path = (const char*)src;
+    if (strncmp(path, "B:/", 3) != 0) return false;
+
+    const char* dims = strrchr(path, '_');
+    unsigned pw, ph;
+    if (!dims || sscanf(dims + 1, "%ux%u", &pw, &ph) != 2) return false;
+    *w = pw;
+    *h = ph;
+    return true;
+}
+
+static lv_res_t fake_info(lv_img_decoder_t* dec, const void* src, lv_img_header_t* header) {
+    uint32_t w, h;
+    if (!parse_size(src, &w, &h)) return LV_RES_INV;
+    header->always_zero = 0;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    header->w = w;
+    header->h = h;
+    return LV_RES_OK;
+}
+
+static lv_res_t fake_open(lv_img_decoder_t* dec, lv_img_decoder_dsc_t* dsc) {
+    uint32_t w, h;
+    if (!parse_size(dsc->src, &w, &h)) return LV_RES_INV;
+
+    uint32_t size = w * h * sizeof(lv_color_t);
+    uint8_t* frame = (uint8_t*)lv_img_cache_data_alloc(size);
+    if (!frame) return LV_RES_INV;
+    memset(frame, 0x5A, size);
+
+    dsc->img_data = frame;
+    dsc->cache_size = size;
+    g_opens++;
+    if (strncmp((const char*)dsc->src, "B:/status", 9) == 0) g_statusOpens++;
+    return LV_RES_OK;
+}
+
+static void fake_close(lv_img_decoder_t* dec, lv_img_decoder_dsc_t* dsc) {
+    lv_img_cache_data_free((void*)dsc->img_data);
+    dsc->img_data = NULL;
+    g_closes++;
+}
+
+static void fake_decoder_init() {
+    lv_img_decoder_t* dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, fake_info);
+    lv_img_decoder_set_open_cb(dec, fake_open);
+    lv_img_decoder_set_close_cb(dec, fake_close);
+}
+
+// ============================================================================
+// TELAS
+// ============================================================================
+
+static lv_obj_t* build_screen(int s) {
+    lv_obj_t* scr = lv_obj_create(NULL);
+
+    lv_obj_t* bg = lv_img_create(scr);
+    lv_img_set_src(bg, g_bgSrc[s]);
+    lv_obj_set_pos(bg, 0, 0);
+
+    for (int i = 0; i < ICONS_PER_SCREEN; i++) {
+        lv_obj_t* icon = lv_img_create(scr);
+        lv_img_set_src(icon, g_iconSrc[s][i]);
+        lv_obj_set_pos(icon, (lv_coord_t)(i * (ICON_W + 8)), SCREEN_HEIGHT - ICON_H * 2);
+    }
+
+    // Barra de status: os mesmos icones em todas as telas
+    for (int i = 0; i < COMMON_ICONS; i++) {
+        lv_obj_t* icon = lv_img_create(scr);
+        lv_img_set_src(icon, g_commonSrc[i]);
+        lv_obj_set_pos(icon, (lv_coord_t)(SCREEN_WIDTH - (i + 1) * (ICON_W + 8)), 0);
+    }
+
+    lv_obj_t* logo = lv_img_create(scr);
+    lv_img_set_src(logo, &g_logo);
+    lv_obj_align(logo, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    return scr;
+}
+
+static void init_sources() {
+    for (int s = 0; s < NUM_SCREENS; s++) {
+        snprintf(g_bgSrc[s], sizeof(g_bgSrc[s]), "B:/fundo%d_%dx%d", s, BG_W, BG_H);
+        for (int i = 0; i < ICONS_PER_SCREEN; i++) {
+            snprintf(g_iconSrc[s][i], sizeof(g_iconSrc[s][i]), "B:/icone%d.%d_%dx%d",
+                     s, i, ICON_W, ICON_H);
+        }
+    }
+    for (int i = 0; i < COMMON_ICONS; i++) {
+        snprintf(g_commonSrc[i], sizeof(g_commonSrc[i]), "B:/status%d_%dx%d", i, ICON_W, ICON_H);
+    }
+
+    memset(g_logoPx, 0xA5, sizeof(g_logoPx));
+    g_logo.header.always_zero = 0;
+    g_logo.header.cf = LV_IMG_CF_TRUE_COLOR;
+    g_logo.header.w = ICON_W;
+    g_logo.header.h = ICON_H;
+    g_logo.data_size = sizeof(g_logoPx);
+    g_logo.data = (const uint8_t*)g_logoPx;
+}
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+static void test_screen_cycle() {
+    host_display_init();
+    fake_decoder_init();
+    init_sources();
+
+    // Os fundos sozinhos passam do orcamento: precisa haver eviccao por bytes
+    static_assert((uint64_t)NUM_SCREENS * BG_W * BG_H * sizeof(lv_color_t) > LV_IMG_CACHE_BUDGET,
+                  "cenario nao exercita o orcamento");
+
+    lv_obj_t* screens[NUM_SCREENS];
+    for (int s = 0; s < NUM_SCREENS; s++) screens[s] = build_screen(s);
+
+    lv_img_cache_stats_t start;
+    lv_img_cache_get_stats(&start);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int c = 0; c < CYCLES; c++) {
+        for (int s = 0; s < NUM_SCREENS; s++) {
+            lv_scr_load(screens[s]);
+            host_timer_advance_ms(LV_DISP_DEF_REFR_PERIOD);
+            lv_refr_now(NULL);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    lv_img_cache_stats_t st;
+    lv_img_cache_get_stats(&st);
+    uint32_t hits = st.hits - start.hits;
+    uint32_t misses = st.misses - start.misses;
+    uint32_t evictions = st.evictions - start.evictions;
+    double usPerSwitch = std::chrono::duration<double, std::micro>(t1 - t0).count() /
+                         (CYCLES * NUM_SCREENS);
+
+    printf("img_cache: %d telas x %d ciclos, %u entradas, orcamento %u B\n",
+           NUM_SCREENS, CYCLES, (unsigned)LV_IMG_CACHE_DEF_SIZE, (unsigned)LV_IMG_CACHE_BUDGET);
+    printf("img_cache: acertos %u (%u%%), faltas %u, evicoes %u, decodificacoes %u\n",
+           (unsigned)hits, (unsigned)(hits + misses ? hits * 100 / (hits + misses) : 0),
+           (unsigned)misses, (unsigned)evictions, (unsigned)g_opens);
+    printf("img_cache: abertas %u, %u B (pico %u B), %.0f us por troca de tela\n",
+           (unsigned)st.entries, (unsigned)st.bytes, (unsigned)st.bytes_peak, usPerSwitch);
+    printf("img_cache: icones comuns decodificados %u vezes (%d presentes em toda tela)\n",
+           (unsigned)g_statusOpens, COMMON_ICONS);
+
+    CHECK(st.bytes_peak <= LV_IMG_CACHE_BUDGET);
+    CHECK(st.entries <= LV_IMG_CACHE_DEF_SIZE);
+    CHECK(evictions > 0);
+    CHECK(hits > 0);
+
+    // Entradas abertas = quadros do decoder falso (+ o logo, sem bytes)
+    uint32_t fakeOpen = g_opens - g_closes;
+    CHECK(st.entries == fakeOpen || st.entries == fakeOpen + 1);
+
+    // Fim: telas apagadas e cache invalidado, nada aberto
+    for (int s = 0; s < NUM_SCREENS; s++) {
+        if (screens[s] != lv_scr_act()) lv_obj_del(screens[s]);
+    }
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_get_stats(&st);
+    CHECK(st.entries == 0);
+    CHECK(st.bytes == 0);
+    CHECK(g_opens == g_closes);
+}
+
+int main() {
+    test_screen_cycle();
+    return TEST_RESULT();
+}
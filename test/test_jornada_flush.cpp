@@ -0,0 +1,275 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - ESCRITAS NA FLASH DOS TOTAIS DE JORNADA
+ * ============================================================================
+ *
+ * Benchmark de commits na NVS do JornadaService/JornadaStore. O loop
+ * principal do firmware chama flushIfDue() a cada segundo; aqui o relogio
+ * do host anda 1 s por volta e a NVS em memoria conta set_blob e commit.
+ *
+ * Um turno simulado (patio parado, turno de 8 h com todos os motoristas em
+ * jornada, ignicao desligada, rajada de manobras) tem de gravar exatamente o
+ * numero de commits que as regras de JORNADA_FLUSH_INTERVAL_MS e
+ * JORNADA_FLUSH_THRESHOLD dao, contra uma escrita por mudanca sem o
+ * espelho. Depois, um reset a quente (relogio de volta a zero, espelho RTC
+ * preservado) com mudancas nao gravadas tem de chegar a flash na primeira
+ * chamada de flushIfDue(), sem escrever durante o init().
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "services/jornada/jornada_service.h"
+#include "esp_timer.h"
+#include "nvs_flash.h"
+#include "test_check.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define NUM_DRIVERS     MAX_MOTORISTAS
+#define TICK_MS         1000
+#define SHIFT_S         (8 * 3600)
+#define SWITCH_EVERY_S  (15 * 60)
+
+static const int INTERVAL_S = JORNADA_FLUSH_INTERVAL_MS / 1000;
+
+// ============================================================================
+// LOOP PRINCIPAL SIMULADO
+// ============================================================================
+
+static JornadaService* g_svc;
+
+// Maior intervalo entre commits com estado em curso
+static uint32_t g_lastCommitMs;
+static uint32_t g_maxGapMs;
+
+static void tick(bool trackGap = false) {
+    uint32_t before = host_nvs_commit_count();
+    host_timer_advance_ms(TICK_MS);
+    g_svc->flushIfDue();
+
+    if (host_nvs_commit_count() != before) {
+        uint32_t now = (uint32_t)(esp_timer_get_time() / 1000);
+        if (trackGap && now - g_lastCommitMs > g_maxGapMs) g_maxGapMs = now - g_lastCommitMs;
+        g_lastCommitMs = now;
+    }
+}
+
+static void run_seconds(int s, bool trackGap = false) {
+    for (int i = 0; i < s; i++) tick(trackGap);
+}
+
+// Chamadas que mudam motorista ou estado: sem o espelho, cada uma seria
+// uma escrita na flash
+static uint32_t g_calls;
+
+static void add(int id) {
+    char nome[16];
+    snprintf(nome, sizeof(nome), "Motorista %d", id);
+    CHECK(g_svc->addMotorista(id, nome));
+    g_calls++;
+}
+
+static void change(int id, EstadoJornada e) {
+    CHECK(g_svc->iniciarEstado(id, e));
+    g_calls++;
+}
+
+static void stop(int id) {
+    CHECK(g_svc->finalizarEstado(id));
+    g_calls++;
+}
+
+struct PhaseCount {
+    uint32_t commits;
+    uint32_t calls;
+};
+
+static PhaseCount g_mark;
+static PhaseCount g_total;
+
+static void mark() {
+    g_mark.commits = host_nvs_commit_count();
+    g_mark.calls = g_calls;
+}
+
+static PhaseCount since_mark(const char* phase) {
+    PhaseCount d;
+    d.commits = host_nvs_commit_count() - g_mark.commits;
+    d.calls = g_calls - g_mark.calls;
+    printf("%-22s %3u commits (uma escrita por mudanca: %3u)\n", phase,
+           (unsigned)d.commits, (unsigned)d.calls);
+    g_total.commits += d.commits;
+    g_total.calls += d.calls;
+    return d;
+}
+
+// ============================================================================
+// TURNO
+// ============================================================================
+
+static void test_shift() {
+    nvs_flash_erase_partition(NVS_PARTITION_LABEL);
+    host_timer_reset();
+
+    g_svc = JornadaService::getInstance();
+    g_svc->init();
+    CHECK(g_svc->getPersistStats().restoredFrom == JornadaRestoreSource::NONE);
+    CHECK(host_nvs_commit_count() == 0);
+
+    PhaseCount d;
+
+    // Patio parado (1 h): cadastro em t=0, nada em curso. So o intervalo
+    // do dado sujo vence, uma vez
+    mark();
+    for (int id = 1; id <= NUM_DRIVERS; id++) add(id);
+    run_seconds(3600);
+    d = since_mark("patio parado (1 h)");
+    CHECK(d.commits == 1);
+
+    // Turno de 8 h: todos em jornada e um motorista troca de estado a cada
+    // 15 min (menos que o limiar entre dois flushes). Com estado em curso o
+    // total cresce sozinho: flush a cada intervalo desde o ultimo, o
+    // primeiro ja no primeiro tick (o ultimo flush foi ha 50 min)
+    mark();
+    for (int id = 1; id <= NUM_DRIVERS; id++) change(id, EstadoJornada::JORNADA);
+
+    static const EstadoJornada PAUSAS[] = {
+        EstadoJornada::MANOBRA, EstadoJornada::ESPERA,
+        EstadoJornada::DESCARGA, EstadoJornada::REFEICAO,
+    };
+    g_lastCommitMs = (uint32_t)(esp_timer_get_time() / 1000);
+    g_maxGapMs = 0;
+    for (int s = 1; s <= SHIFT_S; s++) {
+        tick(true);
+        if (s % SWITCH_EVERY_S == SWITCH_EVERY_S / 2) {
+            int n = s / SWITCH_EVERY_S;
+            int id = 1 + n % NUM_DRIVERS;
+            EstadoJornada e = (n / NUM_DRIVERS) % 2 ? EstadoJornada::JORNADA
+                                                    : PAUSAS[(n / (2 * NUM_DRIVERS)) % 4];
+            change(id, e);
+        }
+    }
+    d = since_mark("turno (8 h)");
+    CHECK(d.commits == (uint32_t)(SHIFT_S / INTERVAL_S));
+    CHECK(g_maxGapMs <= JORNADA_FLUSH_INTERVAL_MS + TICK_MS);
+    printf("%-22s %3u ms entre commits no maximo\n", "", (unsigned)g_maxGapMs);
+
+    // Ignicao desligada: todos param e o flush e forcado; o segundo flush
+    // nao tem nada novo e nao escreve
+    mark();
+    for (int id = 1; id <= NUM_DRIVERS; id++) stop(id);
+    CHECK(g_svc->flush());
+    CHECK(g_svc->flush());
+    d = since_mark("ignicao desligada");
+    CHECK(d.commits == 1);
+
+    // Rajada de manobras de 2 em 2 s logo depois do flush. O limiar agrega:
+    // um commit no tick seguinte a mudanca que o atinge; as que sobram so
+    // vencem pelo intervalo, ja com todos parados
+    mark();
+    change(1, EstadoJornada::MANOBRA);     // Sai do inativo: total nao muda
+    run_seconds(2);
+
+    uint32_t before = host_nvs_commit_count();
+    int burst = JORNADA_FLUSH_THRESHOLD + JORNADA_FLUSH_THRESHOLD / 2;
+    int firstCommitAt = -1;
+    for (int i = 0; i < burst; i++) {
+        change(1, i % 2 ? EstadoJornada::MANOBRA : EstadoJornada::ESPERA);
+        run_seconds(2);
+        if (firstCommitAt < 0 && host_nvs_commit_count() != before) firstCommitAt = i;
+    }
+    CHECK(firstCommitAt == JORNADA_FLUSH_THRESHOLD - 1);
+    CHECK(host_nvs_commit_count() - before == 1);
+    stop(1);
+    run_seconds(INTERVAL_S);
+    d = since_mark("rajada + intervalo");
+    CHECK(d.commits == 2);
+
+    printf("%-22s %3u commits (uma escrita por mudanca: %3u)\n", "total",
+           (unsigned)g_total.commits, (unsigned)g_total.calls);
+
+    // Toda escrita passa pelo flush: um set_blob por commit
+    JornadaPersistStats st = g_svc->getPersistStats();
+    CHECK(st.flushes == host_nvs_commit_count());
+    CHECK(host_nvs_set_count() == host_nvs_commit_count());
+    CHECK(st.changes <= g_calls);
+    CHECK(st.errors == 0);
+}
+
+// ============================================================================
+// RESET A QUENTE
+// ============================================================================
+
+static bool read_stored(JornadaPersistImage* img) {
+    nvs_handle_t h;
+    size_t len = sizeof(*img);
+    return nvs_open_from_partition(NVS_PARTITION_LABEL, NVS_NS_JORNADA, NVS_READWRITE, &h) == ESP_OK &&
+           nvs_get_blob(h, NVS_KEY_JORNADA_TOTAIS, img, &len) == ESP_OK && len == sizeof(*img);
+}
+
+static void warm_reset() {
+    JornadaService::destroyInstance();
+    host_timer_reset();
+    g_svc = JornadaService::getInstance();
+    g_svc->init();
+}
+
+static void test_warm_reset() {
+    // Mudancas abaixo do limiar e do intervalo: so o espelho RTC as tem
+    uint32_t flushed = host_nvs_commit_count();
+    change(3, EstadoJornada::DESCARGA);
+    run_seconds(90);
+    change(3, EstadoJornada::MANOBRA);
+    run_seconds(30);
+    stop(3);
+    run_seconds(5);
+    CHECK(host_nvs_commit_count() == flushed);
+
+    DadosMotorista expected[NUM_DRIVERS];
+    for (int id = 1; id <= NUM_DRIVERS; id++) {
+        CHECK(g_svc->getMotorista(id, &expected[id - 1]));
+    }
+
+    JornadaPersistImage stored;
+    CHECK(read_stored(&stored));
+    CHECK(stored.slots[2].totais[4] != expected[2].tempoTotalDescarga);
+
+    // Reset: o init restaura do RTC e nao escreve na flash
+    warm_reset();
+    CHECK(g_svc->getPersistStats().restoredFrom == JornadaRestoreSource::RTC);
+    CHECK(host_nvs_commit_count() == flushed);
+    for (int id = 1; id <= NUM_DRIVERS; id++) {
+        DadosMotorista m;
+        CHECK(g_svc->getMotorista(id, &m));
+        CHECK(m.tempoTotalJornada == expected[id - 1].tempoTotalJornada);
+        CHECK(m.tempoTotalManobra == expected[id - 1].tempoTotalManobra);
+        CHECK(m.tempoTotalDescarga == expected[id - 1].tempoTotalDescarga);
+    }
+
+    // Primeira chamada do loop principal grava o que so estava no RTC
+    tick();
+    printf("%-22s %3u commits no primeiro tick apos o reset\n", "reset a quente",
+           (unsigned)(host_nvs_commit_count() - flushed));
+    CHECK(host_nvs_commit_count() == flushed + 1);
+    CHECK(read_stored(&stored));
+    CHECK(stored.slots[2].totais[4] == expected[2].tempoTotalDescarga);
+    CHECK(stored.slots[2].totais[1] == expected[2].tempoTotalManobra);
+
+    // Reset com o espelho igual a flash: nada a gravar
+    warm_reset();
+    CHECK(g_svc->getPersistStats().restoredFrom == JornadaRestoreSource::RTC);
+    run_seconds(INTERVAL_S + 1);
+    CHECK(host_nvs_commit_count() == flushed + 1);
+
+    JornadaService::destroyInstance();
+}
+
+int main() {
+    test_shift();
+    test_warm_reset();
+    return TEST_RESULT();
+}
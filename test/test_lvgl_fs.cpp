@@ -0,0 +1,319 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - DRIVER DE FILESYSTEM DA LVGL
+ * ============================================================================
+ *
+ * src/lvgl_fs_driver.cpp sobre um diretorio POSIX temporario no build
+ * (FS_BASE_PATH), pela API lv_fs_* e pelo decoder de imagem da LVGL:
+ *
+ *  - info + open de uma imagem .bin abrem o arquivo uma vez so (o segundo
+ *    open sai do cache de handles) e as linhas lidas conferem byte a byte
+ *  - leituras picadas, seek e tell atravessando o bloco de read-ahead
+ *  - abrir para escrita descarta o handle em cache: a leitura seguinte ve
+ *    o conteudo e o tamanho novos
+ *  - LRU com mais arquivos que FS_DRV_HANDLE_CACHE e handle avulso com
+ *    todos os slots em uso
+ *  - dir_read: diretorios com "/" na frente, sem "." e "..", fim vazio
+ *  - lvgl_fs_flush_cache fecha tudo: nenhum fd aberto sobra
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "lvgl_fs_driver.h"
+#include "test_check.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <set>
+#include <string>
+#include <vector>
+
+#define IMG_W   64
+#define IMG_H   40
+
+// ============================================================================
+// ARQUIVOS DE TESTE
+// ============================================================================
+
+static std::string base_path(const char* rel) {
+    return std::string(FS_BASE_PATH) + rel;
+}
+
+static void write_file(const char* rel, const std::vector<uint8_t>& data) {
+    int fd = open(base_path(rel).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    CHECK(fd >= 0);
+    CHECK(write(fd, data.data(), data.size()) == (ssize_t)data.size());
+    close(fd);
+}
+
+static std::vector<uint8_t> pattern(size_t size, uint8_t seed) {
+    std::vector<uint8_t> v(size);
+    for (size_t i = 0; i < size; i++) v[i] = (uint8_t)(i * 31 + seed + (i >> 8));
+    return v;
+}
+
+static void remove_tree(const std::string& path) {
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return;
+    while (struct dirent* e = readdir(dir)) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        std::string child = path + "/" + e->d_name;
+        if (e->d_type == DT_DIR) {
+            remove_tree(child);
+        } else {
+            unlink(child.c_str());
+        }
+    }
+    closedir(dir);
+    rmdir(path.c_str());
+}
+
+static int open_fd_count() {
+    int n = 0;
+    DIR* dir = opendir("/proc/self/fd");
+    if (!dir) return -1;
+    while (readdir(dir)) n++;
+    closedir(dir);
+    return n;
+}
+
+// Imagem .bin da LVGL: cabecalho + RGB565
+static std::vector<uint8_t> g_img;
+
+static void make_files() {
+    remove_tree(FS_BASE_PATH);
+    mkdir(FS_BASE_PATH, 0755);
+    mkdir(base_path("/sub").c_str(), 0755);
+    mkdir(base_path("/vazio").c_str(), 0755);
+
+    lv_img_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.cf = LV_IMG_CF_TRUE_COLOR;
+    header.w = IMG_W;
+    header.h = IMG_H;
+
+    std::vector<uint8_t> px = pattern(IMG_W * IMG_H * sizeof(lv_color_t), 7);
+    g_img.assign((uint8_t*)&header, (uint8_t*)&header + sizeof(header));
+    g_img.insert(g_img.end(), px.begin(), px.end());
+
+    write_file("/logo.bin", g_img);
+    write_file("/dados.txt", pattern(10000, 3));
+    write_file("/a.txt", pattern(100, 1));
+    write_file("/b.txt", pattern(100, 2));
+    write_file("/c.txt", pattern(100, 3));
+    write_file("/d.txt", pattern(100, 4));
+    write_file("/sub/interno.txt", pattern(10, 5));
+}
+
+static lvgl_fs_stats_t stats() {
+    lvgl_fs_stats_t s;
+    lvgl_fs_get_stats(&s);
+    return s;
+}
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+static void test_decoder_info_open() {
+    lvgl_fs_stats_t s0 = stats();
+
+    // Como o lv_img: info (abre, le o cabecalho, fecha) e depois open
+    lv_img_header_t header;
+    CHECK(lv_img_decoder_get_info("A:/logo.bin", &header) == LV_RES_OK);
+    CHECK(header.w == IMG_W && header.h == IMG_H && header.cf == LV_IMG_CF_TRUE_COLOR);
+
+    lv_img_decoder_dsc_t dsc;
+    CHECK(lv_img_decoder_open(&dsc, "A:/logo.bin", lv_color_black(), 0) == LV_RES_OK);
+
+    // Linhas pelo read_line do decoder (seek + leitura por linha)
+    size_t stride = IMG_W * sizeof(lv_color_t);
+    std::vector<uint8_t> line(stride);
+    int bad = 0;
+    for (int y = 0; y < IMG_H; y++) {
+        if (lv_img_decoder_read_line(&dsc, 0, (lv_coord_t)y, IMG_W, line.data()) != LV_RES_OK ||
+            memcmp(line.data(), &g_img[sizeof(lv_img_header_t) + y * stride], stride) != 0) {
+            bad++;
+        }
+    }
+    CHECK(bad == 0);
+    lv_img_decoder_close(&dsc);
+
+    lvgl_fs_stats_t s = stats();
+    printf("lvgl_fs: info+open+%d linhas: %u open, %u fstat, %u read, %u lseek, %u acertos de handle, %u de bloco\n",
+           IMG_H, (unsigned)(s.opens - s0.opens), (unsigned)(s.stats - s0.stats),
+           (unsigned)(s.reads - s0.reads), (unsigned)(s.seeks - s0.seeks),
+           (unsigned)(s.handleHits - s0.handleHits), (unsigned)(s.bufferHits - s0.bufferHits));
+    CHECK(s.opens - s0.opens == 1);
+    CHECK(s.stats - s0.stats == 1);
+    // lv_img_decoder_open repete o info antes do open_cb: tres lv_fs_open,
+    // um open de verdade e dois acertos de handle
+    CHECK(s.handleHits - s0.handleHits == 2);
+    CHECK(s.closes == s0.closes);
+
+    // Arquivo de 5 KB: duas leituras de bloco, o resto sai do read-ahead
+    CHECK(s.reads - s0.reads <= 3);
+}
+
+static void test_read_seek() {
+    std::vector<uint8_t> ref = pattern(10000, 3);
+    lv_fs_file_t f;
+    CHECK(lv_fs_open(&f, "A:/dados.txt", LV_FS_MODE_RD) == LV_FS_RES_OK);
+
+    // Pedacos de tamanhos variados, um deles maior que o bloco
+    static const uint32_t CHUNKS[] = {7, 100, 4089, 3, 5000, 1, 2000};
+    std::vector<uint8_t> got;
+    uint32_t br;
+    for (uint32_t n : CHUNKS) {
+        std::vector<uint8_t> buf(n);
+        CHECK(lv_fs_read(&f, buf.data(), n, &br) == LV_FS_RES_OK);
+        got.insert(got.end(), buf.begin(), buf.begin() + br);
+    }
+    CHECK(got.size() == ref.size());
+    CHECK(got == ref);
+
+    // Fim, volta relativa e posicao
+    uint32_t pos;
+    CHECK(lv_fs_seek(&f, 0, LV_FS_SEEK_END) == LV_FS_RES_OK);
+    CHECK(lv_fs_tell(&f, &pos) == LV_FS_RES_OK && pos == ref.size());
+    CHECK(lv_fs_seek(&f, (uint32_t)-10, LV_FS_SEEK_CUR) == LV_FS_RES_OK);
+    uint8_t tail[16];
+    CHECK(lv_fs_read(&f, tail, sizeof(tail), &br) == LV_FS_RES_OK);
+    CHECK(br == 10 && memcmp(tail, &ref[ref.size() - 10], 10) == 0);
+
+    CHECK(lv_fs_seek(&f, 4095, LV_FS_SEEK_SET) == LV_FS_RES_OK);
+    CHECK(lv_fs_read(&f, tail, 2, &br) == LV_FS_RES_OK);
+    CHECK(br == 2 && tail[0] == ref[4095] && tail[1] == ref[4096]);
+
+    // Leitura nao escreve
+    CHECK(lv_fs_write(&f, tail, 1, &br) == LV_FS_RES_DENIED);
+    lv_fs_close(&f);
+}
+
+static void test_write_invalidates() {
+    std::vector<uint8_t> old = pattern(100, 1);
+    std::vector<uint8_t> fresh = pattern(300, 9);
+    uint8_t buf[400];
+    uint32_t br;
+    lv_fs_file_t f;
+
+    // Em cache, com o bloco cheio do conteudo antigo
+    CHECK(lv_fs_open(&f, "A:/a.txt", LV_FS_MODE_RD) == LV_FS_RES_OK);
+    CHECK(lv_fs_read(&f, buf, 10, &br) == LV_FS_RES_OK && memcmp(buf, old.data(), 10) == 0);
+    lv_fs_close(&f);
+
+    lvgl_fs_stats_t s0 = stats();
+    CHECK(lv_fs_open(&f, "A:/a.txt", LV_FS_MODE_WR) == LV_FS_RES_OK);
+    CHECK(stats().closes - s0.closes == 1);      // Handle em cache descartado
+    CHECK(lv_fs_write(&f, fresh.data(), fresh.size(), &br) == LV_FS_RES_OK && br == fresh.size());
+    lv_fs_close(&f);
+    CHECK(stats().closes - s0.closes == 2);      // Escrita nao fica em cache
+
+    // Proxima leitura abre de novo e ve o conteudo e o tamanho novos
+    CHECK(lv_fs_open(&f, "A:/a.txt", LV_FS_MODE_RD) == LV_FS_RES_OK);
+    lvgl_fs_stats_t s = stats();
+    CHECK(s.opens - s0.opens == 2);
+    CHECK(s.handleHits == s0.handleHits);
+    CHECK(lv_fs_read(&f, buf, sizeof(buf), &br) == LV_FS_RES_OK);
+    CHECK(br == fresh.size() && memcmp(buf, fresh.data(), br) == 0);
+    uint32_t pos;
+    CHECK(lv_fs_seek(&f, 0, LV_FS_SEEK_END) == LV_FS_RES_OK);
+    CHECK(lv_fs_tell(&f, &pos) == LV_FS_RES_OK && pos == fresh.size());
+    lv_fs_close(&f);
+}
+
+static void test_lru_and_overflow() {
+    lv_fs_file_t f;
+    static const char* FILES[] = {"A:/b.txt", "A:/c.txt", "A:/d.txt", "A:/sub/interno.txt"};
+    static_assert(sizeof(FILES) / sizeof(FILES[0]) > FS_DRV_HANDLE_CACHE, "precisa passar do cache");
+
+    lvgl_fs_flush_cache();
+    lvgl_fs_stats_t s0 = stats();
+
+    // Um a mais que o cache: o menos usado (b) e fechado
+    for (const char* path : FILES) {
+        CHECK(lv_fs_open(&f, path, LV_FS_MODE_RD) == LV_FS_RES_OK);
+        lv_fs_close(&f);
+    }
+    lvgl_fs_stats_t s = stats();
+    CHECK(s.opens - s0.opens == 4);
+    CHECK(s.closes - s0.closes == 1);
+
+    CHECK(lv_fs_open(&f, "A:/d.txt", LV_FS_MODE_RD) == LV_FS_RES_OK);
+    lv_fs_close(&f);
+    CHECK(stats().handleHits - s0.handleHits == 1);
+    CHECK(lv_fs_open(&f, "A:/b.txt", LV_FS_MODE_RD) == LV_FS_RES_OK);
+    lv_fs_close(&f);
+    CHECK(stats().handleHits - s0.handleHits == 1);
+
+    // Todos os slots em uso: o quarto vem avulso e fecha de verdade
+    lv_fs_file_t open[FS_DRV_HANDLE_CACHE + 1];
+    for (int i = 0; i <= FS_DRV_HANDLE_CACHE; i++) {
+        CHECK(lv_fs_open(&open[i], FILES[i], LV_FS_MODE_RD) == LV_FS_RES_OK);
+    }
+    uint32_t closes = stats().closes;
+    lv_fs_close(&open[FS_DRV_HANDLE_CACHE]);
+    CHECK(stats().closes - closes == 1);
+    for (int i = 0; i < FS_DRV_HANDLE_CACHE; i++) lv_fs_close(&open[i]);
+    CHECK(stats().closes - closes == 1);
+}
+
+static std::set<std::string> list_dir(const char* path) {
+    std::set<std::string> names;
+    lv_fs_dir_t dir;
+    CHECK(lv_fs_dir_open(&dir, path) == LV_FS_RES_OK);
+    char fn[LV_FS_MAX_FN_LENGTH];
+    for (int i = 0; i < 32; i++) {
+        CHECK(lv_fs_dir_read(&dir, fn) == LV_FS_RES_OK);
+        if (fn[0] == '\0') break;
+        names.insert(fn);
+    }
+    lv_fs_dir_close(&dir);
+    return names;
+}
+
+static void test_dir_read() {
+    std::set<std::string> root = list_dir("A:/");
+    std::set<std::string> expected = {
+        "/sub", "/vazio", "logo.bin", "dados.txt", "a.txt", "b.txt", "c.txt", "d.txt",
+    };
+    CHECK(root == expected);
+
+    CHECK((list_dir("A:/sub") == std::set<std::string>{"interno.txt"}));
+    CHECK(list_dir("A:/vazio").empty());
+
+    lv_fs_dir_t dir;
+    CHECK(lv_fs_dir_open(&dir, "A:/nao_existe") != LV_FS_RES_OK);
+}
+
+int main() {
+    lv_init();
+    make_files();
+
+    int fdsBefore = open_fd_count();
+    lvgl_fs_init('A');
+
+    test_decoder_info_open();
+    test_read_seek();
+    test_write_invalidates();
+    test_lru_and_overflow();
+    test_dir_read();
+
+    // Cache esvaziado: todo open do VFS teve o seu close
+    lvgl_fs_flush_cache();
+    lvgl_fs_stats_t s = stats();
+    printf("lvgl_fs: total %u open, %u close, %u acertos de handle\n",
+           (unsigned)s.opens, (unsigned)s.closes, (unsigned)s.handleHits);
+    CHECK(s.opens == s.closes);
+    CHECK(open_fd_count() == fdsBefore);
+
+    remove_tree(FS_BASE_PATH);
+    return TEST_RESULT();
+}
@@ -0,0 +1,336 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - REPLAY DE TRACE DO HEAP DA LVGL
+ * ============================================================================
+ *
+ * Le um trace de alocacoes da LVGL (linhas LVMEM de lvgl_mem_trace_dump,
+ * texto ou .gz, log inteiro aceito) e repete as operacoes contra o
+ * lvgl_mem (pool TLSF de LV_MEM_TLSF_POOL_SIZE e transbordo no heap_caps).
+ * Os enderecos do trace so identificam os blocos; cada bloco e preenchido
+ * com um padrao, conferido no free e no realloc.
+ *
+ * O trace de test/data foi capturado do test_screen_cycle (NumpadScreen e
+ * JornadaScreen com transicao, SUSPEND e DESTROY) com -DLVGL_MEM_CAPTURE=ON:
+ *
+ *   test_screen_cycle | grep '^LVMEM' | gzip -9n > data/lvgl_mem_screen_cycle.trace.gz
+ *
+ * Passadas:
+ *  - tempo por operacao, contra o malloc do sistema (so informativo; sem
+ *    -DCMAKE_BUILD_TYPE=Release o lv_tlsf roda sem otimizacao)
+ *  - pool inteiro: nenhuma falha, nada grande nem transbordado, pico
+ *    abaixo do pool e fragmentacao ate FRAG_MAX_PCT com o pool ao menos
+ *    1/4 cheio
+ *  - pool reduzido por lastro a metade do pico: o que nao cabe vai para o
+ *    heap_caps (PSRAM) sem falhas; um realloc leva um bloco para fora do
+ *    pool e de volta; tudo volta a zero no fim
+ *
+ *   test_lvgl_mem_replay <trace>
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "lvgl_mem.h"
+#include "lvgl.h"
+#include "test_check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+#define TIMING_ROUNDS   5
+#define FRAG_MAX_PCT    50
+
+// ============================================================================
+// TRACE
+// ============================================================================
+
+// Enderecos do trace trocados por indices densos na carga: o replay nao
+// procura nada em mapa no laco medido
+struct TraceOp {
+    char op;                    // 'a', 'f', 'r'
+    uint32_t slot;
+    uint32_t size;
+};
+
+struct Trace {
+    std::vector<TraceOp> ops;
+    uint32_t slots;
+};
+
+static bool load_trace(const char* path, Trace* trace) {
+    gzFile f = gzopen(path, "rb");
+    if (!f) return false;
+
+    std::unordered_map<unsigned long long, uint32_t> live;
+    uint32_t unknown = 0;
+    trace->slots = 0;
+
+    char line[160];
+    while (gzgets(f, line, sizeof(line))) {
+        const char* p = strstr(line, "LVMEM ");
+        if (!p) continue;
+
+        TraceOp t = {};
+        unsigned long long a = 0, b = 0;
+        unsigned size = 0;
+        t.op = p[6];
+        if (t.op == 'a' && sscanf(p + 8, "%llx %u", &a, &size) == 2) {
+            if (!a) continue;       // Falhou no aparelho
+            t.slot = trace->slots++;
+            live[a] = t.slot;
+        } else if ((t.op == 'f' && sscanf(p + 8, "%llx", &a) == 1) ||
+                   (t.op == 'r' && sscanf(p + 8, "%llx %llx %u", &a, &b, &size) == 3)) {
+            auto it = live.find(a);
+            if (it == live.end()) {
+                unknown++;
+                continue;
+            }
+            t.slot = it->second;
+            live.erase(it);
+            if (t.op == 'r') live[b] = t.slot;
+        } else {
+            fprintf(stderr, "linha invalida: %s", line);
+            gzclose(f);
+            return false;
+        }
+        t.size = size;
+        trace->ops.push_back(t);
+    }
+    gzclose(f);
+
+    // O trace comeca no lv_init: todo free/realloc tem o seu alloc
+    if (unknown) fprintf(stderr, "%u free/realloc de blocos que o trace nao alocou\n", unknown);
+    return unknown == 0;
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+struct Allocator {
+    void* (*alloc)(size_t);
+    void (*free)(void*);
+    void* (*realloc)(void*, size_t);
+};
+
+static const Allocator LVGL_MEM = {lvgl_mem_alloc, lvgl_mem_free, lvgl_mem_realloc};
+static const Allocator LIBC = {malloc, free, realloc};
+
+struct Block {
+    void* p;
+    uint32_t size;
+    uint8_t fill;
+};
+
+struct ReplayResult {
+    uint32_t nullReturns;       // alloc/realloc que voltaram NULL
+    uint32_t corrupt;           // padrao alterado entre operacoes
+    uint32_t peakUsed;          // Maior poolUsed (so com stats)
+    uint8_t worstFrag;          // Pior fragmentacao com o pool >= 1/4 (so com stats)
+    double ns;
+};
+
+static bool check_fill(const void* p, uint32_t len, uint8_t fill) {
+    const uint8_t* b = (const uint8_t*)p;
+    for (uint32_t i = 0; i < len; i++) {
+        if (b[i] != fill) return false;
+    }
+    return true;
+}
+
+/**
+ * Repete o trace. Os blocos que o trace deixa alocados ficam em live (as
+ * telas ainda existem no fim da captura). Com stats, consulta o
+ * lvgl_mem_get_stats depois de cada operacao e confere os padroes.
+ */
+static ReplayResult replay(const Trace& trace, const Allocator& m, std::vector<Block>* live, bool stats) {
+    ReplayResult r = {};
+    uint8_t fill = 0;
+    live->assign(trace.slots, Block{NULL, 0, 0});
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (const TraceOp& t : trace.ops) {
+        Block& b = (*live)[t.slot];
+        if (t.op == 'a') {
+            b.p = m.alloc(t.size);
+            if (!b.p) {
+                r.nullReturns++;
+                continue;
+            }
+            b.size = t.size;
+            b.fill = ++fill;
+            if (stats) memset(b.p, b.fill, b.size);
+        } else if (!b.p) {
+            continue;               // Alloc anterior falhou (ja contado)
+        } else if (t.op == 'f') {
+            if (stats && !check_fill(b.p, b.size, b.fill)) r.corrupt++;
+            m.free(b.p);
+            b.p = NULL;
+        } else {
+            void* p = m.realloc(b.p, t.size);
+            if (!p) {
+                r.nullReturns++;
+                continue;
+            }
+            if (stats) {
+                if (!check_fill(p, b.size < t.size ? b.size : t.size, b.fill)) r.corrupt++;
+                b.fill = ++fill;
+                memset(p, b.fill, t.size);
+            }
+            b.p = p;
+            b.size = t.size;
+        }
+
+        if (stats) {
+            lvgl_mem_stats_t s;
+            lvgl_mem_get_stats(&s);
+            if (s.poolUsed > r.peakUsed) r.peakUsed = s.poolUsed;
+            if (s.poolUsed >= s.poolSize / 4 && s.poolFragPct > r.worstFrag) r.worstFrag = s.poolFragPct;
+        }
+    }
+
+    r.ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    return r;
+}
+
+static uint32_t free_all(const Allocator& m, std::vector<Block>* live) {
+    uint32_t n = 0;
+    for (Block& b : *live) {
+        if (!b.p) continue;
+        m.free(b.p);
+        b.p = NULL;
+        n++;
+    }
+    return n;
+}
+
+static lvgl_mem_stats_t mem_stats() {
+    lvgl_mem_stats_t s;
+    lvgl_mem_get_stats(&s);
+    return s;
+}
+
+// ============================================================================
+// PASSADAS
+// ============================================================================
+
+static void test_timing(const Trace& trace) {
+    std::vector<Block> live;
+    double best[2] = {0, 0};
+    const Allocator* allocs[2] = {&LVGL_MEM, &LIBC};
+
+    for (int round = 0; round < TIMING_ROUNDS; round++) {
+        for (int i = 0; i < 2; i++) {
+            ReplayResult r = replay(trace, *allocs[i], &live, false);
+            free_all(*allocs[i], &live);
+            CHECK(r.nullReturns == 0);
+            if (round == 0 || r.ns < best[i]) best[i] = r.ns;
+        }
+    }
+    printf("lvgl_mem: %zu operacoes, %.1f ns/op (malloc do sistema: %.1f ns/op)\n",
+           trace.ops.size(), best[0] / trace.ops.size(), best[1] / trace.ops.size());
+}
+
+static uint32_t test_full_pool(const Trace& trace) {
+    std::vector<Block> live;
+    lvgl_mem_stats_t s0 = mem_stats();
+
+    ReplayResult r = replay(trace, LVGL_MEM, &live, true);
+    lvgl_mem_stats_t s = mem_stats();
+    uint32_t left = free_all(LVGL_MEM, &live);
+    printf("lvgl_mem: pool de %u KB: pico %u B, %u blocos no fim, fragmentacao ate %u%% "
+           "com o pool >= 1/4, %u grandes, %u transbordos, %u falhas\n",
+           (unsigned)(s.poolSize / 1024), (unsigned)r.peakUsed, (unsigned)left,
+           (unsigned)r.worstFrag, (unsigned)(s.largeAllocs - s0.largeAllocs),
+           (unsigned)(s.overflowAllocs - s0.overflowAllocs), (unsigned)(s.failedAllocs - s0.failedAllocs));
+
+    CHECK(r.nullReturns == 0 && r.corrupt == 0);
+    CHECK(s.poolSize == LV_MEM_TLSF_POOL_SIZE);
+    CHECK(r.peakUsed > 0 && r.peakUsed < s.poolSize);
+    CHECK(s.poolPeak == r.peakUsed);
+    CHECK(s.failedAllocs == s0.failedAllocs);
+    CHECK(s.largeAllocs == s0.largeAllocs);
+    CHECK(s.overflowAllocs == s0.overflowAllocs);
+    CHECK(s.psramPeak == 0);
+    CHECK(r.worstFrag <= FRAG_MAX_PCT);
+
+    s = mem_stats();
+    CHECK(s.poolUsed == 0 && s.poolBlocks == 0);
+    return r.peakUsed;
+}
+
+static void test_small_pool(const Trace& trace, uint32_t peak) {
+    // Lastro de blocos pequenos ate sobrar metade do pico no pool
+    std::vector<void*> ballast;
+    while (mem_stats().poolSize - mem_stats().poolUsed > peak / 2) {
+        void* p = lvgl_mem_alloc(LVGL_MEM_SMALL_MAX);
+        if (!p) break;
+        ballast.push_back(p);
+    }
+    lvgl_mem_stats_t s0 = mem_stats();
+    CHECK(s0.psramUsed == 0);
+    uint32_t avail = s0.poolSize - s0.poolUsed;
+
+    std::vector<Block> live;
+    ReplayResult r = replay(trace, LVGL_MEM, &live, true);
+    lvgl_mem_stats_t s = mem_stats();
+    printf("lvgl_mem: pool com %u B livres: %u transbordos, pico fora do pool %u B, %u falhas\n",
+           (unsigned)avail, (unsigned)(s.overflowAllocs - s0.overflowAllocs),
+           (unsigned)s.psramPeak, (unsigned)(s.failedAllocs - s0.failedAllocs));
+
+    CHECK(r.nullReturns == 0 && r.corrupt == 0);
+    CHECK(s.overflowAllocs > s0.overflowAllocs);
+    CHECK(s.psramPeak > 0);
+    CHECK(s.failedAllocs == s0.failedAllocs);
+    CHECK(s.largeAllocs == s0.largeAllocs);
+
+    free_all(LVGL_MEM, &live);
+
+    // O trace nao cruza o limiar: um bloco do lastro cresce para fora do
+    // pool e encolhe de volta, com o conteudo preservado nos dois sentidos
+    CHECK(!ballast.empty());
+    uint8_t* p = (uint8_t*)ballast.back();
+    memset(p, 0x5a, LVGL_MEM_SMALL_MAX);
+    s0 = mem_stats();
+    p = (uint8_t*)lvgl_mem_realloc(p, 2 * LVGL_MEM_SMALL_MAX);
+    CHECK(p != NULL && check_fill(p, LVGL_MEM_SMALL_MAX, 0x5a));
+    CHECK(mem_stats().largeAllocs == s0.largeAllocs + 1);
+    CHECK(mem_stats().psramUsed > s0.psramUsed);
+    memset(p, 0xa5, 2 * LVGL_MEM_SMALL_MAX);
+    p = (uint8_t*)lvgl_mem_realloc(p, 64);
+    CHECK(p != NULL && check_fill(p, 64, 0xa5));
+    CHECK(mem_stats().psramUsed == s0.psramUsed);
+    ballast.back() = p;
+
+    // Tudo devolvido: pool vazio, nada fora dele
+    for (void* b : ballast) lvgl_mem_free(b);
+    s = mem_stats();
+    CHECK(s.poolUsed == 0 && s.poolBlocks == 0);
+    CHECK(s.psramUsed == 0);
+    CHECK(s.poolFragPct == 0);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s <trace LVMEM, texto ou .gz>\n", argv[0]);
+        return 2;
+    }
+
+    Trace trace;
+    CHECK(load_trace(argv[1], &trace));
+    CHECK(!trace.ops.empty());
+    if (trace.ops.empty()) return TEST_RESULT();
+
+    test_timing(trace);
+    uint32_t peak = test_full_pool(trace);
+    test_small_pool(trace, peak);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,473 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - DECODER PNG EM STREAMING
+ * ============================================================================
+ *
+ * Gera PNGs em memoria (zlib) com todos os filtros, inclusive Up/Average/
+ * Paeth na linha 0, em todos os tipos de cor (0, 2, 3, 4, 6) e profundidades
+ * (1/2/4/8/16), com e sem tRNS, e compara cada linha decodificada, pixel a
+ * pixel, com o lodepng_decode32 do lodepng da LVGL (lib/lvgl). Imagens
+ * pequenas passam pelo caminho decodificado inteiro; imagens acima de
+ * PNG_STREAM_FULL_DECODE_MAX pelo read_line, com saltos para tras (rewind).
+ * O lv_mem_alloc do teste entrega memoria suja para pegar leitura de buffer
+ * nao inicializado.
+ *
+ * Benchmark de memoria: pico de lv_mem_alloc + heap_caps_* de cada imagem em
+ * streaming contra o pico do lodepng_decode32 na mesma imagem. O streaming
+ * tem de ficar na janela do inflate + duas linhas, qualquer que seja a
+ * altura.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "lvgl.h"
+#include "ui/common/png_stream.h"
+#include "esp_heap_caps.h"
+#include "miniz.h"
+#include "test_check.h"
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+// Referencia: lodepng da LVGL (lodepng.c compilado como C; o header nao
+// tem extern "C" e em C++ declara a API std::vector)
+extern "C" unsigned lodepng_decode32(unsigned char** out, unsigned* w, unsigned* h,
+                                     const unsigned char* in, size_t insize);
+
+// ============================================================================
+// LVGL MINIMA (FS em memoria, alocador sujo e medido, registro do decoder)
+// ============================================================================
+
+static std::map<std::string, std::vector<uint8_t>> g_files;
+static lv_img_decoder_t g_dec;
+static size_t g_memInUse;
+static size_t g_memPeak;
+
+struct MemFile {
+    const std::vector<uint8_t>* data;
+    uint32_t pos;
+};
+
+extern "C" {
+
+void* lv_mem_alloc(size_t size) {
+    void* p = malloc(size);
+    if (p) {
+        memset(p, 0xA5, size);
+        g_memInUse += malloc_usable_size(p);
+        if (g_memInUse > g_memPeak) g_memPeak = g_memInUse;
+    }
+    return p;
+}
+
+void* lv_mem_realloc(void* old, size_t size) {
+    size_t oldSize = old ? malloc_usable_size(old) : 0;
+    void* p = realloc(old, size);
+    if (p) {
+        g_memInUse += malloc_usable_size(p) - oldSize;
+        if (g_memInUse > g_memPeak) g_memPeak = g_memInUse;
+    }
+    return p;
+}
+
+void lv_mem_free(void* p) {
+    if (p) g_memInUse -= malloc_usable_size(p);
+    free(p);
+}
+
+lv_fs_res_t lv_fs_open(lv_fs_file_t* f, const char* path, lv_fs_mode_t mode) {
+    auto it = g_files.find(path);
+    if (it == g_files.end()) return LV_FS_RES_NOT_EX;
+    f->file_d = new MemFile{&it->second, 0};
+    f->drv = reinterpret_cast<lv_fs_drv_t*>(&g_files);
+    return LV_FS_RES_OK;
+}
+
+lv_fs_res_t lv_fs_close(lv_fs_file_t* f) {
+    delete static_cast<MemFile*>(f->file_d);
+    f->drv = NULL;
+    return LV_FS_RES_OK;
+}
+
+lv_fs_res_t lv_fs_read(lv_fs_file_t* f, void* buf, uint32_t len, uint32_t* rn) {
+    MemFile* m = static_cast<MemFile*>(f->file_d);
+    uint32_t left = (uint32_t)m->data->size() - m->pos;
+    *rn = len < left ? len : left;
+    memcpy(buf, m->data->data() + m->pos, *rn);
+    m->pos += *rn;
+    return LV_FS_RES_OK;
+}
+
+lv_fs_res_t lv_fs_write(lv_fs_file_t* f, const void* buf, uint32_t len, uint32_t* wn) {
+    return LV_FS_RES_NOT_IMP;
+}
+
+lv_fs_res_t lv_fs_tell(lv_fs_file_t* f, uint32_t* pos) {
+    *pos = static_cast<MemFile*>(f->file_d)->pos;
+    return LV_FS_RES_OK;
+}
+
+lv_fs_res_t lv_fs_seek(lv_fs_file_t* f, uint32_t pos, lv_fs_whence_t whence) {
+    MemFile* m = static_cast<MemFile*>(f->file_d);
+    if (pos > m->data->size()) return LV_FS_RES_UNKNOWN;
+    m->pos = pos;
+    return LV_FS_RES_OK;
+}
+
+const char* lv_fs_get_ext(const char* fn) {
+    const char* dot = strrchr(fn, '.');
+    return dot ? dot + 1 : "";
+}
+
+lv_img_src_t lv_img_src_get_type(const void* src) {
+    return LV_IMG_SRC_FILE;
+}
+
+lv_img_decoder_t* lv_img_decoder_create(void) { return &g_dec; }
+void lv_img_decoder_set_info_cb(lv_img_decoder_t* d, lv_img_decoder_info_f_t cb) { d->info_cb = cb; }
+void lv_img_decoder_set_open_cb(lv_img_decoder_t* d, lv_img_decoder_open_f_t cb) { d->open_cb = cb; }
+void lv_img_decoder_set_read_line_cb(lv_img_decoder_t* d, lv_img_decoder_read_line_f_t cb) { d->read_line_cb = cb; }
+void lv_img_decoder_set_close_cb(lv_img_decoder_t* d, lv_img_decoder_close_f_t cb) { d->close_cb = cb; }
+
+} // extern "C"
+
+// ============================================================================
+// ENCODER PNG (qualquer tipo/profundidade, filtro escolhido por linha)
+// ============================================================================
+
+#define PNG_GRAY        0
+#define PNG_RGB         2
+#define PNG_PALETTE     3
+#define PNG_GRAY_ALPHA  4
+#define PNG_RGBA        6
+
+static uint32_t channels_of(uint8_t colorType) {
+    static const uint8_t channels[7] = {1, 0, 3, 1, 2, 0, 4};
+    return channels[colorType];
+}
+
+static void put32(std::vector<uint8_t>& v, uint32_t x) {
+    for (int i = 3; i >= 0; i--) v.push_back((uint8_t)(x >> (i * 8)));
+}
+
+static void put_chunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& data) {
+    put32(png, (uint32_t)data.size());
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    put32(png, (uint32_t)crc32(0, png.data() + start, (uInt)(png.size() - start)));
+}
+
+static uint8_t paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) return (uint8_t)a;
+    return (uint8_t)(pb <= pc ? b : c);
+}
+
+struct PngImage {
+    uint32_t w;
+    uint32_t h;
+    uint8_t colorType;
+    uint8_t depth;
+    uint32_t stride;                // Bytes por linha sem o byte de filtro
+    std::vector<uint8_t> rows;      // Linhas ja empacotadas (h * stride)
+    std::vector<uint8_t> plte;
+    std::vector<uint8_t> trns;
+};
+
+/**
+ * Amostras em ordem de pixel/canal empacotadas na profundidade da imagem
+ * (bits mais altos primeiro, 16 bits big-endian)
+ */
+static void pack_row(PngImage& img, const std::vector<uint16_t>& samples, uint8_t* out) {
+    memset(out, 0, img.stride);
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (img.depth == 16) {
+            out[i * 2] = (uint8_t)(samples[i] >> 8);
+            out[i * 2 + 1] = (uint8_t)samples[i];
+        } else {
+            size_t bit = i * img.depth;
+            out[bit >> 3] |= (uint8_t)(samples[i] << (8 - img.depth - (bit & 7)));
+        }
+    }
+}
+
+/**
+ * Linha y usa o filtro (firstFilter + y) % 5
+ */
+static std::vector<uint8_t> encode_png(const PngImage& img, int firstFilter) {
+    const uint32_t bits = channels_of(img.colorType) * img.depth;
+    const uint32_t bpp = bits >= 8 ? bits / 8 : 1;
+    std::vector<uint8_t> raw;
+    std::vector<uint8_t> zero(img.stride, 0);
+
+    for (uint32_t y = 0; y < img.h; y++) {
+        const uint8_t* line = &img.rows[y * img.stride];
+        const uint8_t* prev = y ? &img.rows[(y - 1) * img.stride] : zero.data();
+        int filter = (firstFilter + (int)y) % 5;
+        raw.push_back((uint8_t)filter);
+
+        for (uint32_t i = 0; i < img.stride; i++) {
+            int a = i >= bpp ? line[i - bpp] : 0;
+            int b = prev[i];
+            int c = i >= bpp ? prev[i - bpp] : 0;
+            int pred = 0;
+            switch (filter) {
+                case 1: pred = a; break;
+                case 2: pred = b; break;
+                case 3: pred = (a + b) >> 1; break;
+                case 4: pred = paeth(a, b, c); break;
+            }
+            raw.push_back((uint8_t)(line[i] - pred));
+        }
+    }
+
+    uLongf zlen = compressBound((uLong)raw.size());
+    std::vector<uint8_t> z(zlen);
+    compress2(z.data(), &zlen, raw.data(), (uLong)raw.size(), 9);
+    z.resize(zlen);
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> ihdr;
+    put32(ihdr, img.w);
+    put32(ihdr, img.h);
+    ihdr.push_back(img.depth);
+    ihdr.push_back(img.colorType);
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    put_chunk(png, "IHDR", ihdr);
+    if (!img.plte.empty()) put_chunk(png, "PLTE", img.plte);
+    if (!img.trns.empty()) put_chunk(png, "tRNS", img.trns);
+
+    // IDAT dividido para cruzar fronteiras de chunk no meio do inflate
+    const size_t split = 700;
+    for (size_t i = 0; i < z.size(); i += split) {
+        size_t n = z.size() - i < split ? z.size() - i : split;
+        put_chunk(png, "IDAT", std::vector<uint8_t>(z.begin() + i, z.begin() + i + n));
+    }
+    put_chunk(png, "IEND", {});
+    return png;
+}
+
+/**
+ * Imagem pseudo-aleatoria: gradiente com ruido (todos os preditores produzem
+ * residuos diferentes). Com trns, a chave tRNS e uma cor que aparece na
+ * imagem; na paleta, parte das entradas ganha alfa.
+ */
+static PngImage make_image(uint32_t w, uint32_t h, uint8_t colorType, uint8_t depth, bool trns) {
+    PngImage img;
+    img.w = w;
+    img.h = h;
+    img.colorType = colorType;
+    img.depth = depth;
+    const uint32_t ch = channels_of(colorType);
+    img.stride = (w * ch * depth + 7) / 8;
+    img.rows.resize(h * img.stride);
+
+    const uint32_t maxSample = (1u << depth) - 1;
+    const uint32_t paletteSize = colorType == PNG_PALETTE ? (depth == 8 ? 200 : maxSample + 1) : 0;
+
+    uint32_t seed = w * 131 + h * 7 + colorType * 17 + depth;
+    std::vector<uint16_t> samples(w * ch);
+    std::vector<uint16_t> firstPixel;
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t i = 0; i < samples.size(); i++) {
+            seed = seed * 1103515245u + 12345u;
+            uint32_t v = (y * w * ch + i) * 3 * (maxSample / 255 + 1) + (seed >> 16);
+            samples[i] = (uint16_t)(paletteSize ? v % paletteSize : v & maxSample);
+        }
+        // Repete a cor da chave tRNS em algumas posicoes
+        if (y == 0) firstPixel.assign(samples.begin(), samples.begin() + ch);
+        if (y % 3 == 1) std::copy(firstPixel.begin(), firstPixel.end(), samples.begin() + (y % w) * ch);
+        pack_row(img, samples, &img.rows[y * img.stride]);
+    }
+
+    if (paletteSize) {
+        for (uint32_t i = 0; i < paletteSize; i++) {
+            img.plte.push_back((uint8_t)(i * 37));
+            img.plte.push_back((uint8_t)(255 - i * 11));
+            img.plte.push_back((uint8_t)(i * 91 + 5));
+        }
+        if (trns) {
+            // Menos entradas que a paleta: o resto fica opaco
+            for (uint32_t i = 0; i < (paletteSize + 1) / 2; i++) img.trns.push_back((uint8_t)(i * 53));
+        }
+    } else if (trns) {
+        for (uint16_t v : firstPixel) {
+            img.trns.push_back((uint8_t)(v >> 8));
+            img.trns.push_back((uint8_t)v);
+        }
+    }
+    return img;
+}
+
+// ============================================================================
+// COMPARACAO COM O LODEPNG
+// ============================================================================
+
+static bool row_matches(const uint8_t* out, const uint8_t* rgba, uint32_t x0, uint32_t len, bool alpha) {
+    const uint32_t px = alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    for (uint32_t x = 0; x < len; x++) {
+        const uint8_t* s = rgba + (x0 + x) * 4;
+        lv_color_t expected = lv_color_make(s[0], s[1], s[2]);
+        if (memcmp(out + x * px, &expected, sizeof(expected)) != 0) return false;
+        if (alpha ? out[x * px + px - 1] != s[3] : s[3] != 0xFF) return false;
+    }
+    return true;
+}
+
+static size_t peak_since_reset() {
+    return g_memPeak + host_heap_peak_bytes();
+}
+
+static void reset_peak() {
+    g_memPeak = g_memInUse;
+    host_heap_reset_peak();
+}
+
+static void check_image(uint32_t w, uint32_t h, uint8_t colorType, uint8_t depth, bool trns,
+                        int firstFilter) {
+    PngImage img = make_image(w, h, colorType, depth, trns);
+
+    char name[64];
+    snprintf(name, sizeof(name), "A:/t_%ux%u_c%u_d%u%s_f%d.png", (unsigned)w, (unsigned)h,
+             (unsigned)colorType, (unsigned)depth, trns ? "_trns" : "", firstFilter);
+    std::string fn = name;
+    const std::vector<uint8_t>& file = g_files[fn] = encode_png(img, firstFilter);
+
+    // Referencia: quadro RGBA 8 do lodepng
+    reset_peak();
+    size_t base = g_memInUse + host_heap_bytes_in_use();
+    unsigned char* rgba = nullptr;
+    unsigned rw = 0, rh = 0;
+    unsigned err = lodepng_decode32(&rgba, &rw, &rh, file.data(), file.size());
+    size_t lodepngPeak = peak_since_reset() - base;
+    if (err || rw != w || rh != h) {
+        fprintf(stderr, "%s: lodepng falhou (%u)\n", fn.c_str(), err);
+        CHECK(!"lodepng falhou");
+        lv_mem_free(rgba);
+        return;
+    }
+
+    lv_img_header_t header;
+    memset(&header, 0, sizeof(header));
+    CHECK(g_dec.info_cb(&g_dec, fn.c_str(), &header) == LV_RES_OK);
+    CHECK(header.w == (lv_coord_t)w && header.h == (lv_coord_t)h);
+    const bool alpha = header.cf == LV_IMG_CF_TRUE_COLOR_ALPHA;
+    CHECK(alpha == (colorType == PNG_GRAY_ALPHA || colorType == PNG_RGBA || trns));
+
+    reset_peak();
+    base = g_memInUse + host_heap_bytes_in_use();
+
+    lv_img_decoder_dsc_t dsc;
+    memset(&dsc, 0, sizeof(dsc));
+    dsc.src = fn.c_str();
+    dsc.src_type = LV_IMG_SRC_FILE;
+    dsc.header = header;
+    if (g_dec.open_cb(&g_dec, &dsc) != LV_RES_OK) {
+        CHECK(!"open falhou");
+        lv_mem_free(rgba);
+        return;
+    }
+
+    const uint32_t px = alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    const bool full = w * h * px <= PNG_STREAM_FULL_DECODE_MAX;
+    CHECK(full == (dsc.img_data != NULL));
+
+    int bad = 0;
+    if (dsc.img_data) {
+        for (uint32_t y = 0; y < h; y++) {
+            if (!row_matches(dsc.img_data + y * w * px, rgba + y * w * 4, 0, w, alpha)) bad++;
+        }
+    } else {
+        // Passada em ordem e depois linhas fora de ordem com x parcial
+        // (rewind a cada salto para tras)
+        std::vector<uint8_t> buf(w * px);
+        for (int pass = 0; pass < 2; pass++) {
+            for (uint32_t i = 0; i < h; i++) {
+                uint32_t y = pass ? (i * 37) % h : i;
+                uint32_t x0 = pass ? y % (w / 3) : 0;
+                if (g_dec.read_line_cb(&g_dec, &dsc, (lv_coord_t)x0, (lv_coord_t)y,
+                                       (lv_coord_t)(w - x0), buf.data()) != LV_RES_OK) {
+                    bad++;
+                    break;
+                }
+                if (!row_matches(buf.data(), rgba + y * w * 4, x0, w - x0, alpha)) bad++;
+            }
+        }
+    }
+    size_t streamPeak = peak_since_reset() - base;
+
+    if (bad) {
+        fprintf(stderr, "%s: %d linhas diferentes do lodepng\n", fn.c_str(), bad);
+    }
+    CHECK(bad == 0);
+    g_dec.close_cb(&g_dec, &dsc);
+    lv_mem_free(rgba);
+
+    if (!full) {
+        // Janela do inflate + estado + duas linhas + PngStream (com folga),
+        // independente da altura. No host o estado interno da zlib fica fora
+        // da conta; no alvo ele e o proprio tinfl_decompressor.
+        const uint32_t stride = img.stride;
+        const size_t bound = TINFL_LZ_DICT_SIZE + sizeof(tinfl_decompressor) + 2 * (stride + 1) + 4096;
+        CHECK(streamPeak <= bound);
+        CHECK(streamPeak < lodepngPeak);
+        if (firstFilter == 0) {
+            printf("png_stream %ux%u tipo %u/%u bits%s: pico %zu B (lodepng_decode32: %zu B)\n",
+                   (unsigned)w, (unsigned)h, (unsigned)colorType, (unsigned)depth,
+                   trns ? " +tRNS" : "", streamPeak, lodepngPeak);
+        }
+    }
+}
+
+// ============================================================================
+// CORPUS
+// ============================================================================
+
+struct PngFormat {
+    uint8_t colorType;
+    uint8_t depth;
+};
+
+static const PngFormat FORMATS[] = {
+    {PNG_GRAY, 1}, {PNG_GRAY, 2}, {PNG_GRAY, 4}, {PNG_GRAY, 8}, {PNG_GRAY, 16},
+    {PNG_RGB, 8}, {PNG_RGB, 16},
+    {PNG_PALETTE, 1}, {PNG_PALETTE, 2}, {PNG_PALETTE, 4}, {PNG_PALETTE, 8},
+    {PNG_GRAY_ALPHA, 8}, {PNG_GRAY_ALPHA, 16},
+    {PNG_RGBA, 8}, {PNG_RGBA, 16},
+};
+
+int main() {
+    png_stream_init();
+
+    for (const PngFormat& f : FORMATS) {
+        // tRNS so nos tipos sem canal alfa
+        const bool canTrns = f.colorType != PNG_GRAY_ALPHA && f.colorType != PNG_RGBA;
+
+        for (int trns = 0; trns <= (canTrns ? 1 : 0); trns++) {
+            for (int filter = 0; filter < 5; filter++) {
+                // Decodificadas inteiras no open (larguras que nao fecham byte)
+                check_image(37, 21, f.colorType, f.depth, trns, filter);
+
+                // Em streaming (acima de PNG_STREAM_FULL_DECODE_MAX)
+                check_image(301, 170, f.colorType, f.depth, trns, filter);
+            }
+        }
+    }
+
+    // Altura nao muda o pico do streaming
+    check_image(301, 1200, PNG_RGBA, 8, false, 0);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,296 @@
+/**
+ * ============================================================================
+ * TESTE DE HOST - CICLO DE TELAS (SUSPEND / DESTROY)
+ * ============================================================================
+ *
+ * Alterna NumpadScreen e JornadaScreen pelo ScreenManagerImpl (cycleTo ->
+ * switchScreen, com a transicao por snapshot ate o fim) muitas vezes, com a
+ * politica real (SUSPEND) e com as mesmas telas forcadas a DESTROY. Depois
+ * do aquecimento, cada volta tem de deixar os blocos do heap da LVGL
+ * (lvgl_mem: pool e PSRAM) e o numero de objetos LVGL exatamente onde
+ * estavam. Os bytes do pool contam o tamanho do bloco TLSF, que depende de
+ * onde o bloco caiu (sobra menor que o bloco minimo fica junto): com
+ * DESTROY eles podem variar ate esse arredondamento por bloco. Destruir as
+ * duas telas volta exatamente ao estado de antes de cria-las, bytes
+ * inclusive. Os ButtonManager vem do pool: nenhum e alocado depois da
+ * primeira volta.
+ *
+ * Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+ * Desenvolvido por Mario Stanski Jr
+ *
+ * ============================================================================
+ */
+
+#include "ui/screen_manager.h"
+#include "ui/screens/numpad_screen.h"
+#include "ui/screens/jornada_screen.h"
+#include "button_manager.h"
+#include "lvgl_mem.h"
+#include "esp_timer.h"
+#include "test_check.h"
+
+#include <stdlib.h>
+#include <new>
+
+#ifndef CYCLES
+#define CYCLES  50
+#endif
+
+// Sobra maxima que o TLSF deixa junto de um bloco (bloco minimo, 64 bits)
+#define TLSF_ROUNDING   24
+
+// ============================================================================
+// CONTADOR DE operator new
+// ============================================================================
+
+static uint32_t g_newCount;
+
+void* operator new(size_t size) {
+    g_newCount++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// ============================================================================
+// DISPLAY DO HOST
+// ============================================================================
+
+static lv_color_t g_buf[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+static void flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* px) {
+    lv_disp_flush_ready(drv);
+}
+
+extern "C" void playAudioFile(const char* filename) {
+}
+
+static void host_display_init() {
+    static lv_disp_draw_buf_t drawBuf;
+    static lv_disp_drv_t dispDrv;
+
+    lv_init();
+    lv_disp_draw_buf_init(&drawBuf, g_buf, NULL, SCREEN_WIDTH * SCREEN_HEIGHT);
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.hor_res = SCREEN_WIDTH;
+    dispDrv.ver_res = SCREEN_HEIGHT;
+    dispDrv.flush_cb = flush_cb;
+    dispDrv.draw_buf = &drawBuf;
+    dispDrv.full_refresh = 1;
+    lv_disp_drv_register(&dispDrv);
+}
+
+static void run_lvgl(uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += 10) {
+        host_timer_advance_ms(10);
+        lv_timer_handler();
+    }
+}
+
+// ============================================================================
+// MEDIDAS
+// ============================================================================
+
+struct UiFootprint {
+    uint32_t poolUsed;
+    uint32_t poolBlocks;
+    uint32_t psramUsed;
+    uint32_t objects;
+    uint32_t screens;
+
+    // Mesmos blocos e objetos vivos (os bytes do pool podem arredondar)
+    bool sameLive(const UiFootprint& o) const {
+        return poolBlocks == o.poolBlocks && psramUsed == o.psramUsed &&
+               objects == o.objects && screens == o.screens;
+    }
+
+    bool operator==(const UiFootprint& o) const {
+        return sameLive(o) && poolUsed == o.poolUsed;
+    }
+};
+
+static uint32_t count_tree(lv_obj_t* obj) {
+    uint32_t n = 1;
+    uint32_t cnt = lv_obj_get_child_cnt(obj);
+    for (uint32_t i = 0; i < cnt; i++) n += count_tree(lv_obj_get_child(obj, i));
+    return n;
+}
+
+static UiFootprint footprint() {
+    lvgl_mem_stats_t m;
+    lvgl_mem_get_stats(&m);
+
+    lv_disp_t* disp = lv_disp_get_default();
+    UiFootprint f;
+    f.poolUsed = m.poolUsed;
+    f.poolBlocks = m.poolBlocks;
+    f.psramUsed = m.psramUsed;
+    f.screens = disp->screen_cnt;
+    f.objects = count_tree(lv_disp_get_layer_top(disp)) + count_tree(lv_disp_get_layer_sys(disp));
+    for (uint32_t i = 0; i < disp->screen_cnt; i++) f.objects += count_tree(disp->screens[i]);
+    return f;
+}
+
+static void print_footprint(const char* when, const UiFootprint& f) {
+    printf("%-28s pool %6u B (%4u blocos), psram %7u B, %4u objetos, %u telas\n", when,
+           (unsigned)f.poolUsed, (unsigned)f.poolBlocks, (unsigned)f.psramUsed,
+           (unsigned)f.objects, (unsigned)f.screens);
+}
+
+// ============================================================================
+// TELAS FORCADAS A DESTROY
+// ============================================================================
+
+class DestroyNumpadScreen : public NumpadScreen {
+public:
+    ScreenRetention getRetention() const override { return ScreenRetention::DESTROY; }
+};
+
+class DestroyJornadaScreen : public JornadaScreen {
+public:
+    ScreenRetention getRetention() const override { return ScreenRetention::DESTROY; }
+};
+
+/**
+ * NUMPAD -> JORNADA -> NUMPAD, com a transicao terminada em cada troca
+ */
+static void cycle_once(ScreenManagerImpl* mgr) {
+    mgr->cycleTo(ScreenType::JORNADA);
+    run_lvgl(SCREEN_TRANSITION_TIME_MS + 100);
+    mgr->cycleTo(ScreenType::NUMPAD);
+    run_lvgl(SCREEN_TRANSITION_TIME_MS + 100);
+}
+
+/**
+ * Troca para uma tela vazia e destroi as telas do gerenciador
+ */
+static void tear_down(lv_obj_t* blank, IScreen* a, IScreen* b) {
+    lv_scr_load(blank);
+    run_lvgl(50);
+    a->destroy();
+    b->destroy();
+    run_lvgl(50);
+}
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+static void run_policy(const char* name, ScreenManagerImpl* mgr, IScreen* numpad, IScreen* jornada,
+                       lv_obj_t* blank, bool destroy) {
+    mgr->init();
+    mgr->registerScreen(numpad);
+    mgr->registerScreen(jornada);
+
+    UiFootprint before = footprint();
+
+    mgr->showInitialScreen(ScreenType::NUMPAD);
+    run_lvgl(100);
+
+    // Aquecimento: primeira criacao das duas telas, faces, snapshots
+    cycle_once(mgr);
+    cycle_once(mgr);
+
+    ScreenNavStats navStart = mgr->getNavStats();
+    uint32_t newStart = g_newCount;
+    UiFootprint start = footprint();
+
+    int drift = 0;
+    uint32_t maxPoolDelta = 0;
+    for (int i = 0; i < CYCLES; i++) {
+        cycle_once(mgr);
+        UiFootprint f = footprint();
+        if (!f.sameLive(start)) drift++;
+        uint32_t delta = f.poolUsed > start.poolUsed ? f.poolUsed - start.poolUsed
+                                                     : start.poolUsed - f.poolUsed;
+        if (delta > maxPoolDelta) maxPoolDelta = delta;
+    }
+
+    UiFootprint end = footprint();
+    ScreenNavStats nav = mgr->getNavStats();
+    uint32_t creates = nav.creates - navStart.creates;
+    uint32_t destroys = nav.destroys - navStart.destroys;
+    uint32_t resumes = nav.resumes - navStart.resumes;
+
+    printf("%s: %d voltas, %u create, %u destroy, %u resume, %u operator new\n", name, CYCLES,
+           (unsigned)creates, (unsigned)destroys, (unsigned)resumes, (unsigned)(g_newCount - newStart));
+    print_footprint("  antes das telas", before);
+    print_footprint("  apos o aquecimento", start);
+    print_footprint("  apos as voltas", end);
+    printf("  variacao do pool entre voltas: ate %u B\n", (unsigned)maxPoolDelta);
+
+    CHECK(drift == 0);
+    CHECK(end.sameLive(start));
+    CHECK(maxPoolDelta <= start.poolBlocks * TLSF_ROUNDING);
+
+    if (destroy) {
+        CHECK(creates == 2 * CYCLES && destroys == 2 * CYCLES && resumes == 0);
+    } else {
+        CHECK(creates == 0 && destroys == 0 && resumes == 2 * CYCLES);
+
+        // Nada e alocado nem liberado: nem o arredondamento muda
+        CHECK(maxPoolDelta == 0);
+
+        // Telas retidas voltam sem nenhuma alocacao de C++
+        CHECK(g_newCount == newStart);
+    }
+
+    tear_down(blank, numpad, jornada);
+    UiFootprint after = footprint();
+    print_footprint("  telas destruidas", after);
+
+    // Sem as telas, o heap e os objetos voltam ao estado de antes
+    CHECK(after == before);
+
+    // Pool de ButtonManager livre de novo, sem instancias novas
+    uint32_t newBefore = g_newCount;
+    ButtonManager* a = ButtonManager::acquire();
+    ButtonManager* b = ButtonManager::acquire();
+    CHECK(a != nullptr && b != nullptr && a != b);
+    CHECK(g_newCount == newBefore);
+    ButtonManager::release(a, true);
+    ButtonManager::release(b, true);
+}
+
+int main() {
+    host_display_init();
+
+    lv_obj_t* blank = lv_obj_create(NULL);
+    lv_scr_load(blank);
+
+    ScreenManagerImpl* mgr = ScreenManagerImpl::getInstance();
+
+    // Primeira passada sem medir: cria o que fica para sempre (pool de
+    // ButtonManager, buffers de snapshot, tela da transicao, estilos)
+    {
+        NumpadScreen numpad;
+        JornadaScreen jornada;
+        mgr->init();
+        mgr->registerScreen(&numpad);
+        mgr->registerScreen(&jornada);
+        mgr->showInitialScreen(ScreenType::NUMPAD);
+        cycle_once(mgr);
+        tear_down(blank, &numpad, &jornada);
+    }
+
+    NumpadScreen numpad;
+    JornadaScreen jornada;
+    run_policy("SUSPEND", mgr, &numpad, &jornada, blank, false);
+
+    DestroyNumpadScreen numpadD;
+    DestroyJornadaScreen jornadaD;
+    run_policy("DESTROY", mgr, &numpadD, &jornadaD, blank, true);
+
+    // So imprime com LVGL_MEM_CAPTURE (trace para test_lvgl_mem_replay)
+    lvgl_mem_trace_dump();
+
+    return TEST_RESULT();
+}
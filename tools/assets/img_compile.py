@@ -0,0 +1,291 @@
+#!/usr/bin/env python3
+# ============================================================================
+# COMPILADOR DE ASSETS DE IMAGEM
+# ============================================================================
+#
+# Converte PNGs (data/*.png) em imagens RGB565 / RGB565A8 prontas para o
+# LVGL e gera a imagem da particao "assets" (mapeada em memoria no boot,
+# sem decodificacao). Sem dependencias alem da biblioteca padrao.
+#
+# Formato (little-endian), lido por src/ui/common/asset_store.cpp:
+#
+#   cabecalho   : magic 'LVAS' u32, versao u16, quantidade u16
+#   entradas    : nome char[32], formato u8, compressao u8, flags u8,
+#                 reservado u8, largura u16, altura u16,
+#                 offset u32, tamanho u32, tamanho_bruto u32   (52 bytes)
+#   dados       : pixels de cada entrada, alinhados em 4 bytes
+#
+#   formato     : 0 = RGB565, 1 = RGB565A8 (cor + alfa intercalados, 3 B/px)
+#   compressao  : 0 = nenhuma, 1 = RLE por pixel
+#   flags       : bit0 = bytes do RGB565 trocados (LV_COLOR_16_SWAP)
+#
+# Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+# Desenvolvido por Mario Stanski Jr
+#
+# ============================================================================
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+ASSET_MAGIC = 0x5341564C  # 'LVAS'
+ASSET_VERSION = 1
+ASSET_NAME_MAX = 32
+ENTRY_FMT = "<32sBBBBHHIII"
+
+FORMAT_RGB565 = 0
+FORMAT_RGB565A8 = 1
+
+COMPRESS_NONE = 0
+COMPRESS_RLE = 1
+
+FLAG_SWAP16 = 0x01
+
+RLE_MAX_RUN = 128
+
+
+# ============================================================================
+# LEITURA DE PNG
+# ============================================================================
+
+def _paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Retorna (largura, altura, pixels RGBA em bytearray)"""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: nao e um PNG" % path)
+
+    pos = 8
+    idat = bytearray()
+    palette = None
+    trns = None
+    width = height = depth = ctype = interlace = None
+
+    while pos < len(data):
+        length, tag = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+
+        if tag == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif tag == b"PLTE":
+            palette = chunk
+        elif tag == b"tRNS":
+            trns = chunk
+        elif tag == b"IDAT":
+            idat += chunk
+        elif tag == b"IEND":
+            break
+
+    if depth != 8 or interlace != 0:
+        raise ValueError("%s: suportado apenas 8 bits por canal, sem interlace" % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(ctype)
+    if channels is None:
+        raise ValueError("%s: tipo de cor %d nao suportado" % (path, ctype))
+
+    raw = zlib.decompress(bytes(idat))
+    stride = width * channels
+    prev = bytearray(stride)
+    rgba = bytearray(width * height * 4)
+    src = 0
+
+    for y in range(height):
+        ftype = raw[src]
+        line = bytearray(raw[src + 1:src + 1 + stride])
+        src += 1 + stride
+
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                line[i] = (line[i] + _paeth(a, b, c)) & 0xFF
+        prev = line
+
+        out = y * width * 4
+        for x in range(width):
+            s = x * channels
+            if ctype == 6:
+                px = line[s:s + 4]
+            elif ctype == 2:
+                px = line[s:s + 3] + b"\xff"
+            elif ctype == 0:
+                px = bytes((line[s], line[s], line[s], 0xFF))
+            elif ctype == 4:
+                px = bytes((line[s], line[s], line[s], line[s + 1]))
+            else:
+                idx = line[s]
+                alpha = trns[idx] if trns and idx < len(trns) else 0xFF
+                px = palette[idx * 3:idx * 3 + 3] + bytes((alpha,))
+            rgba[out + x * 4:out + x * 4 + 4] = px
+
+    return width, height, rgba
+
+
+# ============================================================================
+# CONVERSAO
+# ============================================================================
+
+def to_rgb565(rgba, swap, with_alpha):
+    """Converte RGBA8888 para RGB565 (opcionalmente + A8 por pixel)"""
+    out = bytearray()
+    for i in range(0, len(rgba), 4):
+        r, g, b, a = rgba[i], rgba[i + 1], rgba[i + 2], rgba[i + 3]
+        c = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+        out += struct.pack(">H" if swap else "<H", c)
+        if with_alpha:
+            out.append(a)
+    return out
+
+
+def rle_encode(data, unit):
+    """
+    RLE por pixel: byte de controle c
+      c & 0x80 -> repete o proximo pixel (c & 0x7F) + 1 vezes
+      senao    -> copia os proximos c + 1 pixels literais
+    """
+    px = [bytes(data[i:i + unit]) for i in range(0, len(data), unit)]
+    out = bytearray()
+    i = 0
+    n = len(px)
+
+    while i < n:
+        run = 1
+        while i + run < n and run < RLE_MAX_RUN and px[i + run] == px[i]:
+            run += 1
+        if run >= 2:
+            out.append(0x80 | (run - 1))
+            out += px[i]
+            i += run
+            continue
+
+        start = i
+        while i < n and i - start < RLE_MAX_RUN:
+            if i + 1 < n and px[i + 1] == px[i]:
+                break
+            i += 1
+        if i == start:
+            i += 1
+        out.append(i - start - 1)
+        for p in px[start:i]:
+            out += p
+
+    return out
+
+
+# ============================================================================
+# LV_CONF
+# ============================================================================
+
+_COMMENT_RE = re.compile(r"/\*.*?\*/|//[^\n]*", re.S)
+
+
+def read_conf(conf_path):
+    """LV_COLOR_DEPTH e LV_COLOR_16_SWAP de lv_conf.h"""
+    with open(conf_path, encoding="utf-8") as f:
+        text = _COMMENT_RE.sub(" ", f.read())
+
+    def value(name):
+        m = re.search(r"^[ \t]*#define[ \t]+%s[ \t]+\(?(\d+)\)?" % name, text, re.M)
+        if not m:
+            sys.exit("erro: %s nao definido em %s" % (name, conf_path))
+        return int(m.group(1))
+
+    return value("LV_COLOR_DEPTH"), value("LV_COLOR_16_SWAP") != 0
+
+
+# ============================================================================
+# IMAGEM DA PARTICAO
+# ============================================================================
+
+def compile_assets(paths, swap, compress):
+    entries = []
+    blobs = bytearray()
+    header_size = 8 + struct.calcsize(ENTRY_FMT) * len(paths)
+
+    for path in paths:
+        name = os.path.splitext(os.path.basename(path))[0]
+        if len(name) >= ASSET_NAME_MAX:
+            raise ValueError("%s: nome maior que %d caracteres" % (path, ASSET_NAME_MAX - 1))
+
+        width, height, rgba = read_png(path)
+        opaque = all(rgba[i] == 0xFF for i in range(3, len(rgba), 4))
+        fmt = FORMAT_RGB565 if opaque else FORMAT_RGB565A8
+        pixels = to_rgb565(rgba, swap, not opaque)
+        unit = 2 if opaque else 3
+
+        method = COMPRESS_NONE
+        payload = pixels
+        if compress:
+            packed = rle_encode(pixels, unit)
+            # So compensa se economizar ao menos 1/8 (a descompressao ocupa RAM)
+            if len(packed) < len(pixels) - len(pixels) // 8:
+                method = COMPRESS_RLE
+                payload = packed
+
+        while len(blobs) % 4:
+            blobs.append(0)
+        offset = header_size + len(blobs)
+        blobs += payload
+
+        entries.append(struct.pack(ENTRY_FMT, name.encode(), fmt, method,
+                                   FLAG_SWAP16 if swap else 0, 0,
+                                   width, height, offset, len(payload), len(pixels)))
+
+        print("  %-24s %3dx%-3d %-8s %7d B%s" % (
+            name, width, height, "RGB565A8" if fmt else "RGB565", len(payload),
+            " (RLE de %d B)" % len(pixels) if method == COMPRESS_RLE else ""))
+
+    return struct.pack("<IHH", ASSET_MAGIC, ASSET_VERSION, len(entries)) + b"".join(entries) + blobs
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compila PNGs para a particao de assets LVGL")
+    parser.add_argument("pngs", nargs="+", help="arquivos PNG de entrada")
+    parser.add_argument("-o", "--output", required=True, help="imagem binaria da particao")
+    color = parser.add_mutually_exclusive_group()
+    color.add_argument("--conf", help="lv_conf.h: troca de bytes conforme LV_COLOR_16_SWAP")
+    color.add_argument("--swap", action="store_true", help="trocar bytes do RGB565 (sem lv_conf.h)")
+    parser.add_argument("--rle", action="store_true", help="comprimir com RLE quando compensar")
+    parser.add_argument("--max-size", type=lambda v: int(v, 0), default=0,
+                        help="tamanho da particao (erro se exceder)")
+    args = parser.parse_args()
+
+    swap = args.swap
+    if args.conf:
+        depth, swap = read_conf(args.conf)
+        if depth != 16:
+            sys.exit("erro: LV_COLOR_DEPTH %d em %s, os assets sao RGB565" % (depth, args.conf))
+
+    print("Assets -> %s (RGB565%s)" % (args.output, ", bytes trocados" if swap else ""))
+    image = compile_assets(sorted(args.pngs), swap, args.rle)
+
+    if args.max_size and len(image) > args.max_size:
+        sys.exit("erro: %d bytes nao cabem na particao (%d)" % (len(image), args.max_size))
+
+    with open(args.output, "wb") as f:
+        f.write(image)
+    print("  total %d B" % len(image))
+
+
+if __name__ == "__main__":
+    main()
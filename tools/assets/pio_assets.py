@@ -0,0 +1,44 @@
+# ============================================================================
+# PLATFORMIO: ASSETS DE IMAGEM
+# ============================================================================
+#
+# O builder ESP-IDF do PlatformIO nao executa os custom targets do CMake,
+# entao este script gera assets.bin (mesmo compilador) e o inclui no
+# upload, no offset da particao "assets" de partitions.csv.
+#
+# Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+# Desenvolvido por Mario Stanski Jr
+#
+# ============================================================================
+
+import csv
+import glob
+import os
+import subprocess
+
+Import("env")  # noqa: F821 (injetado pelo SCons)
+
+project_dir = env.subst("$PROJECT_DIR")
+build_dir = env.subst("$BUILD_DIR")
+tool = os.path.join(project_dir, "tools", "assets", "img_compile.py")
+conf = os.path.join(project_dir, "include", "lv_conf.h")
+output = os.path.join(build_dir, "assets.bin")
+
+
+def find_partition(label):
+    path = os.path.join(project_dir, env.GetProjectOption("board_build.partitions"))
+    with open(path) as f:
+        for row in csv.reader(line for line in f if not line.lstrip().startswith("#")):
+            cols = [c.strip() for c in row]
+            if cols and cols[0] == label:
+                return cols[3], cols[4]
+    raise RuntimeError("particao '%s' nao encontrada em %s" % (label, path))
+
+
+offset, size = find_partition("assets")
+pngs = sorted(glob.glob(os.path.join(project_dir, "data", "*.png")))
+
+os.makedirs(build_dir, exist_ok=True)
+subprocess.check_call([env.subst("$PYTHONEXE"), tool, "--conf", conf, "--max-size", size, "-o", output] + pngs)
+
+env.Append(FLASH_EXTRA_IMAGES=[(offset, output)])
@@ -0,0 +1,548 @@
+#!/usr/bin/env python3
+# ============================================================================
+# SUBCONJUNTO DE FONTES (PACOTE DE FONTES DO BUILD)
+# ============================================================================
+#
+# Varre os fontes da UI atras dos tamanhos de Montserrat e dos glifos em uso
+# (lv_font_montserrat_N, LV_SYMBOL_*, literais fora do ASCII) e gera um unico
+# .c com as fontes recortadas, com os mesmos nomes das fontes da LVGL
+# (lv_font_montserrat_N), lido a partir das proprias fontes de lib/lvgl.
+#
+#   - ASCII imprimivel (0x20-0x7E) sempre entra: nomes, numeros e mensagens
+#     montados em tempo de execucao nao aparecem como literais
+#   - dos demais glifos (simbolos FontAwesome, grau, bullet) so os usados
+#   - cmap compacto: faixa FORMAT0_TINY para as sequencias continuas e
+#     SPARSE_TINY para o resto; classes de kerning renumeradas
+#   - tamanhos habilitados em lv_conf.h e nao usados sao sinalizados
+#
+# O relatorio compara bytes de .rodata (bitmaps + descritores + cmap +
+# kerning) das fontes completas com o pacote e o numero de linhas de cache
+# de flash que os bitmaps ocupam.
+#
+# Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+# Desenvolvido por Mario Stanski Jr
+#
+# ============================================================================
+
+import argparse
+import os
+import re
+import sys
+
+ASCII_FIRST = 0x20
+ASCII_LAST = 0x7E
+
+SOURCE_EXTS = (".c", ".cpp", ".h", ".hpp")
+SKIP_FILES = ("lv_conf.h",)
+
+# Sequencias continuas menores que isso vao para a lista esparsa
+FORMAT0_MIN_RUN = 8
+
+# Tamanho (32 bits) das estruturas da LVGL, para o relatorio
+GLYPH_DSC_SIZE = 8
+CMAP_SIZE = 20
+FLASH_CACHE_LINE = 32
+
+
+# ============================================================================
+# VARREDURA DOS FONTES DA UI
+# ============================================================================
+
+_STRING_RE = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+_COMMENT_RE = re.compile(r'//[^\n]*|/\*.*?\*/|("(?:[^"\\\n]|\\.)*"|\'(?:[^\'\\\n]|\\.)*\')', re.S)
+_FONT_RE = re.compile(r"\blv_font_montserrat_(\d+)\b")
+_SYMBOL_USE_RE = re.compile(r"\b(LV_SYMBOL_[A-Z0-9_]+)\b")
+_SYMBOL_DEF_RE = re.compile(r'#define\s+(LV_SYMBOL_[A-Z0-9_]+)\s+"([^"]*)"')
+_LOG_CALL_RE = re.compile(r"\b(?:esp_rom_printf|printf|ESP_LOG[EWIDV]|LOG_[EWIDV])\s*\(")
+
+# LV_SYMBOL_DUMMY marca "sem simbolo" e nao existe em nenhuma fonte
+SKIP_SYMBOLS = ("LV_SYMBOL_DUMMY",)
+
+
+def strip_comments(text):
+    """Remove comentarios preservando strings e caracteres literais"""
+    return _COMMENT_RE.sub(lambda m: m.group(1) or " ", text)
+
+
+def unescape_c(body):
+    """Decodifica um literal C (sem as aspas) para bytes"""
+    out = bytearray()
+    i = 0
+    raw = body.encode("utf-8")
+    while i < len(raw):
+        c = raw[i]
+        if c != 0x5C:
+            out.append(c)
+            i += 1
+            continue
+        i += 1
+        e = chr(raw[i])
+        if e == "x":
+            j = i + 1
+            while j < len(raw) and chr(raw[j]) in "0123456789abcdefABCDEF":
+                j += 1
+            out.append(int(raw[i + 1:j], 16) & 0xFF)
+            i = j
+        elif e in "01234567":
+            j = i
+            while j < len(raw) and j < i + 3 and chr(raw[j]) in "01234567":
+                j += 1
+            out.append(int(raw[i:j], 8) & 0xFF)
+            i = j
+        else:
+            out += {"n": b"\n", "t": b"\t", "r": b"\r", "0": b"\0"}.get(e, e.encode())
+            i += 1
+    return bytes(out)
+
+
+def load_symbols(lvgl_dir):
+    """LV_SYMBOL_* -> codepoint, de lv_symbol_def.h"""
+    path = os.path.join(lvgl_dir, "src", "font", "lv_symbol_def.h")
+    symbols = {}
+    with open(path, encoding="utf-8") as f:
+        for name, body in _SYMBOL_DEF_RE.findall(f.read()):
+            text = unescape_c(body).decode("utf-8")
+            if len(text) == 1 and name not in SKIP_SYMBOLS:
+                symbols[name] = ord(text)
+    return symbols
+
+
+def scan_sources(roots, symbols):
+    """Retorna (tamanhos usados, {codepoint fora do ASCII: [arquivos]})"""
+    sizes = {}
+    glyphs = {}
+
+    files = []
+    for root in roots:
+        if os.path.isfile(root):
+            files.append(root)
+            continue
+        for dirpath, _, names in os.walk(root):
+            for name in names:
+                if name.endswith(SOURCE_EXTS) and name not in SKIP_FILES:
+                    files.append(os.path.join(dirpath, name))
+
+    for path in sorted(files):
+        with open(path, encoding="utf-8", errors="replace") as f:
+            code = strip_comments(f.read())
+        rel = os.path.relpath(path)
+
+        for size in _FONT_RE.findall(code):
+            sizes.setdefault(int(size), set()).add(rel)
+
+        for name in _SYMBOL_USE_RE.findall(code):
+            if name in symbols:
+                glyphs.setdefault(symbols[name], set()).add(rel)
+
+        # Literais de log nao vao para a tela
+        for line in code.splitlines():
+            if _LOG_CALL_RE.search(line):
+                continue
+            for body in _STRING_RE.findall(line):
+                text = unescape_c(body).decode("utf-8", errors="ignore")
+                for ch in text:
+                    if ord(ch) > ASCII_LAST:
+                        glyphs.setdefault(ord(ch), set()).add(rel)
+
+    return sizes, glyphs
+
+
+def read_conf(conf_path):
+    """Tamanhos habilitados e tamanho da LV_FONT_DEFAULT em lv_conf.h"""
+    with open(conf_path, encoding="utf-8") as f:
+        text = strip_comments(f.read())
+
+    enabled = set()
+    for size, value in re.findall(r"#define\s+LV_FONT_MONTSERRAT_(\d+)\s+(.+)", text):
+        if value.strip() not in ("0", "(0)"):
+            enabled.add(int(size))
+
+    default = re.search(r"#define\s+LV_FONT_DEFAULT\s+&lv_font_montserrat_(\d+)", text)
+    return enabled, int(default.group(1)) if default else None
+
+
+# ============================================================================
+# LEITURA DAS FONTES DA LVGL (lv_font_conv --format lvgl, sem compressao)
+# ============================================================================
+
+def _array(text, name):
+    m = re.search(r"\b%s\[\]\s*=\s*\{(.*?)\n\};" % re.escape(name), text, re.S)
+    if not m:
+        return None
+    body = re.sub(r"/\*.*?\*/", "", m.group(1), flags=re.S)
+    return [int(v, 0) for v in re.findall(r"-?(?:0x[0-9a-fA-F]+|\d+)", body)]
+
+
+def _field(text, name):
+    m = re.search(r"\.%s\s*=\s*(-?\d+)" % name, text)
+    if not m:
+        raise ValueError("campo .%s nao encontrado" % name)
+    return int(m.group(1))
+
+
+def parse_font(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+
+    font = {
+        "bpp": _field(text, "bpp"),
+        "kern_scale": _field(text, "kern_scale"),
+        "line_height": _field(text, "line_height"),
+        "base_line": _field(text, "base_line"),
+        "underline_position": _field(text, "underline_position"),
+        "underline_thickness": _field(text, "underline_thickness"),
+    }
+    if _field(text, "bitmap_format") != 0:
+        raise ValueError("%s: fonte comprimida nao suportada" % path)
+    if _field(text, "kern_classes") != 1:
+        raise ValueError("%s: kerning por pares nao suportado" % path)
+
+    font["bitmap"] = _array(text, "glyph_bitmap")
+    font["glyphs"] = [
+        tuple(int(v) for v in g) for g in re.findall(
+            r"\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), \.box_h = (\d+), "
+            r"\.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}", text)
+    ]
+
+    # codepoint -> glyph id antigo
+    cmap = {}
+    for m in re.finditer(r"\.range_start = (\d+), \.range_length = (\d+), \.glyph_id_start = (\d+),\s*"
+                         r"\.unicode_list = (\w+), \.glyph_id_ofs_list = (\w+), \.list_length = (\d+), "
+                         r"\.type = (\w+)", text):
+        start, length, gid = int(m.group(1)), int(m.group(2)), int(m.group(3))
+        ctype = m.group(7)
+        if ctype == "LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY":
+            for i in range(length):
+                cmap.setdefault(start + i, gid + i)
+        elif ctype == "LV_FONT_FMT_TXT_CMAP_SPARSE_TINY":
+            for i, ofs in enumerate(_array(text, m.group(4))):
+                cmap.setdefault(start + ofs, gid + i)
+        else:
+            raise ValueError("%s: cmap %s nao suportado" % (path, ctype))
+    font["cmap"] = cmap
+
+    font["left_map"] = _array(text, "kern_left_class_mapping")
+    font["right_map"] = _array(text, "kern_right_class_mapping")
+    font["kern_values"] = _array(text, "kern_class_values")
+    font["left_cnt"] = _field(text, "left_class_cnt")
+    font["right_cnt"] = _field(text, "right_class_cnt")
+    return font
+
+
+def glyph_bytes(font, gid):
+    _, _, w, h, _, _ = font["glyphs"][gid]
+    return (w * h * font["bpp"] + 7) // 8
+
+
+def cache_lines(font, gids):
+    lines = set()
+    for gid in gids:
+        start = font["glyphs"][gid][0]
+        for addr in range(start, start + glyph_bytes(font, gid)):
+            lines.add(addr // FLASH_CACHE_LINE)
+    return len(lines)
+
+
+def rodata_size(n_glyphs, bitmap, cmaps, sparse, left_cnt, right_cnt):
+    return (bitmap + n_glyphs * GLYPH_DSC_SIZE + cmaps * CMAP_SIZE + sparse * 2 +
+            2 * n_glyphs + left_cnt * right_cnt)
+
+
+# ============================================================================
+# SUBCONJUNTO
+# ============================================================================
+
+def subset(font, codepoints):
+    cps = sorted(cp for cp in codepoints if cp in font["cmap"])
+    old_ids = [font["cmap"][cp] for cp in cps]
+
+    # Bitmaps na ordem dos novos ids
+    bitmap = []
+    glyphs = [(0, 0, 0, 0, 0, 0)]
+    for gid in old_ids:
+        start, adv, w, h, ox, oy = font["glyphs"][gid]
+        size = glyph_bytes(font, gid)
+        glyphs.append((len(bitmap), adv, w, h, ox, oy))
+        bitmap += font["bitmap"][start:start + size]
+
+    # Sequencias continuas -> FORMAT0_TINY; o resto entre elas -> SPARSE_TINY.
+    # range_length = ultimo - primeiro: a busca da LVGL aceita rcp <= range_length
+    # e para na primeira faixa que contem o codepoint, entao nao pode haver sobra.
+    runs = []
+    i = 0
+    while i < len(cps):
+        j = i
+        while j + 1 < len(cps) and cps[j + 1] == cps[j] + 1:
+            j += 1
+        runs.append((i, j))
+        i = j + 1
+
+    cmaps = []
+    pending = []
+
+    def flush_sparse():
+        if pending:
+            first = cps[pending[0]]
+            cmaps.append(("SPARSE_TINY", first, cps[pending[-1]] - first, pending[0] + 1,
+                          [cps[k] - first for k in pending]))
+            del pending[:]
+
+    for i, j in runs:
+        if j - i + 1 >= FORMAT0_MIN_RUN:
+            flush_sparse()
+            cmaps.append(("FORMAT0_TINY", cps[i], cps[j] - cps[i], i + 1, None))
+        else:
+            pending.extend(range(i, j + 1))
+    flush_sparse()
+
+    for kind, first, span, _, lst in cmaps:
+        if span > 0xFFFF:
+            raise ValueError("faixa de cmap maior que 64k a partir de U+%04X" % first)
+
+    # Classes de kerning renumeradas (so as dos glifos mantidos)
+    def remap(mapping):
+        used = sorted({mapping[g] for g in old_ids if mapping[g]})
+        index = {c: n + 1 for n, c in enumerate(used)}
+        return [0] + [index.get(mapping[g], 0) for g in old_ids], used
+
+    left_map, left_used = remap(font["left_map"])
+    right_map, right_used = remap(font["right_map"])
+    values = [font["kern_values"][(l - 1) * font["right_cnt"] + (r - 1)]
+              for l in left_used for r in right_used]
+
+    # Sem nenhum par com valor, o kerning inteiro e dispensavel
+    if not any(values):
+        left_map = right_map = values = None
+        left_used = right_used = []
+
+    return {
+        "codepoints": cps,
+        "old_ids": old_ids,
+        "bitmap": bitmap,
+        "glyphs": glyphs,
+        "cmaps": cmaps,
+        "left_map": left_map,
+        "right_map": right_map,
+        "values": values,
+        "left_cnt": len(left_used),
+        "right_cnt": len(right_used),
+    }
+
+
+# ============================================================================
+# GERACAO DO .C
+# ============================================================================
+
+def _rows(values, fmt, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt % v for v in values[i:i + per_line]))
+    return ",\n".join(lines)
+
+
+def _char_comment(cp):
+    if cp == 0x5C:
+        return "\\\\"
+    if ASCII_FIRST <= cp <= ASCII_LAST and cp != 0x2A:
+        return chr(cp)
+    return ""
+
+
+def emit_font(size, font, sub):
+    p = "montserrat_%d" % size
+    out = []
+    out.append("/*-----------------\n * %s (%d glifos)\n *----------------*/\n" % (p, len(sub["codepoints"])))
+
+    out.append("static LV_ATTRIBUTE_LARGE_CONST const uint8_t %s_bitmap[] = {" % p)
+    for n, cp in enumerate(sub["codepoints"]):
+        start = sub["glyphs"][n + 1][0]
+        end = sub["glyphs"][n + 2][0] if n + 2 < len(sub["glyphs"]) else len(sub["bitmap"])
+        out.append("    /* U+%04X \"%s\" */" % (cp, _char_comment(cp)))
+        if end > start:
+            out.append(_rows(sub["bitmap"][start:end], "0x%x", 16) + ",")
+        out.append("")
+    out.append("};\n")
+
+    out.append("static const lv_font_fmt_txt_glyph_dsc_t %s_glyph_dsc[] = {" % p)
+    out.append(",\n".join(
+        "    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d}" % g
+        for g in sub["glyphs"]))
+    out.append("};\n")
+
+    for n, (kind, _, _, _, lst) in enumerate(sub["cmaps"]):
+        if lst is not None:
+            out.append("static const uint16_t %s_unicode_list_%d[] = {" % (p, n))
+            out.append(_rows(lst, "0x%x", 8))
+            out.append("};\n")
+
+    out.append("static const lv_font_fmt_txt_cmap_t %s_cmaps[] = {" % p)
+    entries = []
+    for n, (kind, first, span, gid, lst) in enumerate(sub["cmaps"]):
+        entries.append(
+            "    {\n"
+            "        .range_start = %d, .range_length = %d, .glyph_id_start = %d,\n"
+            "        .unicode_list = %s, .glyph_id_ofs_list = NULL, .list_length = %d, "
+            ".type = LV_FONT_FMT_TXT_CMAP_%s\n    }" % (
+                first, span, gid,
+                "%s_unicode_list_%d" % (p, n) if lst is not None else "NULL",
+                len(lst) if lst is not None else 0, kind))
+    out.append(",\n".join(entries))
+    out.append("};\n")
+
+    if sub["values"] is not None:
+        out.append("static const uint8_t %s_kern_left[] = {" % p)
+        out.append(_rows(sub["left_map"], "%d", 16))
+        out.append("};\n")
+        out.append("static const uint8_t %s_kern_right[] = {" % p)
+        out.append(_rows(sub["right_map"], "%d", 16))
+        out.append("};\n")
+        out.append("static const int8_t %s_kern_values[] = {" % p)
+        out.append(_rows(sub["values"], "%d", 16))
+        out.append("};\n")
+        out.append("static const lv_font_fmt_txt_kern_classes_t %s_kern_classes = {" % p)
+        out.append("    .class_pair_values   = %s_kern_values," % p)
+        out.append("    .left_class_mapping  = %s_kern_left," % p)
+        out.append("    .right_class_mapping = %s_kern_right," % p)
+        out.append("    .left_class_cnt      = %d," % sub["left_cnt"])
+        out.append("    .right_class_cnt     = %d," % sub["right_cnt"])
+        out.append("};\n")
+
+    out.append("static lv_font_fmt_txt_glyph_cache_t %s_cache;" % p)
+    out.append("static const lv_font_fmt_txt_dsc_t %s_dsc = {" % p)
+    out.append("    .glyph_bitmap = %s_bitmap," % p)
+    out.append("    .glyph_dsc = %s_glyph_dsc," % p)
+    out.append("    .cmaps = %s_cmaps," % p)
+    if sub["values"] is not None:
+        out.append("    .kern_dsc = &%s_kern_classes," % p)
+        out.append("    .kern_scale = %d," % font["kern_scale"])
+    else:
+        out.append("    .kern_dsc = NULL,")
+        out.append("    .kern_scale = 0,")
+    out.append("    .cmap_num = %d," % len(sub["cmaps"]))
+    out.append("    .bpp = %d," % font["bpp"])
+    out.append("    .kern_classes = %d," % (1 if sub["values"] is not None else 0))
+    out.append("    .bitmap_format = 0,")
+    out.append("    .cache = &%s_cache" % p)
+    out.append("};\n")
+
+    out.append("const lv_font_t lv_font_%s = {" % p)
+    out.append("    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,")
+    out.append("    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,")
+    out.append("    .line_height = %d," % font["line_height"])
+    out.append("    .base_line = %d," % font["base_line"])
+    out.append("    .subpx = LV_FONT_SUBPX_NONE,")
+    out.append("    .underline_position = %d," % font["underline_position"])
+    out.append("    .underline_thickness = %d," % font["underline_thickness"])
+    out.append("    .dsc = &%s_dsc" % p)
+    out.append("};\n")
+    return "\n".join(out)
+
+
+def emit_pack(fonts):
+    head = (
+        "/*******************************************************************************\n"
+        " * Pacote de fontes gerado por tools/fonts/font_subset.py - NAO EDITAR\n"
+        " * Tamanhos: %s\n"
+        " ******************************************************************************/\n\n"
+        "#include \"lvgl.h\"\n\n"
+        "#if LV_FONT_PACK\n\n" % ", ".join(str(s) for s, _, _ in fonts))
+    body = "\n".join(emit_font(size, font, sub) for size, font, sub in fonts)
+    return head + body + "\n#endif /*LV_FONT_PACK*/\n"
+
+
+# ============================================================================
+# MAIN
+# ============================================================================
+
+def main():
+    parser = argparse.ArgumentParser(description="Gera o pacote de fontes Montserrat recortado para a UI")
+    parser.add_argument("sources", nargs="+", help="diretorios/arquivos da UI a varrer")
+    parser.add_argument("--lvgl", required=True, help="diretorio da LVGL (lib/lvgl)")
+    parser.add_argument("--conf", required=True, help="lv_conf.h")
+    parser.add_argument("-o", "--output", required=True, help=".c gerado")
+    parser.add_argument("--extra", default="",
+                        help="codepoints adicionais, ex.: 0xB0,0x2022 (texto vindo de fora)")
+    parser.add_argument("-v", "--verbose", action="store_true", help="listar glifos e origem")
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.lvgl)
+    sizes, glyphs = scan_sources(args.sources, symbols)
+    enabled, default = read_conf(args.conf)
+    if default is not None:
+        sizes.setdefault(default, set()).add("LV_FONT_DEFAULT")
+
+    codepoints = set(range(ASCII_FIRST, ASCII_LAST + 1)) | set(glyphs)
+    for cp in filter(None, args.extra.split(",")):
+        codepoints.add(int(cp, 0))
+
+    font_dir = os.path.join(args.lvgl, "src", "font")
+    fonts = []
+    missing = set()
+    full_total = pack_total = 0
+    full_lines = pack_lines = 0
+
+    print("Pacote de fontes -> %s" % args.output)
+    for size in sorted(sizes):
+        path = os.path.join(font_dir, "lv_font_montserrat_%d.c" % size)
+        if not os.path.exists(path):
+            sys.exit("erro: lv_font_montserrat_%d nao existe na LVGL (%s)" % (size, ", ".join(sorted(sizes[size]))))
+        font = parse_font(path)
+        sub = subset(font, codepoints)
+        missing |= codepoints - set(font["cmap"])
+
+        full = rodata_size(len(font["glyphs"]), len(font["bitmap"]), 2,
+                           len(font["cmap"]) - (ASCII_LAST - ASCII_FIRST + 1),
+                           font["left_cnt"], font["right_cnt"])
+        sparse = sum(len(c[4]) for c in sub["cmaps"] if c[4] is not None)
+        packed = rodata_size(len(sub["glyphs"]), len(sub["bitmap"]), len(sub["cmaps"]), sparse,
+                             sub["left_cnt"], sub["right_cnt"])
+        if sub["values"] is None:
+            packed -= 2 * len(sub["glyphs"])
+
+        lines_full = cache_lines(font, sub["old_ids"])
+        lines_pack = (len(sub["bitmap"]) + FLASH_CACHE_LINE - 1) // FLASH_CACHE_LINE
+        full_total += full
+        pack_total += packed
+        full_lines += lines_full
+        pack_lines += lines_pack
+        fonts.append((size, font, sub))
+
+        print("  montserrat_%-3d %3d -> %3d glifos  %7d -> %6d B  linhas de cache %5d -> %5d" % (
+            size, len(font["glyphs"]) - 1, len(sub["codepoints"]), full, packed, lines_full, lines_pack))
+        if args.verbose:
+            print("      usado em: %s" % ", ".join(sorted(sizes[size])))
+
+    # Fontes completas habilitadas e nao usadas: flash desperdicada sem o pacote
+    unused = sorted(enabled - set(sizes))
+    for size in unused:
+        font = parse_font(os.path.join(font_dir, "lv_font_montserrat_%d.c" % size))
+        full = rodata_size(len(font["glyphs"]), len(font["bitmap"]), 2,
+                           len(font["cmap"]) - (ASCII_LAST - ASCII_FIRST + 1),
+                           font["left_cnt"], font["right_cnt"])
+        full_total += full
+        print("  AVISO: montserrat_%d habilitada em lv_conf.h e nao usada (%d B)" % (size, full))
+
+    for cp in sorted(cp for cp in missing if cp in glyphs):
+        print("  AVISO: U+%04X nao existe na Montserrat da LVGL (%s)" % (cp, ", ".join(sorted(glyphs[cp]))))
+
+    if args.verbose:
+        extra = sorted(cp for cp in codepoints if cp > ASCII_LAST and cp not in missing)
+        print("  glifos alem do ASCII: %s" % " ".join("U+%04X" % cp for cp in extra))
+
+    print("  total %d -> %d B (-%d B)  linhas de %d B tocadas pelos glifos: %d -> %d" % (
+        full_total, pack_total, full_total - pack_total, FLASH_CACHE_LINE, full_lines, pack_lines))
+
+    text = emit_pack(fonts)
+    old = None
+    if os.path.exists(args.output):
+        with open(args.output, encoding="utf-8") as f:
+            old = f.read()
+    # So reescreve se mudou, para nao recompilar o pacote a cada build
+    if old != text:
+        os.makedirs(os.path.dirname(os.path.abspath(args.output)), exist_ok=True)
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,34 @@
+# ============================================================================
+# PLATFORMIO: PACOTE DE FONTES
+# ============================================================================
+#
+# O builder ESP-IDF do PlatformIO compila as fontes listadas no configure do
+# CMake, mas nao executa os custom commands: este script regera o
+# lv_font_pack.c no mesmo caminho antes de cada build, para mudancas na UI
+# entrarem sem reconfigurar. Nada a fazer com LV_FONT_PACK 0.
+#
+# Copyright (c) 2024-2026 Getscale Sistemas Embarcados
+# Desenvolvido por Mario Stanski Jr
+#
+# ============================================================================
+
+import os
+import re
+import subprocess
+
+Import("env")  # noqa: F821 (injetado pelo SCons)
+
+project_dir = env.subst("$PROJECT_DIR")
+build_dir = env.subst("$BUILD_DIR")
+tool = os.path.join(project_dir, "tools", "fonts", "font_subset.py")
+conf = os.path.join(project_dir, "include", "lv_conf.h")
+output = os.path.join(build_dir, "font_pack", "lv_font_pack.c")
+
+with open(conf) as f:
+    enabled = re.search(r"^#define[ \t]+LV_FONT_PACK[ \t]+1", f.read(), re.M)
+
+if enabled:
+    subprocess.check_call([env.subst("$PYTHONEXE"), tool,
+                           "--lvgl", os.path.join(project_dir, "lib", "lvgl"),
+                           "--conf", conf, "-o", output,
+                           os.path.join(project_dir, "src"), os.path.join(project_dir, "include")])